@@ -222,6 +222,47 @@ int main(int argc, char **argv)
   amg_tag_sa_pmis.set_interpolation_method(viennacl::linalg::AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION);
   run_amg (cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), SA INTERPOLATION", amg_tag_sa_pmis);
 
+  /**
+  * Smoothed aggregation with a Chebyshev smoother (degree 2, largest eigenvalue estimated during setup) and with a hybrid l1-Gauss-Seidel smoother instead of damped Jacobi
+  **/
+  viennacl::linalg::amg_tag amg_tag_sa_cheby(amg_tag_sa_pmis);
+  amg_tag_sa_cheby.set_smoother_type(viennacl::linalg::AMG_SMOOTHER_CHEBYSHEV);
+  amg_tag_sa_cheby.set_chebyshev_degree(2);
+  run_amg (cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), SA INTERPOLATION, CHEBYSHEV SMOOTHER", amg_tag_sa_cheby);
+
+  viennacl::linalg::amg_tag amg_tag_sa_l1gs(amg_tag_sa_pmis);
+  amg_tag_sa_l1gs.set_smoother_type(viennacl::linalg::AMG_SMOOTHER_L1_GAUSS_SEIDEL);
+  run_amg (cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), SA INTERPOLATION, L1-GAUSS-SEIDEL SMOOTHER", amg_tag_sa_l1gs);
+
+  /**
+  * If only the values of the system matrix change (e.g. from one time step to the next), the preconditioner can be updated via update_values().
+  * This keeps the coarsening and the sparsity patterns of all operators and is considerably cheaper than a new setup:
+  **/
+  {
+    std::cout << "-- CG with AMG preconditioner, AG COARSENING (PMIS), SA INTERPOLATION, UPDATED VALUES --" << std::endl;
+    std::vector< std::map<unsigned int, ScalarType> > shifted_matrix(read_in_matrix);
+    for (std::size_t i=0; i<shifted_matrix.size(); ++i)
+      if (shifted_matrix[i].find(static_cast<unsigned int>(i)) != shifted_matrix[i].end())
+        shifted_matrix[i][static_cast<unsigned int>(i)] *= ScalarType(1.1);
+
+    viennacl::compressed_matrix<ScalarType> vcl_shifted_matrix(ctx);
+    viennacl::copy(shifted_matrix, vcl_shifted_matrix);
+    viennacl::vector<ScalarType> vcl_shifted_vec = viennacl::linalg::prod(vcl_shifted_matrix, vcl_result);
+
+    viennacl::linalg::amg_precond<viennacl::compressed_matrix<ScalarType> > vcl_amg(vcl_compressed_matrix, amg_tag_sa_pmis);
+    vcl_amg.setup();
+
+    std::cout << " * Update phase (ViennaCL types)..." << std::endl;
+    viennacl::tools::timer timer;
+    timer.start();
+    vcl_amg.update_values(vcl_shifted_matrix);
+    viennacl::backend::finish();
+    std::cout << "  > Update time: " << timer.get() << std::endl;
+
+    std::cout << " * CG solver (ViennaCL types)..." << std::endl;
+    run_solver(vcl_shifted_matrix, vcl_shifted_vec, vcl_result, cg_solver, vcl_amg);
+  }
+
   std::cout << std::endl;
   std::cout << " -------------- Benchmark runs -------------- " << std::endl;
   std::cout << std::endl;
@@ -231,6 +272,8 @@ int main(int argc, char **argv)
   run_amg(cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "ONEPASS COARSENING, DIRECT INTERPOLATION", amg_tag_direct);
   run_amg(cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), AG INTERPOLATION", amg_tag_agg_pmis);
   run_amg (cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), SA INTERPOLATION", amg_tag_sa_pmis);
+  run_amg (cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), SA INTERPOLATION, CHEBYSHEV SMOOTHER", amg_tag_sa_cheby);
+  run_amg (cg_solver, vcl_vec, vcl_result, vcl_compressed_matrix, "AG COARSENING (PMIS), SA INTERPOLATION, L1-GAUSS-SEIDEL SMOOTHER", amg_tag_sa_l1gs);
 
   /**
   *  That's it.
@@ -0,0 +1,378 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/amg.cpp  Tests the algebraic multigrid preconditioner.
+*   \test  Tests the Galerkin product against two sparse matrix-matrix products, the smoothers within AMG-preconditioned CG, and the update of the AMG hierarchy for new matrix values against a full setup.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/amg.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::map<unsigned int, double> > std_sparse_matrix;
+
+/* 5-point finite difference Laplacian on an n x n grid with variable coefficients. */
+std_sparse_matrix poisson_2d(unsigned int n)
+{
+  std_sparse_matrix A(n * n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+    {
+      unsigned int row = i * n + j;
+      double diag = 0;
+      if (i > 0)   { double v = 1.0 + 0.5 * std::sin(double(row));     A[row][row - n] = -v; diag += v; }
+      if (i < n-1) { double v = 1.0 + 0.5 * std::sin(double(row + n)); A[row][row + n] = -v; diag += v; }
+      if (j > 0)   { double v = 1.0 + 0.5 * std::cos(double(row));     A[row][row - 1] = -v; diag += v; }
+      if (j < n-1) { double v = 1.0 + 0.5 * std::cos(double(row + 1)); A[row][row + 1] = -v; diag += v; }
+      A[row][row] = diag + 0.1;
+    }
+  return A;
+}
+
+/* Returns a matrix with the same sparsity pattern and the same strong connections, but different values. */
+std_sparse_matrix rescale(std_sparse_matrix const & A)
+{
+  std_sparse_matrix B(A);
+  for (std::size_t i=0; i<B.size(); ++i)
+    for (std::map<unsigned int, double>::iterator it = B[i].begin(); it != B[i].end(); ++it)
+      it->second *= (it->first == i) ? 3.5 : 3.0;
+  return B;
+}
+
+/* Returns the relative difference of the preconditioner applications to a fixed vector. */
+template<typename PrecondT>
+double apply_difference(PrecondT const & P1, PrecondT const & P2, std::size_t size)
+{
+  viennacl::vector<double> x1(size);
+  for (std::size_t i=0; i<size; ++i)
+    x1[i] = 1.0 + std::sin(double(i));
+  viennacl::vector<double> x2 = x1;
+
+  P1.apply(x1);
+  P2.apply(x2);
+
+  x1 -= x2;
+  return viennacl::linalg::norm_2(x1) / viennacl::linalg::norm_2(x2);
+}
+
+/* Reads the stored entries of a host matrix, including explicit zeros. */
+std_sparse_matrix to_std(viennacl::compressed_matrix<double> const & A)
+{
+  std_sparse_matrix result(A.size1());
+  if (A.size1() == 0)
+    return result;
+
+  std::vector<unsigned int> row_buffer(A.size1() + 1);
+  viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * row_buffer.size(), &row_buffer[0]);
+  std::size_t nnz = row_buffer[A.size1()];
+  if (nnz == 0)
+    return result;
+
+  std::vector<unsigned int> col_buffer(nnz);
+  std::vector<double>       elements(nnz);
+  viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * nnz, &col_buffer[0]);
+  viennacl::backend::memory_read(A.handle(),  0, sizeof(double) * nnz, &elements[0]);
+  for (std::size_t i=0; i<A.size1(); ++i)
+    for (unsigned int j=row_buffer[i]; j<row_buffer[i+1]; ++j)
+      result[i][col_buffer[j]] = elements[j];
+  return result;
+}
+
+/* Compares the fused Galerkin product with the reference R * (A * P). */
+int check_galerkin_prod(std_sparse_matrix const & std_A, std_sparse_matrix const & std_P, std::size_t coarse_size, std::string const & name)
+{
+  typedef viennacl::compressed_matrix<double> SparseMatrixType;
+
+  std::size_t fine_size = std_A.size();
+  std_sparse_matrix std_R(coarse_size);
+  for (std::size_t i=0; i<std_P.size(); ++i)
+    for (std::map<unsigned int, double>::const_iterator it = std_P[i].begin(); it != std_P[i].end(); ++it)
+      std_R[it->first][static_cast<unsigned int>(i)] = it->second;
+
+  viennacl::tools::const_sparse_matrix_adapter<double> adapted_A(std_A, fine_size, fine_size);
+  viennacl::tools::const_sparse_matrix_adapter<double> adapted_P(std_P, fine_size, coarse_size);
+  viennacl::tools::const_sparse_matrix_adapter<double> adapted_R(std_R, coarse_size, fine_size);
+  SparseMatrixType A(fine_size, fine_size), P(fine_size, coarse_size), R(coarse_size, fine_size);
+  viennacl::copy(adapted_A, A);
+  viennacl::copy(adapted_P, P);
+  viennacl::copy(adapted_R, R);
+
+  SparseMatrixType A_coarse;
+  viennacl::linalg::detail::amg::amg_galerkin_prod(A, P, R, A_coarse);
+
+  SparseMatrixType AP = viennacl::linalg::prod(A, P);
+  SparseMatrixType A_coarse_ref = viennacl::linalg::prod(R, AP);
+
+  if (A_coarse.size1() != coarse_size || A_coarse.size2() != coarse_size)
+  {
+    std::cout << "# Error for " << name << ": Galerkin product has size " << A_coarse.size1() << "x" << A_coarse.size2() << ", expected " << coarse_size << "x" << coarse_size << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std_sparse_matrix std_C     = to_std(A_coarse);
+  std_sparse_matrix std_C_ref = to_std(A_coarse_ref);
+  for (std::size_t i=0; i<coarse_size; ++i)
+  {
+    if (std_C[i].size() != std_C_ref[i].size())
+    {
+      std::cout << "# Error for " << name << ": Galerkin product has " << std_C[i].size() << " entries in row " << i << ", reference: " << std_C_ref[i].size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (std::map<unsigned int, double>::const_iterator it = std_C_ref[i].begin(); it != std_C_ref[i].end(); ++it)
+    {
+      std::map<unsigned int, double>::const_iterator it2 = std_C[i].find(it->first);
+      if (it2 == std_C[i].end() || std::fabs(it2->second - it->second) > 1e-13 * std::max(std::fabs(it->second), 1.0))
+      {
+        std::cout << "# Error for " << name << ": Galerkin product differs from R * (A * P) in entry (" << i << ", " << it->first << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Testing Galerkin product for " << name << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int test_galerkin_prod()
+{
+  unsigned int n = 12;
+  std_sparse_matrix std_A = poisson_2d(n);
+  std::size_t fine_size = std_A.size();
+
+  // aggregates of four consecutive points, the last aggregate consists of a single point:
+  std::vector<unsigned int> aggregate(fine_size);
+  for (std::size_t i=0; i<fine_size; ++i)
+    aggregate[i] = static_cast<unsigned int>(std::min<std::size_t>(i / 4, (fine_size - 2) / 4));
+  aggregate[fine_size - 1] = aggregate[fine_size - 2] + 1;
+  std::size_t coarse_size = aggregate[fine_size - 1] + 1;
+
+  std_sparse_matrix std_P(fine_size);
+  for (std::size_t i=0; i<fine_size; ++i)
+    std_P[i][aggregate[i]] = 1.0 + 0.1 * std::sin(double(i));
+  if (check_galerkin_prod(std_A, std_P, coarse_size, "tentative prolongation") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // several coarse points per fine point (as for smoothed aggregation):
+  std_sparse_matrix std_P_smoothed(std_P);
+  for (std::size_t i=0; i<fine_size; ++i)
+  {
+    if (aggregate[i] + 1 < coarse_size)
+      std_P_smoothed[i][aggregate[i] + 1] = 0.25 * std::cos(double(i));
+    if (aggregate[i] > 1)
+      std_P_smoothed[i][aggregate[i] - 2] = -0.125;
+  }
+  if (check_galerkin_prod(std_A, std_P_smoothed, coarse_size, "smoothed prolongation") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // empty rows in A and P, and a coarse point without fine points (empty row in R):
+  std_sparse_matrix std_A_empty(std_A);
+  std_sparse_matrix std_P_empty(std_P_smoothed);
+  for (std::size_t i=0; i<fine_size; i += 7)
+    std_A_empty[i].clear();
+  for (std::size_t i=3; i<fine_size; i += 11)
+    std_P_empty[i].clear();
+  for (std::size_t i=0; i<fine_size; ++i)
+    std_P_empty[i].erase(2);
+  if (check_galerkin_prod(std_A_empty, std_P_empty, coarse_size, "empty rows") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+int test_smoother(viennacl::linalg::amg_tag tag, viennacl::linalg::amg_smoother_type smoother, std::string const & name)
+{
+  typedef viennacl::compressed_matrix<double>            SparseMatrixType;
+  typedef viennacl::linalg::amg_precond<SparseMatrixType> PrecondType;
+
+  SparseMatrixType A;
+  viennacl::copy(poisson_2d(80), A);
+
+  viennacl::vector<double> b(A.size1());
+  for (std::size_t i=0; i<b.size(); ++i)
+    b[i] = 1.0 + std::cos(double(i));
+
+  viennacl::linalg::cg_tag cg_tag(1e-10, 500);
+  viennacl::vector<double> x = viennacl::linalg::solve(A, b, cg_tag);
+  std::size_t iters_unpreconditioned = cg_tag.iters();
+
+  tag.set_smoother_type(smoother);
+  srand(42);
+  PrecondType P(A, tag);
+  P.setup();
+
+  x = viennacl::linalg::solve(A, b, cg_tag, P);
+
+  viennacl::vector<double> r = viennacl::linalg::prod(A, x);
+  r = b - r;
+  double residual = viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b);
+  if (residual > 1e-8 || cg_tag.iters() * 4 > iters_unpreconditioned)
+  {
+    std::cout << "# Error for " << name << ": AMG-preconditioned CG took " << cg_tag.iters() << " iterations (unpreconditioned: "
+              << iters_unpreconditioned << "), relative residual " << residual << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing AMG-preconditioned CG with " << name << ": PASSED (" << cg_tag.iters() << " iterations, unpreconditioned: " << iters_unpreconditioned << ")" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int test_update_values(viennacl::linalg::amg_tag const & tag, std::string const & name, bool check_pattern_change)
+{
+  typedef viennacl::compressed_matrix<double>            SparseMatrixType;
+  typedef viennacl::linalg::amg_precond<SparseMatrixType> PrecondType;
+
+  std_sparse_matrix std_A0 = poisson_2d(40);
+  std_sparse_matrix std_A1 = rescale(std_A0);
+
+  SparseMatrixType A0, A1;
+  viennacl::copy(std_A0, A0);
+  viennacl::copy(std_A1, A1);
+
+  // coarsening with MIS(2) uses random numbers, hence reset the seed before each setup:
+  srand(42);
+  PrecondType P_updated(A0, tag);
+  P_updated.setup();
+
+  srand(42);
+  P_updated.update_values(A1);
+
+  srand(42);
+  PrecondType P_full(A1, tag);
+  P_full.setup();
+
+  double error = apply_difference(P_updated, P_full, A1.size1());
+  if (error > 1e-10)
+  {
+    std::cout << "# Error for " << name << ": update_values() differs from full setup, relative difference " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (check_pattern_change)
+  {
+    // move a coupling to the opposite corner of the grid: same number of nonzeros, but a different sparsity pattern
+    std_sparse_matrix std_A2(std_A1);
+    unsigned int last = static_cast<unsigned int>(std_A2.size() - 1);
+    double value = std_A2[0][1];
+    std_A2[0].erase(1);
+    std_A2[1].erase(0);
+    std_A2[0][last] = value;
+    std_A2[last][0] = value;
+
+    SparseMatrixType A2;
+    viennacl::copy(std_A2, A2);
+
+    srand(42);
+    P_updated.update_values(A2);
+
+    srand(42);
+    PrecondType P_full2(A2, tag);
+    P_full2.setup();
+
+    error = apply_difference(P_updated, P_full2, A2.size1());
+    if (error > 1e-10)
+    {
+      std::cout << "# Error for " << name << ": update_values() with changed sparsity pattern differs from full setup, relative difference " << error << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Testing update_values() for " << name << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Algebraic Multigrid" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  viennacl::linalg::amg_tag tag_direct;
+  tag_direct.set_coarsening_method(viennacl::linalg::AMG_COARSENING_METHOD_ONEPASS);
+  tag_direct.set_interpolation_method(viennacl::linalg::AMG_INTERPOLATION_METHOD_DIRECT);
+  tag_direct.set_strong_connection_threshold(0.25);
+  tag_direct.set_coarsening_cutoff(1000);
+
+  viennacl::linalg::amg_tag tag_ag;
+  tag_ag.set_coarsening_method(viennacl::linalg::AMG_COARSENING_METHOD_MIS2_AGGREGATION);
+  tag_ag.set_interpolation_method(viennacl::linalg::AMG_INTERPOLATION_METHOD_AGGREGATION);
+
+  viennacl::linalg::amg_tag tag_sa;
+  tag_sa.set_coarsening_method(viennacl::linalg::AMG_COARSENING_METHOD_MIS2_AGGREGATION);
+  tag_sa.set_interpolation_method(viennacl::linalg::AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION);
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  if (test_galerkin_prod() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "# Test passed" << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  viennacl::linalg::amg_tag tag_cheb(tag_sa);
+  tag_cheb.set_chebyshev_degree(3);
+  if (   test_smoother(tag_ag, viennacl::linalg::AMG_SMOOTHER_JACOBI, "Jacobi smoother, aggregation") != EXIT_SUCCESS
+      || test_smoother(tag_ag, viennacl::linalg::AMG_SMOOTHER_CHEBYSHEV, "Chebyshev smoother, aggregation") != EXIT_SUCCESS
+      || test_smoother(tag_cheb, viennacl::linalg::AMG_SMOOTHER_CHEBYSHEV, "Chebyshev smoother of degree 3, smoothed aggregation") != EXIT_SUCCESS
+      || test_smoother(tag_ag, viennacl::linalg::AMG_SMOOTHER_L1_GAUSS_SEIDEL, "l1-Gauss-Seidel smoother, aggregation") != EXIT_SUCCESS
+      || test_smoother(tag_sa, viennacl::linalg::AMG_SMOOTHER_L1_GAUSS_SEIDEL, "l1-Gauss-Seidel smoother, smoothed aggregation") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "# Test passed" << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  if (   test_update_values(tag_direct, "direct interpolation", false) != EXIT_SUCCESS
+      || test_update_values(tag_ag, "aggregation", true) != EXIT_SUCCESS
+      || test_update_values(tag_sa, "smoothed aggregation", true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "# Test passed" << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,339 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/cpu_ram.cpp  Tests the main memory backend.
+*   \test  Tests buffer reuse, alignment and statistics of the memory pool for main memory, and the copy routines of the main memory backend.
+**/
+
+//
+// *** System
+//
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+//
+// *** ViennaCL
+//
+#include "viennacl/backend/cpu_ram.hpp"
+#include "viennacl/vector.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+namespace cpu_ram = viennacl::backend::cpu_ram;
+typedef viennacl::vcl_size_t vcl_size_t;
+
+bool is_aligned(cpu_ram::handle_type const & h)
+{
+  return (reinterpret_cast<vcl_size_t>(h.get()) % VIENNACL_CPU_RAM_ALIGNMENT) == 0;
+}
+
+int test_pool()
+{
+  //
+  // By default, released buffers are not kept:
+  //
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(10000);
+  }
+  if (cpu_ram::memory_pool_info().bytes_cached != 0)
+  {
+    std::cout << "# Error: Released buffer kept with the default pool limit" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  cpu_ram::memory_pool_limit(vcl_size_t(1) << 30);
+  cpu_ram::memory_pool_release();
+
+  cpu_ram::memory_pool_statistics stats_begin = cpu_ram::memory_pool_info();
+  if (stats_begin.bytes_cached != 0)
+  {
+    std::cout << "# Error: Pool not empty after release (" << stats_begin.bytes_cached << " bytes cached)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Alignment and size classes:
+  //
+  vcl_size_t sizes[] = {1, 7, 64, 65, 1000, 4096, 100000, 1234567};
+  vcl_size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+  for (vcl_size_t i=0; i<num_sizes; ++i)
+  {
+    vcl_size_t capacity = cpu_ram::detail::memory_pool::size_class(sizes[i]);
+    if (capacity < sizes[i] || capacity > sizes[i] + sizes[i] / 4 + VIENNACL_CPU_RAM_ALIGNMENT)
+    {
+      std::cout << "# Error: Invalid size class " << capacity << " for " << sizes[i] << " bytes" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<char> data(sizes[i]);
+    for (vcl_size_t j=0; j<sizes[i]; ++j)
+      data[j] = char(j * 7 + i);
+
+    cpu_ram::handle_type h = cpu_ram::memory_create(sizes[i], &data[0]);
+    if (!is_aligned(h))
+    {
+      std::cout << "# Error: Buffer of " << sizes[i] << " bytes not aligned" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (vcl_size_t j=0; j<sizes[i]; ++j)
+      if (h.get()[j] != data[j])
+      {
+        std::cout << "# Error: Buffer of " << sizes[i] << " bytes not initialized correctly" << std::endl;
+        return EXIT_FAILURE;
+      }
+  }
+
+  //
+  // Reuse: a released buffer is handed out again for a request of the same size class.
+  //
+  cpu_ram::memory_pool_statistics stats_before = cpu_ram::memory_pool_info();
+  char * first_ptr = NULL;
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(10000);
+    first_ptr = h.get();
+
+    cpu_ram::memory_pool_statistics stats = cpu_ram::memory_pool_info();
+    if (stats.bytes_in_use != stats_before.bytes_in_use + cpu_ram::detail::memory_pool::size_class(10000))
+    {
+      std::cout << "# Error: bytes_in_use not updated on allocation" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  cpu_ram::memory_pool_statistics stats_released = cpu_ram::memory_pool_info();
+  if (stats_released.bytes_in_use != stats_before.bytes_in_use
+      || stats_released.bytes_cached != stats_before.bytes_cached + cpu_ram::detail::memory_pool::size_class(10000))
+  {
+    std::cout << "# Error: Released buffer not kept in pool" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(9990); // same size class
+    cpu_ram::memory_pool_statistics stats = cpu_ram::memory_pool_info();
+    if (h.get() != first_ptr || stats.hits != stats_released.hits + 1 || stats.misses != stats_released.misses)
+    {
+      std::cout << "# Error: Released buffer not reused" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // Peak usage and limit:
+  //
+  {
+    cpu_ram::handle_type h1 = cpu_ram::memory_create(1 << 20);
+    cpu_ram::handle_type h2 = cpu_ram::memory_create(1 << 20);
+    cpu_ram::memory_pool_statistics stats = cpu_ram::memory_pool_info();
+    if (stats.peak_bytes_in_use < stats.bytes_in_use || stats.bytes_in_use < stats_before.bytes_in_use + (vcl_size_t(2) << 20))
+    {
+      std::cout << "# Error: Inconsistent peak memory usage" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  cpu_ram::memory_pool_limit(0);
+  {
+    cpu_ram::handle_type h = cpu_ram::memory_create(1000);
+  }
+  if (cpu_ram::memory_pool_info().bytes_cached != 0)
+  {
+    std::cout << "# Error: Buffers kept in pool despite zero limit" << std::endl;
+    return EXIT_FAILURE;
+  }
+  cpu_ram::memory_pool_limit(vcl_size_t(1) << 30);
+
+  //
+  // Concurrent allocation and release:
+  //
+  cpu_ram::memory_pool_statistics stats_concurrent = cpu_ram::memory_pool_info();
+  bool concurrent_ok = true;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(&&: concurrent_ok)
+#endif
+  for (long i = 0; i < 4000; ++i)
+  {
+    vcl_size_t size = vcl_size_t(64 + (i % 17) * 1000);
+    cpu_ram::handle_type h = cpu_ram::memory_create(size);
+    h.get()[0] = char(i);
+    h.get()[size - 1] = char(i);
+    concurrent_ok = concurrent_ok && is_aligned(h) && h.get()[0] == char(i) && h.get()[size - 1] == char(i);
+  }
+
+  cpu_ram::memory_pool_statistics stats_end = cpu_ram::memory_pool_info();
+  if (!concurrent_ok
+      || stats_end.bytes_in_use != stats_concurrent.bytes_in_use
+      || stats_end.hits + stats_end.misses != stats_concurrent.hits + stats_concurrent.misses + 4000)
+  {
+    std::cout << "# Error: Inconsistent pool state after concurrent use" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Vectors obtain their buffers from the pool:
+  //
+  {
+    viennacl::vector<double> x = viennacl::scalar_vector<double>(1000, 2.0);
+    viennacl::vector<double> y = x + x;
+    if (y[999] != 4.0 || !is_aligned(x.handle().ram_handle()) || !is_aligned(y.handle().ram_handle()))
+    {
+      std::cout << "# Error: Vector buffers not aligned or wrong result" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (cpu_ram::memory_pool_info().bytes_in_use != stats_concurrent.bytes_in_use)
+  {
+    std::cout << "# Error: Vector buffers not returned to pool" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  cpu_ram::memory_pool_release();
+  if (cpu_ram::memory_pool_info().bytes_cached != 0)
+  {
+    std::cout << "# Error: Pool not empty after release" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing memory pool: PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+/* Checks the content of 'h' against 'ref'. */
+bool equal_content(cpu_ram::handle_type const & h, std::vector<char> const & ref)
+{
+  std::vector<char> content(ref.size());
+  cpu_ram::memory_read(h, 0, ref.size(), &content[0], false);
+  return content == ref;
+}
+
+int test_copy()
+{
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(4);
+#endif
+
+  // serial copies, chunked parallel copies, chunked copies with streaming stores:
+  vcl_size_t sizes[] = {100, VIENNACL_CPU_RAM_PARALLEL_COPY_MIN_SIZE + 37, VIENNACL_CPU_RAM_STREAMING_COPY_MIN_SIZE + 4099};
+  vcl_size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+  for (vcl_size_t i=0; i<num_sizes; ++i)
+  {
+    vcl_size_t n = sizes[i];
+
+    std::vector<char> ref(n);
+    for (vcl_size_t j=0; j<n; ++j)
+      ref[j] = char(j * 7 + j / 251);
+
+    cpu_ram::handle_type h = cpu_ram::memory_create(n, &ref[0]);
+    if (!equal_content(h, ref))
+    {
+      std::cout << "# Error: memory_create() of " << n << " bytes failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // read and write at unaligned offsets:
+    std::vector<char> part(n - 5);
+    cpu_ram::memory_read(h, 3, n - 5, &part[0], false);
+    if (std::memcmp(&part[0], &ref[3], n - 5) != 0)
+    {
+      std::cout << "# Error: memory_read() of " << n - 5 << " bytes failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (vcl_size_t j=0; j<part.size(); ++j)
+      part[j] = char(j * 3 + 1);
+    cpu_ram::memory_write(h, 5, n - 9, &part[0], false);
+    std::memcpy(&ref[5], &part[0], n - 9);
+    if (!equal_content(h, ref))
+    {
+      std::cout << "# Error: memory_write() of " << n - 9 << " bytes failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // copy between different buffers:
+    std::vector<char> ref2(n + 64, char(42));
+    cpu_ram::handle_type h2 = cpu_ram::memory_create(n + 64, &ref2[0]);
+    cpu_ram::memory_copy(h, h2, 1, 7, n - 1);
+    std::memcpy(&ref2[7], &ref[1], n - 1);
+    if (!equal_content(h2, ref2))
+    {
+      std::cout << "# Error: memory_copy() of " << n - 1 << " bytes failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // overlapping copies within the same buffer, destination behind and before the source:
+    cpu_ram::memory_copy(h, h, 0, 13, n - 13);
+    std::memmove(&ref[13], &ref[0], n - 13);
+    if (!equal_content(h, ref))
+    {
+      std::cout << "# Error: Overlapping memory_copy() of " << n - 13 << " bytes to a higher offset failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    cpu_ram::memory_copy(h, h, 17, 3, n - 17);
+    std::memmove(&ref[3], &ref[17], n - 17);
+    if (!equal_content(h, ref))
+    {
+      std::cout << "# Error: Overlapping memory_copy() of " << n - 17 << " bytes to a lower offset failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Testing copy routines: PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Main Memory Backend" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = test_pool();
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  retval = test_copy();
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -63,6 +63,7 @@
 #include "viennacl/linalg/norm_inf.hpp"
 #include "viennacl/linalg/norm_frobenius.hpp"
 #include "viennacl/linalg/lanczos.hpp"
+#include "viennacl/linalg/mrrr.hpp"
 #include "viennacl/linalg/qr.hpp"
 #include "viennacl/linalg/qr-method.hpp"
 #include "viennacl/linalg/row_scaling.hpp"
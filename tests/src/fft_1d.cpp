@@ -1015,6 +1015,154 @@ int testcorrectnes_multiply(const std::string& log_tag)
   return EXIT_SUCCESS;
 }
 
+int test_mixed_radix(const std::string& log_tag);
+
+int test_mixed_radix(const std::string& log_tag)
+{
+  std::cout << std::endl;
+  std::cout << "*****************" << log_tag << "***************************\n";
+
+  // sizes with radix-3/5/8 factors, a small generic prime factor, and a large prime factor (Bluestein):
+  unsigned int sizes[] = { 360, 77, 1000, 202 };
+  unsigned int batch_num = 3;
+
+  for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    unsigned int size = sizes[s];
+    std::vector<ScalarType> in(2 * size * batch_num);
+    std::vector<ScalarType> ref(2 * size * batch_num);
+    std::vector<ScalarType> res(2 * size * batch_num);
+    for (std::size_t i = 0; i < in.size(); ++i)
+      in[i] = ScalarType(std::sin(0.37 * double(i)) + 0.25 * std::cos(1.91 * double(i)));
+
+    for (unsigned int b = 0; b < batch_num; ++b)
+      for (unsigned int k = 0; k < size; ++k)
+      {
+        std::complex<double> el;
+        for (unsigned int n = 0; n < size; ++n)
+        {
+          double arg = -2.0 * 3.14159265358979323846 * double((k * n) % size) / double(size);
+          el += std::complex<double>(in[2 * (b * size + n)], in[2 * (b * size + n) + 1]) * std::complex<double>(std::cos(arg), std::sin(arg));
+        }
+        ref[2 * (b * size + k)]     = ScalarType(el.real());
+        ref[2 * (b * size + k) + 1] = ScalarType(el.imag());
+      }
+
+    viennacl::vector<ScalarType> input(in.size());
+    viennacl::vector<ScalarType> output(in.size());
+    viennacl::fast_copy(in, input);
+
+    viennacl::fft(input, output, batch_num);
+
+    viennacl::backend::finish();
+    viennacl::fast_copy(output, res);
+
+    ScalarType df = diff_max(res, ref);
+    printf("%7s ROWS=%6d COLS=%6d; BATCH=%3d; DIFF=%3.15f;\n", ((fabs(df) < EPS) ? "[Ok]" : "[Fail]"),
+        1, size, batch_num, df);
+    if (!(df < EPS))
+      return EXIT_FAILURE;
+  }
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+int test_real_fft(const std::string& log_tag);
+
+int test_real_fft(const std::string& log_tag)
+{
+  std::cout << std::endl;
+  std::cout << "*****************" << log_tag << "***************************\n";
+
+  // even, odd, and Bluestein sizes:
+  unsigned int sizes[] = { 64, 90, 77, 202 };
+  unsigned int batch_num = 2;
+
+  for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    unsigned int size = sizes[s];
+    unsigned int spectrum_size = size / 2 + 1;
+    std::vector<ScalarType> in(size * batch_num);
+    std::vector<ScalarType> ref(2 * spectrum_size * batch_num);
+    std::vector<ScalarType> res(2 * spectrum_size * batch_num);
+    std::vector<ScalarType> back(size * batch_num);
+    for (std::size_t i = 0; i < in.size(); ++i)
+      in[i] = ScalarType(std::sin(0.37 * double(i)) + 0.25 * std::cos(1.91 * double(i)));
+
+    for (unsigned int b = 0; b < batch_num; ++b)
+      for (unsigned int k = 0; k < spectrum_size; ++k)
+      {
+        std::complex<double> el;
+        for (unsigned int n = 0; n < size; ++n)
+        {
+          double arg = -2.0 * 3.14159265358979323846 * double((k * n) % size) / double(size);
+          el += double(in[b * size + n]) * std::complex<double>(std::cos(arg), std::sin(arg));
+        }
+        ref[2 * (b * spectrum_size + k)]     = ScalarType(el.real());
+        ref[2 * (b * spectrum_size + k) + 1] = ScalarType(el.imag());
+      }
+
+    viennacl::vector<ScalarType> input(in.size());
+    viennacl::vector<ScalarType> spectrum(res.size());
+    viennacl::vector<ScalarType> output(in.size());
+    viennacl::fast_copy(in, input);
+
+    viennacl::rfft(input, spectrum, batch_num);
+    viennacl::irfft(spectrum, output, batch_num);
+
+    viennacl::backend::finish();
+    viennacl::fast_copy(spectrum, res);
+    viennacl::fast_copy(output, back);
+
+    ScalarType df = std::max(diff_max(res, ref), diff_max(back, in));
+    printf("%7s ROWS=%6d COLS=%6d; BATCH=%3d; DIFF=%3.15f;\n", ((fabs(df) < EPS) ? "[Ok]" : "[Fail]"),
+        1, size, batch_num, df);
+    if (!(df < EPS))
+      return EXIT_FAILURE;
+  }
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+int test_plan_cache(const std::string& log_tag);
+
+int test_plan_cache(const std::string& log_tag)
+{
+  std::cout << std::endl;
+  std::cout << "*****************" << log_tag << "***************************\n";
+
+  namespace hb = viennacl::linalg::host_based;
+
+  unsigned int size = 360;
+  std::vector<ScalarType> in(2 * size);
+  std::vector<ScalarType> ref(2 * size);
+  std::vector<ScalarType> res(2 * size);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = ScalarType(std::sin(0.37 * double(i)) + 0.25 * std::cos(1.91 * double(i)));
+
+  hb::fft_plan_handle<hb::fft_plan<ScalarType> > plan = hb::get_fft_plan<ScalarType>(size, ScalarType(-1));
+  plan->execute(&(in[0]), &(ref[0]), 1, 1, size);
+
+  // the plan in use must survive clearing and eviction, while the cache stays bounded:
+  hb::fft_plan_cache_clear<ScalarType>();
+  for (unsigned int n = 1; n <= VIENNACL_FFT_PLAN_CACHE_SIZE + 10; ++n)
+    hb::get_fft_plan<ScalarType>(n, ScalarType(1));
+
+  bool bounded = hb::fft_plan_cache_size<ScalarType>() <= VIENNACL_FFT_PLAN_CACHE_SIZE;
+  plan->execute(&(in[0]), &(res[0]), 1, 1, size);
+
+  ScalarType df = diff_max(res, ref);
+  printf("%7s CACHED=%6d; DIFF=%3.15f;\n", ((bounded && fabs(df) < EPS) ? "[Ok]" : "[Fail]"),
+      int(hb::fft_plan_cache_size<ScalarType>()), df);
+  if (!bounded || !(df < EPS))
+    return EXIT_FAILURE;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
 int main()
 {
   std::cout << "*" << std::endl;
@@ -1031,6 +1179,9 @@ int main()
   if (test_correctness("fft::radix2", read_vectors_pair, &radix2) == EXIT_FAILURE)
     return EXIT_FAILURE;
 
+  if (test_mixed_radix("fft::mixed_radix") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
   if (test_correctness("fft::fft_ifft_radix2", read_vectors_pair, &fft_ifft_radix2) == EXIT_FAILURE)
     return EXIT_FAILURE;
 
@@ -1061,6 +1212,12 @@ int main()
   if (test_correctness("fft:complex_to_real", read_vectors_pair, &complex_to_real) == EXIT_FAILURE)
     return EXIT_FAILURE;
 
+  if (test_real_fft("fft::real_fft") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan_cache("fft::plan_cache") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
   if (test_correctness("fft::fft_reverse_direct", read_vectors_pair,
       &fft_reverse_direct) == EXIT_FAILURE)
     return EXIT_FAILURE;
@@ -308,6 +308,73 @@ int test_correctness(const std::string& log_tag, input_function_ptr input_functi
   return EXIT_SUCCESS;
 }
 
+int test_real_fft_2d(const std::string& log_tag);
+
+int test_real_fft_2d(const std::string& log_tag)
+{
+  std::cout << std::endl;
+  std::cout << "*****************" << log_tag << "***************************\n";
+
+  unsigned int rows[] = { 8, 6, 5 };
+  unsigned int cols[] = { 16, 10, 7 };
+
+  for (std::size_t t = 0; t < sizeof(rows) / sizeof(rows[0]); ++t)
+  {
+    unsigned int row = rows[t];
+    unsigned int col = cols[t];
+    unsigned int spectrum_size = col / 2 + 1;
+
+    // reference: complex 2D transformation of the real data
+    std::vector<std::vector<ScalarType> > real_data(row, std::vector<ScalarType>(col));
+    std::vector<std::vector<ScalarType> > complex_data(row, std::vector<ScalarType>(2 * col));
+    for (unsigned int i = 0; i < row; i++)
+      for (unsigned int j = 0; j < col; j++)
+      {
+        real_data[i][j] = ScalarType(std::sin(0.37 * double(i * col + j)) + 0.25 * std::cos(1.91 * double(i + j)));
+        complex_data[i][2 * j]     = real_data[i][j];
+        complex_data[i][2 * j + 1] = 0;
+      }
+
+    viennacl::matrix<ScalarType> complex_input(row, 2 * col);
+    viennacl::matrix<ScalarType> complex_output(row, 2 * col);
+    viennacl::copy(complex_data, complex_input);
+    viennacl::fft(complex_input, complex_output);
+    viennacl::copy(complex_output, complex_data);
+
+    viennacl::matrix<ScalarType> input(row, col);
+    viennacl::matrix<ScalarType> spectrum(row, 2 * spectrum_size);
+    viennacl::matrix<ScalarType> output(row, col);
+    viennacl::copy(real_data, input);
+
+    viennacl::rfft(input, spectrum);
+    viennacl::irfft(spectrum, output);
+    viennacl::backend::finish();
+
+    std::vector<std::vector<ScalarType> > spectrum_data(row, std::vector<ScalarType>(2 * spectrum_size));
+    std::vector<std::vector<ScalarType> > output_data(row, std::vector<ScalarType>(col));
+    viennacl::copy(spectrum, spectrum_data);
+    viennacl::copy(output, output_data);
+
+    std::vector<ScalarType> res, ref, back, orig;
+    for (unsigned int i = 0; i < row; i++)
+    {
+      res.insert(res.end(), spectrum_data[i].begin(), spectrum_data[i].end());
+      ref.insert(ref.end(), complex_data[i].begin(), complex_data[i].begin() + 2 * spectrum_size);
+      back.insert(back.end(), output_data[i].begin(), output_data[i].end());
+      orig.insert(orig.end(), real_data[i].begin(), real_data[i].end());
+    }
+
+    ScalarType df = std::max(diff_max(res, ref), diff_max(back, orig));
+    printf("%7s ROWS=%6d COLS=%6d; BATCH=%3d; DIFF=%3.15f;\n", ((fabs(df) < EPS) ? "[Ok]" : "[Fail]"),
+        row, col, 1, df);
+    if (!(df < EPS))
+      return EXIT_FAILURE;
+  }
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
 int main()
 {
   std::cout << "*" << std::endl;
@@ -326,6 +393,8 @@ int main()
     return EXIT_FAILURE;
   if (test_correctness("fft::transpose", read_matrices_pair, &transpose) == EXIT_FAILURE)
       return EXIT_FAILURE;
+  if (test_real_fft_2d("fft:2d::real_fft") == EXIT_FAILURE)
+    return EXIT_FAILURE;
 
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
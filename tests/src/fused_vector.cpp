@@ -0,0 +1,494 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/fused_vector.cpp  Tests the single-pass evaluation of vector expressions in host memory.
+*   \test  Tests multi-term expressions, element-wise functions, ranges and slices, aliasing with the result, integer vectors, and the assignments with a fused norm or inner product for the fused vector evaluator.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/scalar.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/vector_operations.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+/* Evaluates the expression in the same way as the assignment operators of vector_base, but reports whether the fused evaluator was used. */
+template<typename OpT, typename VectorT, typename ExpressionT>
+bool assign(VectorT & x, ExpressionT const & proxy)
+{
+  typedef typename viennacl::result_of::cpu_value_type<VectorT>::type NumericT;
+  viennacl::vector_base<NumericT> & x_base = x;
+
+  if (viennacl::linalg::host_based::fused_vector_assign<OpT>(x_base, proxy))
+    return true;
+
+  viennacl::linalg::detail::op_executor<viennacl::vector_base<NumericT>, OpT, ExpressionT>::apply(x_base, proxy);
+  return false;
+}
+
+template<typename NumericT, typename VectorT>
+int check(std::vector<double> const & reference, VectorT const & x, bool fused, bool expect_fused, double epsilon, std::string const & name)
+{
+  if (fused != expect_fused)
+  {
+    std::cout << "# Error for " << name << ": fused evaluator " << (fused ? "used" : "not used") << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<NumericT> host_x(x.size());
+  viennacl::copy(x, host_x);
+
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    double error = std::fabs(double(host_x[i]) - reference[i]) / std::max(1.0, std::fabs(reference[i]));
+    if (error > epsilon)
+    {
+      std::cout << "# Error for " << name << " at entry " << i << ": " << host_x[i] << " vs. " << reference[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+std::vector<double> host_values(std::vector<NumericT> const & v)
+{
+  return std::vector<double>(v.begin(), v.end());
+}
+
+template<typename NumericT>
+int test_float(std::size_t n, double epsilon)
+{
+  typedef viennacl::vector<NumericT> VectorType;
+
+  std::vector<NumericT> std_x(n), std_y(n), std_z(n), std_w(n), std_v(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    std_x[i] = NumericT(std::sin(double(i)));
+    std_y[i] = NumericT(std::cos(double(i)) + 0.25);
+    std_z[i] = NumericT(0.5 * std::sin(double(3 * i)));
+    std_w[i] = NumericT(double(i % 13) / 7.0 - 0.5);
+    std_v[i] = NumericT(1.0 + double(i % 5));
+  }
+  std::vector<double> y = host_values(std_y), z = host_values(std_z), w = host_values(std_w), v = host_values(std_v);
+
+  VectorType vcl_x(n), vcl_y(n), vcl_z(n), vcl_w(n), vcl_v(n);
+  viennacl::copy(std_x, vcl_x);
+  viennacl::copy(std_y, vcl_y);
+  viennacl::copy(std_z, vcl_z);
+  viennacl::copy(std_w, vcl_w);
+  viennacl::copy(std_v, vcl_v);
+
+  NumericT a = NumericT(2.5);
+  NumericT c = NumericT(-1.25);
+  viennacl::scalar<NumericT> b = NumericT(0.75);
+  double da = double(a), db = 0.75, dc = double(c);
+
+  std::vector<double> ref(n);
+  bool fused;
+
+  //
+  // Multi-term expressions:
+  //
+  fused = assign<viennacl::op_assign>(vcl_x, a * vcl_y + b * vcl_z - c * vcl_w + vcl_v);
+  for (std::size_t i=0; i<n; ++i) ref[i] = da * y[i] + db * z[i] - dc * w[i] + v[i];
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x = a*y + b*z - c*w + v") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  fused = assign<viennacl::op_inplace_add>(vcl_x, (vcl_y + vcl_z) * a);
+  for (std::size_t i=0; i<n; ++i) ref[i] += (y[i] + z[i]) * da;
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x += (y + z) * a") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  fused = assign<viennacl::op_inplace_sub>(vcl_x, vcl_y / a - vcl_z + vcl_w * b);
+  for (std::size_t i=0; i<n; ++i) ref[i] -= y[i] / da - z[i] + w[i] * db;
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x -= y/a - z + w*b") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // a single kernel without temporaries is left to the existing kernels:
+  fused = assign<viennacl::op_assign>(vcl_x, a * vcl_y + b * vcl_z);
+  for (std::size_t i=0; i<n; ++i) ref[i] = da * y[i] + db * z[i];
+  if (check<NumericT>(ref, vcl_x, fused, false, epsilon, "x = a*y + b*z") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Element-wise functions:
+  //
+  fused = assign<viennacl::op_assign>(vcl_x, viennacl::linalg::element_exp(vcl_y - vcl_z) / a);
+  for (std::size_t i=0; i<n; ++i) ref[i] = std::exp(y[i] - z[i]) / da;
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x = exp(y - z) / a") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  fused = assign<viennacl::op_assign>(vcl_x, viennacl::linalg::element_prod(vcl_y, vcl_z) + viennacl::linalg::element_div(vcl_w, vcl_v));
+  for (std::size_t i=0; i<n; ++i) ref[i] = y[i] * z[i] + w[i] / v[i];
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x = y .* z + w ./ v") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  fused = assign<viennacl::op_inplace_add>(vcl_x, viennacl::linalg::element_sqrt(viennacl::linalg::element_fabs(vcl_y - vcl_w)) * a);
+  for (std::size_t i=0; i<n; ++i) ref[i] += std::sqrt(std::fabs(y[i] - w[i])) * da;
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x += sqrt(|y - w|) * a") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // The result as operand at the same positions:
+  //
+  fused = assign<viennacl::op_assign>(vcl_x, vcl_x * a + vcl_y - vcl_z);
+  for (std::size_t i=0; i<n; ++i) ref[i] = ref[i] * da + y[i] - z[i];
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x = x*a + y - z") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  fused = assign<viennacl::op_inplace_sub>(vcl_x, viennacl::linalg::element_prod(vcl_x, vcl_y) + vcl_x / a);
+  for (std::size_t i=0; i<n; ++i) ref[i] -= ref[i] * y[i] + ref[i] / da;
+  if (check<NumericT>(ref, vcl_x, fused, true, epsilon, "x -= x .* y + x/a") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Ranges and slices:
+  //
+  VectorType vcl_large_1(3 * n + 10), vcl_large_2(3 * n + 10);
+  std::vector<NumericT> std_large(3 * n + 10);
+  for (std::size_t i=0; i<std_large.size(); ++i)
+    std_large[i] = NumericT(std::cos(double(7 * i)));
+  std::vector<double> large = host_values(std_large);
+  viennacl::copy(std_large, vcl_large_1);
+  viennacl::copy(std_large, vcl_large_2);
+
+  viennacl::vector_range<VectorType> x_range(vcl_large_1, viennacl::range(3, 3 + n));
+  viennacl::vector_slice<VectorType> y_slice(vcl_large_2, viennacl::slice(1, 2, n));
+  viennacl::vector_slice<VectorType> z_slice(vcl_large_2, viennacl::slice(2, 3, n));
+
+  fused = assign<viennacl::op_assign>(x_range, y_slice * a + z_slice - vcl_w);
+  for (std::size_t i=0; i<n; ++i) ref[i] = large[1 + 2 * i] * da + large[2 + 3 * i] - w[i];
+  if (check<NumericT>(ref, x_range, fused, true, epsilon, "range = slice*a + slice - w") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::vector_slice<VectorType> x_slice(vcl_large_1, viennacl::slice(3 + n, 2, n));
+  fused = assign<viennacl::op_inplace_add>(x_slice, viennacl::linalg::element_exp(y_slice) - vcl_y * b + z_slice);
+  for (std::size_t i=0; i<n; ++i) ref[i] = large[3 + n + 2 * i] + std::exp(large[1 + 2 * i]) - y[i] * db + large[2 + 3 * i];
+  if (check<NumericT>(ref, x_slice, fused, true, epsilon, "slice += exp(slice) - y*b + slice") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Operands overlapping with the result at other positions use the individual kernels:
+  //
+  viennacl::copy(std_large, vcl_large_1);
+  viennacl::vector_range<VectorType> range_0(vcl_large_1, viennacl::range(0, n));
+  viennacl::vector_range<VectorType> range_1(vcl_large_1, viennacl::range(1, 1 + n));
+
+  fused = assign<viennacl::op_assign>(range_0, range_1 + vcl_y + vcl_z);
+  for (std::size_t i=0; i<n; ++i) ref[i] = large[1 + i] + y[i] + z[i];
+  if (check<NumericT>(ref, range_0, fused, false, epsilon, "range = shifted range + y + z") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::copy(std_large, vcl_large_1);
+  fused = assign<viennacl::op_assign>(range_1, range_0 * a + vcl_y - vcl_z);
+  for (std::size_t i=0; i<n; ++i) ref[i] = large[i] * da + y[i] - z[i];
+  if (check<NumericT>(ref, range_1, fused, false, epsilon, "shifted range = range*a + y - z") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::copy(std_large, vcl_large_1);
+  viennacl::vector_slice<VectorType> slice_even(vcl_large_1, viennacl::slice(0, 2, n));
+  viennacl::vector_slice<VectorType> slice_odd(vcl_large_1, viennacl::slice(1, 2, n));
+  fused = assign<viennacl::op_inplace_add>(slice_even, viennacl::linalg::element_prod(slice_odd, vcl_y) + vcl_z);
+  for (std::size_t i=0; i<n; ++i) ref[i] = large[2 * i] + large[1 + 2 * i] * y[i] + z[i];
+  if (check<NumericT>(ref, slice_even, fused, false, epsilon, "even slice += odd slice .* y + z") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Through the assignment operators:
+  //
+  vcl_x = a * vcl_y + b * vcl_z - c * vcl_w + vcl_v;
+  vcl_x += viennacl::linalg::element_exp(vcl_z) * a;
+  for (std::size_t i=0; i<n; ++i) ref[i] = da * y[i] + db * z[i] - dc * w[i] + v[i] + std::exp(z[i]) * da;
+  if (check<NumericT>(ref, vcl_x, true, true, epsilon, "operators") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing fused vector expressions for size " << n << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int check_scalar(double reference, double value, double epsilon, std::string const & name)
+{
+  if (std::fabs(value - reference) / std::max(1.0, std::fabs(reference)) > epsilon)
+  {
+    std::cout << "# Error for " << name << ": " << value << " vs. " << reference << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_reductions(std::size_t n, double epsilon)
+{
+  typedef viennacl::vector<NumericT> VectorType;
+
+  std::vector<NumericT> std_y(n), std_z(n), std_w(n), std_large(4 * n + 10);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    std_y[i] = NumericT(std::sin(double(i)));
+    std_z[i] = NumericT(std::cos(double(i)) + 0.25);
+    std_w[i] = NumericT(double(i % 13) / 7.0 - 0.5);
+  }
+  for (std::size_t i=0; i<std_large.size(); ++i)
+    std_large[i] = NumericT(std::cos(double(7 * i)));
+  std::vector<double> y = host_values(std_y), z = host_values(std_z), w = host_values(std_w), large = host_values(std_large);
+
+  VectorType vcl_x(n), vcl_y(n), vcl_z(n), vcl_w(n), vcl_large(4 * n + 10);
+  viennacl::copy(std_y, vcl_y);
+  viennacl::copy(std_z, vcl_z);
+  viennacl::copy(std_w, vcl_w);
+  viennacl::copy(std_large, vcl_large);
+
+  NumericT a = NumericT(2.5);
+  double da = double(a);
+
+  std::vector<double> ref(n);
+  NumericT result = 0;
+  bool fused;
+
+  //
+  // x = proxy together with the norm of x:
+  //
+  fused = viennacl::linalg::host_based::fused_assign_norm_2(vcl_x, a * vcl_y + vcl_z - vcl_w, result);
+  double ref_result = 0;
+  for (std::size_t i=0; i<n; ++i) { ref[i] = da * y[i] + z[i] - w[i]; ref_result += ref[i] * ref[i]; }
+  if (   check<NumericT>(ref, vcl_x, fused, true, epsilon, "x = a*y + z - w with norm") != EXIT_SUCCESS
+      || check_scalar(ref_result, double(result), epsilon, "squared norm of a*y + z - w") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // the residual update of the solvers:
+  viennacl::linalg::assign_norm_2_cpu(vcl_x, vcl_x - a * vcl_y, result);
+  ref_result = 0;
+  for (std::size_t i=0; i<n; ++i) { ref[i] -= da * y[i]; ref_result += ref[i] * ref[i]; }
+  if (   check<NumericT>(ref, vcl_x, true, true, epsilon, "x = x - a*y with norm") != EXIT_SUCCESS
+      || check_scalar(std::sqrt(ref_result), double(result), epsilon, "norm of x - a*y") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // x = proxy together with <x, w>:
+  //
+  fused = viennacl::linalg::host_based::fused_assign_inner_prod(vcl_x, viennacl::linalg::element_exp(vcl_z) - vcl_y * a, vcl_w, result);
+  ref_result = 0;
+  for (std::size_t i=0; i<n; ++i) { ref[i] = std::exp(z[i]) - y[i] * da; ref_result += ref[i] * w[i]; }
+  if (   check<NumericT>(ref, vcl_x, fused, true, epsilon, "x = exp(z) - y*a with inner product") != EXIT_SUCCESS
+      || check_scalar(ref_result, double(result), epsilon, "<exp(z) - y*a, w>") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // slice as the second vector of the inner product, range as result:
+  viennacl::vector_range<VectorType> x_range(vcl_large, viennacl::range(3 * n, 4 * n));
+  viennacl::vector_slice<VectorType> w_slice(vcl_large, viennacl::slice(1, 3, n));
+  VectorType vcl_large_copy(vcl_large);
+  viennacl::vector_range<VectorType> x_range_copy(vcl_large_copy, viennacl::range(2 * n + 10, 3 * n + 10));
+  fused = viennacl::linalg::host_based::fused_assign_inner_prod(x_range_copy, vcl_y + vcl_z * a, w_slice, result);
+  ref_result = 0;
+  for (std::size_t i=0; i<n; ++i) { ref[i] = y[i] + z[i] * da; ref_result += ref[i] * large[1 + 3 * i]; }
+  if (   check<NumericT>(ref, x_range_copy, fused, true, epsilon, "range = y + z*a with inner product with slice") != EXIT_SUCCESS
+      || check_scalar(ref_result, double(result), epsilon, "<y + z*a, slice>") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // The second vector overlapping with the result uses the individual kernels:
+  //
+  viennacl::vector_range<VectorType> w_overlap(vcl_large, viennacl::range(3 * n - 1, 4 * n - 1));
+  fused = viennacl::linalg::host_based::fused_assign_inner_prod(x_range, vcl_y - vcl_z, w_overlap, result);
+  if (fused)
+  {
+    std::cout << "# Error: inner product with a vector overlapping with the result must not be fused" << std::endl;
+    return EXIT_FAILURE;
+  }
+  viennacl::linalg::assign_inner_prod_cpu(x_range, vcl_y - vcl_z, w_overlap, result);
+  ref_result = large[3 * n - 1] * (y[0] - z[0]);
+  for (std::size_t i=0; i<n; ++i) ref[i] = y[i] - z[i];
+  for (std::size_t i=1; i<n; ++i) ref_result += ref[i-1] * ref[i];
+  if (   check<NumericT>(ref, x_range, false, false, epsilon, "range = y - z with inner product with shifted range") != EXIT_SUCCESS
+      || check_scalar(ref_result, double(result), epsilon, "<y - z, shifted range>") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing fused norm and inner product for size " << n << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+/* CG and BiCGStab without preconditioner use the generic implementations for dense matrices, which update the residual and its norm in one pass. */
+template<typename NumericT>
+int test_solvers(std::size_t n, double tolerance)
+{
+  viennacl::matrix<NumericT> A(n, n);
+  viennacl::matrix<NumericT> A_nonsym(n, n);
+  std::vector<std::vector<NumericT> > std_A(n, std::vector<NumericT>(n)), std_A_nonsym(n, std::vector<NumericT>(n));
+  for (std::size_t i=0; i<n; ++i)
+  {
+    std_A[i][i] = std_A_nonsym[i][i] = NumericT(4);
+    if (i > 0)   { std_A[i][i-1] = NumericT(-1); std_A_nonsym[i][i-1] = NumericT(-1.5); }
+    if (i < n-1) { std_A[i][i+1] = NumericT(-1); std_A_nonsym[i][i+1] = NumericT(-1); }
+  }
+  viennacl::copy(std_A, A);
+  viennacl::copy(std_A_nonsym, A_nonsym);
+
+  std::vector<NumericT> std_b(n);
+  for (std::size_t i=0; i<n; ++i)
+    std_b[i] = NumericT(1) + NumericT(std::sin(double(i)));
+  viennacl::vector<NumericT> b(n);
+  viennacl::copy(std_b, b);
+
+  viennacl::linalg::cg_tag cg_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, b, cg_tag);
+  viennacl::vector<NumericT> r = viennacl::linalg::prod(A, x);
+  r = b - r;
+  double residual = double(viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b));
+  if (residual > 10 * tolerance || std::fabs(residual - cg_tag.error()) > tolerance)
+  {
+    std::cout << "# Error for CG: relative residual " << residual << ", reported " << cg_tag.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::bicgstab_tag bicgstab_tag(tolerance, 1000);
+  x = viennacl::linalg::solve(A_nonsym, b, bicgstab_tag);
+  r = viennacl::linalg::prod(A_nonsym, x);
+  r = b - r;
+  residual = double(viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b));
+  if (residual > 10 * tolerance || std::fabs(residual - bicgstab_tag.error()) > tolerance)
+  {
+    std::cout << "# Error for BiCGStab: relative residual " << residual << ", reported " << bicgstab_tag.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing CG and BiCGStab for dense matrices: PASSED (CG: " << cg_tag.iters() << " iterations, BiCGStab: " << bicgstab_tag.iters() << " iterations)" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int test_int(std::size_t n)
+{
+  typedef viennacl::vector<int> VectorType;
+
+  std::vector<int> std_y(n), std_z(n), std_w(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    std_y[i] = int(i % 17) - 8;
+    std_z[i] = int(i % 5) + 1;
+    std_w[i] = int(i % 3);
+  }
+
+  VectorType vcl_x(n), vcl_y(n), vcl_z(n), vcl_w(n);
+  viennacl::copy(std_y, vcl_y);
+  viennacl::copy(std_z, vcl_z);
+  viennacl::copy(std_w, vcl_w);
+
+  std::vector<double> ref(n);
+  bool fused;
+
+  fused = assign<viennacl::op_assign>(vcl_x, 3 * vcl_y + 2 * vcl_z - vcl_w + vcl_y);
+  for (std::size_t i=0; i<n; ++i) ref[i] = 3 * std_y[i] + 2 * std_z[i] - std_w[i] + std_y[i];
+  if (check<int>(ref, vcl_x, fused, false, 0.0, "int: x = 3*y + 2*z - w + y") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  fused = assign<viennacl::op_inplace_add>(vcl_x, viennacl::linalg::element_prod(vcl_y, vcl_z) - vcl_w * 4);
+  for (std::size_t i=0; i<n; ++i) ref[i] += std_y[i] * std_z[i] - std_w[i] * 4;
+  if (check<int>(ref, vcl_x, fused, false, 0.0, "int: x += y .* z - w*4") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  vcl_x -= vcl_y + vcl_z - vcl_w;
+  for (std::size_t i=0; i<n; ++i) ref[i] -= std_y[i] + std_z[i] - std_w[i];
+  if (check<int>(ref, vcl_x, false, false, 0.0, "int: x -= y + z - w") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing integer vector expressions for size " << n << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Fused Vector Expressions" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  // sizes below and above the threshold for OpenMP:
+  std::size_t sizes[] = {37, 12345};
+
+  for (std::size_t k=0; k<sizeof(sizes) / sizeof(sizes[0]); ++k)
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    if (test_float<float>(sizes[k], 1e-5) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    std::cout << "# Test passed" << std::endl;
+
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test_float<double>(sizes[k], 1e-13) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    std::cout << "# Test passed" << std::endl;
+
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: float, fused norm and inner product" << std::endl;
+    if (test_reductions<float>(sizes[k], 1e-4) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    std::cout << "# Test passed" << std::endl;
+
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double, fused norm and inner product" << std::endl;
+    if (test_reductions<double>(sizes[k], 1e-12) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    std::cout << "# Test passed" << std::endl;
+
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: int" << std::endl;
+    if (test_int(sizes[k]) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    std::cout << "# Test passed" << std::endl;
+  }
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double, solvers" << std::endl;
+  if (test_solvers<double>(300, 1e-10) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "# Test passed" << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
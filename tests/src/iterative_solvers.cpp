@@ -0,0 +1,323 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/iterative_solvers.cpp  Tests the iterative solvers.
+*   \test  Tests the matrix powers kernel against matrix-vector products, the s-step variants of CG and GMRES for convergence of the true residual, and block CG and block GMRES for several right hand sides.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_frobenius.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/gmres.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::map<unsigned int, double> > std_sparse_matrix;
+
+/* 5-point finite difference Laplacian on an n x n grid. If 'convection' is nonzero, a first-order upwind convection term makes the matrix nonsymmetric. */
+std_sparse_matrix poisson_2d(unsigned int n, double convection)
+{
+  std_sparse_matrix A(n * n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+    {
+      unsigned int row = i * n + j;
+      A[row][row] = 4.0 + convection;
+      if (i > 0)   A[row][row - n] = -1.0;
+      if (i < n-1) A[row][row + n] = -1.0;
+      if (j > 0)   A[row][row - 1] = -1.0 - convection;
+      if (j < n-1) A[row][row + 1] = -1.0;
+    }
+  return A;
+}
+
+template<typename NumericT>
+double relative_residual(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & b)
+{
+  viennacl::vector<NumericT> r = viennacl::linalg::prod(A, x);
+  r = b - r;
+  return double(viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b));
+}
+
+template<typename NumericT>
+int check_solution(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & b,
+                   double tolerance, double reported_error, bool reports_true_residual, std::string const & name)
+{
+  double residual = relative_residual(A, x, b);
+  if (residual > tolerance || reported_error > tolerance)
+  {
+    std::cout << "# Error for " << name << ": relative residual " << residual << ", reported " << reported_error << ", tolerance " << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (reports_true_residual && std::fabs(residual - reported_error) > 0.01 * tolerance)
+  {
+    std::cout << "# Error for " << name << ": reported error " << reported_error << " differs from true residual " << residual << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Compares the matrix powers kernel of the s-step solvers with repeated matrix-vector products. The dense first row is split among threads. */
+int test_matrix_powers(double tolerance)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(4);
+#endif
+
+  unsigned int n = 4000;
+  std_sparse_matrix std_A(n);
+  for (unsigned int j=0; j<n; ++j)
+    std_A[0][j] = 1.0 / double(j + 1);
+  for (unsigned int i=1; i<n; ++i)
+  {
+    std_A[i][i-1] = -1.0;
+    std_A[i][i]   = 2.0 + std::sin(double(i));
+    if (i+1 < n)
+      std_A[i][i+1] = -1.0;
+  }
+  viennacl::compressed_matrix<double> A;
+  viennacl::copy(std_A, A);
+
+  std::size_t count = 4;
+  std::size_t internal_size = n + 3;
+  double scaling = 0.25;
+
+  viennacl::vector<double> basis = viennacl::zero_vector<double>(internal_size * (count + 1));
+  viennacl::vector<double> v(n);
+  for (std::size_t i=0; i<n; ++i)
+    v[i] = basis[i] = std::cos(double(i));
+
+  viennacl::linalg::s_step_matrix_powers(A, basis, n, internal_size, 0, count, scaling);
+
+  for (std::size_t j=1; j<=count; ++j)
+  {
+    v = scaling * viennacl::vector<double>(viennacl::linalg::prod(A, v));
+    viennacl::vector_range<viennacl::vector<double> > v_basis(basis, viennacl::range(j * internal_size, j * internal_size + n));
+    viennacl::vector<double> difference = v_basis - v;
+    double error = viennacl::linalg::norm_2(difference) / viennacl::linalg::norm_2(v);
+    if (error > tolerance)
+    {
+      std::cout << "# Error: Matrix powers kernel differs from matrix-vector products for power " << j << ", relative difference " << error << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Testing matrix powers kernel: PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_s_step(double tolerance)
+{
+  unsigned int n = 60;
+
+  viennacl::compressed_matrix<NumericT> A_spd, A_nonsym;
+  viennacl::copy(poisson_2d(n, 0.0), A_spd);
+  viennacl::copy(poisson_2d(n, 0.5), A_nonsym);
+
+  std::vector<NumericT> std_b(n * n);
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = NumericT(1) + NumericT(std::sin(double(i)));
+  viennacl::vector<NumericT> b(n * n);
+  viennacl::copy(std_b, b);
+
+  unsigned int s_steps[] = {1, 2, 4, 8};
+  for (std::size_t k=0; k<sizeof(s_steps) / sizeof(s_steps[0]); ++k)
+  {
+    viennacl::linalg::cg_tag cg_tag(tolerance, 3000);
+    cg_tag.s_steps(s_steps[k]);
+    viennacl::vector<NumericT> x = viennacl::linalg::solve(A_spd, b, cg_tag);
+    if (check_solution(A_spd, x, b, tolerance, cg_tag.error(), s_steps[k] > 1, "CG") != EXIT_SUCCESS)
+    {
+      std::cout << "  s = " << s_steps[k] << ", iterations: " << cg_tag.iters() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    viennacl::linalg::gmres_tag gmres_tag(tolerance, 3000, 40);
+    gmres_tag.s_steps(s_steps[k]);
+    x = viennacl::linalg::solve(A_nonsym, b, gmres_tag);
+    if (check_solution(A_nonsym, x, b, tolerance, gmres_tag.error(), s_steps[k] > 1, "GMRES") != EXIT_SUCCESS)
+    {
+      std::cout << "  s = " << s_steps[k] << ", iterations: " << gmres_tag.iters() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Testing s-step solvers with s = " << s_steps[k] << ": PASSED (CG: " << cg_tag.iters() << " iterations, GMRES: " << gmres_tag.iters() << " iterations)" << std::endl;
+  }
+
+  // zero right hand side:
+  viennacl::vector<NumericT> zero = viennacl::zero_vector<NumericT>(n * n);
+  viennacl::linalg::cg_tag cg_tag(tolerance, 100);
+  cg_tag.s_steps(4);
+  viennacl::linalg::gmres_tag gmres_tag(tolerance, 100, 20);
+  gmres_tag.s_steps(4);
+  if (   viennacl::linalg::norm_2(viennacl::linalg::solve(A_spd, zero, cg_tag)) > 0
+      || viennacl::linalg::norm_2(viennacl::linalg::solve(A_nonsym, zero, gmres_tag)) > 0)
+  {
+    std::cout << "# Error: s-step solvers return nonzero result for zero right hand side" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* Largest relative residual of the columns of X for A X = B. Columns of B equal to zero require zero columns of X. */
+double block_relative_residual(std_sparse_matrix const & A, std::vector<std::vector<double> > const & X, std::vector<std::vector<double> > const & B)
+{
+  double max_residual = 0;
+  for (std::size_t j=0; j<B[0].size(); ++j)
+  {
+    double norm_r = 0;
+    double norm_b = 0;
+    for (std::size_t i=0; i<A.size(); ++i)
+    {
+      double r_i = B[i][j];
+      for (std::map<unsigned int, double>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+        r_i -= it->second * X[it->first][j];
+      norm_r += r_i * r_i;
+      norm_b += B[i][j] * B[i][j];
+    }
+    max_residual = std::max(max_residual, (norm_b > 0) ? std::sqrt(norm_r / norm_b) : std::sqrt(norm_r));
+  }
+  return max_residual;
+}
+
+template<typename LayoutT>
+int test_block(double tolerance, std::string const & layout_name)
+{
+  unsigned int n = 30;
+  std_sparse_matrix std_A_spd = poisson_2d(n, 0.0);
+  std_sparse_matrix std_A_nonsym = poisson_2d(n, 0.5);
+
+  viennacl::compressed_matrix<double> A_spd, A_nonsym;
+  viennacl::copy(std_A_spd, A_spd);
+  viennacl::copy(std_A_nonsym, A_nonsym);
+
+  // right hand sides: two independent columns, a multiple of the first column, a zero column, and a linear combination:
+  std::vector<std::vector<double> > std_B(n * n, std::vector<double>(5));
+  for (std::size_t i=0; i<std_B.size(); ++i)
+  {
+    std_B[i][0] = 1.0 + std::sin(double(i));
+    std_B[i][1] = 2.0 * std_B[i][0];
+    std_B[i][2] = 0;
+    std_B[i][3] = std::cos(double(3 * i)) - 0.5;
+    std_B[i][4] = std_B[i][0] - 3.0 * std_B[i][3];
+  }
+  viennacl::matrix<double, LayoutT> B(n * n, 5);
+  viennacl::copy(std_B, B);
+
+  std::vector<std::vector<double> > std_X(n * n, std::vector<double>(5));
+
+  viennacl::linalg::cg_tag cg_tag(tolerance, 1000);
+  viennacl::matrix<double, LayoutT> X = viennacl::linalg::solve(A_spd, B, cg_tag);
+  viennacl::copy(X, std_X);
+  double residual = block_relative_residual(std_A_spd, std_X, std_B);
+  if (residual > tolerance || cg_tag.error() > tolerance)
+  {
+    std::cout << "# Error for block CG with " << layout_name << " right hand sides: relative residual " << residual << ", reported " << cg_tag.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::gmres_tag gmres_tag(tolerance, 1000, 30);
+  X = viennacl::linalg::solve(A_nonsym, B, gmres_tag);
+  viennacl::copy(X, std_X);
+  residual = block_relative_residual(std_A_nonsym, std_X, std_B);
+  if (residual > tolerance || gmres_tag.error() > tolerance)
+  {
+    std::cout << "# Error for block GMRES with " << layout_name << " right hand sides: relative residual " << residual << ", reported " << gmres_tag.error() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing block solvers with " << layout_name << " right hand sides: PASSED (CG: " << cg_tag.iters() << " iterations, GMRES: " << gmres_tag.iters() << " iterations)" << std::endl;
+
+  // only zero right hand sides:
+  viennacl::matrix<double, LayoutT> Z = viennacl::zero_matrix<double>(n * n, 3);
+  if (   viennacl::linalg::norm_frobenius(viennacl::linalg::solve(A_spd, Z, cg_tag)) > 0
+      || viennacl::linalg::norm_frobenius(viennacl::linalg::solve(A_nonsym, Z, gmres_tag)) > 0)
+  {
+    std::cout << "# Error: Block solvers return nonzero result for zero right hand sides" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Iterative Solvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  retval = test_matrix_powers(1e-12);
+  if ( retval == EXIT_SUCCESS )
+    retval = test_s_step<double>(1e-10);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  retval = test_block<viennacl::row_major>(1e-10, "row-major");
+  if ( retval == EXIT_SUCCESS )
+    retval = test_block<viennacl::column_major>(1e-10, "column-major");
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -0,0 +1,291 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/matrix_market.cpp  Tests the MatrixMarket reader.
+*   \test  Tests the parallel MatrixMarket reader for compressed_matrix against the generic reader.
+**/
+
+//
+// *** System
+//
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/io/matrix_market.hpp"
+
+#include "viennacl/tools/random.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+/* Returns the maximum relative difference of two sparse matrices, where missing entries are treated as zeros. */
+template<typename NumericT>
+double diff(std::vector<std::map<unsigned int, NumericT> > const & A,
+            std::vector<std::map<unsigned int, NumericT> > const & B)
+{
+  if (A.size() != B.size())
+    return 1.0;
+
+  double error = 0;
+  for (std::size_t i=0; i<A.size(); ++i)
+  {
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+    {
+      typename std::map<unsigned int, NumericT>::const_iterator it_B = B[i].find(it->first);
+      double val_B = (it_B != B[i].end()) ? double(it_B->second) : 0.0;
+      if (it->second != val_B)
+        error = std::max(error, std::fabs(double(it->second) - val_B) / std::max(std::fabs(double(it->second)), std::fabs(val_B)));
+    }
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = B[i].begin(); it != B[i].end(); ++it)
+      if (A[i].find(it->first) == A[i].end() && it->second != NumericT(0))
+        error = std::max(error, 1.0);
+  }
+  return error;
+}
+
+template<typename NumericT>
+int test_file(std::string const & filename, std::string const & contents, double epsilon, std::size_t expected_nnz)
+{
+  {
+    std::ofstream writer(filename.c_str());
+    writer << contents;
+  }
+
+  std::vector<std::map<unsigned int, NumericT> > std_A;
+  viennacl::compressed_matrix<NumericT> vcl_A;
+
+  long lines_generic = viennacl::io::read_matrix_market_file(std_A, filename);
+  long lines_csr     = viennacl::io::read_matrix_market_file(vcl_A, filename);
+  std::remove(filename.c_str());
+
+  if (lines_generic == 0 || lines_csr == 0)
+  {
+    std::cout << "# Error reading " << filename << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::map<unsigned int, NumericT> > std_A_csr(vcl_A.size1());
+  viennacl::copy(vcl_A, std_A_csr);
+
+  if (vcl_A.size1() != std_A.size() || (expected_nnz > 0 && vcl_A.nnz() != expected_nnz))
+  {
+    std::cout << "# Error for " << filename << ": Size or number of nonzeros mismatch (" << vcl_A.size1() << " rows, " << vcl_A.nnz() << " nonzeros)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  double error = diff(std_A, std_A_csr);
+  if (error > epsilon)
+  {
+    std::cout << "# Error for " << filename << ": Entries differ, relative difference " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing " << filename << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+/* Checks that a malformed file is rejected by the CSR reader. */
+template<typename NumericT>
+int test_rejected(std::string const & filename, std::string const & contents)
+{
+  {
+    std::ofstream writer(filename.c_str());
+    writer << contents;
+  }
+
+  viennacl::compressed_matrix<NumericT> vcl_A;
+  long lines = viennacl::io::read_matrix_market_file(vcl_A, filename);
+  std::remove(filename.c_str());
+
+  if (lines != 0)
+  {
+    std::cout << "# Error: " << filename << " not rejected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing rejection of " << filename << ": PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test(double epsilon)
+{
+  // unsorted entries, a duplicate (the last one wins), comments, blank lines, CRLF line endings, various number formats:
+  if (test_file<NumericT>("mm_test_general.mtx",
+                          "%%MatrixMarket matrix coordinate real general\n"
+                          "% comment\n"
+                          "%\n"
+                          "4 5 9\n"
+                          "3 2 1.5\n"
+                          "1 1 -2.25e-3\r\n"
+                          "\n"
+                          "1 5 +7\n"
+                          "4 4 0.1\n"
+                          "3 1 1E2\n"
+                          "  2 3   3.14159265358979323846\n"
+                          "1 5 8.5\n"
+                          "4 1 -0.000000000000000000000000000001\n"
+                          "4 2 123456789012345678901234567890\n",
+                          epsilon, 8) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_file<NumericT>("mm_test_symmetric.mtx",
+                          "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                          "3 3 4\n"
+                          "1 1\n"
+                          "2 1\n"
+                          "3 2\n"
+                          "3 3\n",
+                          epsilon, 6) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_file<NumericT>("mm_test_complex.mtx",
+                          "%%MatrixMarket matrix coordinate complex general\n"
+                          "2 2 2\n"
+                          "1 2 1.5 -3\n"
+                          "2 1 -0.5 4\n",
+                          epsilon, 2) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_file<NumericT>("mm_test_array.mtx",
+                          "%%MatrixMarket matrix array real general\n"
+                          "3 2\n"
+                          "1\n2\n0\n4\n5\n6\n",
+                          epsilon, 5) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_file<NumericT>("mm_test_array_symmetric.mtx",
+                          "%%MatrixMarket matrix array real symmetric\n"
+                          "3 3\n"
+                          "1\n2\n3\n4\n5\n6\n",
+                          epsilon, 9) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // larger file with entries in random order, so that it is split into several chunks:
+  viennacl::tools::uniform_random_numbers<double> randomNumber;
+  std::ostringstream contents;
+  std::size_t rows = 2000, cols = 1500, nnz = 60000;
+  contents << "%%MatrixMarket matrix coordinate real general\n" << rows << " " << cols << " " << nnz << "\n" << std::setprecision(17);
+  for (std::size_t i=0; i<nnz; ++i)
+  {
+    std::size_t row = std::min(rows - 1, static_cast<std::size_t>(randomNumber() * double(rows)));
+    std::size_t col = std::min(cols - 1, static_cast<std::size_t>(randomNumber() * double(cols)));
+    contents << row + 1 << " " << col + 1 << " " << (randomNumber() - 0.5) * std::pow(10.0, int(randomNumber() * 40) - 20) << "\n";
+  }
+  if (test_file<NumericT>("mm_test_random.mtx", contents.str(), epsilon, 0) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // number of entries not matching the size line, indices exceeding the range of the index type:
+  if (test_rejected<NumericT>("mm_test_extra_entries.mtx",
+                              "%%MatrixMarket matrix coordinate real general\n"
+                              "3 3 2\n"
+                              "1 1 1.0\n"
+                              "2 2 2.0\n"
+                              "3 3 3.0\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_rejected<NumericT>("mm_test_missing_entries.mtx",
+                              "%%MatrixMarket matrix coordinate pattern symmetric\n"
+                              "3 3 3\n"
+                              "1 1\n"
+                              "3 2\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_rejected<NumericT>("mm_test_empty_with_entries.mtx",
+                              "%%MatrixMarket matrix coordinate real general\n"
+                              "0 0 1\n"
+                              "1 1 1.0\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_rejected<NumericT>("mm_test_index_overflow.mtx",
+                              "%%MatrixMarket matrix coordinate real general\n"
+                              "3 3 1\n"
+                              "18446744073709551618 1 1.0\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_rejected<NumericT>("mm_test_row_index_overflow.mtx",
+                              "%%MatrixMarket matrix coordinate real general\n"
+                              "4294967297 3 1\n"
+                              "4294967297 1 1.0\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_rejected<NumericT>("mm_test_column_index_overflow.mtx",
+                              "%%MatrixMarket matrix coordinate real general\n"
+                              "3 4294967297 1\n"
+                              "1 4294967297 1.0\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_rejected<NumericT>("mm_test_size_overflow.mtx",
+                              "%%MatrixMarket matrix coordinate real general\n"
+                              "3 3 100000000000000000000000\n"
+                              "1 1 1.0\n") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: MatrixMarket Reader" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  retval = test<float>(1e-6);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  retval = test<double>(0);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
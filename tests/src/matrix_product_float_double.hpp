@@ -345,6 +345,28 @@ int run_test(T epsilon)
 
 #undef TEST_ALL_LAYOUTS
 
+//    short and wide C (fewer row blocks than threads), several blocks of columns and along the inner dimension:
+    {
+      std::size_t wide_M = 64;
+      std::size_t wide_N = 4200;
+      std::size_t wide_K = 270;
+
+      matrix_type A_wide(wide_M, wide_K);
+      init_rand(A_wide);
+      matrix_type AT_wide = boost::numeric::ublas::trans(A_wide);
+      matrix_type B_wide(wide_K, wide_N);
+      init_rand(B_wide);
+      matrix_type BT_wide = boost::numeric::ublas::trans(B_wide);
+      matrix_type C_wide(wide_M, wide_N);
+      init_rand(C_wide);
+
+      std::cout << ">> short and wide matrices" << std::endl;
+      if (test_all_layouts<T>(wide_M, wide_N, C_wide,
+                              wide_M, wide_K, A_wide, AT_wide,
+                              wide_K, wide_N, B_wide, BT_wide, epsilon) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
 
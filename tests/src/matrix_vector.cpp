@@ -1243,6 +1243,73 @@ int test(Epsilon const& epsilon)
       retval = EXIT_FAILURE;
    }
 
+   //full solver with partial pivoting. Rows of a diagonally dominant matrix are shuffled, so the unpivoted factorization would break down:
+   std::cout << "Full solver with partial pivoting" << std::endl;
+   unsigned int plu_dim = 150;
+   unsigned int plu_rhs_num = 3;
+   std::vector<std::vector<NumericT> > plu_matrix(plu_dim, std::vector<NumericT>(plu_dim));
+   std::vector<std::vector<NumericT> > plu_rhs(plu_dim, std::vector<NumericT>(plu_rhs_num));
+   std::vector<std::vector<NumericT> > plu_result(plu_dim, std::vector<NumericT>(plu_rhs_num));
+   viennacl::matrix<NumericT, F> vcl_plu_matrix(plu_dim, plu_dim);
+   viennacl::matrix<NumericT, F> vcl_plu_rhs(plu_dim, plu_rhs_num);
+   viennacl::vector<NumericT> vcl_plu_rhs_vec(plu_dim);
+   std::vector<NumericT> plu_result_vec(plu_dim);
+   std::vector<NumericT> plu_rhs_vec(plu_dim);
+
+   for (std::size_t i=0; i<plu_dim; ++i)
+   {
+     std::size_t row = (7 * i + 3) % plu_dim;  // row permutation, 7 and plu_dim are coprime
+     for (std::size_t j=0; j<plu_dim; ++j)
+       plu_matrix[row][j] = randomNumber() - static_cast<NumericT>(0.5);
+     plu_matrix[row][i] = static_cast<NumericT>(plu_dim) + randomNumber();
+     if (i > 0)
+       plu_matrix[row][0] = 0;
+   }
+
+   for (std::size_t i=0; i<plu_dim; ++i)
+   {
+     for (std::size_t k=0; k<plu_rhs_num; ++k)
+       plu_result[i][k] = NumericT(0.1) + randomNumber();
+     plu_result_vec[i] = plu_result[i][0];
+   }
+
+   for (std::size_t i=0; i<plu_dim; ++i)
+     for (std::size_t j=0; j<plu_dim; ++j)
+     {
+       for (std::size_t k=0; k<plu_rhs_num; ++k)
+         plu_rhs[i][k] += plu_matrix[i][j] * plu_result[j][k];
+       plu_rhs_vec[i] += plu_matrix[i][j] * plu_result_vec[j];
+     }
+
+   viennacl::copy(plu_matrix, vcl_plu_matrix);
+   viennacl::copy(plu_rhs, vcl_plu_rhs);
+   viennacl::copy(plu_rhs_vec, vcl_plu_rhs_vec);
+
+   std::vector<viennacl::vcl_size_t> plu_perm;
+   viennacl::linalg::lu_factorize(vcl_plu_matrix, plu_perm);
+   viennacl::linalg::lu_substitute(vcl_plu_matrix, plu_perm, vcl_plu_rhs_vec);
+   viennacl::linalg::lu_substitute(vcl_plu_matrix, plu_perm, vcl_plu_rhs);
+
+   if ( std::fabs(diff(plu_result_vec, vcl_plu_rhs_vec)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with partial pivoting (vector)" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(plu_result_vec, vcl_plu_rhs_vec)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
+   std::vector<std::vector<NumericT> > plu_solution(plu_dim, std::vector<NumericT>(plu_rhs_num));
+   viennacl::copy(vcl_plu_rhs, plu_solution);
+   NumericT plu_max_diff = 0;
+   for (std::size_t i=0; i<plu_dim; ++i)
+     for (std::size_t k=0; k<plu_rhs_num; ++k)
+       plu_max_diff = std::max<NumericT>(plu_max_diff, std::fabs(plu_solution[i][k] - plu_result[i][k]) / std::fabs(plu_result[i][k]));
+   if (plu_max_diff > epsilon)
+   {
+      std::cout << "# Error at operation: dense solver with partial pivoting (matrix)" << std::endl;
+      std::cout << "  diff: " << plu_max_diff << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
 
 
    return retval;
@@ -0,0 +1,208 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/mixed_precision.cpp  Tests mixed-precision iterative refinement.
+*   \test  Tests mixed-precision iterative refinement with a CG inner solver, the update of the low-precision matrix, and the behavior at stagnation.
+**/
+
+//
+// *** System
+//
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/mixed_precision.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::map<unsigned int, double> > std_sparse_matrix;
+
+/* 5-point finite difference Laplacian on an n x n grid, with 'diagonal' on the diagonal. */
+std_sparse_matrix poisson_2d(unsigned int n, double diagonal)
+{
+  std_sparse_matrix A(n * n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+    {
+      unsigned int row = i * n + j;
+      A[row][row] = diagonal;
+      if (i > 0)   A[row][row - n] = -1.0;
+      if (i < n-1) A[row][row + n] = -1.0;
+      if (j > 0)   A[row][row - 1] = -1.0;
+      if (j < n-1) A[row][row + 1] = -1.0;
+    }
+  return A;
+}
+
+double relative_residual(viennacl::compressed_matrix<double> const & A, viennacl::vector<double> const & x, viennacl::vector<double> const & b)
+{
+  viennacl::vector<double> r = viennacl::linalg::prod(A, x);
+  r = b - r;
+  return viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b);
+}
+
+int check_solution(viennacl::compressed_matrix<double> const & A, viennacl::vector<double> const & x, viennacl::vector<double> const & b,
+                   double tolerance, double reported_error, std::string const & name)
+{
+  double residual = relative_residual(A, x, b);
+  if (residual > tolerance || std::fabs(residual - reported_error) > 1e-3 * residual)
+  {
+    std::cout << "# Error for " << name << ": relative residual " << residual << ", reported " << reported_error << ", tolerance " << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int test_mixed_precision()
+{
+  unsigned int n = 40;
+
+  viennacl::compressed_matrix<double> A;
+  viennacl::copy(poisson_2d(n, 4.0), A);
+
+  std::vector<double> std_b(n * n);
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = 1.0 + std::sin(double(i));
+  viennacl::vector<double> b(n * n);
+  viennacl::copy(std_b, b);
+
+  viennacl::linalg::cg_tag inner_tag(1e-4, 500);
+
+  //
+  // Refinement to full precision:
+  //
+  viennacl::linalg::mixed_precision_matrix<double> A_mixed(A);
+  viennacl::linalg::mixed_precision_tag<viennacl::linalg::cg_tag> tag(inner_tag, 1e-10, 30);
+  viennacl::vector<double> x = viennacl::linalg::solve(A_mixed, b, tag);
+  if (check_solution(A, x, b, 1e-10, tag.error(), "mixed-precision CG") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (tag.iters() < 2 || tag.inner_iters() < tag.iters())
+  {
+    std::cout << "# Error: Unexpected number of refinement steps " << tag.iters() << " with " << tag.inner_iters() << " inner iterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Testing mixed-precision refinement: PASSED (" << tag.iters() << " refinement steps, " << tag.inner_iters() << " inner iterations)" << std::endl;
+
+  // low-precision copy created for a single solve:
+  x = viennacl::linalg::solve(A, b, tag);
+  if (check_solution(A, x, b, 1e-10, tag.error(), "mixed-precision CG without mixed_precision_matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // New values with the same sparsity pattern:
+  //
+  viennacl::compressed_matrix<double> B;
+  viennacl::copy(poisson_2d(n, 4.5), B);
+  A_mixed.update_values(B);
+  x = viennacl::linalg::solve(A_mixed, b, tag);
+  if (check_solution(B, x, b, 1e-10, tag.error(), "mixed-precision CG after update_values()") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // the entries of B are exact in single precision:
+  viennacl::vector<double> ones = viennacl::scalar_vector<double>(n * n, 1.0);
+  viennacl::vector<float> ones_low = viennacl::scalar_vector<float>(n * n, 1.0f);
+  viennacl::vector<double> y = viennacl::linalg::prod(B, ones);
+  viennacl::vector<float> y_mixed = viennacl::linalg::prod(A_mixed.low(), ones_low);
+  viennacl::vector<double> y_low(n * n);
+  y_low = y_mixed;
+  y_low -= y;
+  if (viennacl::linalg::norm_2(y_low) > 0)
+  {
+    std::cout << "# Error: Low-precision values not updated by update_values()" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Testing update of low-precision values: PASSED" << std::endl;
+
+  //
+  // Unattainable tolerance: the refinement stops at stagnation.
+  //
+  viennacl::linalg::mixed_precision_tag<viennacl::linalg::cg_tag> tag_stagnation(inner_tag, 0.0, 30);
+  x = viennacl::linalg::solve(A, b, tag_stagnation);
+  if (tag_stagnation.iters() >= 30 || check_solution(A, x, b, 1e-13, tag_stagnation.error(), "mixed-precision CG at stagnation") != EXIT_SUCCESS)
+  {
+    std::cout << "  refinement steps: " << tag_stagnation.iters() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // A correction increasing the residual is discarded: a single step of CG (steepest descent) increases the residual
+  // for a right hand side with small components for the large eigenvalues of an ill-conditioned matrix.
+  //
+  std_sparse_matrix std_D(n * n);
+  for (unsigned int i=0; i<n * n; ++i)
+  {
+    std_D[i][i] = (i % 2) ? 1000.0 : 1.0;
+    std_b[i]    = (i % 2) ? 0.03 : 1.0;
+  }
+  viennacl::compressed_matrix<double> D;
+  viennacl::copy(std_D, D);
+  viennacl::copy(std_b, b);
+
+  viennacl::linalg::mixed_precision_tag<viennacl::linalg::cg_tag> tag_increase(viennacl::linalg::cg_tag(1e-4, 1), 1e-10, 10);
+  x = viennacl::linalg::solve(D, b, tag_increase);
+  if (check_solution(D, x, b, 1.0, tag_increase.error(), "mixed-precision CG with residual increasing corrections") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  std::cout << "Testing refinement at stagnation: PASSED" << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Mixed-Precision Iterative Refinement" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double with float inner solver" << std::endl;
+  retval = test_mixed_precision();
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -0,0 +1,443 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/preconditioner.cpp  Tests the incomplete factorization preconditioners on the host.
+*   \test  Tests that the multithreaded ILUT factorization matches the sequential one, that the ILUT and Chow-Patel preconditioned solvers converge,
+*          and that the level-scheduled triangular solves with the ILU0, ILUT and ICHOL0 factors match the plain substitutions.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/ilu.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::map<unsigned int, double> > std_sparse_matrix;
+
+/* 5-point finite difference Laplacian on an n x n grid. If 'convection' is nonzero, a first-order upwind convection term makes the matrix nonsymmetric. */
+std_sparse_matrix poisson_2d(unsigned int n, double convection)
+{
+  std_sparse_matrix A(n * n);
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+    {
+      unsigned int row = i * n + j;
+      A[row][row] = 4.0 + convection;
+      if (i > 0)   A[row][row - n] = -1.0;
+      if (i < n-1) A[row][row + n] = -1.0;
+      if (j > 0)   A[row][row - 1] = -1.0 - convection;
+      if (j < n-1) A[row][row + 1] = -1.0;
+    }
+  return A;
+}
+
+template<typename NumericT>
+double relative_residual(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & b)
+{
+  viennacl::vector<NumericT> r = viennacl::linalg::prod(A, x);
+  r = b - r;
+  return double(viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b));
+}
+
+/* Returns true if the two CSR matrices have identical row arrays, column indices and (bitwise) values. Entries reserved beyond the last row are ignored. */
+template<typename NumericT>
+bool identical(viennacl::compressed_matrix<NumericT> const & A, viennacl::compressed_matrix<NumericT> const & B)
+{
+  if (A.size1() != B.size1() || A.size2() != B.size2())
+    return false;
+
+  std::vector<unsigned int> rows_A(A.size1() + 1), rows_B(B.size1() + 1);
+  viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * rows_A.size(), &(rows_A[0]));
+  viennacl::backend::memory_read(B.handle1(), 0, sizeof(unsigned int) * rows_B.size(), &(rows_B[0]));
+  if (rows_A != rows_B)
+    return false;
+
+  std::size_t nnz = rows_A.back();
+  if (nnz == 0)
+    return true;
+
+  std::vector<unsigned int> cols_A(nnz), cols_B(nnz);
+  std::vector<NumericT> values_A(nnz), values_B(nnz);
+  viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * nnz, &(cols_A[0]));
+  viennacl::backend::memory_read(B.handle2(), 0, sizeof(unsigned int) * nnz, &(cols_B[0]));
+  viennacl::backend::memory_read(A.handle(),  0, sizeof(NumericT) * nnz, &(values_A[0]));
+  viennacl::backend::memory_read(B.handle(),  0, sizeof(NumericT) * nnz, &(values_B[0]));
+
+  return cols_A == cols_B && values_A == values_B;
+}
+
+void set_threads(int num_threads)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(num_threads);
+#else
+  (void)num_threads;
+#endif
+}
+
+template<typename NumericT>
+int test_ilut(double tolerance)
+{
+  unsigned int n = 40;  // more than 1000 rows, so that the factorization runs multithreaded
+
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::copy(poisson_2d(n, 0.5), A);
+
+  std::vector<NumericT> std_b(n * n);
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = NumericT(1) + NumericT(std::sin(double(i)));
+  viennacl::vector<NumericT> b(n * n);
+  viennacl::copy(std_b, b);
+
+  unsigned int entries_per_row[] = {5, 20};
+  for (std::size_t k=0; k<sizeof(entries_per_row) / sizeof(entries_per_row[0]); ++k)
+  {
+    viennacl::linalg::ilut_tag ilut_config(entries_per_row[k], 1e-3);
+
+    // sequential reference:
+    set_threads(1);
+    viennacl::compressed_matrix<NumericT> L_ref(A.size1(), A.size2()), U_ref(A.size1(), A.size2());
+    viennacl::linalg::precondition(A, L_ref, U_ref, ilut_config);
+
+    int thread_counts[] = {2, 4, 7};
+    for (std::size_t t=0; t<sizeof(thread_counts) / sizeof(thread_counts[0]); ++t)
+    {
+      set_threads(thread_counts[t]);
+      viennacl::compressed_matrix<NumericT> L(A.size1(), A.size2()), U(A.size1(), A.size2());
+      viennacl::linalg::precondition(A, L, U, ilut_config);
+      if (!identical(L, L_ref) || !identical(U, U_ref))
+      {
+        std::cout << "# Error: ILUT factors with " << thread_counts[t] << " threads differ from the sequential factors (entries per row: " << entries_per_row[k] << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // preconditioned solve:
+    set_threads(4);
+    viennacl::linalg::bicgstab_tag plain_tag(tolerance, 1000);
+    viennacl::linalg::solve(A, b, plain_tag);
+
+    viennacl::linalg::ilut_precond<viennacl::compressed_matrix<NumericT> > ilut(A, ilut_config);
+    viennacl::linalg::bicgstab_tag solver_tag(tolerance, 1000);
+    viennacl::vector<NumericT> x = viennacl::linalg::solve(A, b, solver_tag, ilut);
+
+    double residual = relative_residual(A, x, b);
+    if (residual > 10 * tolerance || solver_tag.iters() >= plain_tag.iters())
+    {
+      std::cout << "# Error: ILUT-preconditioned BiCGStab: relative residual " << residual << " after " << solver_tag.iters()
+                << " iterations, unpreconditioned: " << plain_tag.iters() << " iterations" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Testing ILUT with " << entries_per_row[k] << " entries per row: PASSED (BiCGStab: " << solver_tag.iters()
+              << " iterations, unpreconditioned: " << plain_tag.iters() << ")" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* Runs BiCGStab with the Chow-Patel ILU and CG with the Chow-Patel ICC preconditioner for the given tag. Both must converge in fewer iterations than without preconditioner. */
+template<typename NumericT>
+int check_chow_patel(viennacl::compressed_matrix<NumericT> const & A_spd, viennacl::compressed_matrix<NumericT> const & A_nonsym, viennacl::vector<NumericT> const & b,
+                     viennacl::linalg::chow_patel_tag const & chow_patel_config, double tolerance, std::string const & name,
+                     viennacl::linalg::cg_tag const & plain_cg_tag, viennacl::linalg::bicgstab_tag const & plain_bicgstab_tag)
+{
+
+  viennacl::linalg::chow_patel_icc_precond<viennacl::compressed_matrix<NumericT> > icc(A_spd, chow_patel_config);
+  viennacl::linalg::cg_tag cg_tag(tolerance, 1000);
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A_spd, b, cg_tag, icc);
+  double residual = relative_residual(A_spd, x, b);
+  if (residual > 10 * tolerance || cg_tag.iters() >= plain_cg_tag.iters())
+  {
+    std::cout << "# Error: Chow-Patel ICC-preconditioned CG (" << name << "): relative residual " << residual << " after " << cg_tag.iters()
+              << " iterations, unpreconditioned: " << plain_cg_tag.iters() << " iterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::chow_patel_ilu_precond<viennacl::compressed_matrix<NumericT> > ilu(A_nonsym, chow_patel_config);
+  viennacl::linalg::bicgstab_tag bicgstab_tag(tolerance, 1000);
+  x = viennacl::linalg::solve(A_nonsym, b, bicgstab_tag, ilu);
+  residual = relative_residual(A_nonsym, x, b);
+  if (residual > 10 * tolerance || bicgstab_tag.iters() >= plain_bicgstab_tag.iters())
+  {
+    std::cout << "# Error: Chow-Patel ILU-preconditioned BiCGStab (" << name << "): relative residual " << residual << " after " << bicgstab_tag.iters()
+              << " iterations, unpreconditioned: " << plain_bicgstab_tag.iters() << " iterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing Chow-Patel preconditioners (" << name << "): PASSED (CG: " << cg_tag.iters() << " of " << plain_cg_tag.iters()
+            << " iterations, BiCGStab: " << bicgstab_tag.iters() << " of " << plain_bicgstab_tag.iters() << ")" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_chow_patel(double tolerance)
+{
+  unsigned int n = 80;  // more than VIENNACL_OPENMP_ILU_MIN_SIZE rows, so that sweeps and Jacobi iterations run multithreaded
+
+  viennacl::compressed_matrix<NumericT> A_spd, A_nonsym;
+  viennacl::copy(poisson_2d(n, 0.0), A_spd);
+  viennacl::copy(poisson_2d(n, 0.5), A_nonsym);
+
+  std::vector<NumericT> std_b(n * n);
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = NumericT(1) + NumericT(std::sin(double(i)));
+  viennacl::vector<NumericT> b(n * n);
+  viennacl::copy(std_b, b);
+
+  int thread_counts[] = {1, 4};
+  for (std::size_t t=0; t<sizeof(thread_counts) / sizeof(thread_counts[0]); ++t)
+  {
+    set_threads(thread_counts[t]);
+    std::cout << "  threads: " << thread_counts[t] << std::endl;
+
+    viennacl::linalg::cg_tag plain_cg_tag(tolerance, 1000);
+    viennacl::linalg::solve(A_spd, b, plain_cg_tag);
+    viennacl::linalg::bicgstab_tag plain_bicgstab_tag(tolerance, 1000);
+    viennacl::linalg::solve(A_nonsym, b, plain_bicgstab_tag);
+
+    // fixed number of sweeps and Jacobi iterations:
+    viennacl::linalg::chow_patel_tag default_config;
+    if (check_chow_patel(A_spd, A_nonsym, b, default_config, tolerance, "default", plain_cg_tag, plain_bicgstab_tag) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // sweeps stop early once the nonlinear residual is small:
+    viennacl::linalg::chow_patel_tag sweep_config(20, 2);
+    sweep_config.sweep_tolerance(1e-3);
+    if (check_chow_patel(A_spd, A_nonsym, b, sweep_config, tolerance, "sweep tolerance", plain_cg_tag, plain_bicgstab_tag) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // Jacobi iterations stop early once the update is small:
+    viennacl::linalg::chow_patel_tag jacobi_config(3, 10);
+    jacobi_config.jacobi_tolerance(1e-2);
+    if (check_chow_patel(A_spd, A_nonsym, b, jacobi_config, tolerance, "Jacobi tolerance", plain_cg_tag, plain_bicgstab_tag) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    // both tolerances:
+    viennacl::linalg::chow_patel_tag both_config(20, 10);
+    both_config.sweep_tolerance(1e-3);
+    both_config.jacobi_tolerance(1e-2);
+    if (check_chow_patel(A_spd, A_nonsym, b, both_config, tolerance, "both tolerances", plain_cg_tag, plain_bicgstab_tag) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/* Largest entry-wise relative difference of two vectors */
+template<typename NumericT>
+double max_relative_difference(std::vector<NumericT> const & x, std::vector<NumericT> const & y)
+{
+  double max_diff = 0;
+  for (std::size_t i=0; i<x.size(); ++i)
+    max_diff = std::max(max_diff, std::fabs(double(x[i]) - double(y[i])) / std::max(1.0, std::fabs(double(y[i]))));
+  return max_diff;
+}
+
+/* Solves with the lower or upper triangular part of M once level by level and once by the plain substitution and compares the results. */
+template<typename NumericT, typename TagT>
+int check_level_scheduled_solve(viennacl::compressed_matrix<NumericT> const & M, TagT tag, bool lower, bool unit_diagonal, double epsilon, std::string const & name)
+{
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle2());
+  NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(M.handle());
+
+  viennacl::linalg::host_based::detail::csr_level_schedule schedule;
+  viennacl::linalg::host_based::detail::csr_level_schedule_setup(M, schedule, lower);
+  if (schedule.levels() < 2 || schedule.levels() >= M.size1())
+  {
+    std::cout << "# Error for " << name << ": level schedule with " << schedule.levels() << " levels for " << M.size1() << " rows" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<NumericT> x_ref(M.size1()), x(M.size1());
+  for (std::size_t i=0; i<x.size(); ++i)
+    x[i] = x_ref[i] = NumericT(1) + NumericT(std::sin(double(i)));
+  NumericT * x_ref_buffer = &(x_ref[0]);
+  NumericT * x_buffer     = &(x[0]);
+
+  viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, x_ref_buffer, M.size2(), tag);
+  viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, elements, x_buffer, schedule, lower, unit_diagonal);
+
+  double diff = max_relative_difference(x, x_ref);
+  if (diff > epsilon)
+  {
+    std::cout << "# Error for " << name << ": level-scheduled solve differs from substitution by " << diff << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Applies the preconditioner with a single thread and with several threads, where the host substitutions run level-scheduled in OpenMP builds. */
+template<typename NumericT, typename PreconditionerT>
+int check_threaded_apply(PreconditionerT const & precond, viennacl::vector<NumericT> const & b, double epsilon, std::string const & name)
+{
+  std::vector<NumericT> x_ref(b.size()), x(b.size());
+
+  set_threads(1);
+  viennacl::vector<NumericT> y = b;
+  precond.apply(y);
+  viennacl::copy(y, x_ref);
+
+  set_threads(4);
+  y = b;
+  precond.apply(y);
+  viennacl::copy(y, x);
+
+  double diff = max_relative_difference(x, x_ref);
+  if (diff > epsilon)
+  {
+    std::cout << "# Error for " << name << ": multithreaded application differs from the sequential one by " << diff << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_level_scheduling(double epsilon)
+{
+  unsigned int n = 80;  // more than VIENNACL_OPENMP_TRIANGULAR_MIN_ROWS_PER_LEVEL rows per level of the factors
+
+  viennacl::compressed_matrix<NumericT> A_spd, A_nonsym;
+  viennacl::copy(poisson_2d(n, 0.0), A_spd);
+  viennacl::copy(poisson_2d(n, 0.5), A_nonsym);
+
+  std::vector<NumericT> std_b(n * n);
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = NumericT(1) + NumericT(std::sin(double(i)));
+  viennacl::vector<NumericT> b(n * n);
+  viennacl::copy(std_b, b);
+
+  set_threads(4);
+
+  // ILU0: unit lower and upper triangular part of the combined factor:
+  viennacl::compressed_matrix<NumericT> LU = A_nonsym;
+  viennacl::linalg::precondition(LU, viennacl::linalg::ilu0_tag());
+  if (   check_level_scheduled_solve(LU, viennacl::linalg::unit_lower_tag(), true,  true,  epsilon, "ILU0, L") != EXIT_SUCCESS
+      || check_level_scheduled_solve(LU, viennacl::linalg::upper_tag(),      false, false, epsilon, "ILU0, U") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // ILUT: separate factors:
+  viennacl::linalg::ilut_tag ilut_config(10, 1e-4);
+  viennacl::compressed_matrix<NumericT> L(A_nonsym.size1(), A_nonsym.size2()), U(A_nonsym.size1(), A_nonsym.size2());
+  viennacl::linalg::precondition(A_nonsym, L, U, ilut_config);
+  if (   check_level_scheduled_solve(L, viennacl::linalg::unit_lower_tag(), true,  true,  epsilon, "ILUT, L") != EXIT_SUCCESS
+      || check_level_scheduled_solve(U, viennacl::linalg::upper_tag(),      false, false, epsilon, "ILUT, U") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // ICHOL0: the upper triangular part holds L^T, the lower triangular factor is extracted explicitly:
+  viennacl::compressed_matrix<NumericT> LLT = A_spd;
+  viennacl::linalg::precondition(LLT, viennacl::linalg::ichol0_tag());
+  viennacl::compressed_matrix<NumericT> L_chol;
+  viennacl::linalg::detail::ichol0_extract_lower(LLT, L_chol);
+  if (   check_level_scheduled_solve(L_chol, viennacl::linalg::lower_tag(), true,  false, epsilon, "ICHOL0, L") != EXIT_SUCCESS
+      || check_level_scheduled_solve(LLT,    viennacl::linalg::upper_tag(), false, false, epsilon, "ICHOL0, L^T") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // the schedule of L computed from LLT without the explicit L:
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule, L_trans_schedule;
+  viennacl::linalg::host_based::detail::csr_level_schedule_setup(L_chol, L_schedule, true);
+  viennacl::linalg::host_based::detail::csr_trans_level_schedule_setup(LLT, L_trans_schedule, true);
+  if (   L_schedule.levels() != L_trans_schedule.levels()
+      || !std::equal(L_schedule.level_start(), L_schedule.level_start() + L_schedule.levels() + 1, L_trans_schedule.level_start())
+      || !std::equal(L_schedule.level_rows(), L_schedule.level_rows() + L_chol.size1(), L_trans_schedule.level_rows()))
+  {
+    std::cout << "# Error: level schedule of L computed from the transpose differs from the one computed from L" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // whole preconditioners, level-scheduled if run multithreaded:
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > ilu0(A_nonsym, viennacl::linalg::ilu0_tag());
+  viennacl::linalg::ilut_precond<viennacl::compressed_matrix<NumericT> > ilut(A_nonsym, ilut_config);
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > ichol0(A_spd, viennacl::linalg::ichol0_tag());
+  if (   check_threaded_apply(ilu0,   b, epsilon, "ILU0 preconditioner") != EXIT_SUCCESS
+      || check_threaded_apply(ilut,   b, epsilon, "ILUT preconditioner") != EXIT_SUCCESS
+      || check_threaded_apply(ichol0, b, epsilon, "ICHOL0 preconditioner") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing level-scheduled triangular solves: PASSED (" << L_schedule.levels() << " levels for " << L_chol.size1() << " rows)" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Preconditioners" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  retval = test_ilut<double>(1e-10);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  retval = test_chow_patel<double>(1e-10);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  retval = test_level_scheduling<double>(1e-12);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
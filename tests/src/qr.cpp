@@ -0,0 +1,324 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/qr.cpp  Tests the QR factorization of dense matrices.
+*   \test  Tests the blocked Householder QR factorization and the tall-skinny QR factorization, the recovery of Q, and the application of Q^T for both matrix layouts.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/qr.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::vector<double> > std_matrix;
+
+std_matrix random_matrix(std::size_t rows, std::size_t cols)
+{
+  std_matrix A(rows, std::vector<double>(cols));
+  for (std::size_t i=0; i<rows; ++i)
+    for (std::size_t j=0; j<cols; ++j)
+      A[i][j] = std::sin(double(i * cols + j) * 0.7 + 0.3) + 0.01 * double((i + 2 * j) % 5);
+  return A;
+}
+
+std::vector<double> random_vector(std::size_t size)
+{
+  std::vector<double> b(size);
+  for (std::size_t i=0; i<size; ++i)
+    b[i] = std::cos(double(i) * 1.3) + 0.5;
+  return b;
+}
+
+template<typename MatrixT>
+std_matrix to_host(MatrixT const & A)
+{
+  std_matrix A_host(A.size1(), std::vector<double>(A.size2()));
+  viennacl::copy(A, A_host);
+  return A_host;
+}
+
+/* Maximum of |A - Q R|, of |Q^T Q - I| (over the columns of Q), and of the entries of R below the diagonal. */
+double factorization_error(std_matrix const & A, std_matrix const & Q, std_matrix const & R)
+{
+  double error = 0;
+  for (std::size_t i=0; i<A.size(); ++i)
+    for (std::size_t j=0; j<A[i].size(); ++j)
+    {
+      double QR_ij = 0;
+      for (std::size_t k=0; k<R.size(); ++k)
+        QR_ij += Q[i][k] * R[k][j];
+      error = std::max(error, std::fabs(QR_ij - A[i][j]));
+    }
+
+  for (std::size_t i=0; i<Q[0].size(); ++i)
+    for (std::size_t j=0; j<Q[0].size(); ++j)
+    {
+      double QtQ_ij = 0;
+      for (std::size_t k=0; k<Q.size(); ++k)
+        QtQ_ij += Q[k][i] * Q[k][j];
+      error = std::max(error, std::fabs(QtQ_ij - ((i == j) ? 1.0 : 0.0)));
+    }
+
+  for (std::size_t i=0; i<R.size(); ++i)
+    for (std::size_t j=0; j<std::min(i, R[i].size()); ++j)
+      error = std::max(error, std::fabs(R[i][j]));
+
+  return error;
+}
+
+/* Maximum of |Q^T b - result| over the first Q[0].size() entries. */
+double trans_Q_error(std_matrix const & Q, std::vector<double> const & b, std::vector<double> const & result)
+{
+  double error = 0;
+  for (std::size_t j=0; j<Q[0].size(); ++j)
+  {
+    double Qtb_j = 0;
+    for (std::size_t i=0; i<Q.size(); ++i)
+      Qtb_j += Q[i][j] * b[i];
+    error = std::max(error, std::fabs(Qtb_j - result[j]));
+  }
+  return error;
+}
+
+template<typename LayoutT>
+int test_qr(std::size_t rows, std::size_t cols, std::size_t block_size, double epsilon, std::string const & layout_name)
+{
+  std_matrix std_A = random_matrix(rows, cols);
+  std::vector<double> std_b = random_vector(rows);
+
+  viennacl::matrix<double, LayoutT> A(rows, cols);
+  viennacl::copy(std_A, A);
+  viennacl::vector<double> b(rows);
+  viennacl::copy(std_b, b);
+
+  std::vector<double> betas = viennacl::linalg::inplace_qr(A, block_size);
+
+  // Q and R are resized by recoverQ():
+  viennacl::matrix<double, LayoutT> Q(1, 1);
+  viennacl::matrix<double, LayoutT> R;
+  viennacl::linalg::recoverQ(A, betas, Q, R);
+  if (Q.size1() != rows || Q.size2() != rows || R.size1() != rows || R.size2() != cols)
+  {
+    std::cout << "# Error: QR factorization of " << rows << "x" << cols << " " << layout_name << " matrix: Q or R not resized" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std_matrix std_Q = to_host(Q);
+
+  viennacl::linalg::inplace_qr_apply_trans_Q(A, betas, b);
+  std::vector<double> std_Qtb(rows);
+  viennacl::copy(b, std_Qtb);
+
+  double error_QR  = factorization_error(std_A, std_Q, to_host(R));
+  double error_Qtb = trans_Q_error(std_Q, std_b, std_Qtb);
+  if (error_QR > epsilon || error_Qtb > epsilon)
+  {
+    std::cout << "# Error: QR factorization of " << rows << "x" << cols << " " << layout_name << " matrix with block size " << block_size
+              << ": |A - QR|, |Q^T Q - I|: " << error_QR << ", |Q^T b|: " << error_Qtb << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // sizes not matching the factorization are rejected:
+  std::vector<double> betas_short(betas.begin(), betas.begin() + long(std::min(rows, cols)) - 1);
+  viennacl::vector<double> b_short(rows + 1);
+  int rejected = 0;
+  try
+  {
+    viennacl::linalg::recoverQ(A, betas_short, Q, R);
+  }
+  catch (std::runtime_error const &)
+  {
+    ++rejected;
+  }
+  try
+  {
+    viennacl::linalg::inplace_qr_apply_trans_Q(A, betas, b_short);
+  }
+  catch (std::runtime_error const &)
+  {
+    ++rejected;
+  }
+  if (rejected != 2)
+  {
+    std::cout << "# Error: QR factorization of " << rows << "x" << cols << " " << layout_name << " matrix: betas or vector of wrong size not rejected" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int test_inplace_qr(double epsilon)
+{
+  // square, tall and wide matrices, with block sizes dividing the number of columns or not:
+  std::size_t sizes[][3] = {{1, 1, 16}, {100, 100, 16}, {97, 97, 16}, {37, 23, 4}, {130, 70, 16}, {203, 97, 7}, {300, 64, 32}, {70, 130, 16}};
+  for (std::size_t k=0; k<sizeof(sizes) / sizeof(sizes[0]); ++k)
+  {
+    if (test_qr<viennacl::row_major>(sizes[k][0], sizes[k][1], sizes[k][2], epsilon, "row-major") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_qr<viennacl::column_major>(sizes[k][0], sizes[k][1], sizes[k][2], epsilon, "column-major") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing inplace_qr(), recoverQ(), inplace_qr_apply_trans_Q(): PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template<typename LayoutT>
+int test_tsqr(std::size_t rows, std::size_t cols, std::size_t num_blocks, double epsilon, std::string const & layout_name)
+{
+  std_matrix std_A = random_matrix(rows, cols);
+  std::vector<double> std_b = random_vector(rows);
+
+  viennacl::matrix<double, LayoutT> A(rows, cols);
+  viennacl::copy(std_A, A);
+  viennacl::vector<double> b(rows);
+  viennacl::copy(std_b, b);
+
+  viennacl::linalg::tsqr_factors<double> factors;
+  viennacl::linalg::tsqr(A, factors, num_blocks, 8);
+
+  // Q and R are resized by tsqr_recoverQ():
+  viennacl::matrix<double, LayoutT> Q(1, 1);
+  viennacl::matrix<double, LayoutT> R;
+  viennacl::linalg::tsqr_recoverQ(A, factors, Q, R);
+  if (Q.size1() != rows || Q.size2() != cols || R.size1() != cols || R.size2() != cols)
+  {
+    std::cout << "# Error: TSQR of " << rows << "x" << cols << " " << layout_name << " matrix: Q or R not resized" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std_matrix std_Q = to_host(Q);
+
+  viennacl::linalg::tsqr_apply_trans_Q(A, factors, b);
+  std::vector<double> std_Qtb(rows);
+  viennacl::copy(b, std_Qtb);
+
+  double error_QR  = factorization_error(std_A, std_Q, to_host(R));
+  double error_Qtb = trans_Q_error(std_Q, std_b, std_Qtb);
+  if (error_QR > epsilon || error_Qtb > epsilon)
+  {
+    std::cout << "# Error: TSQR of " << rows << "x" << cols << " " << layout_name << " matrix with " << factors.block_betas.size() << " blocks"
+              << ": |A - QR|, |Q^T Q - I|: " << error_QR << ", |Q^T b|: " << error_Qtb << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // sizes not matching the factorization are rejected:
+  viennacl::vector<double> b_short(rows - 1);
+  bool rejected = false;
+  try
+  {
+    viennacl::linalg::tsqr_apply_trans_Q(A, factors, b_short);
+  }
+  catch (std::runtime_error const &)
+  {
+    rejected = true;
+  }
+  if (!rejected)
+  {
+    std::cout << "# Error: TSQR of " << rows << "x" << cols << " " << layout_name << " matrix: vector of wrong size not rejected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int test_tall_skinny_qr(double epsilon)
+{
+  // 0 blocks: one block per thread. The number of blocks is limited by the number of rows per block, which must not be smaller than the number of columns:
+  std::size_t sizes[][2] = {{1, 1}, {7, 7}, {40, 7}, {333, 17}, {1000, 50}};
+  for (std::size_t k=0; k<sizeof(sizes) / sizeof(sizes[0]); ++k)
+    for (std::size_t num_blocks=0; num_blocks<=16; ++num_blocks)
+    {
+      if (test_tsqr<viennacl::row_major>(sizes[k][0], sizes[k][1], num_blocks, epsilon, "row-major") != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+      if (test_tsqr<viennacl::column_major>(sizes[k][0], sizes[k][1], num_blocks, epsilon, "column-major") != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+
+  // wide matrices are rejected:
+  viennacl::matrix<double> A_wide(5, 6);
+  viennacl::linalg::tsqr_factors<double> factors;
+  bool rejected = false;
+  try
+  {
+    viennacl::linalg::tsqr(A_wide, factors);
+  }
+  catch (std::runtime_error const &)
+  {
+    rejected = true;
+  }
+  if (!rejected)
+  {
+    std::cout << "# Error: TSQR of matrix with more columns than rows not rejected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing tsqr(), tsqr_recoverQ(), tsqr_apply_trans_Q(): PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: QR Factorization" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  retval = test_inplace_qr(1e-11);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  retval = test_tall_skinny_qr(1e-11);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
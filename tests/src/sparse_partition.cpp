@@ -0,0 +1,296 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/sparse_partition.cpp  Tests the partitioned sparse matrix-vector product of the host backend.
+*   \test  Tests sparse matrix-vector products with skewed row lengths for several numbers of threads, the invalidation of the cached partition,
+*          concurrent products with the same matrix, that copies do not keep the cached partitions, and products with empty and small matrices.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_inf.hpp"
+#include "viennacl/tools/random.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::map<unsigned int, double> > std_sparse_matrix;
+
+/* Power-law like row lengths: a few dense rows (longer than the work of a thread), many short rows, and some empty rows. */
+std_sparse_matrix skewed_matrix(unsigned int rows, unsigned int cols, unsigned int seed)
+{
+  viennacl::tools::uniform_random_numbers<double> randomNumber;
+  std_sparse_matrix A(rows);
+  for (unsigned int i=0; i<rows; ++i)
+  {
+    unsigned int row = (i * 7 + seed) % rows;
+    unsigned int length = 0;
+    if (i == 0)
+      length = cols;
+    else if (i < 4)
+      length = cols / (2 * i);
+    else if (i % 5 != 0)
+      length = 1 + (i % 4);
+
+    for (unsigned int j=0; j<length; ++j)
+      A[row][static_cast<unsigned int>(randomNumber() * double(cols - 1))] = randomNumber() - 0.5;
+  }
+  return A;
+}
+
+template<typename NumericT>
+double spmv_error(std_sparse_matrix const & std_A, viennacl::compressed_matrix<NumericT> const & A, unsigned int cols)
+{
+  std::vector<NumericT> std_x(cols);
+  for (unsigned int i=0; i<cols; ++i)
+    std_x[i] = NumericT(1) + NumericT(i % 7) / NumericT(4);
+
+  viennacl::vector<NumericT> x(cols);
+  viennacl::copy(std_x, x);
+
+  // full vectors and ranges of larger vectors (the latter use the alpha/beta kernel):
+  viennacl::vector<NumericT> y = viennacl::linalg::prod(A, x);
+
+  viennacl::vector<NumericT> x_large(cols + 10);
+  viennacl::vector<NumericT> y_large = viennacl::scalar_vector<NumericT>(std_A.size() + 7, NumericT(3));
+  viennacl::range x_r(5, 5 + cols);
+  viennacl::range y_r(3, 3 + std_A.size());
+  viennacl::vector_range<viennacl::vector<NumericT> > x_sub(x_large, x_r);
+  viennacl::vector_range<viennacl::vector<NumericT> > y_sub(y_large, y_r);
+  x_sub = x;
+  y_sub = viennacl::linalg::prod(A, x_sub);
+
+  std::vector<NumericT> std_y(std_A.size());
+  std::vector<NumericT> std_y_large(y_large.size());
+  viennacl::copy(y, std_y);
+  viennacl::copy(y_large, std_y_large);
+
+  double error = 0;
+  for (std::size_t i=0; i<std_A.size(); ++i)
+  {
+    double ref = 0;
+    double abs_sum = 0;
+    for (std::map<unsigned int, double>::const_iterator it = std_A[i].begin(); it != std_A[i].end(); ++it)
+    {
+      ref     += double(NumericT(it->second)) * double(std_x[it->first]);
+      abs_sum += std::fabs(double(NumericT(it->second)) * double(std_x[it->first]));
+    }
+    abs_sum = std::max(abs_sum, 1.0);
+    error = std::max(error, std::fabs(ref - double(std_y[i])) / abs_sum);
+    error = std::max(error, std::fabs(ref - double(std_y_large[i + 3])) / abs_sum);
+  }
+  for (std::size_t i=0; i<3; ++i)
+    error = std::max(error, std::fabs(double(std_y_large[i]) - 3.0));
+  for (std::size_t i=3 + std_A.size(); i<std_y_large.size(); ++i)
+    error = std::max(error, std::fabs(double(std_y_large[i]) - 3.0));
+
+  return error;
+}
+
+template<typename NumericT>
+int test(double epsilon)
+{
+  unsigned int rows = 3000;
+  unsigned int cols = 2500;
+
+  std_sparse_matrix std_A = skewed_matrix(rows, cols, 0);
+  viennacl::compressed_matrix<NumericT> A(rows, cols);
+  viennacl::tools::sparse_matrix_adapter<double> adapted_A(std_A, rows, cols);
+  viennacl::copy(adapted_A, A);
+
+  unsigned int thread_counts[] = {1, 2, 3, 4, 7, 16};
+  for (std::size_t k=0; k<sizeof(thread_counts) / sizeof(thread_counts[0]); ++k)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    omp_set_num_threads(int(thread_counts[k]));
+#endif
+    double error = spmv_error(std_A, A, cols);
+    if (error > epsilon)
+    {
+      std::cout << "# Error: Sparse matrix-vector product with " << thread_counts[k] << " threads, relative error " << error << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // Rewrite the row array in place (same number of rows and nonzeros, different row lengths). The cached partition must not be reused.
+  //
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(4);
+#endif
+  if (spmv_error(std_A, A, cols) > epsilon)
+    return EXIT_FAILURE;
+
+  std::vector<unsigned int> row_buffer(rows + 1);
+  std::vector<unsigned int> col_buffer(A.nnz());
+  std::vector<NumericT>     elements(A.nnz());
+  viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * (rows + 1), &row_buffer[0]);
+  viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * A.nnz(), &col_buffer[0]);
+  viennacl::backend::memory_read(A.handle(),  0, sizeof(NumericT) * A.nnz(), &elements[0]);
+
+  // reverse the order of the rows:
+  std_sparse_matrix std_B(rows);
+  std::vector<unsigned int> row_buffer_B(rows + 1, 0);
+  std::vector<unsigned int> col_buffer_B;
+  std::vector<NumericT>     elements_B;
+  for (unsigned int i=0; i<rows; ++i)
+  {
+    unsigned int row_A = rows - 1 - i;
+    for (unsigned int j=row_buffer[row_A]; j<row_buffer[row_A+1]; ++j)
+    {
+      col_buffer_B.push_back(col_buffer[j]);
+      elements_B.push_back(elements[j]);
+      std_B[i][col_buffer[j]] = double(elements[j]);
+    }
+    row_buffer_B[i+1] = static_cast<unsigned int>(col_buffer_B.size());
+  }
+
+  // write through the handles. The address of the row array, the number of rows, and the number of nonzeros remain the same:
+  viennacl::backend::memory_write(A.handle1(), 0, sizeof(unsigned int) * (rows + 1), &row_buffer_B[0]);
+  viennacl::backend::memory_write(A.handle2(), 0, sizeof(unsigned int) * col_buffer_B.size(), &col_buffer_B[0]);
+  viennacl::backend::memory_write(A.handle(),  0, sizeof(NumericT) * elements_B.size(), &elements_B[0]);
+
+  double error = spmv_error(std_B, A, cols);
+  if (error > epsilon)
+  {
+    std::cout << "# Error: Sparse matrix-vector product after modification of the row array, relative error " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // A copy starts without a partition and computes its own:
+  //
+  viennacl::compressed_matrix<NumericT> A_copy(A);
+  if (A_copy.host_partitions().size() != 0)
+  {
+    std::cout << "# Error: Copy of a compressed_matrix keeps the cached partition of the source" << std::endl;
+    return EXIT_FAILURE;
+  }
+  error = spmv_error(std_B, A_copy, cols);
+  if (error > epsilon)
+  {
+    std::cout << "# Error: Sparse matrix-vector product with a copy, relative error " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  //
+  // Concurrent products with the same matrix. Each thread uses a different number of parts, so the cached partition is rebuilt while other threads use it:
+  //
+  std::vector<double> errors(8, 0.0);
+  #pragma omp parallel for num_threads(4) schedule(static, 1)
+  for (long i = 0; i < static_cast<long>(errors.size()); ++i)
+  {
+    omp_set_num_threads(2 + int(i % 3));
+    for (int repeat = 0; repeat < 5; ++repeat)
+      errors[std::size_t(i)] = std::max(errors[std::size_t(i)], spmv_error(std_B, A, cols));
+  }
+  omp_set_num_threads(4);
+
+  error = *std::max_element(errors.begin(), errors.end());
+  if (error > epsilon)
+  {
+    std::cout << "# Error: Concurrent sparse matrix-vector products with the same matrix, relative error " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  //
+  // Matrices without rows (no row array), without nonzeros, and too small for partitioning:
+  //
+  viennacl::vector<NumericT> x5 = viennacl::scalar_vector<NumericT>(5, NumericT(1));
+  viennacl::compressed_matrix<NumericT> E_rows(0, 5);
+  viennacl::vector<NumericT> y_rows = viennacl::linalg::prod(E_rows, x5);
+
+  viennacl::compressed_matrix<NumericT> E_nnz(4, 5);
+  viennacl::vector<NumericT> y_nnz = viennacl::scalar_vector<NumericT>(4, NumericT(3));
+  y_nnz = viennacl::linalg::prod(E_nnz, x5);
+
+  std_sparse_matrix std_S = skewed_matrix(40, 30, 3);
+  viennacl::compressed_matrix<NumericT> S(40, 30);
+  viennacl::tools::sparse_matrix_adapter<double> adapted_S(std_S, 40, 30);
+  viennacl::copy(adapted_S, S);
+  error = spmv_error(std_S, S, 30);
+
+  if (y_rows.size() != 0 || viennacl::linalg::norm_inf(y_nnz) > 0 || error > epsilon || S.host_partitions().size() != 0)
+  {
+    std::cout << "# Error: Sparse matrix-vector product with empty or small matrices, relative error " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing partitioned sparse matrix-vector product: PASSED" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Partitioned Sparse Matrix-Vector Product" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  retval = test<float>(1e-5);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  retval = test<double>(1e-12);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -34,7 +34,10 @@
 //
 #include "viennacl/scalar.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/spgemm_plan.hpp"
 
 #include "viennacl/tools/random.hpp"
 
@@ -110,6 +113,20 @@ NumericT diff(std::vector<std::map<IndexT, NumericT> > const & stl_A,
   return error;
 }
 
+/* Overwrites the values of vcl_A with the ones of stl_A, which must have the same sparsity pattern. Leaves the row and column arrays of vcl_A untouched. */
+template<typename IndexT, typename NumericT>
+void write_values(std::vector<std::map<IndexT, NumericT> > const & stl_A,
+                  viennacl::compressed_matrix<NumericT> & vcl_A)
+{
+  std::vector<NumericT> values;
+  for (std::size_t row = 0; row < stl_A.size(); ++row)
+    for (typename std::map<IndexT, NumericT>::const_iterator col_it = stl_A[row].begin(); col_it != stl_A[row].end(); ++col_it)
+      values.push_back(col_it->second);
+
+  if (values.size() > 0)
+    viennacl::backend::memory_write(vcl_A.handle(), 0, sizeof(NumericT) * values.size(), &values[0]);
+}
+
 template<typename IndexT, typename NumericT>
 void prod(std::vector<std::map<IndexT, NumericT> > const & stl_A,
           std::vector<std::map<IndexT, NumericT> > const & stl_B,
@@ -124,6 +141,25 @@ void prod(std::vector<std::map<IndexT, NumericT> > const & stl_A,
     }
 }
 
+/* Maximum relative difference of stl_C and the block of vcl_C starting at (start1, start2) with strides (stride1, stride2). All other entries of vcl_C must equal 'fill'. */
+template<typename NumericT, typename MatrixT>
+NumericT dense_diff(std::vector<std::vector<NumericT> > const & stl_C, MatrixT const & vcl_C,
+                    std::size_t start1, std::size_t stride1, std::size_t start2, std::size_t stride2, NumericT fill)
+{
+  std::vector<std::vector<NumericT> > host_C(vcl_C.size1(), std::vector<NumericT>(vcl_C.size2()));
+  viennacl::copy(vcl_C, host_C);
+
+  NumericT error = 0;
+  for (std::size_t i=0; i<host_C.size(); ++i)
+    for (std::size_t j=0; j<host_C[i].size(); ++j)
+    {
+      bool in_block = i >= start1 && (i - start1) % stride1 == 0 && (i - start1) / stride1 < stl_C.size()
+                   && j >= start2 && (j - start2) % stride2 == 0 && (j - start2) / stride2 < stl_C[0].size();
+      NumericT ref = in_block ? stl_C[(i - start1) / stride1][(j - start2) / stride2] : fill;
+      error = std::max(error, std::fabs(ref - host_C[i][j]) / std::max(std::fabs(ref), NumericT(1)));
+    }
+  return error;
+}
 
 //
 // -------------------------------------------------------------
@@ -192,6 +228,213 @@ int test(Epsilon const& epsilon)
     retval = EXIT_FAILURE;
   }
 
+  // --------------------------------------------------------------------------
+  std::cout << "Testing products: compressed_matrix with spgemm_plan" << std::endl;
+  viennacl::linalg::spgemm_plan<NumericT> plan_rows(vcl_A, vcl_B, false);
+  viennacl::linalg::spgemm_plan<NumericT> plan_cols(vcl_A, vcl_B, true);
+  viennacl::linalg::spgemm_plan<NumericT> plan_checked(vcl_A, vcl_B, true, true);
+
+  viennacl::compressed_matrix<NumericT> vcl_F;
+  viennacl::compressed_matrix<NumericT> vcl_G;
+  viennacl::compressed_matrix<NumericT> vcl_I;
+  plan_rows.execute(vcl_A, vcl_B, vcl_F);
+  plan_cols.execute(vcl_A, vcl_B, vcl_G);
+  plan_checked.execute(vcl_A, vcl_B, vcl_I);
+  if ( std::fabs(diff(stl_C, vcl_F)) > epsilon || std::fabs(diff(stl_C, vcl_G)) > epsilon || std::fabs(diff(stl_C, vcl_I)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-matrix product with spgemm_plan" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(stl_C, vcl_F)) << ", " << std::fabs(diff(stl_C, vcl_G)) << ", " << std::fabs(diff(stl_C, vcl_I)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // new values for the same sparsity patterns written through handle(), which keeps the row arrays. Reuses the plans and the result matrices:
+  for (std::size_t i=0; i<stl_A.size(); ++i)
+    for (typename std::map<unsigned int, NumericT>::iterator it = stl_A[i].begin(); it != stl_A[i].end(); ++it)
+      it->second = NumericT(0.5) + randomNumber();
+  for (std::size_t i=0; i<stl_B.size(); ++i)
+    for (typename std::map<unsigned int, NumericT>::iterator it = stl_B[i].begin(); it != stl_B[i].end(); ++it)
+      it->second = NumericT(0.5) + randomNumber();
+  write_values(stl_A, vcl_A);
+  write_values(stl_B, vcl_B);
+
+  stl_C.clear();
+  stl_C.resize(N);
+  prod(stl_A, stl_B, stl_C);
+
+  plan_rows.execute(vcl_A, vcl_B, vcl_F);
+  plan_cols.execute(vcl_A, vcl_B, vcl_G);
+  if ( std::fabs(diff(stl_C, vcl_F)) > epsilon || std::fabs(diff(stl_C, vcl_G)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-matrix product with spgemm_plan and updated values" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(stl_C, vcl_F)) << ", " << std::fabs(diff(stl_C, vcl_G)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // new values written with copy(), which rewrites the row arrays. The plan with pattern checks is still used, the others compute prod(A, B):
+  for (std::size_t i=0; i<stl_A.size(); ++i)
+    for (typename std::map<unsigned int, NumericT>::iterator it = stl_A[i].begin(); it != stl_A[i].end(); ++it)
+      it->second = NumericT(0.5) + randomNumber();
+  viennacl::copy(adapted_stl_A, vcl_A);
+
+  stl_C.clear();
+  stl_C.resize(N);
+  prod(stl_A, stl_B, stl_C);
+
+  plan_rows.execute(vcl_A, vcl_B, vcl_F);
+  plan_cols.execute(vcl_A, vcl_B, vcl_G);
+  plan_checked.execute(vcl_A, vcl_B, vcl_I);
+  if ( std::fabs(diff(stl_C, vcl_F)) > epsilon || std::fabs(diff(stl_C, vcl_G)) > epsilon || std::fabs(diff(stl_C, vcl_I)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-matrix product with spgemm_plan and values updated with copy()" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(stl_C, vcl_F)) << ", " << std::fabs(diff(stl_C, vcl_G)) << ", " << std::fabs(diff(stl_C, vcl_I)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // refresh the plans for the rewritten row array of A:
+  plan_rows.init(vcl_A, vcl_B, false);
+  plan_cols.init(vcl_A, vcl_B, true);
+
+  // result matrix with the size and number of nonzeros of the product, but a different sparsity pattern (leading rows full, trailing rows empty):
+  std::vector<std::map<unsigned int, NumericT> > stl_H(N);
+  std::size_t nnz_C = vcl_G.nnz();
+  for (std::size_t k=0; k<nnz_C; ++k)
+    stl_H[k / M][static_cast<unsigned int>(k % M)] = NumericT(1);
+
+  viennacl::compressed_matrix<NumericT> vcl_H(N, M);
+  viennacl::tools::sparse_matrix_adapter<NumericT> adapted_stl_H(stl_H, N, M);
+  viennacl::copy(adapted_stl_H, vcl_H);
+
+  viennacl::vector<NumericT> vcl_x = viennacl::scalar_vector<NumericT>(M, NumericT(1));
+  viennacl::vector<NumericT> vcl_y = viennacl::linalg::prod(vcl_H, vcl_x);   // caches the work partition of the old pattern
+
+  {
+    plan_cols.execute(vcl_A, vcl_B, vcl_H);
+    vcl_y = viennacl::linalg::prod(vcl_H, vcl_x);
+
+    NumericT y_error = 0;
+    for (std::size_t i=0; i<N; ++i)
+    {
+      NumericT row_sum = 0;
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = stl_C[i].begin(); it != stl_C[i].end(); ++it)
+        row_sum += it->second;
+      y_error = std::max(y_error, std::fabs(row_sum - NumericT(vcl_y[i])) / std::max(std::fabs(row_sum), NumericT(1)));
+    }
+
+    if ( std::fabs(diff(stl_C, vcl_H)) > epsilon || y_error > epsilon )
+    {
+      std::cout << "# Error at operation: matrix-matrix product with spgemm_plan into a matrix with a different sparsity pattern" << std::endl;
+      std::cout << "  diff: " << std::fabs(diff(stl_C, vcl_H)) << ", matrix-vector product: " << y_error << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
+  // move one entry of each row of A to a new column: same number of nonzeros, but a different sparsity pattern
+  for (std::size_t i=0; i<stl_A.size(); ++i)
+  {
+    NumericT value = stl_A[i].begin()->second;
+    stl_A[i].erase(stl_A[i].begin());
+    for (unsigned int col = static_cast<unsigned int>(i % K); ; col = static_cast<unsigned int>((col + 1) % K))
+      if (stl_A[i].find(col) == stl_A[i].end())
+      {
+        stl_A[i][col] = value;
+        break;
+      }
+  }
+  viennacl::copy(adapted_stl_A, vcl_A);
+
+  stl_C.clear();
+  stl_C.resize(N);
+  prod(stl_A, stl_B, stl_C);
+
+  plan_rows.execute(vcl_A, vcl_B, vcl_F);
+  plan_cols.execute(vcl_A, vcl_B, vcl_G);
+  plan_checked.execute(vcl_A, vcl_B, vcl_I);
+  if ( std::fabs(diff(stl_C, vcl_F)) > epsilon || std::fabs(diff(stl_C, vcl_G)) > epsilon || std::fabs(diff(stl_C, vcl_I)) > epsilon )
+  {
+    std::cout << "# Error at operation: matrix-matrix product with spgemm_plan and changed sparsity pattern" << std::endl;
+    std::cout << "  diff: " << std::fabs(diff(stl_C, vcl_F)) << ", " << std::fabs(diff(stl_C, vcl_G)) << ", " << std::fabs(diff(stl_C, vcl_I)) << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // left factor without rows, which has no row array:
+  {
+    viennacl::compressed_matrix<NumericT> vcl_E(0, K);
+    viennacl::compressed_matrix<NumericT> vcl_J;
+    viennacl::linalg::spgemm_plan<NumericT> plan_empty(vcl_E, vcl_B, true, true);
+    plan_empty.execute(vcl_E, vcl_B, vcl_J);
+    vcl_E.handle1();   // non-const access marks the row array as modified, hence the patterns are compared
+    plan_empty.execute(vcl_E, vcl_B, vcl_J);
+    if (vcl_J.size1() != 0 || vcl_J.size2() != M)
+    {
+      std::cout << "# Error at operation: matrix-matrix product with spgemm_plan and a factor without rows" << std::endl;
+      std::cout << "  size of result: " << vcl_J.size1() << "x" << vcl_J.size2() << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  std::cout << "Testing products: compressed_matrix with dense matrices" << std::endl;
+  std::size_t dense_cols[] = {1, 8, 13, 21};
+  for (std::size_t k=0; k<sizeof(dense_cols) / sizeof(dense_cols[0]); ++k)
+  {
+    std::size_t cols = dense_cols[k];
+
+    std::vector<std::vector<NumericT> > stl_D(K, std::vector<NumericT>(cols));
+    for (std::size_t i=0; i<K; ++i)
+      for (std::size_t j=0; j<cols; ++j)
+        stl_D[i][j] = randomNumber() - NumericT(0.5);
+
+    std::vector<std::vector<NumericT> > stl_R(N, std::vector<NumericT>(cols));
+    for (std::size_t i=0; i<N; ++i)
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = stl_A[i].begin(); it != stl_A[i].end(); ++it)
+        for (std::size_t j=0; j<cols; ++j)
+          stl_R[i][j] += it->second * stl_D[it->first][j];
+
+    viennacl::matrix<NumericT, viennacl::row_major>    D_row(K, cols);
+    viennacl::matrix<NumericT, viennacl::column_major> D_col(K, cols);
+    viennacl::copy(stl_D, D_row);
+    viennacl::copy(stl_D, D_col);
+
+    viennacl::matrix<NumericT, viennacl::row_major> D_range_holder = viennacl::scalar_matrix<NumericT>(K + 4, cols + 6, NumericT(3));
+    viennacl::matrix<NumericT, viennacl::row_major> D_slice_holder = viennacl::scalar_matrix<NumericT>(2 * K + 1, 2 * cols + 2, NumericT(3));
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::row_major> > D_range(D_range_holder, viennacl::range(3, 3 + K), viennacl::range(5, 5 + cols));
+    viennacl::matrix_slice<viennacl::matrix<NumericT, viennacl::row_major> > D_slice(D_slice_holder, viennacl::slice(1, 2, K), viennacl::slice(2, 2, cols));
+    D_range = D_row;
+    D_slice = D_row;
+
+    viennacl::matrix<NumericT, viennacl::row_major>    R_row(N, cols);
+    viennacl::matrix<NumericT, viennacl::column_major> R_col(N, cols);
+    viennacl::matrix<NumericT, viennacl::row_major> R_range_holder = viennacl::scalar_matrix<NumericT>(N + 4, cols + 6, NumericT(7));
+    viennacl::matrix<NumericT, viennacl::row_major> R_slice_holder = viennacl::scalar_matrix<NumericT>(2 * N + 1, 2 * cols + 1, NumericT(7));
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::row_major> > R_range(R_range_holder, viennacl::range(2, 2 + N), viennacl::range(3, 3 + cols));
+    viennacl::matrix_slice<viennacl::matrix<NumericT, viennacl::row_major> > R_slice(R_slice_holder, viennacl::slice(1, 2, N), viennacl::slice(0, 2, cols));
+
+    // row-major operands and results with contiguous rows:
+    R_row = viennacl::linalg::prod(vcl_A, D_row);
+    NumericT error = dense_diff(stl_R, R_row, 0, 1, 0, 1, NumericT(0));
+    R_range = viennacl::linalg::prod(vcl_A, D_range);
+    error = std::max(error, dense_diff(stl_R, R_range_holder, 2, 1, 3, 1, NumericT(7)));
+
+    // strided columns, column-major operands and results:
+    R_row = viennacl::linalg::prod(vcl_A, D_slice);
+    error = std::max(error, dense_diff(stl_R, R_row, 0, 1, 0, 1, NumericT(0)));
+    R_slice = viennacl::linalg::prod(vcl_A, D_row);
+    error = std::max(error, dense_diff(stl_R, R_slice_holder, 1, 2, 0, 2, NumericT(7)));
+    R_col = viennacl::linalg::prod(vcl_A, D_row);
+    error = std::max(error, dense_diff(stl_R, R_col, 0, 1, 0, 1, NumericT(0)));
+    R_col = viennacl::linalg::prod(vcl_A, D_col);
+    error = std::max(error, dense_diff(stl_R, R_col, 0, 1, 0, 1, NumericT(0)));
+    R_range = viennacl::linalg::prod(vcl_A, D_col);
+    error = std::max(error, dense_diff(stl_R, R_range_holder, 2, 1, 3, 1, NumericT(7)));
+
+    if ( error > epsilon )
+    {
+      std::cout << "# Error at operation: product of compressed_matrix with dense matrix of " << cols << " columns" << std::endl;
+      std::cout << "  diff: " << error << std::endl;
+      retval = EXIT_FAILURE;
+    }
+  }
+
   // --------------------------------------------------------------------------
   return retval;
 }
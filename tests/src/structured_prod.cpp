@@ -0,0 +1,268 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/structured_prod.cpp  Tests matrix-vector products with Toeplitz and circulant matrices.
+*   \test  Tests matrix-vector products with Toeplitz and circulant matrices whose entries are modified between products, and concurrent products with the same matrix.
+**/
+
+//
+// *** System
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/toeplitz_matrix.hpp"
+#include "viennacl/circulant_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+template<typename NumericT>
+class dense_matrix
+{
+public:
+  typedef NumericT    value_type;
+  typedef std::size_t size_type;
+
+  dense_matrix(std::size_t rows, std::size_t cols) : rows_(rows), cols_(cols), data_(rows * cols) {}
+
+  NumericT & operator()(std::size_t i, std::size_t j)       { return data_[i * cols_ + j]; }
+  NumericT   operator()(std::size_t i, std::size_t j) const { return data_[i * cols_ + j]; }
+
+  std::size_t size1() const { return rows_; }
+  std::size_t size2() const { return cols_; }
+
+private:
+  std::size_t rows_;
+  std::size_t cols_;
+  std::vector<NumericT> data_;
+};
+
+/* Compares prod(A, x) with the product of the current entries of A, obtained by copying A to a dense matrix. */
+template<typename NumericT, typename MatrixT>
+int check_product(MatrixT & A, double epsilon, std::string const & name)
+{
+  std::size_t n = A.size1();
+
+  std::vector<NumericT> std_x(n);
+  for (std::size_t i=0; i<n; ++i)
+    std_x[i] = NumericT(std::sin(double(i)) + 0.5);
+  viennacl::vector<NumericT> x(n);
+  viennacl::copy(std_x, x);
+
+  viennacl::vector<NumericT> y = viennacl::linalg::prod(A, x);
+  std::vector<NumericT> std_y(n);
+  viennacl::copy(y, std_y);
+
+  dense_matrix<NumericT> dense_A(n, n);
+  viennacl::copy(A, dense_A);
+
+  for (std::size_t i=0; i<n; ++i)
+  {
+    double ref = 0;
+    double abs_sum = 0;
+    for (std::size_t j=0; j<n; ++j)
+    {
+      ref     += double(dense_A(i, j)) * double(std_x[j]);
+      abs_sum += std::fabs(double(dense_A(i, j)) * double(std_x[j]));
+    }
+    if (std::fabs(ref - double(std_y[i])) > epsilon * std::max(abs_sum, 1.0))
+    {
+      std::cout << "# Error for " << name << " in row " << i << ": " << std_y[i] << " vs. " << ref << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Products with entries modified in between, through the non-const accessors and through references kept across products. */
+template<typename NumericT, typename MatrixT>
+int test_modification(MatrixT & A, std::size_t num_entries, double epsilon, std::string const & name)
+{
+  std::vector<NumericT> entries(num_entries);
+  for (std::size_t i=0; i<num_entries; ++i)
+    entries[i] = NumericT(std::cos(double(3 * i)));
+  viennacl::copy(entries, A);
+
+  if (check_product<NumericT>(A, epsilon, name + ", initial entries") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // entries changed through the non-const accessors:
+  A.elements()[1] = NumericT(7);
+  if (check_product<NumericT>(A, epsilon, name + ", single entry changed") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  A.elements() *= NumericT(2);
+  if (check_product<NumericT>(A, epsilon, name + ", entries scaled") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::vector<NumericT> host_elements(A.elements().size());
+  viennacl::copy(A.elements(), host_elements);
+  for (std::size_t i=0; i<host_elements.size(); ++i)
+    host_elements[i] = -host_elements[i] + NumericT(0.25);
+  viennacl::copy(host_elements, A.elements());
+  if (check_product<NumericT>(A, epsilon, name + ", entries overwritten") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  A(2, 1) = NumericT(-3);
+  if (check_product<NumericT>(A, epsilon, name + ", entry changed through proxy") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // references kept across products require explicit invalidation:
+  viennacl::vector<NumericT> & elements = A.elements();
+  viennacl::entry_proxy<NumericT> entry = A(1, 2);
+  if (check_product<NumericT>(A, epsilon, name + ", references obtained") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  elements[0] = NumericT(5);
+  entry = NumericT(0.5);
+  A.convolution_cache().invalidate();
+  if (check_product<NumericT>(A, epsilon, name + ", entries changed through kept references") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // unchanged entries reuse the transform:
+  if (check_product<NumericT>(A, epsilon, name + ", unchanged entries") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+/* Concurrent products with the same const matrix. The transform is rebuilt by the first of the threads. */
+template<typename NumericT, typename MatrixT>
+int test_concurrent(MatrixT const & A, double epsilon, std::string const & name)
+{
+  std::size_t n = A.size1();
+  std::size_t num_vectors = 8;
+
+  std::vector<viennacl::vector<NumericT> > x(num_vectors);
+  std::vector<std::vector<NumericT> > y_ref(num_vectors, std::vector<NumericT>(n));
+  for (std::size_t k=0; k<num_vectors; ++k)
+  {
+    std::vector<NumericT> std_x(n);
+    for (std::size_t i=0; i<n; ++i)
+      std_x[i] = NumericT(std::sin(double(i * (k + 1))));
+    x[k].resize(n);
+    viennacl::copy(std_x, x[k]);
+
+    viennacl::vector<NumericT> y = viennacl::linalg::prod(A, x[k]);
+    viennacl::copy(y, y_ref[k]);
+  }
+
+  A.convolution_cache().invalidate();
+
+  std::vector<double> errors(num_vectors, 0.0);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for num_threads(4) schedule(static, 1)
+#endif
+  for (long k = 0; k < static_cast<long>(num_vectors); ++k)
+  {
+    std::vector<NumericT> std_y(n);
+    for (int repeat = 0; repeat < 5; ++repeat)
+    {
+      viennacl::vector<NumericT> y = viennacl::linalg::prod(A, x[std::size_t(k)]);
+      viennacl::copy(y, std_y);
+      for (std::size_t i=0; i<n; ++i)
+        errors[std::size_t(k)] = std::max(errors[std::size_t(k)], std::fabs(double(std_y[i]) - double(y_ref[std::size_t(k)][i])));
+    }
+  }
+
+  double error = *std::max_element(errors.begin(), errors.end());
+  if (error > epsilon)
+  {
+    std::cout << "# Error: Concurrent products with the same " << name << ", error " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test(double epsilon)
+{
+  std::size_t sizes[] = {64, 100};
+  for (std::size_t k=0; k<sizeof(sizes) / sizeof(sizes[0]); ++k)
+  {
+    std::size_t n = sizes[k];
+
+    viennacl::toeplitz_matrix<NumericT> T(n, n);
+    if (test_modification<NumericT>(T, 2 * n - 1, epsilon, "Toeplitz matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    viennacl::circulant_matrix<NumericT> C(n, n);
+    if (test_modification<NumericT>(C, n, epsilon, "circulant matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    std::cout << "Testing products with modified entries for size " << n << ": PASSED" << std::endl;
+
+    if (test_concurrent<NumericT>(static_cast<viennacl::toeplitz_matrix<NumericT> const &>(T), epsilon, "Toeplitz matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_concurrent<NumericT>(static_cast<viennacl::circulant_matrix<NumericT> const &>(C), epsilon, "circulant matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    std::cout << "Testing concurrent products for size " << n << ": PASSED" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Structured Matrix-Vector Products" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  retval = test<float>(1e-5);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  retval = test<double>(1e-12);
+  if ( retval == EXIT_SUCCESS )
+    std::cout << "# Test passed" << std::endl;
+  else
+    return retval;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -29,12 +29,15 @@
 
 // include necessary system headers
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 
 //include basic scalar and vector types of ViennaCL
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/linalg/tql2.hpp"
+#include "viennacl/linalg/mrrr.hpp"
 
 #define EPS 10.0e-5
 
@@ -116,6 +119,109 @@ void test_qr_method_sym()
     */
 }
 
+
+/**
+ * Test the eigenvalues and eigenvectors from bisection and twisted factorizations against the ones from the tql2 algorithm.
+ */
+
+template <typename MatrixLayout>
+void test_mrrr()
+{
+  std::size_t sz = 220;
+
+  viennacl::matrix<ScalarType, MatrixLayout> Q = viennacl::identity_matrix<ScalarType>(sz);
+  viennacl::matrix<ScalarType, MatrixLayout> Z;
+  std::vector<ScalarType> d(sz), e(sz), d_ref(sz), e_ref(sz), eigenvalues;
+
+  std::cout << "Testing matrix of size " << sz << "-by-" << sz << std::endl << std::endl;
+
+  // same matrix as for tql2, with many close eigenvalues due to its periodic structure
+  for(unsigned int i = 0; i < sz; ++i)
+  {
+    d[i] = ((float)(i % 9)) - 4.5f;
+    e[i] = ((float)(i % 5)) - 4.5f;
+  }
+  e[0] = 0.0f;
+  d_ref = d;
+  e_ref = e;
+
+  viennacl::linalg::tql2(Q, d, e);
+  std::sort(d.begin(), d.end());
+
+  viennacl::linalg::mrrr(d_ref, e_ref, eigenvalues, Z);
+  if (eigenvalues.size() != sz || Z.size1() != sz || Z.size2() != sz)
+    exit(EXIT_FAILURE);
+  for (std::size_t i = 0; i < sz; ++i)
+  {
+    if (std::fabs(eigenvalues[i] - d[i]) > EPS * std::max<ScalarType>(1, std::fabs(d[i])))
+    {
+      std::cout << "Eigenvalue " << i << " differs: " << eigenvalues[i] << " vs. " << d[i] << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // residuals and orthogonality:
+  std::vector<ScalarType> Z_cpu(sz * sz);
+  for (std::size_t i = 0; i < sz; ++i)
+    for (std::size_t j = 0; j < sz; ++j)
+      Z_cpu[i * sz + j] = Z(i, j);
+
+  for (std::size_t j = 0; j < sz; ++j)
+  {
+    for (std::size_t i = 0; i < sz; ++i)
+    {
+      ScalarType value = (d_ref[i] - eigenvalues[j]) * Z_cpu[i * sz + j];
+      if (i > 0)
+        value += e_ref[i] * Z_cpu[(i-1) * sz + j];
+      if (i+1 < sz)
+        value += e_ref[i+1] * Z_cpu[(i+1) * sz + j];
+      if (std::fabs(value) > EPS)
+      {
+        std::cout << "Residual of eigenpair " << j << " too large: " << value << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    for (std::size_t k = 0; k <= j; ++k)
+    {
+      ScalarType dot = 0;
+      for (std::size_t i = 0; i < sz; ++i)
+        dot += Z_cpu[i * sz + j] * Z_cpu[i * sz + k];
+      if (std::fabs(dot - ScalarType(j == k ? 1 : 0)) > EPS)
+      {
+        std::cout << "Eigenvectors " << j << " and " << k << " not orthonormal: " << dot << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  // subset of the spectrum:
+  std::size_t first = 40, last = 75;
+  viennacl::linalg::mrrr(d_ref, e_ref, eigenvalues, Z, first, last);
+  if (eigenvalues.size() != last - first || Z.size1() != sz || Z.size2() != last - first)
+    exit(EXIT_FAILURE);
+  for (std::size_t i = first; i < last; ++i)
+  {
+    if (std::fabs(eigenvalues[i - first] - d[i]) > EPS * std::max<ScalarType>(1, std::fabs(d[i])))
+    {
+      std::cout << "Eigenvalue " << i << " of subset differs: " << eigenvalues[i - first] << " vs. " << d[i] << std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+    // well-separated eigenvectors are unique up to the sign:
+    bool isolated = i > first && i+1 < last && eigenvalues[i - first] - eigenvalues[i - first - 1] > ScalarType(0.1)
+                                            && eigenvalues[i - first + 1] - eigenvalues[i - first] > ScalarType(0.1);
+    for (std::size_t k = 0; isolated && k < sz; ++k)
+    {
+      if (std::fabs(std::fabs(ScalarType(Z(k, i - first))) - std::fabs(Z_cpu[k * sz + i])) > EPS)
+      {
+        std::cout << "Eigenvector " << i << " of subset differs" << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+}
+
 int main()
 {
 
@@ -126,5 +232,11 @@ int main()
   std::cout << std::endl << "Testing QL algorithm for symmetric tridiagonal column-major matrices..." << std::endl;
   test_qr_method_sym<viennacl::column_major>();
 
+  std::cout << std::endl << "Testing bisection and twisted factorizations for symmetric tridiagonal row-major matrices..." << std::endl;
+  test_mrrr<viennacl::row_major>();
+
+  std::cout << std::endl << "Testing bisection and twisted factorizations for symmetric tridiagonal column-major matrices..." << std::endl;
+  test_mrrr<viennacl::column_major>();
+
   std::cout << std::endl <<"--------TEST SUCCESSFULLY COMPLETED----------" << std::endl;
 }
@@ -20,16 +20,84 @@
 
 /** @file viennacl/backend/cpu_ram.hpp
     @brief Implementations for the OpenCL backend functionality
+
+    Buffers in main memory are obtained from a caching pool with size classes (four classes per power of two, i.e. at most 25 percent overhead).
+    Released buffers can be kept in the pool up to a configurable number of bytes (VIENNACL_CPU_RAM_POOL_LIMIT or memory_pool_limit())
+    and are then handed out again to later requests of the same size class, which avoids allocator churn for temporaries in iterative solvers.
+    The default limit is zero, i.e. released buffers are returned to the operating system right away.
+    All buffers are aligned to VIENNACL_CPU_RAM_ALIGNMENT bytes (default and minimum: 64, i.e. one cache line).
+
+    With OpenMP, newly obtained pages are first touched by the threads which later operate on them (using the same static schedule as the host kernels),
+    so that on NUMA systems the pages are placed on the memory node of the owning thread.
 */
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
 #include <vector>
-#ifdef VIENNACL_WITH_AVX2
-#include <stdlib.h>
+#ifdef _WIN32
+#include <malloc.h>
+#if (defined(_MSC_VER) && _MSC_VER >= 1700) || __cplusplus >= 201103L
+#include <mutex>
+#define VIENNACL_CPU_RAM_STD_MUTEX
+#else
+// compilers without <mutex>: critical sections from <windows.h>, without the min/max macros
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+#else
+#include <pthread.h>
 #endif
 
 #include "viennacl/forwards.h"
 #include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/tools/cpu_features.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VIENNACL_HAVE_STREAMING_STORES
+#endif
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Alignment of buffers in main memory (in bytes). Must be a power of two and at least 64 (cache line size).
+#ifndef VIENNACL_CPU_RAM_ALIGNMENT
+  #define VIENNACL_CPU_RAM_ALIGNMENT  64
+#endif
+
+#if VIENNACL_CPU_RAM_ALIGNMENT < 64 || (VIENNACL_CPU_RAM_ALIGNMENT & (VIENNACL_CPU_RAM_ALIGNMENT - 1)) != 0
+  #error "VIENNACL_CPU_RAM_ALIGNMENT must be a power of two and at least 64"
+#endif
+
+// Maximum number of bytes kept in the memory pool for reuse. Zero (default) disables caching.
+#ifndef VIENNACL_CPU_RAM_POOL_LIMIT
+  #define VIENNACL_CPU_RAM_POOL_LIMIT  0
+#endif
+
+// Minimum number of bytes for which copies are split across OpenMP threads:
+#ifndef VIENNACL_CPU_RAM_PARALLEL_COPY_MIN_SIZE
+  #define VIENNACL_CPU_RAM_PARALLEL_COPY_MIN_SIZE  (vcl_size_t(1) << 18)
+#endif
+
+// Minimum number of bytes for which copies use non-temporal (streaming) stores, bypassing the caches:
+#ifndef VIENNACL_CPU_RAM_STREAMING_COPY_MIN_SIZE
+  #define VIENNACL_CPU_RAM_STREAMING_COPY_MIN_SIZE  (vcl_size_t(1) << 24)
+#endif
+
+// Minimum buffer size (in bytes) for which newly allocated pages are first touched in parallel:
+#ifndef VIENNACL_CPU_RAM_FIRST_TOUCH_MIN_SIZE
+  #define VIENNACL_CPU_RAM_FIRST_TOUCH_MIN_SIZE  (vcl_size_t(1) << 20)
+#endif
 
 namespace viennacl
 {
@@ -49,22 +117,424 @@ typedef viennacl::tools::shared_ptr<char>  handle_type;
 // *
 //
 
+/** @brief Counters of the memory pool for main memory. All sizes refer to the (rounded-up) capacity of the buffers. */
+struct memory_pool_statistics
+{
+  memory_pool_statistics() : hits(0), misses(0), bytes_in_use(0), bytes_cached(0), peak_bytes_in_use(0) {}
+
+  vcl_size_t hits;               // requests served from the pool
+  vcl_size_t misses;             // requests which required a fresh allocation
+  vcl_size_t bytes_in_use;       // bytes currently held by handles
+  vcl_size_t bytes_cached;       // bytes of released buffers kept for reuse
+  vcl_size_t peak_bytes_in_use;  // maximum of bytes_in_use observed so far
+};
+
 namespace detail
 {
-  /** @brief Helper struct for deleting an pointer to an array */
-  template<class U>
-  struct array_deleter
+  /** @brief Minimal mutex protecting the memory pool. Handles may be created and released from several threads (e.g. one context per thread), with or without OpenMP. */
+  class pool_mutex
+  {
+  public:
+#if defined(VIENNACL_CPU_RAM_STD_MUTEX)
+    pool_mutex()  {}
+
+    void lock()   { mutex_.lock(); }
+    void unlock() { mutex_.unlock(); }
+#elif defined(_WIN32)
+    pool_mutex()  { InitializeCriticalSection(&mutex_); }
+    ~pool_mutex() { DeleteCriticalSection(&mutex_); }
+
+    void lock()   { EnterCriticalSection(&mutex_); }
+    void unlock() { LeaveCriticalSection(&mutex_); }
+#else
+    pool_mutex()  { pthread_mutex_init(&mutex_, NULL); }
+    ~pool_mutex() { pthread_mutex_destroy(&mutex_); }
+
+    void lock()   { pthread_mutex_lock(&mutex_); }
+    void unlock() { pthread_mutex_unlock(&mutex_); }
+#endif
+
+  private:
+    pool_mutex(pool_mutex const &);
+    pool_mutex & operator=(pool_mutex const &);
+
+#if defined(VIENNACL_CPU_RAM_STD_MUTEX)
+    std::mutex       mutex_;
+#elif defined(_WIN32)
+    CRITICAL_SECTION mutex_;
+#else
+    pthread_mutex_t  mutex_;
+#endif
+  };
+
+  /** @brief Locks a pool_mutex for the lifetime of the object. */
+  class pool_lock
   {
-#ifdef VIENNACL_WITH_AVX2
-    void operator()(U* p) const { free(p); }
+  public:
+    explicit pool_lock(pool_mutex & m) : mutex_(m) { mutex_.lock(); }
+    ~pool_lock() { mutex_.unlock(); }
+
+  private:
+    pool_lock(pool_lock const &);
+    pool_lock & operator=(pool_lock const &);
+
+    pool_mutex & mutex_;
+  };
+
+  inline char * aligned_malloc(vcl_size_t size_in_bytes)
+  {
+    void * ptr = NULL;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size_in_bytes, VIENNACL_CPU_RAM_ALIGNMENT);
+#else
+    if (posix_memalign(&ptr, VIENNACL_CPU_RAM_ALIGNMENT, size_in_bytes) != 0)
+      ptr = NULL;
+#endif
+    if (!ptr)
+      throw std::bad_alloc();
+    return static_cast<char*>(ptr);
+  }
+
+  inline void aligned_free(char * ptr)
+  {
+#ifdef _WIN32
+    _aligned_free(ptr);
 #else
-    void operator()(U* p) const { delete[] p; }
+    free(ptr);
+#endif
+  }
+
+  /** @brief Touches each page of a freshly allocated buffer from the thread which processes the respective range in a statically scheduled loop.
+    *
+    * Operating systems place a page on the NUMA node of the thread touching it first. Without this, all pages end up on the node of the allocating thread.
+    */
+  inline void first_touch(char * ptr, vcl_size_t size_in_bytes)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    if (size_in_bytes < VIENNACL_CPU_RAM_FIRST_TOUCH_MIN_SIZE || omp_get_max_threads() < 2)
+      return;
+
+    vcl_size_t const page_size = 4096;
+    long num_pages = long((size_in_bytes - 1) / page_size + 1);
+
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < num_pages; ++i)
+      ptr[vcl_size_t(i) * page_size] = 0;
+#else
+    (void)ptr; (void)size_in_bytes;
+#endif
+  }
+
+#ifdef VIENNACL_HAVE_STREAMING_STORES
+  /** @brief Copies with 16-byte loads and non-temporal 16-byte stores. The destination is aligned first, remainders are copied with memcpy. */
+  inline void stream_copy_SSE2(char * dst, char const * src, vcl_size_t num_bytes)
+  {
+    vcl_size_t head = (16 - (reinterpret_cast<vcl_size_t>(dst) & 15)) & 15;
+    if (head > num_bytes)
+      head = num_bytes;
+    std::memcpy(dst, src, head);
+    dst += head; src += head; num_bytes -= head;
+
+    for (; num_bytes >= 64; num_bytes -= 64, dst += 64, src += 64)
+    {
+      __m128i v0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src));
+      __m128i v1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + 16));
+      __m128i v2 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + 32));
+      __m128i v3 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst),      v0);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16), v1);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32), v2);
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48), v3);
+    }
+    _mm_sfence();
+
+    std::memcpy(dst, src, num_bytes);
+  }
+#endif
+
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+  /** @brief Copies with 32-byte loads and non-temporal 32-byte stores. The destination is aligned first, remainders are copied with memcpy. */
+  VIENNACL_TARGET_AVX2 inline void stream_copy_AVX2(char * dst, char const * src, vcl_size_t num_bytes)
+  {
+    vcl_size_t head = (32 - (reinterpret_cast<vcl_size_t>(dst) & 31)) & 31;
+    if (head > num_bytes)
+      head = num_bytes;
+    std::memcpy(dst, src, head);
+    dst += head; src += head; num_bytes -= head;
+
+    for (; num_bytes >= 128; num_bytes -= 128, dst += 128, src += 128)
+    {
+      __m256i v0 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src));
+      __m256i v1 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + 32));
+      __m256i v2 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + 64));
+      __m256i v3 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + 96));
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dst),      v0);
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + 32), v1);
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + 64), v2);
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + 96), v3);
+    }
+    _mm_sfence();
+
+    std::memcpy(dst, src, num_bytes);
+  }
+#endif
+
+  /** @brief Copies a contiguous range by a single thread. Streaming stores are used if requested and available, otherwise memcpy (which uses the widest vector loads/stores of the C library). */
+  inline void copy_chunk(char * dst, char const * src, vcl_size_t num_bytes, bool streaming)
+  {
+    if (num_bytes == 0)
+      return;
+
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+    if (streaming && viennacl::tools::host_isa() >= viennacl::tools::ISA_AVX2)
+    {
+      stream_copy_AVX2(dst, src, num_bytes);
+      return;
+    }
 #endif
+#ifdef VIENNACL_HAVE_STREAMING_STORES
+    if (streaming)
+    {
+      stream_copy_SSE2(dst, src, num_bytes);
+      return;
+    }
+#endif
+    (void)streaming;
+    std::memcpy(dst, src, num_bytes);
+  }
+
+  /** @brief Copies 'num_bytes' bytes from 'src' to 'dst'.
+    *
+    * Overlapping ranges (e.g. from memory_copy() within the same buffer) are copied by a single thread with memmove.
+    * Large copies are split into one contiguous chunk per thread, with chunk boundaries on cache lines (so that no two threads write to the same line).
+    * Each chunk is copied with wide vector loads and stores; copies beyond VIENNACL_CPU_RAM_STREAMING_COPY_MIN_SIZE bytes use non-temporal stores
+    * in order to avoid reading the destination into the cache and evicting useful data.
+    * Since the partitioning matches a static schedule, the initializing copy in memory_create() also first-touches pages by their owning threads.
+    */
+  inline void copy_bytes(char * dst, char const * src, vcl_size_t num_bytes)
+  {
+    if (num_bytes == 0 || dst == src)
+      return;
+
+    vcl_size_t dst_addr = reinterpret_cast<vcl_size_t>(dst);
+    vcl_size_t src_addr = reinterpret_cast<vcl_size_t>(src);
+    if (dst_addr < src_addr + num_bytes && src_addr < dst_addr + num_bytes)
+    {
+      std::memmove(dst, src, num_bytes);
+      return;
+    }
+
+    bool streaming = (num_bytes >= VIENNACL_CPU_RAM_STREAMING_COPY_MIN_SIZE);
+
+#ifdef VIENNACL_WITH_OPENMP
+    if (num_bytes >= VIENNACL_CPU_RAM_PARALLEL_COPY_MIN_SIZE && omp_get_max_threads() > 1)
+    {
+      #pragma omp parallel
+      {
+        vcl_size_t num_threads = vcl_size_t(omp_get_num_threads());
+        vcl_size_t thread_id   = vcl_size_t(omp_get_thread_num());
+
+        vcl_size_t chunk_size = (((num_bytes - 1) / num_threads + 1 + 63) / 64) * 64;
+        vcl_size_t begin = std::min(thread_id * chunk_size, num_bytes);
+        vcl_size_t end   = std::min(begin + chunk_size, num_bytes);
+
+        copy_chunk(dst + begin, src + begin, end - begin, streaming);
+      }
+      return;
+    }
+#endif
+
+    copy_chunk(dst, src, num_bytes, streaming);
+  }
+
+  /** @brief Caching pool for aligned buffers in main memory. Buffers are binned by size class, released buffers are kept up to a byte limit. */
+  class memory_pool
+  {
+    typedef std::vector<char*>                   free_list_type;
+    typedef std::map<vcl_size_t, free_list_type>  free_lists_type;
+
+  public:
+    memory_pool() : limit_(VIENNACL_CPU_RAM_POOL_LIMIT) { alive() = true; }
+
+    ~memory_pool()
+    {
+      release_cached();
+      alive() = false;
+    }
+
+    /** @brief Returns the pool instance. Buffers released after destruction of the pool at program exit are freed directly. */
+    static memory_pool & instance()
+    {
+      static memory_pool pool;
+      return pool;
+    }
+
+    static bool & alive()
+    {
+      static bool is_alive = false;
+      return is_alive;
+    }
+
+    /** @brief Rounds a request up to its size class: multiples of 2^k/4 between 2^k and 2^(k+1), at least the alignment. */
+    static vcl_size_t size_class(vcl_size_t size_in_bytes)
+    {
+      if (size_in_bytes <= VIENNACL_CPU_RAM_ALIGNMENT)
+        return VIENNACL_CPU_RAM_ALIGNMENT;
+
+      vcl_size_t power = VIENNACL_CPU_RAM_ALIGNMENT;
+      while (power <= size_in_bytes / 2)
+        power *= 2;
+      vcl_size_t step = power / 4;
+      return power + ((size_in_bytes - power + step - 1) / step) * step;
+    }
+
+    /** @brief Returns a buffer of at least 'size_in_bytes' bytes. The capacity of the buffer (required for deallocate()) is written to 'capacity'. */
+    char * allocate(vcl_size_t size_in_bytes, vcl_size_t & capacity, bool & from_pool)
+    {
+      capacity = size_class(size_in_bytes);
+      char * ptr = NULL;
+
+      {
+        pool_lock guard(mutex_);
+        free_lists_type::iterator it = free_lists_.find(capacity);
+        if (it != free_lists_.end() && it->second.size() > 0)
+        {
+          ptr = it->second.back();
+          it->second.pop_back();
+          stats_.bytes_cached -= capacity;
+          ++stats_.hits;
+        }
+        else
+          ++stats_.misses;
+
+        stats_.bytes_in_use += capacity;
+        if (stats_.bytes_in_use > stats_.peak_bytes_in_use)
+          stats_.peak_bytes_in_use = stats_.bytes_in_use;
+      }
+
+      from_pool = (ptr != NULL);
+      if (!ptr)
+      {
+        try
+        {
+          ptr = aligned_malloc(capacity);
+        }
+        catch (std::bad_alloc const &)
+        {
+          // drop cached buffers and retry once:
+          release_cached();
+          ptr = aligned_malloc(capacity);
+        }
+      }
+      return ptr;
+    }
+
+    /** @brief Returns a buffer obtained from allocate() to the pool. The buffer is freed if the pool limit would be exceeded. */
+    void deallocate(char * ptr, vcl_size_t capacity)
+    {
+      bool keep = false;
+
+      {
+        pool_lock guard(mutex_);
+        stats_.bytes_in_use -= capacity;
+        if (stats_.bytes_cached + capacity <= limit_)
+        {
+          free_lists_[capacity].push_back(ptr);
+          stats_.bytes_cached += capacity;
+          keep = true;
+        }
+      }
+
+      if (!keep)
+        aligned_free(ptr);
+    }
+
+    /** @brief Frees all buffers currently kept for reuse. */
+    void release_cached()
+    {
+      free_lists_type lists;
+
+      {
+        pool_lock guard(mutex_);
+        lists.swap(free_lists_);
+        stats_.bytes_cached = 0;
+      }
+
+      for (free_lists_type::iterator it = lists.begin(); it != lists.end(); ++it)
+        for (vcl_size_t i=0; i<it->second.size(); ++i)
+          aligned_free(it->second[i]);
+    }
+
+    memory_pool_statistics statistics()
+    {
+      memory_pool_statistics result;
+      {
+        pool_lock guard(mutex_);
+        result = stats_;
+      }
+      return result;
+    }
+
+    void limit(vcl_size_t max_bytes_cached)
+    {
+      {
+        pool_lock guard(mutex_);
+        limit_ = max_bytes_cached;
+      }
+
+      if (statistics().bytes_cached > max_bytes_cached)
+        release_cached();
+    }
+
+  private:
+    memory_pool(memory_pool const &);
+    memory_pool & operator=(memory_pool const &);
+
+    pool_mutex             mutex_;
+    free_lists_type        free_lists_;
+    memory_pool_statistics stats_;
+    vcl_size_t             limit_;
+  };
+
+  /** @brief Deleter for handles obtained from the memory pool. Returns the buffer to the pool. */
+  struct pool_deleter
+  {
+    explicit pool_deleter(vcl_size_t capacity) : capacity_(capacity) {}
+
+    void operator()(char * p) const
+    {
+      if (memory_pool::alive())
+        memory_pool::instance().deallocate(p, capacity_);
+      else
+        aligned_free(p);
+    }
+
+    vcl_size_t capacity_;
   };
 
 }
 
+/** @brief Returns the hit/miss counters and the memory usage of the pool for main memory. */
+inline memory_pool_statistics memory_pool_info()
+{
+  return detail::memory_pool::instance().statistics();
+}
+
+/** @brief Frees all buffers kept in the pool for main memory for reuse. Buffers in use are not affected. */
+inline void memory_pool_release()
+{
+  detail::memory_pool::instance().release_cached();
+}
+
+/** @brief Sets the maximum number of bytes kept in the pool for main memory. Zero disables caching of released buffers. */
+inline void memory_pool_limit(vcl_size_t max_bytes_cached)
+{
+  detail::memory_pool::instance().limit(max_bytes_cached);
+}
+
 /** @brief Creates an array of the specified size in main RAM. If the second argument is provided, the buffer is initialized with data from that pointer.
+ *
+ * The buffer is taken from the memory pool and aligned to VIENNACL_CPU_RAM_ALIGNMENT bytes.
  *
  * @param size_in_bytes   Number of bytes to allocate
  * @param host_ptr        Pointer to data which will be copied to the new array. Must point to at least 'size_in_bytes' bytes of data.
@@ -72,32 +542,27 @@ namespace detail
  */
 inline handle_type  memory_create(vcl_size_t size_in_bytes, const void * host_ptr = NULL)
 {
-#ifdef VIENNACL_WITH_AVX2
-  // Note: aligned_alloc not available on all compilers. Consider platform-specific alternatives such as posix_memalign()
-  if (!host_ptr)
-    return handle_type(reinterpret_cast<char*>(aligned_alloc(32, size_in_bytes)), detail::array_deleter<char>());
+  vcl_size_t capacity = 0;
+  bool from_pool = false;
+  char * ptr = detail::memory_pool::instance().allocate(size_in_bytes, capacity, from_pool);
+  handle_type new_handle(ptr, detail::pool_deleter(capacity));
 
-  handle_type new_handle(reinterpret_cast<char*>(aligned_alloc(32, size_in_bytes)), detail::array_deleter<char>());
-#else
   if (!host_ptr)
-    return handle_type(new char[size_in_bytes], detail::array_deleter<char>());
-
-  handle_type new_handle(new char[size_in_bytes], detail::array_deleter<char>());
-#endif
+  {
+    if (!from_pool)
+      detail::first_touch(new_handle.get(), size_in_bytes);
+    return new_handle;
+  }
 
-  // copy data:
-  char * raw_ptr = new_handle.get();
-  const char * data_ptr = static_cast<const char *>(host_ptr);
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-#endif
-  for (long i=0; i<long(size_in_bytes); ++i)
-    raw_ptr[i] = data_ptr[i];
+  // copy data (also first-touches the pages by the owning threads):
+  detail::copy_bytes(new_handle.get(), static_cast<const char *>(host_ptr), size_in_bytes);
 
   return new_handle;
 }
 
 /** @brief Copies 'bytes_to_copy' bytes from address 'src_buffer + src_offset' to memory starting at address 'dst_buffer + dst_offset'.
+ *
+ *  Source and destination may overlap if both refer to the same buffer.
  *
  *  @param src_buffer     A smart pointer to the begin of an allocated buffer
  *  @param dst_buffer     A smart pointer to the end of an allocated buffer
@@ -114,11 +579,7 @@ inline void memory_copy(handle_type const & src_buffer,
   assert( (dst_buffer.get() != NULL) && bool("Memory not initialized!"));
   assert( (src_buffer.get() != NULL) && bool("Memory not initialized!"));
 
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long i=0; i<long(bytes_to_copy); ++i)
-    dst_buffer.get()[vcl_size_t(i)+dst_offset] = src_buffer.get()[vcl_size_t(i) + src_offset];
+  detail::copy_bytes(dst_buffer.get() + dst_offset, src_buffer.get() + src_offset, bytes_to_copy);
 }
 
 /** @brief Writes data from main RAM identified by 'ptr' to the buffer identified by 'dst_buffer'
@@ -136,11 +597,7 @@ inline void memory_write(handle_type & dst_buffer,
 {
   assert( (dst_buffer.get() != NULL) && bool("Memory not initialized!"));
 
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long i=0; i<long(bytes_to_copy); ++i)
-    dst_buffer.get()[vcl_size_t(i)+dst_offset] = static_cast<const char *>(ptr)[i];
+  detail::copy_bytes(dst_buffer.get() + dst_offset, static_cast<const char *>(ptr), bytes_to_copy);
 }
 
 /** @brief Reads data from a buffer back to main RAM.
@@ -158,11 +615,7 @@ inline void memory_read(handle_type const & src_buffer,
 {
   assert( (src_buffer.get() != NULL) && bool("Memory not initialized!"));
 
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long i=0; i<long(bytes_to_copy); ++i)
-    static_cast<char *>(ptr)[i] = src_buffer.get()[vcl_size_t(i)+src_offset];
+  detail::copy_bytes(static_cast<char *>(ptr), src_buffer.get() + src_offset, bytes_to_copy);
 }
 
 }
@@ -24,7 +24,10 @@
 
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
+#include "viennacl/linalg/detail/fft_convolution_cache.hpp"
 
 #include "viennacl/linalg/circulant_matrix_operations.hpp"
 
@@ -71,6 +74,7 @@ public:
   void resize(vcl_size_t sz, bool preserve = true)
   {
     elements_.resize(sz, preserve);
+    convolution_cache_.invalidate();
   }
 
   /** @brief Returns the OpenCL handle
@@ -82,10 +86,15 @@ public:
   /**
     * @brief Returns an internal viennacl::vector, which represents a circulant matrix elements
     *
+    * Non-const access discards the cached transform of the entries used for matrix-vector products,
+    * hence call elements() again after changing entries instead of keeping the reference across products.
     */
-  viennacl::vector<NumericT, AlignmentV> & elements() { return elements_; }
+  viennacl::vector<NumericT, AlignmentV> & elements() { convolution_cache_.invalidate(); return elements_; }
   viennacl::vector<NumericT, AlignmentV> const & elements() const { return elements_; }
 
+  /** @brief Returns the cached transform of the entries and the work vectors used for matrix-vector products. Call invalidate() on it after changing entries through a reference or an entry proxy kept across products. */
+  viennacl::linalg::detail::fft_convolution_cache<NumericT> & convolution_cache() const { return convolution_cache_; }
+
   /**
     * @brief Returns the number of rows of the matrix
     */
@@ -118,6 +127,7 @@ public:
 
     while (index < 0)
       index += static_cast<long>(size1());
+    convolution_cache_.invalidate();
     return elements_[static_cast<vcl_size_t>(index)];
   }
 
@@ -130,6 +140,7 @@ public:
   circulant_matrix<NumericT, AlignmentV>& operator +=(circulant_matrix<NumericT, AlignmentV>& that)
   {
     elements_ += that.elements();
+    convolution_cache_.invalidate();
     return *this;
   }
 
@@ -138,6 +149,7 @@ private:
   circulant_matrix & operator=(circulant_matrix const & t);
 
   viennacl::vector<NumericT, AlignmentV> elements_;
+  mutable viennacl::linalg::detail::fft_convolution_cache<NumericT> convolution_cache_;
 };
 
 /** @brief Copies a circulant matrix from the std::vector to the OpenCL device (either GPU or multi-core CPU)
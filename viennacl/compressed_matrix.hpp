@@ -26,6 +26,7 @@
 #include <list>
 #include <map>
 #include "viennacl/forwards.h"
+#include "viennacl/detail/csr_partition.hpp"
 #include "viennacl/vector.hpp"
 
 #include "viennacl/linalg/sparse_matrix_operations.hpp"
@@ -617,7 +618,7 @@ public:
   typedef vcl_size_t                                                                                 size_type;
 
   /** @brief Default construction of a compressed matrix. No memory is allocated */
-  compressed_matrix() : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0) {}
+  compressed_matrix() : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation()) {}
 
   /** @brief Construction of a compressed matrix with the supplied number of rows and columns. If the number of nonzeros is positive, memory is allocated
       *
@@ -627,7 +628,7 @@ public:
       * @param ctx      Optional context in which the matrix is created (one out of multiple OpenCL contexts, CUDA, host)
       */
   explicit compressed_matrix(vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros = 0, viennacl::context ctx = viennacl::context())
-    : rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
+    : rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation())
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -663,7 +664,7 @@ public:
       * @param ctx      Context in which to create the matrix
       */
   explicit compressed_matrix(vcl_size_t rows, vcl_size_t cols, viennacl::context ctx)
-    : rows_(rows), cols_(cols), nonzeros_(0), row_block_num_(0)
+    : rows_(rows), cols_(cols), nonzeros_(0), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation())
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -691,7 +692,7 @@ public:
     *
     * This is useful if you want to want to populate e.g. a viennacl::compressed_matrix<> on the host with copy(), but the default backend is OpenCL.
     */
-  explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0)
+  explicit compressed_matrix(viennacl::context ctx) : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation())
   {
     row_buffer_.switch_active_handle_id(ctx.memory_type());
     col_buffer_.switch_active_handle_id(ctx.memory_type());
@@ -721,7 +722,7 @@ public:
     */
   explicit compressed_matrix(unsigned int *mem_row_buffer, unsigned int *mem_col_buffer, NumericT *mem_elements, viennacl::memory_types mem_type,
                              vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros) :
-    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
+    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation())
   {
     row_buffer_.switch_active_handle_id(mem_type);
     col_buffer_.switch_active_handle_id(mem_type);
@@ -774,7 +775,7 @@ public:
     */
   explicit compressed_matrix(cl_mem mem_row_buffer, cl_mem mem_col_buffer, cl_mem mem_elements,
                              vcl_size_t rows, vcl_size_t cols, vcl_size_t nonzeros) :
-    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0)
+    rows_(rows), cols_(cols), nonzeros_(nonzeros), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation())
   {
     row_buffer_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
     row_buffer_.opencl_handle() = mem_row_buffer;
@@ -798,7 +799,7 @@ public:
 
   /** @brief Assignment a compressed matrix from the product of two compressed_matrix objects (C = A * B). */
   compressed_matrix(matrix_expression<const compressed_matrix, const compressed_matrix, op_prod> const & proxy)
-    : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0)
+    : rows_(0), cols_(0), nonzeros_(0), row_block_num_(0), row_buffer_generation_(detail::next_row_buffer_generation())
   {
     viennacl::context ctx = viennacl::traits::context(proxy.lhs());
 
@@ -821,6 +822,12 @@ public:
     generate_row_block_information();
   }
 
+  /** @brief Copy constructor. Shares the buffers with 'other', but not its cached host work partitions, which may be added to concurrently by a product with 'other'. */
+  compressed_matrix(compressed_matrix const & other)
+    : rows_(other.rows_), cols_(other.cols_), nonzeros_(other.nonzeros_), row_block_num_(other.row_block_num_),
+      row_buffer_(other.row_buffer_), row_blocks_(other.row_blocks_), col_buffer_(other.col_buffer_), elements_(other.elements_),
+      row_buffer_generation_(detail::next_row_buffer_generation()) {}
+
   /** @brief Assignment a compressed matrix from possibly another memory domain. */
   compressed_matrix & operator=(compressed_matrix const & other)
   {
@@ -836,6 +843,7 @@ public:
     viennacl::backend::typesafe_memory_copy<unsigned int>(other.col_buffer_, col_buffer_);
     viennacl::backend::typesafe_memory_copy<unsigned int>(other.row_blocks_, row_blocks_);
     viennacl::backend::typesafe_memory_copy<NumericT>(other.elements_, elements_);
+    invalidate_host_partition();
 
     return *this;
   }
@@ -944,6 +952,7 @@ public:
         // faster version without initializing memory:
         //viennacl::backend::memory_create(row_buffer_, viennacl::backend::typesafe_host_array<unsigned int>().element_size() * (new_size1 + 1), viennacl::traits::context(row_buffer_));
         nonzeros_ = 0;
+        invalidate_host_partition();
       }
       else
       {
@@ -1001,6 +1010,7 @@ public:
     viennacl::backend::memory_create(elements_,   sizeof(NumericT) * 1,                         viennacl::traits::context(elements_), &(host_elements[0]));
 
     nonzeros_ = 0;
+    invalidate_host_partition();
   }
 
   /** @brief Returns a reference to the (i,j)-th entry of the sparse matrix. If (i,j) does not exist (zero), it is inserted (slow!) */
@@ -1046,8 +1056,8 @@ public:
   /** @brief  Returns the OpenCL handle to the matrix entry array */
   const handle_type & handle() const { return elements_; }
 
-  /** @brief  Returns the OpenCL handle to the row index array */
-  handle_type & handle1() { return row_buffer_; }
+  /** @brief  Returns the OpenCL handle to the row index array. Since the row indices may be modified through the handle, the cached host work partition is invalidated. */
+  handle_type & handle1() { invalidate_host_partition(); return row_buffer_; }
   /** @brief  Returns the OpenCL handle to the column index array */
   handle_type & handle2() { return col_buffer_; }
   /** @brief  Returns the OpenCL handle to the row block array */
@@ -1061,6 +1071,7 @@ public:
     */
   void switch_memory_context(viennacl::context new_ctx)
   {
+    invalidate_host_partition();
     viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
     viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
     viennacl::backend::switch_memory_context<unsigned int>(row_blocks_, new_ctx);
@@ -1073,7 +1084,20 @@ public:
     return row_buffer_.get_active_handle_id();
   }
 
+  /** @brief Returns the cached work partitions used by the host backend. Not intended for direct use. */
+  detail::csr_host_partition_cache & host_partitions() const { return host_partitions_; }
+
+  /** @brief Returns a counter which changes whenever the row index array may have been modified. Values are unique among all matrices. Used for validating the cached host work partition and sparse matrix-matrix product plans. */
+  vcl_size_t row_buffer_generation() const { return row_buffer_generation_; }
+
 private:
+  /** @brief Discards the cached host work partition and marks the row index array as modified. Buffers obtained from the memory pool may reuse the address of a previous buffer, hence the generation counter. */
+  void invalidate_host_partition()
+  {
+    host_partitions_.clear();
+    row_buffer_generation_ = detail::next_row_buffer_generation();
+  }
+
 
   /** @brief Helper function for accessing the element (i,j) of the matrix. */
   vcl_size_t element_index(vcl_size_t i, vcl_size_t j)
@@ -1108,6 +1132,8 @@ public:
 
     viennacl::backend::typesafe_host_array<unsigned int> row_blocks(row_buffer_, rows_ + 1);
 
+    invalidate_host_partition();
+
     vcl_size_t num_entries_in_current_batch = 0;
 
     const vcl_size_t shared_mem_size = 1024; // number of column indices loaded to shared memory, number of floating point values loaded to shared memory
@@ -1139,10 +1165,6 @@ public:
 
   }
 
-private:
-  // /** @brief Copy constructor is by now not available. */
-  //compressed_matrix(compressed_matrix const &);
-
 private:
 
   vcl_size_t rows_;
@@ -1153,6 +1175,8 @@ private:
   handle_type row_blocks_;
   handle_type col_buffer_;
   handle_type elements_;
+  vcl_size_t row_buffer_generation_;
+  mutable detail::csr_host_partition_cache host_partitions_;
 };
 
 /** @brief Output stream support for compressed_matrix. Output format is same as MATLAB, Octave, or SciPy
@@ -0,0 +1,115 @@
+#ifndef VIENNACL_DETAIL_CSR_PARTITION_HPP_
+#define VIENNACL_DETAIL_CSR_PARTITION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file  viennacl/detail/csr_partition.hpp
+    @brief Definition of the cached host work partitions of compressed_matrix.
+*/
+
+#include <list>
+#include <vector>
+#include "viennacl/forwards.h"
+#include "viennacl/backend/cpu_ram.hpp"
+
+namespace viennacl
+{
+namespace detail
+{
+
+  /** @brief Work partition of a sparse matrix-vector product with a compressed_matrix among the threads of the host backend.
+    *
+    * Computed on first use by the host-based kernels and cached on the matrix. Invalidated whenever the row index array of the matrix may have been modified,
+    * which is tracked by a generation counter of the matrix (the address of the row array is not sufficient, since pooled buffers are reused).
+    */
+  struct csr_host_partition
+  {
+    csr_host_partition() : num_parts(0), rows(0), nonzeros(0), generation(0), merge_path(false) {}
+
+    vcl_size_t  num_parts;    // number of threads the partition was computed for
+    vcl_size_t  rows;         // number of rows at the time the partition was computed
+    vcl_size_t  nonzeros;     // number of nonzeros at the time the partition was computed
+    vcl_size_t  generation;   // generation counter of the row array the partition was computed from
+    bool        merge_path;   // if true, rows may be split among threads and 'nnz_start' is used
+
+    std::vector<vcl_size_t> row_start;  // first row of each part, num_parts + 1 entries
+    std::vector<vcl_size_t> nnz_start;  // first nonzero of each part, num_parts + 1 entries
+  };
+
+  /** @brief Returns a new value for the generation counter of the row array of a compressed_matrix. Values are unique among all matrices, so a (matrix, generation) pair never repeats. Thread-safe. */
+  inline vcl_size_t next_row_buffer_generation()
+  {
+    static viennacl::backend::cpu_ram::detail::pool_mutex m;
+    static vcl_size_t generation = 0;
+
+    viennacl::backend::cpu_ram::detail::pool_lock guard(m);
+    return ++generation;
+  }
+
+  /** @brief The work partitions of a compressed_matrix, one per number of threads.
+    *
+    * A partition is never modified once it has been added, so the kernels use it through a const reference while other threads of a product with the same const matrix
+    * look up or add partitions for other numbers of threads. Lookups and additions are guarded by a mutex of the matrix.
+    * Partitions are only removed by clear(), which is called by the non-const members of the matrix, or if they are stale (the row array changed in between).
+    * Copies start without partitions, so copying a matrix never reads partitions which are being added concurrently.
+    */
+  class csr_host_partition_cache
+  {
+  public:
+    csr_host_partition_cache() {}
+    csr_host_partition_cache(csr_host_partition_cache const &) {}
+    csr_host_partition_cache & operator=(csr_host_partition_cache const &) { clear(); return *this; }
+
+    viennacl::backend::cpu_ram::detail::pool_mutex & mutex() const { return mutex_; }
+
+    /** @brief Returns the partition for 'num_parts' threads of the row array with the given state, or NULL. Stale partitions are removed. Must be called with mutex() locked. */
+    csr_host_partition const * find(vcl_size_t num_parts, vcl_size_t rows, vcl_size_t nonzeros, vcl_size_t generation)
+    {
+      for (std::list<csr_host_partition>::iterator it = partitions_.begin(); it != partitions_.end(); )
+      {
+        if (it->rows != rows || it->nonzeros != nonzeros || it->generation != generation)
+          it = partitions_.erase(it);
+        else if (it->num_parts == num_parts)
+          return &(*it);
+        else
+          ++it;
+      }
+      return NULL;
+    }
+
+    /** @brief Adds an empty partition to be filled by the caller. Must be called with mutex() locked. */
+    csr_host_partition & insert()
+    {
+      partitions_.push_back(csr_host_partition());
+      return partitions_.back();
+    }
+
+    /** @brief Removes all partitions. Must not run concurrently with products with the matrix. */
+    void clear() { partitions_.clear(); }
+
+    vcl_size_t size() const { return partitions_.size(); }
+
+  private:
+    mutable viennacl::backend::cpu_ram::detail::pool_mutex mutex_;
+    std::list<csr_host_partition> partitions_;
+  };
+
+} //namespace detail
+} //namespace viennacl
+
+#endif
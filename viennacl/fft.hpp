@@ -217,6 +217,68 @@ void ifft(viennacl::vector<NumericT, AlignmentV>& input,
   viennacl::linalg::normalize(output);
 }
 
+/**
+ * @brief Real-to-complex 1-D Fourier transformation.
+ *
+ * Transforms batch_num real sequences stored consecutively in 'input' and writes the size/2+1 non-redundant complex entries (interleaved) of each spectrum to 'output'.
+ *
+ * @param input      Input vector with batch_num real sequences.
+ * @param output     Output vector of size batch_num * 2 * (size/2+1), where size = input.size() / batch_num.
+ * @param batch_num  Number of items in batch.
+ */
+template<class NumericT, unsigned int AlignmentV>
+void rfft(viennacl::vector<NumericT, AlignmentV> const & input,
+          viennacl::vector<NumericT, AlignmentV>       & output, vcl_size_t batch_num = 1)
+{
+  vcl_size_t size = input.size() / batch_num;
+  assert(output.size() == batch_num * 2 * (size / 2 + 1) && bool("Size mismatch"));
+  viennacl::linalg::real_fft(input, output, size, batch_num);
+}
+
+/**
+ * @brief Complex-to-real inverse 1-D Fourier transformation, the inverse of rfft().
+ *
+ * @param input      Input vector with batch_num half-spectra of size/2+1 complex entries each.
+ * @param output     Output vector with batch_num real sequences of length size = output.size() / batch_num.
+ * @param batch_num  Number of items in batch.
+ */
+template<class NumericT, unsigned int AlignmentV>
+void irfft(viennacl::vector<NumericT, AlignmentV> const & input,
+           viennacl::vector<NumericT, AlignmentV>       & output, vcl_size_t batch_num = 1)
+{
+  vcl_size_t size = output.size() / batch_num;
+  assert(input.size() == batch_num * 2 * (size / 2 + 1) && bool("Size mismatch"));
+  viennacl::linalg::inverse_real_fft(input, output, size, batch_num);
+  output /= NumericT(size);
+}
+
+/**
+ * @brief Real-to-complex 2-D Fourier transformation.
+ *
+ * @param input      Real M x N input matrix.
+ * @param output     M x 2(N/2+1) output matrix holding the half-spectrum with interleaved real and imaginary parts.
+ */
+template<class NumericT, unsigned int AlignmentV>
+void rfft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & input,
+          viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & output)
+{
+  viennacl::linalg::real_fft(input, output);
+}
+
+/**
+ * @brief Complex-to-real inverse 2-D Fourier transformation, the inverse of the 2-D rfft().
+ *
+ * @param input      M x 2(N/2+1) matrix holding the half-spectrum.
+ * @param output     Real M x N output matrix.
+ */
+template<class NumericT, unsigned int AlignmentV>
+void irfft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & input,
+           viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & output)
+{
+  viennacl::linalg::inverse_real_fft(input, output);
+  output /= NumericT(output.size1() * output.size2());
+}
+
 namespace linalg
 {
   /**
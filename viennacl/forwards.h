@@ -844,6 +844,18 @@ namespace viennacl
     prod_impl(const SparseMatrixType & mat,
               const vector<SCALARTYPE, ALIGNMENT> & vec);
 
+    template<typename SparseMatrixType, class ScalarType>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
+    prod_impl(const SparseMatrixType & sp_mat,
+              const matrix_base<ScalarType> & d_mat,
+                    matrix_base<ScalarType> & result);
+
+    template<typename SparseMatrixType, class ScalarType>
+    typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
+    prod_impl(const SparseMatrixType & sp_mat,
+              const matrix_expression<const matrix_base<ScalarType>, const matrix_base<ScalarType>, op_trans> & d_mat,
+                    matrix_base<ScalarType> & result);
+
     // forward definition of summation routines for matrices:
 
     template<typename NumericT>
@@ -893,6 +905,9 @@ namespace viennacl
     //preconditioner tags
     class ilut_tag;
 
+    template<typename NumericT>
+    class tsqr_factors;
+
     /** @brief A tag class representing the use of no preconditioner */
     class no_precond
     {
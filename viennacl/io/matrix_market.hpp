@@ -21,6 +21,9 @@
 
 /** @file matrix_market.hpp
     @brief A reader and writer for the matrix market format is implemented here
+
+    Sparse matrices of type compressed_matrix are read by a dedicated parallel reader: The file is mapped into memory (mmap() on POSIX systems),
+    split into chunks of lines which are parsed concurrently, and the entries are bucket-sorted by row directly into the CSR arrays.
 */
 
 #include <algorithm>
@@ -31,10 +34,25 @@
 #include <vector>
 #include <map>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include "viennacl/forwards.h"
 #include "viennacl/tools/adapter.hpp"
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/fill.hpp"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace viennacl
 {
 namespace io
@@ -83,6 +101,762 @@ namespace detail
   }
 
 
+  /** @brief Read-only view of the contents of a file. The file is mapped into memory on POSIX systems and read into a buffer otherwise. */
+  class mm_mapped_file
+  {
+  public:
+    explicit mm_mapped_file(const char * file) : data_(NULL), size_(0), mapped_(false)
+    {
+#ifndef _WIN32
+      int fd = ::open(file, O_RDONLY);
+      if (fd < 0)
+        return;
+
+      struct stat file_stat;
+      if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+      {
+        void * ptr = ::mmap(NULL, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED)
+        {
+          data_   = static_cast<const char *>(ptr);
+          size_   = static_cast<vcl_size_t>(file_stat.st_size);
+          mapped_ = true;
+        }
+      }
+      ::close(fd);
+      if (mapped_)
+        return;
+#endif
+      std::ifstream reader(file, std::ios::in | std::ios::binary);
+      if (!reader)
+        return;
+      reader.seekg(0, std::ios::end);
+      std::streamoff file_size = reader.tellg();
+      reader.seekg(0, std::ios::beg);
+      if (file_size <= 0)
+        return;
+      buffer_.resize(static_cast<vcl_size_t>(file_size));
+      reader.read(&(buffer_[0]), file_size);
+      data_ = &(buffer_[0]);
+      size_ = buffer_.size();
+    }
+
+    ~mm_mapped_file()
+    {
+#ifndef _WIN32
+      if (mapped_)
+        ::munmap(const_cast<char *>(data_), size_);
+#endif
+    }
+
+    bool good() const { return data_ != NULL; }
+    const char * begin() const { return data_; }
+    const char * end()   const { return data_ + size_; }
+
+  private:
+    mm_mapped_file(mm_mapped_file const &);
+    void operator=(mm_mapped_file const &);
+
+    const char * data_;
+    vcl_size_t size_;
+    bool mapped_;
+    std::vector<char> buffer_;
+  };
+
+  inline bool mm_is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+  inline const char * mm_line_end(const char * p, const char * end)
+  {
+    const char * pos = static_cast<const char *>(std::memchr(p, '\n', static_cast<vcl_size_t>(end - p)));
+    return pos ? pos : end;
+  }
+
+  /** @brief Parses a non-negative integer and advances p. Returns false if there is no number at p or if the number exceeds the range of vcl_size_t. */
+  inline bool mm_parse_index(const char * & p, const char * end, vcl_size_t & value)
+  {
+    while (p != end && mm_is_blank(*p))
+      ++p;
+
+    const char * start = p;
+    vcl_size_t result = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+      vcl_size_t digit = static_cast<vcl_size_t>(*p - '0');
+      if (result > (std::numeric_limits<vcl_size_t>::max() - digit) / 10)
+        return false;
+      result = 10 * result + digit;
+      ++p;
+    }
+    value = result;
+    return p != start && (p == end || mm_is_blank(*p) || *p == '\n');
+  }
+
+  /** @brief Parses a floating point number and advances p. Returns false if there is no number at p.
+  *
+  * Decimal numbers whose significand fits into 53 bits and which have a decimal exponent of at most 22 in magnitude are converted exactly in double precision.
+  * All other numbers (long significands, large exponents, inf, nan) are passed on to strtod().
+  */
+  inline bool mm_parse_real(const char * & p, const char * end, double & value)
+  {
+    static const double powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    while (p != end && mm_is_blank(*p))
+      ++p;
+
+    const char * start = p;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+      negative = (*p == '-');
+      ++p;
+    }
+
+    vcl_size_t significand = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool exact = true;
+
+    for (bool fraction = false; p != end; ++p)
+    {
+      if (*p >= '0' && *p <= '9')
+      {
+        has_digits = true;
+        if (significant_digits < std::numeric_limits<vcl_size_t>::digits10)
+        {
+          significand = 10 * significand + static_cast<vcl_size_t>(*p - '0');
+          if (significand > 0)
+            ++significant_digits;
+          if (fraction)
+            --exponent;
+        }
+        else if (*p != '0')
+          exact = false;
+        else if (!fraction)
+          ++exponent;
+      }
+      else if (*p == '.' && !fraction)
+        fraction = true;
+      else
+        break;
+    }
+
+    if (has_digits && p != end && (*p == 'e' || *p == 'E'))
+    {
+      ++p;
+      bool negative_exponent = false;
+      if (p != end && (*p == '-' || *p == '+'))
+      {
+        negative_exponent = (*p == '-');
+        ++p;
+      }
+      if (p == end || *p < '0' || *p > '9')
+        return false;
+
+      int exponent_value = 0;
+      for (; p != end && *p >= '0' && *p <= '9'; ++p)
+        if (exponent_value < 100000)
+          exponent_value = 10 * exponent_value + (*p - '0');
+      exponent += negative_exponent ? -exponent_value : exponent_value;
+    }
+
+    if (has_digits && exact && ((significand >> 26) >> 27) == 0 && exponent >= -22 && exponent <= 22)
+    {
+      double result = static_cast<double>(significand);
+      result = (exponent < 0) ? result / powers_of_ten[-exponent] : result * powers_of_ten[exponent];
+      value = negative ? -result : result;
+      return p == end || mm_is_blank(*p) || *p == '\n';
+    }
+
+    // slow path: copy the token and convert with strtod()
+    p = start;
+    while (p != end && !mm_is_blank(*p) && *p != '\n')
+      ++p;
+
+    char token[64];
+    vcl_size_t token_length = static_cast<vcl_size_t>(p - start);
+    if (token_length == 0 || token_length >= sizeof(token))
+      return false;
+    std::memcpy(token, start, token_length);
+    token[token_length] = 0;
+
+    char * token_end;
+    value = std::strtod(token, &token_end);
+    return token_end == token + token_length;
+  }
+
+  /** @brief Splits the range [begin, end) into chunks of complete lines. chunk_begin has num_chunks + 1 entries afterwards. */
+  inline void mm_split_lines(const char * begin, const char * end, std::vector<const char *> & chunk_begin)
+  {
+    vcl_size_t num_chunks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_chunks = 4 * static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+    vcl_size_t size = static_cast<vcl_size_t>(end - begin);
+    num_chunks = std::max<vcl_size_t>(1, std::min<vcl_size_t>(num_chunks, size / (1 << 16)));
+
+    chunk_begin.resize(num_chunks + 1);
+    chunk_begin[0] = begin;
+    for (vcl_size_t i = 1; i < num_chunks; ++i)
+    {
+      const char * pos = std::max(begin + i * (size / num_chunks), chunk_begin[i-1]);
+      pos = mm_line_end(pos, end);
+      chunk_begin[i] = (pos == end) ? end : pos + 1;
+    }
+    chunk_begin[num_chunks] = end;
+  }
+
+  /** @brief Error state of a chunk of lines parsed by one thread. */
+  struct mm_chunk_status
+  {
+    mm_chunk_status() : lines(0), entries(0), error_line(0) {}
+
+    vcl_size_t lines;         // number of lines in the chunk
+    vcl_size_t entries;       // number of matrix entries in the chunk
+    vcl_size_t error_line;    // line (relative to the chunk) of the first error
+    std::string error;        // empty if no error occurred
+  };
+
+  /** @brief Prints the first error of the chunks to std::cerr. Returns true if an error occurred. */
+  inline bool mm_report_error(std::vector<mm_chunk_status> const & status, vcl_size_t first_line, const char * file)
+  {
+    vcl_size_t line = first_line;
+    for (vcl_size_t i = 0; i < status.size(); ++i)
+    {
+      if (status[i].error.size() > 0)
+      {
+        std::cerr << "Error in file " << file << " at line " << line + status[i].error_line << ": " << status[i].error << std::endl;
+        return true;
+      }
+      line += status[i].lines;
+    }
+    return false;
+  }
+
+  /** @brief Returns the total number of lines of the file, given the number of header lines. */
+  inline long mm_count_lines(std::vector<mm_chunk_status> const & status, vcl_size_t header_lines)
+  {
+    vcl_size_t lines = header_lines;
+    for (vcl_size_t i = 0; i < status.size(); ++i)
+      lines += status[i].lines;
+    return static_cast<long>(lines);
+  }
+
+  /** @brief Compares two entries of a CSR row by column index. */
+  template<typename NumericT>
+  struct mm_column_less
+  {
+    bool operator()(std::pair<unsigned int, NumericT> const & a, std::pair<unsigned int, NumericT> const & b) const { return a.first < b.first; }
+  };
+
+  /** @brief Reads a matrix in MatrixMarket format into CSR arrays.
+  *
+  * Coordinate files are parsed in three parallel passes over chunks of lines:
+  * The first pass counts the entries of each chunk per bucket of consecutive rows, the second pass parses the entries and scatters them to their buckets,
+  * and the third pass sorts each bucket by rows (counting sort) into the CSR arrays. Entries within a row are then sorted by column.
+  * Duplicate entries are resolved in favor of the entry appearing last in the file, as for the generic reader.
+  * The number of entries in the file must match the number of nonzeros given in the size line, and the dimensions must fit into the unsigned int indices of the CSR arrays.
+  * Files in array format are parsed into a dense buffer first, zeros are not stored.
+  *
+  * @return The number of lines in the file, or zero if the file could not be parsed.
+  */
+  template<typename NumericT>
+  long read_matrix_market_csr(const char * file, long index_base,
+                              std::vector<unsigned int> & row_buffer,
+                              std::vector<unsigned int> & col_buffer,
+                              std::vector<NumericT> & elements,
+                              vcl_size_t & rows, vcl_size_t & cols)
+  {
+    mm_mapped_file mapped_file(file);
+    if (!mapped_file.good())
+    {
+      std::cerr << "ViennaCL: Matrix Market Reader: Cannot open file " << file << std::endl;
+      return 0;
+    }
+
+    //
+    // header:
+    //
+    const char * p   = mapped_file.begin();
+    const char * end = mapped_file.end();
+    const char * line_end = mm_line_end(p, end);
+    vcl_size_t linenum = 1;
+
+    std::stringstream header(std::string(p, line_end));
+    std::string token[5];
+    header >> token[0] >> token[1] >> token[2] >> token[3] >> token[4];
+    for (int i = 0; i < 5; ++i)
+      tolower(token[i]);
+
+    if (token[0] != "%%matrixmarket" || token[1] != "matrix")
+    {
+      std::cerr << "Error in file " << file << " at line 1: Expected '%%MatrixMarket matrix', got '" << std::string(p, line_end) << "'" << std::endl;
+      return 0;
+    }
+
+    bool dense_format = (token[2] == "array");
+    if (!dense_format && token[2] != "coordinate")
+    {
+      std::cerr << "Error in file " << file << " at line 1: Expected 'array' or 'coordinate', got '" << token[2] << "'" << std::endl;
+      return 0;
+    }
+
+    bool pattern_matrix = (token[3] == "pattern");
+    if (!pattern_matrix && token[3] != "real" && token[3] != "integer" && token[3] != "complex")
+    {
+      std::cerr << "Error in file " << file << ": The MatrixMarket reader provided with ViennaCL supports only real valued floating point arithmetic or pattern type matrices." << std::endl;
+      return 0;
+    }
+
+    bool symmetric = (token[4] == "symmetric");
+    if (!symmetric && token[4] != "general")
+    {
+      std::cerr << "Error in file " << file << ": The MatrixMarket reader provided with ViennaCL supports only general or symmetric matrices." << std::endl;
+      return 0;
+    }
+
+    // skip comments and get size line:
+    vcl_size_t nnz = 0;
+    for (p = line_end; ; )
+    {
+      if (p == end)
+      {
+        std::cerr << "Error in file " << file << ": Could not get matrix dimensions" << std::endl;
+        return 0;
+      }
+      ++p;
+      ++linenum;
+      line_end = mm_line_end(p, end);
+
+      const char * q = p;
+      while (q != line_end && mm_is_blank(*q))
+        ++q;
+      if (q == line_end || *q == '%')
+      {
+        p = line_end;
+        continue;
+      }
+
+      if (!mm_parse_index(q, line_end, rows) || !mm_parse_index(q, line_end, cols) || (!dense_format && !mm_parse_index(q, line_end, nnz)))
+      {
+        std::cerr << "Error in file " << file << ": Could not get matrix dimensions in line " << linenum << std::endl;
+        return 0;
+      }
+      p = (line_end == end) ? end : line_end + 1;
+      break;
+    }
+
+    // row and column indices are stored as unsigned int:
+    if (rows > std::numeric_limits<unsigned int>::max() || cols > std::numeric_limits<unsigned int>::max())
+    {
+      std::cerr << "Error in file " << file << ": Matrix dimensions " << rows << " x " << cols << " exceed the range of the index type in line " << linenum << std::endl;
+      return 0;
+    }
+
+    if (rows == 0 || cols == 0)
+    {
+      if (nnz > 0)
+      {
+        std::cerr << "Error in file " << file << ": Expected no entries for a matrix of size " << rows << " x " << cols << ", got " << nnz << " nonzeros in line " << linenum << std::endl;
+        return 0;
+      }
+      row_buffer.assign(rows + 1, 0);
+      col_buffer.clear();
+      elements.clear();
+      return static_cast<long>(linenum);
+    }
+
+    std::vector<const char *> chunk_begin;
+    mm_split_lines(p, end, chunk_begin);
+    long num_chunks = static_cast<long>(chunk_begin.size() - 1);
+    std::vector<mm_chunk_status> status(chunk_begin.size() - 1);
+
+    if (dense_format)
+    {
+      //
+      // array format: count the values of each chunk, then parse the values into a column-major dense buffer
+      //
+      std::vector<vcl_size_t> chunk_offset(chunk_begin.size(), 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic)
+#endif
+      for (long chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        vcl_size_t num_values = 0;
+        for (const char * q = chunk_begin[static_cast<vcl_size_t>(chunk)]; q < chunk_begin[static_cast<vcl_size_t>(chunk) + 1]; ++q)
+        {
+          const char * q_end = mm_line_end(q, chunk_begin[static_cast<vcl_size_t>(chunk) + 1]);
+          ++status[static_cast<vcl_size_t>(chunk)].lines;
+          while (q != q_end && mm_is_blank(*q))
+            ++q;
+          if (q != q_end && *q != '%')
+            ++num_values;
+          q = q_end;
+        }
+        chunk_offset[static_cast<vcl_size_t>(chunk) + 1] = num_values;
+      }
+
+      for (vcl_size_t i = 1; i < chunk_offset.size(); ++i)
+        chunk_offset[i] += chunk_offset[i-1];
+
+      vcl_size_t expected_values = symmetric ? cols * (cols + 1) / 2 : rows * cols;
+      if (symmetric && rows != cols)
+      {
+        std::cerr << "Error in file " << file << ": Symmetric matrix is not square" << std::endl;
+        return 0;
+      }
+      if (chunk_offset.back() != expected_values)
+      {
+        std::cerr << "Error in file " << file << ": Expected " << expected_values << " values, got " << chunk_offset.back() << std::endl;
+        return 0;
+      }
+
+      std::vector<NumericT> dense(rows * cols);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic)
+#endif
+      for (long chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        mm_chunk_status & chunk_status = status[static_cast<vcl_size_t>(chunk)];
+        const char * chunk_end = chunk_begin[static_cast<vcl_size_t>(chunk) + 1];
+
+        // position (row, col) of the first value of the chunk:
+        vcl_size_t index = chunk_offset[static_cast<vcl_size_t>(chunk)];
+        vcl_size_t col = 0;
+        if (symmetric)
+          for (; index >= rows - col; ++col)
+            index -= rows - col;
+        else
+        {
+          col    = index / rows;
+          index -= col * rows;
+        }
+        vcl_size_t row = symmetric ? col + index : index;
+
+        vcl_size_t line = 0;
+        for (const char * q = chunk_begin[static_cast<vcl_size_t>(chunk)]; q < chunk_end; ++q, ++line)
+        {
+          const char * q_end = mm_line_end(q, chunk_end);
+          while (q != q_end && mm_is_blank(*q))
+            ++q;
+          if (q != q_end && *q != '%')
+          {
+            double value;
+            if (!mm_parse_real(q, q_end, value))
+            {
+              chunk_status.error_line = line;
+              chunk_status.error = "Parse error for matrix entry";
+              break;
+            }
+            dense[col * rows + row] = static_cast<NumericT>(value);
+            if (symmetric)
+              dense[row * rows + col] = static_cast<NumericT>(value);
+
+            if (++row == rows)
+            {
+              ++col;
+              row = symmetric ? col : 0;
+            }
+          }
+          q = q_end;
+        }
+      }
+
+      if (mm_report_error(status, linenum + 1, file))
+        return 0;
+
+      // compress rows:
+      row_buffer.resize(rows + 1);
+      row_buffer[0] = 0;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long row = 0; row < static_cast<long>(rows); ++row)
+      {
+        unsigned int row_nnz = 0;
+        for (vcl_size_t col = 0; col < cols; ++col)
+          if (dense[col * rows + static_cast<vcl_size_t>(row)] != NumericT(0))
+            ++row_nnz;
+        row_buffer[static_cast<vcl_size_t>(row) + 1] = row_nnz;
+      }
+      for (vcl_size_t i = 1; i < row_buffer.size(); ++i)
+        row_buffer[i] += row_buffer[i-1];
+
+      col_buffer.resize(row_buffer[rows]);
+      elements.resize(row_buffer[rows]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long row = 0; row < static_cast<long>(rows); ++row)
+      {
+        vcl_size_t pos = row_buffer[static_cast<vcl_size_t>(row)];
+        for (vcl_size_t col = 0; col < cols; ++col)
+        {
+          NumericT value = dense[col * rows + static_cast<vcl_size_t>(row)];
+          if (value != NumericT(0))
+          {
+            col_buffer[pos] = static_cast<unsigned int>(col);
+            elements[pos]   = value;
+            ++pos;
+          }
+        }
+      }
+
+      return mm_count_lines(status, linenum);
+    }
+
+    //
+    // coordinate format, pass 1: count entries per chunk and bucket of rows
+    //
+    vcl_size_t num_buckets = std::max<vcl_size_t>(1, std::min<vcl_size_t>(rows, 8 * chunk_begin.size()));
+    vcl_size_t bucket_rows = (rows + num_buckets - 1) / std::max<vcl_size_t>(1, num_buckets);
+    num_buckets = rows > 0 ? (rows + bucket_rows - 1) / bucket_rows : 1;
+    std::vector<vcl_size_t> bucket_counts(static_cast<vcl_size_t>(num_chunks) * num_buckets, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      mm_chunk_status & chunk_status = status[static_cast<vcl_size_t>(chunk)];
+      vcl_size_t * counts = &(bucket_counts[static_cast<vcl_size_t>(chunk) * num_buckets]);
+      const char * chunk_end = chunk_begin[static_cast<vcl_size_t>(chunk) + 1];
+
+      for (const char * q = chunk_begin[static_cast<vcl_size_t>(chunk)]; q < chunk_end; ++q)
+      {
+        const char * q_end = mm_line_end(q, chunk_end);
+        ++chunk_status.lines;
+        while (q != q_end && mm_is_blank(*q))
+          ++q;
+        if (q != q_end && *q != '%')
+        {
+          vcl_size_t row, col;
+          if (!mm_parse_index(q, q_end, row) || !mm_parse_index(q, q_end, col))
+          {
+            chunk_status.error_line = chunk_status.lines - 1;
+            chunk_status.error = "Parse error for matrix row or column index";
+            break;
+          }
+          if (row < static_cast<vcl_size_t>(index_base) || row - static_cast<vcl_size_t>(index_base) >= rows
+              || col < static_cast<vcl_size_t>(index_base) || col - static_cast<vcl_size_t>(index_base) >= cols)
+          {
+            std::stringstream ss;
+            ss << "Index out of bounds: (" << row << ", " << col << ") (matrix dim: " << rows << " x " << cols << ")";
+            chunk_status.error_line = chunk_status.lines - 1;
+            chunk_status.error = ss.str();
+            break;
+          }
+          row -= static_cast<vcl_size_t>(index_base);
+          col -= static_cast<vcl_size_t>(index_base);
+
+          ++chunk_status.entries;
+          ++counts[row / bucket_rows];
+          if (symmetric && row != col)
+            ++counts[col / bucket_rows];
+        }
+        q = q_end;
+      }
+    }
+
+    if (mm_report_error(status, linenum + 1, file))
+      return 0;
+
+    vcl_size_t file_entries = 0;
+    for (vcl_size_t i = 0; i < status.size(); ++i)
+      file_entries += status[i].entries;
+    if (file_entries != nnz)
+    {
+      std::cerr << "Error in file " << file << ": Expected " << nnz << " entries, got " << file_entries << std::endl;
+      return 0;
+    }
+
+    // exclusive scan over buckets (outer) and chunks (inner) gives the write position of each chunk within each bucket:
+    std::vector<vcl_size_t> bucket_offset(num_buckets + 1, 0);
+    vcl_size_t num_entries = 0;
+    for (vcl_size_t b = 0; b < num_buckets; ++b)
+    {
+      bucket_offset[b] = num_entries;
+      for (vcl_size_t c = 0; c < static_cast<vcl_size_t>(num_chunks); ++c)
+      {
+        vcl_size_t count = bucket_counts[c * num_buckets + b];
+        bucket_counts[c * num_buckets + b] = num_entries;
+        num_entries += count;
+      }
+    }
+    bucket_offset[num_buckets] = num_entries;
+
+    if (num_entries > std::numeric_limits<unsigned int>::max())
+    {
+      std::cerr << "Error in file " << file << ": Number of nonzeros exceeds the range of the index type" << std::endl;
+      return 0;
+    }
+
+    //
+    // pass 2: parse entries and scatter them to their buckets
+    //
+    std::vector<unsigned int> coo_rows(num_entries);
+    std::vector<unsigned int> coo_cols(num_entries);
+    std::vector<NumericT>     coo_values(num_entries);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      mm_chunk_status & chunk_status = status[static_cast<vcl_size_t>(chunk)];
+      vcl_size_t * offsets = &(bucket_counts[static_cast<vcl_size_t>(chunk) * num_buckets]);
+      const char * chunk_end = chunk_begin[static_cast<vcl_size_t>(chunk) + 1];
+
+      vcl_size_t line = 0;
+      for (const char * q = chunk_begin[static_cast<vcl_size_t>(chunk)]; q < chunk_end; ++q, ++line)
+      {
+        const char * q_end = mm_line_end(q, chunk_end);
+        while (q != q_end && mm_is_blank(*q))
+          ++q;
+        if (q != q_end && *q != '%')
+        {
+          vcl_size_t row = 0, col = 0;
+          double value = 1.0;
+          if (!mm_parse_index(q, q_end, row) || !mm_parse_index(q, q_end, col))
+          {
+            chunk_status.error_line = line;
+            chunk_status.error = "Parse error for matrix row or column index";
+            break;
+          }
+          row -= static_cast<vcl_size_t>(index_base);
+          col -= static_cast<vcl_size_t>(index_base);
+
+          // value for pattern matrices is implicitly 1. For complex matrices, only the real part is read.
+          if (!pattern_matrix && !mm_parse_real(q, q_end, value))
+          {
+            chunk_status.error_line = line;
+            chunk_status.error = "Parse error for matrix entry";
+            break;
+          }
+
+          vcl_size_t pos = offsets[row / bucket_rows]++;
+          coo_rows[pos]   = static_cast<unsigned int>(row);
+          coo_cols[pos]   = static_cast<unsigned int>(col);
+          coo_values[pos] = static_cast<NumericT>(value);
+
+          if (symmetric && row != col)
+          {
+            pos = offsets[col / bucket_rows]++;
+            coo_rows[pos]   = static_cast<unsigned int>(col);
+            coo_cols[pos]   = static_cast<unsigned int>(row);
+            coo_values[pos] = static_cast<NumericT>(value);
+          }
+        }
+        q = q_end;
+      }
+    }
+
+    if (mm_report_error(status, linenum + 1, file))
+      return 0;
+
+    //
+    // pass 3: counting sort of each bucket by rows, then sort each row by columns
+    //
+    row_buffer.resize(rows + 1);
+    col_buffer.resize(num_entries);
+    elements.resize(num_entries);
+    std::vector<unsigned int> row_nnz(rows);
+    bool has_duplicates = false;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(||: has_duplicates)
+#endif
+    for (long bucket = 0; bucket < static_cast<long>(num_buckets); ++bucket)
+    {
+      vcl_size_t row_start = static_cast<vcl_size_t>(bucket) * bucket_rows;
+      vcl_size_t row_stop  = std::min(row_start + bucket_rows, rows);
+
+      std::vector<vcl_size_t> row_pos(row_stop - row_start, 0);
+      for (vcl_size_t i = bucket_offset[static_cast<vcl_size_t>(bucket)]; i < bucket_offset[static_cast<vcl_size_t>(bucket) + 1]; ++i)
+        ++row_pos[coo_rows[i] - row_start];
+
+      vcl_size_t offset = bucket_offset[static_cast<vcl_size_t>(bucket)];
+      for (vcl_size_t row = row_start; row < row_stop; ++row)
+      {
+        vcl_size_t count = row_pos[row - row_start];
+        row_buffer[row] = static_cast<unsigned int>(offset);
+        row_pos[row - row_start] = offset;
+        offset += count;
+      }
+
+      for (vcl_size_t i = bucket_offset[static_cast<vcl_size_t>(bucket)]; i < bucket_offset[static_cast<vcl_size_t>(bucket) + 1]; ++i)
+      {
+        vcl_size_t pos = row_pos[coo_rows[i] - row_start]++;
+        col_buffer[pos] = coo_cols[i];
+        elements[pos]   = coo_values[i];
+      }
+
+      // sort rows by column index (stable, so that the last duplicate in the file wins):
+      std::vector<std::pair<unsigned int, NumericT> > row_entries;
+      for (vcl_size_t row = row_start; row < row_stop; ++row)
+      {
+        vcl_size_t row_begin = row_buffer[row];
+        vcl_size_t row_end   = row_pos[row - row_start];
+
+        bool sorted = true;
+        for (vcl_size_t i = row_begin + 1; i < row_end; ++i)
+          if (col_buffer[i] <= col_buffer[i-1])
+          {
+            sorted = false;
+            break;
+          }
+
+        if (!sorted)
+        {
+          row_entries.resize(row_end - row_begin);
+          for (vcl_size_t i = row_begin; i < row_end; ++i)
+            row_entries[i - row_begin] = std::make_pair(col_buffer[i], elements[i]);
+          std::stable_sort(row_entries.begin(), row_entries.end(), mm_column_less<NumericT>());
+
+          vcl_size_t pos = row_begin;
+          for (vcl_size_t i = 0; i < row_entries.size(); ++i)
+          {
+            if (i + 1 < row_entries.size() && row_entries[i + 1].first == row_entries[i].first)
+              continue;
+            col_buffer[pos] = row_entries[i].first;
+            elements[pos]   = row_entries[i].second;
+            ++pos;
+          }
+          if (pos != row_end)
+            has_duplicates = true;
+          row_end = pos;
+        }
+        row_nnz[row] = static_cast<unsigned int>(row_end - row_begin);
+      }
+    }
+    row_buffer[rows] = static_cast<unsigned int>(num_entries);
+
+    // remove the gaps left by duplicate entries:
+    if (has_duplicates)
+    {
+      vcl_size_t pos = 0;
+      for (vcl_size_t row = 0; row < rows; ++row)
+      {
+        vcl_size_t row_begin = row_buffer[row];
+        row_buffer[row] = static_cast<unsigned int>(pos);
+        for (vcl_size_t i = row_begin; i < row_begin + row_nnz[row]; ++i, ++pos)
+        {
+          col_buffer[pos] = col_buffer[i];
+          elements[pos]   = elements[i];
+        }
+      }
+      row_buffer[rows] = static_cast<unsigned int>(pos);
+      col_buffer.resize(pos);
+      elements.resize(pos);
+    }
+
+    return mm_count_lines(status, linenum);
+  }
+
+
 
 } //namespace
 
@@ -137,6 +911,9 @@ long read_matrix_market_file_impl(MatrixT & mat,
     }
     while (reader.good() && buffer[0] == 0);
 
+    if (buffer[0] == 0) // end of file
+      break;
+
     if (buffer[0] == '%')
     {
       if (buffer[1] == '%')
@@ -161,11 +938,7 @@ long read_matrix_market_file_impl(MatrixT & mat,
         if (detail::tolower(token) != "coordinate")
         {
           if (detail::tolower(token) == "array")
-          {
             dense_format = true;
-            std::cerr << "Error in file " << file << " at line " << linenum << " in file " << file << ": 'array' type is not supported yet!" << std::endl;
-            return 0;
-          }
           else
           {
             std::cerr << "Error in file " << file << " at line " << linenum << " in file " << file << ": Expected 'array' or 'coordinate', got '" << token << "'" << std::endl;
@@ -182,7 +955,7 @@ long read_matrix_market_file_impl(MatrixT & mat,
         {
           //is_complex = true;
         }
-        else if (detail::tolower(token) != "real")
+        else if (detail::tolower(token) != "real" && detail::tolower(token) != "integer")
         {
           std::cerr << "Error in file " << file << ": The MatrixMarket reader provided with ViennaCL supports only real valued floating point arithmetic or pattern type matrices." << std::endl;
           return 0;
@@ -249,12 +1022,14 @@ long read_matrix_market_file_impl(MatrixT & mat,
           ScalarT value;
           line >> value;
           viennacl::traits::fill(mat, static_cast<vcl_size_t>(cur_row), static_cast<vcl_size_t>(cur_col), value);
+          if (symmetric && cur_row != cur_col) // only the lower triangle is stored
+            viennacl::traits::fill(mat, static_cast<vcl_size_t>(cur_col), static_cast<vcl_size_t>(cur_row), value);
 
           if (++cur_row == static_cast<long>(viennacl::traits::size1(mat)))
           {
             //next column
             ++cur_col;
-            cur_row = 0;
+            cur_row = symmetric ? cur_col : 0;
           }
         }
         else //sparse format
@@ -369,6 +1144,51 @@ long read_matrix_market_file(std::vector< std::map<unsigned int, ScalarT> > & ma
   return read_matrix_market_file_impl(adapted_matrix, file.c_str(), index_base);
 }
 
+/** @brief Reads a sparse matrix from a file (MatrixMarket format) directly into a compressed_matrix.
+*
+* Uses the parallel reader, which builds the CSR arrays without intermediate per-entry containers. Both the coordinate and the array format are supported.
+* Duplicate entries are resolved in favor of the last entry in the file.
+*
+* Note: If the matrix in the MatrixMarket file is complex, only the real-valued part is loaded!
+*
+* @param mat The matrix that is to be read
+* @param file The filename
+* @param index_base The index base, typically 1
+* @return Returns the number of lines in the file, or zero if an error occurred
+*/
+template<typename NumericT, unsigned int AlignmentV>
+long read_matrix_market_file(viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
+                             const char * file,
+                             long index_base = 1)
+{
+  std::vector<unsigned int> row_buffer;
+  std::vector<unsigned int> col_buffer;
+  std::vector<NumericT>     elements;
+  vcl_size_t rows = 0;
+  vcl_size_t cols = 0;
+
+  long num_lines = detail::read_matrix_market_csr(file, index_base, row_buffer, col_buffer, elements, rows, cols);
+  if (num_lines == 0 || rows == 0 || cols == 0)
+    return num_lines;
+
+  if (elements.size() > 0)
+    mat.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), rows, cols, elements.size());
+  else
+  {
+    mat.resize(rows, cols, false);
+    mat.clear();
+  }
+  return num_lines;
+}
+
+template<typename NumericT, unsigned int AlignmentV>
+long read_matrix_market_file(viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
+                             const std::string & file,
+                             long index_base = 1)
+{
+  return read_matrix_market_file(mat, file.c_str(), index_base);
+}
+
 
 ////////// writer /////////////
 template<typename MatrixT>
@@ -29,6 +29,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/compressed_matrix.hpp"
 
@@ -81,14 +82,11 @@ namespace detail
                          compressed_matrix<NumericT> & A_coarse)
   {
 
-    compressed_matrix<NumericT> A_fine_times_P(viennacl::traits::context(A_fine));
-
-    // transpose P in memory (no known way of efficiently multiplying P^T * B for CSR-matrices P and B):
+    // transpose P in memory (R is needed for the restriction in the AMG cycle anyway):
     viennacl::linalg::detail::amg::amg_transpose(P, R);
 
-    // compute Galerkin product using a temporary for the result of A_fine * P
-    A_fine_times_P = viennacl::linalg::prod(A_fine, P);
-    A_coarse = viennacl::linalg::prod(R, A_fine_times_P);
+    // compute Galerkin product (fused row-by-row on the host, using a temporary for A_fine * P otherwise):
+    viennacl::linalg::detail::amg::amg_galerkin_prod(A_fine, P, R, A_coarse);
 
   }
 
@@ -156,6 +154,62 @@ namespace detail
   }
 
 
+
+  /** @brief Recomputes the values of the AMG hierarchy after the values of the finest operator changed, but not its sparsity pattern
+  *
+  * The coarsening obtained in amg_setup() is kept. For aggregation-based interpolation the sparsity patterns of the interpolation operators
+  * and of the coarse grid operators are reused and only their values are recomputed.
+  *
+  * @param list_of_A                  Operator matrices on all levels. The finest operator holds the new values.
+  * @param list_of_P                  Prolongation/Interpolation operators on all levels
+  * @param list_of_R                  Restriction operators on all levels
+  * @param list_of_amg_level_context  Auxiliary datastructures for managing the grid hierarchy (coarse nodes, etc.)
+  * @param coarse_levels              Number of coarse levels as returned by amg_setup()
+  * @param tag                        AMG preconditioner tag
+  * @return                           False if the sparsity pattern of an operator no longer matches the hierarchy. The hierarchy is invalid then and needs to be set up again with amg_setup().
+  */
+  template<typename NumericT, typename AMGContextListT>
+  bool amg_setup_values(std::vector<compressed_matrix<NumericT> > & list_of_A,
+                        std::vector<compressed_matrix<NumericT> > & list_of_P,
+                        std::vector<compressed_matrix<NumericT> > & list_of_R,
+                        AMGContextListT & list_of_amg_level_context,
+                        vcl_size_t coarse_levels,
+                        amg_tag & tag)
+  {
+    bool keep_pattern = tag.get_interpolation_method() == AMG_INTERPOLATION_METHOD_AGGREGATION
+                     || tag.get_interpolation_method() == AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION;
+
+    for (vcl_size_t i=0; i<coarse_levels; ++i)
+    {
+      list_of_A[i].switch_memory_context(tag.get_setup_context());
+      list_of_P[i].switch_memory_context(tag.get_setup_context());
+      list_of_R[i].switch_memory_context(tag.get_setup_context());
+      list_of_A[i+1].switch_memory_context(tag.get_setup_context());
+
+      // Update interpolation matrix for level i. Plain aggregation does not depend on the values of A.
+      if (!detail::amg::amg_interpol_values(list_of_A[i], list_of_P[i], list_of_amg_level_context[i], tag))
+        return false;
+      if (tag.get_interpolation_method() != AMG_INTERPOLATION_METHOD_AGGREGATION)
+        viennacl::linalg::detail::amg::amg_transpose(list_of_P[i], list_of_R[i]);
+
+      // Update coarse grid operator:
+      if (keep_pattern)
+      {
+        if (!detail::amg::amg_galerkin_prod_values(list_of_A[i], list_of_P[i], list_of_R[i], list_of_A[i+1]))
+          return false;
+      }
+      else
+        detail::amg::amg_galerkin_prod(list_of_A[i], list_of_P[i], list_of_R[i], list_of_A[i+1]);
+
+      // send matrices to target context:
+      list_of_A[i].switch_memory_context(tag.get_target_context());
+      list_of_P[i].switch_memory_context(tag.get_target_context());
+      list_of_R[i].switch_memory_context(tag.get_target_context());
+    }
+
+    return true;
+  }
+
   /** @brief Initialize AMG preconditioner
   *
   * @param mat                        System matrix
@@ -224,6 +278,81 @@ namespace detail
   }
 
 
+  /** @brief Setup smoother data on all levels except the coarsest
+  *
+  * For Jacobi and Chebyshev smoothing, the diagonal of each operator is stored. For Chebyshev smoothing, the largest eigenvalue of D^{-1}A is estimated by a few power iterations.
+  * For l1-Gauss-Seidel smoothing, the l1-diagonal for one row block per thread is stored.
+  *
+  * @param A               Operators matrices on all levels from setup phase
+  * @param coarse_levels   Number of coarse levels
+  * @param tag             AMG preconditioner tag
+  * @param diag            Diagonal or l1-diagonal on each level
+  * @param lambda_max      Estimate for the largest eigenvalue of D^{-1}A on each level (Chebyshev only)
+  * @param work            Work vector on each level (Chebyshev only)
+  * @param num_blocks      Number of row blocks of the l1-Gauss-Seidel smoother
+  */
+  template<typename SparseMatrixT, typename VectorT, typename NumericT>
+  void amg_setup_smoother(std::vector<SparseMatrixT> const & A,
+                          vcl_size_t coarse_levels,
+                          amg_tag const & tag,
+                          std::vector<VectorT> & diag,
+                          std::vector<NumericT> & lambda_max,
+                          std::vector<VectorT> & work,
+                          vcl_size_t & num_blocks)
+  {
+    diag.resize(coarse_levels);
+    lambda_max.resize(coarse_levels, NumericT(1));
+    work.resize(coarse_levels);
+
+    num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_blocks = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+    for (vcl_size_t level=0; level < coarse_levels; ++level)
+    {
+      diag[level] = VectorT(A[level].size1(), tag.get_target_context());
+
+      if (tag.get_smoother_type() == AMG_SMOOTHER_L1_GAUSS_SEIDEL)
+      {
+        viennacl::linalg::detail::amg::amg_l1_diagonal(A[level], diag[level], num_blocks);
+        continue;
+      }
+
+      viennacl::linalg::detail::row_info(A[level], diag[level], viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+
+      if (tag.get_smoother_type() == AMG_SMOOTHER_CHEBYSHEV)
+      {
+        work[level] = VectorT(A[level].size1(), tag.get_target_context());
+
+        // power iteration for the largest eigenvalue of D^{-1}A, starting from a fixed pseudo-random vector:
+        std::vector<NumericT> v_init(A[level].size1());
+        for (vcl_size_t i=0; i<v_init.size(); ++i)
+          v_init[i] = NumericT(0.5) + NumericT((i * 7919) % 1000) / NumericT(1000);
+
+        VectorT v(A[level].size1(), tag.get_target_context());
+        viennacl::copy(v_init, v);
+        v /= viennacl::linalg::norm_2(v);
+
+        NumericT lambda = NumericT(1);
+        for (unsigned int i=0; i<10; ++i)
+        {
+          work[level] = viennacl::linalg::prod(A[level], v);
+          v = viennacl::linalg::element_div(work[level], diag[level]);
+          lambda = viennacl::linalg::norm_2(v);
+          if (lambda <= 0)
+            break;
+          v /= lambda;
+        }
+
+        // power iteration underestimates the largest eigenvalue, hence add a safety margin:
+        lambda_max[level] = (lambda > 0) ? NumericT(1.1) * lambda : NumericT(2);
+        work[level].clear();
+      }
+    }
+  }
+
+
   /** @brief Pre-compute LU factorization for direct solve (ublas library).
   *
   * Speeds up precondition phase as this is computed only once overall instead of once per iteration.
@@ -266,7 +395,7 @@ class amg_precond< compressed_matrix<NumericT, AlignmentV> >
 
 public:
 
-  amg_precond() {}
+  amg_precond() : smoother_blocks_(1) {}
 
   /** @brief The constructor. Builds data structures.
   *
@@ -274,7 +403,7 @@ public:
   * @param tag  The AMG tag
   */
   amg_precond(compressed_matrix<NumericT, AlignmentV> const & mat,
-              amg_tag const & tag)
+              amg_tag const & tag) : smoother_blocks_(1)
   {
     tag_ = tag;
 
@@ -291,11 +420,45 @@ public:
 
     // Setup precondition phase (Data structures).
     detail::amg_setup_apply(result_list_, result_backup_list_, rhs_list_, residual_list_, A_list_, num_coarse_levels, tag_);
+    detail::amg_setup_smoother(A_list_, num_coarse_levels, tag_, smoother_diag_list_, smoother_lambda_max_list_, smoother_work_list_, smoother_blocks_);
 
     // LU factorization for direct solve.
     detail::amg_lu(coarsest_op_, A_list_[num_coarse_levels], tag_);
   }
 
+  /** @brief Updates the preconditioner for new values of the system matrix with the same sparsity pattern as the one passed to the constructor.
+  *
+  * Keeps the coarsening and, for aggregation-based interpolation, the sparsity patterns of all interpolation and coarse grid operators from setup().
+  * Only the values of the interpolation operators (smoothed aggregation), of the coarse grid operators, the smoother data, and the coarse grid LU factorization are recomputed.
+  * Direct interpolation operators are recomputed from the existing coarsening.
+  * If the sparsity pattern of mat turns out to differ from the one used in setup(), the full setup is run instead.
+  *
+  * @param mat  System matrix with the same sparsity pattern as the one used in setup()
+  */
+  void update_values(compressed_matrix<NumericT, AlignmentV> const & mat)
+  {
+    if (A_list_.size() == 0 || mat.size1() != A_list_[0].size1() || mat.size2() != A_list_[0].size2() || mat.nnz() != A_list_[0].nnz())
+    {
+      rebuild(mat);
+      return;
+    }
+
+    vcl_size_t num_coarse_levels = residual_list_.size();
+
+    A_list_[0].switch_memory_context(viennacl::traits::context(mat));
+    A_list_[0] = mat;
+    A_list_[0].switch_memory_context(tag_.get_setup_context());
+
+    if (!detail::amg_setup_values(A_list_, P_list_, R_list_, amg_context_list_, num_coarse_levels, tag_))
+    {
+      rebuild(mat);
+      return;
+    }
+
+    detail::amg_setup_smoother(A_list_, num_coarse_levels, tag_, smoother_diag_list_, smoother_lambda_max_list_, smoother_work_list_, smoother_blocks_);
+    detail::amg_lu(coarsest_op_, A_list_[num_coarse_levels], tag_);
+  }
+
 
   /** @brief Precondition Operation
   *
@@ -315,12 +478,7 @@ public:
       result_list_[level].clear();
 
       // Apply Smoother presmooth_ times.
-      viennacl::linalg::detail::amg::smooth_jacobi(static_cast<unsigned int>(tag_.get_presmooth_steps()),
-                                                   A_list_[level],
-                                                   result_list_[level],
-                                                   result_backup_list_[level],
-                                                   rhs_list_[level],
-                                                   static_cast<NumericT>(tag_.get_jacobi_weight()));
+      smooth(level, static_cast<unsigned int>(tag_.get_presmooth_steps()), true);
 
       // Compute residual.
       //residual[level] = rhs_[level] - viennacl::linalg::prod(A_[level], result_[level]);
@@ -346,12 +504,7 @@ public:
       result_list_[level] += result_backup_list_[level];
 
       // Apply Smoother postsmooth_ times.
-      viennacl::linalg::detail::amg::smooth_jacobi(static_cast<unsigned int>(tag_.get_postsmooth_steps()),
-                                                   A_list_[level],
-                                                   result_list_[level],
-                                                   result_backup_list_[level],
-                                                   rhs_list_[level],
-                                                   static_cast<NumericT>(tag_.get_jacobi_weight()));
+      smooth(level, static_cast<unsigned int>(tag_.get_postsmooth_steps()), false);
     }
     vec = result_list_[0];
   }
@@ -374,6 +527,55 @@ public:
   amg_tag const & tag() const { return tag_; }
 
 private:
+  /** @brief Discards the current hierarchy and runs the full setup for 'mat'. */
+  void rebuild(compressed_matrix<NumericT, AlignmentV> const & mat)
+  {
+    A_list_.clear();
+    P_list_.clear();
+    R_list_.clear();
+    amg_context_list_.clear();
+
+    detail::amg_init(mat, A_list_, P_list_, R_list_, amg_context_list_, tag_);
+    setup();
+  }
+
+  /** @brief Applies the smoother selected in the tag to the iterate on the given level. Presmoothing and postsmoothing use opposite sweep directions where applicable. */
+  void smooth(vcl_size_t level, unsigned int steps, bool presmooth) const
+  {
+    switch (tag_.get_smoother_type())
+    {
+    case AMG_SMOOTHER_CHEBYSHEV:
+      viennacl::linalg::detail::amg::smooth_chebyshev(steps,
+                                                      A_list_[level],
+                                                      result_list_[level],
+                                                      result_backup_list_[level],
+                                                      rhs_list_[level],
+                                                      smoother_diag_list_[level],
+                                                      smoother_work_list_[level],
+                                                      tag_.get_chebyshev_degree(),
+                                                      static_cast<NumericT>(tag_.get_chebyshev_eigenvalue_ratio()) * smoother_lambda_max_list_[level],
+                                                      smoother_lambda_max_list_[level]);
+      break;
+    case AMG_SMOOTHER_L1_GAUSS_SEIDEL:
+      viennacl::linalg::detail::amg::smooth_l1_gauss_seidel(steps,
+                                                            A_list_[level],
+                                                            result_list_[level],
+                                                            result_backup_list_[level],
+                                                            rhs_list_[level],
+                                                            smoother_diag_list_[level],
+                                                            smoother_blocks_,
+                                                            presmooth);
+      break;
+    default:
+      viennacl::linalg::detail::amg::smooth_jacobi(steps,
+                                                   A_list_[level],
+                                                   result_list_[level],
+                                                   result_backup_list_[level],
+                                                   rhs_list_[level],
+                                                   static_cast<NumericT>(tag_.get_jacobi_weight()));
+    }
+  }
+
   std::vector<SparseMatrixType> A_list_;
   std::vector<SparseMatrixType> P_list_;
   std::vector<SparseMatrixType> R_list_;
@@ -386,6 +588,11 @@ private:
   mutable std::vector<VectorType> rhs_list_;
   mutable std::vector<VectorType> residual_list_;
 
+  std::vector<VectorType>         smoother_diag_list_;
+  std::vector<NumericT>           smoother_lambda_max_list_;
+  mutable std::vector<VectorType> smoother_work_list_;
+  vcl_size_t                      smoother_blocks_;
+
   amg_tag tag_;
 };
 
@@ -27,6 +27,8 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 #include "viennacl/linalg/host_based/amg_operations.hpp"
 
@@ -128,6 +130,37 @@ void amg_interpol(compressed_matrix<NumericT> const & A,
 }
 
 
+/** @brief Recomputes the values of the interpolation matrix P for new values of A with unchanged sparsity pattern. Recomputes P from scratch if not computed on the host.
+  *
+  * Returns false if the sparsity pattern of A no longer fits P, in which case the AMG hierarchy needs to be set up again.
+  */
+template<typename NumericT, typename AMGContextT>
+bool amg_interpol_values(compressed_matrix<NumericT> const & A,
+                         compressed_matrix<NumericT>       & P,
+                         AMGContextT & amg_context,
+                         amg_tag & tag)
+{
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      return viennacl::linalg::host_based::amg::amg_interpol_values(A, P, amg_context, tag);
+#ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+      viennacl::linalg::opencl::amg::amg_interpol(A, P, amg_context, tag);
+      return true;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+      viennacl::linalg::cuda::amg::amg_interpol(A, P, amg_context, tag);
+      return true;
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
 template<typename NumericT>
 void amg_transpose(compressed_matrix<NumericT> & A,
                    compressed_matrix<NumericT> & B)
@@ -168,6 +201,74 @@ void amg_transpose(compressed_matrix<NumericT> & A,
   }
 }
 
+/** @brief Computes the Galerkin operator A_coarse = R * A_fine * P, where R = trans(P) has already been computed.
+  *
+  * In host memory the product is computed row by row without forming A_fine * P. Otherwise two sparse matrix-matrix products are used.
+  */
+template<typename NumericT>
+void amg_galerkin_prod(compressed_matrix<NumericT> & A_fine,
+                       compressed_matrix<NumericT> & P,
+                       compressed_matrix<NumericT> & R,
+                       compressed_matrix<NumericT> & A_coarse)
+{
+  switch (viennacl::traits::handle(A_fine).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::amg::amg_galerkin_prod(A_fine, P, R, A_coarse);
+      break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+  #ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+  #endif
+  #ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+  #endif
+    {
+      compressed_matrix<NumericT> A_fine_times_P(viennacl::traits::context(A_fine));
+      A_fine_times_P = viennacl::linalg::prod(A_fine, P);
+      A_coarse = viennacl::linalg::prod(R, A_fine_times_P);
+      break;
+    }
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Recomputes the values of the Galerkin operator A_coarse = R * A_fine * P, where the sparsity patterns of A_fine, P, and R are the same as when A_coarse was computed.
+  *
+  * In host memory the sparsity pattern of A_coarse is reused. Otherwise the Galerkin operator is recomputed from scratch.
+  * Returns false if the sparsity pattern of A_coarse does not match the product, in which case the AMG hierarchy needs to be set up again.
+  */
+template<typename NumericT>
+bool amg_galerkin_prod_values(compressed_matrix<NumericT> & A_fine,
+                              compressed_matrix<NumericT> & P,
+                              compressed_matrix<NumericT> & R,
+                              compressed_matrix<NumericT> & A_coarse)
+{
+  switch (viennacl::traits::handle(A_fine).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      return viennacl::linalg::host_based::amg::amg_galerkin_prod_values(A_fine, P, R, A_coarse);
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+  #ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+  #endif
+  #ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+  #endif
+      amg_galerkin_prod(A_fine, P, R, A_coarse);
+      return true;
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
 /** Assign sparse matrix A to dense matrix B */
 template<typename SparseMatrixType, typename NumericT>
 typename viennacl::enable_if< viennacl::is_any_sparse_matrix<SparseMatrixType>::value>::type
@@ -229,6 +330,135 @@ void smooth_jacobi(unsigned int iterations,
   }
 }
 
+/** @brief Computes the diagonal for the l1-Gauss-Seidel smoother with the given number of row blocks.
+*
+* Other backends use the l1-Jacobi smoother instead, for which the diagonal is the l1-norm of each row.
+*/
+template<typename NumericT>
+void amg_l1_diagonal(compressed_matrix<NumericT> const & A,
+                     vector<NumericT> & l1_diag,
+                     vcl_size_t num_blocks)
+{
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::amg::amg_l1_diagonal(A, l1_diag, num_blocks);
+      break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+#endif
+      viennacl::linalg::detail::row_info(A, l1_diag, viennacl::linalg::detail::SPARSE_ROW_NORM_1);
+      break;
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Hybrid l1-Gauss-Seidel smoother on the host. Other backends run the l1-Jacobi smoother. */
+template<typename NumericT>
+void smooth_l1_gauss_seidel(unsigned int iterations,
+                            compressed_matrix<NumericT> const & A,
+                            vector<NumericT> & x,
+                            vector<NumericT> & x_backup,
+                            vector<NumericT> const & rhs_smooth,
+                            vector<NumericT> const & l1_diag,
+                            vcl_size_t num_blocks,
+                            bool forward)
+{
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::amg::smooth_l1_gauss_seidel(iterations, A, x, x_backup, rhs_smooth, l1_diag, num_blocks, forward);
+      break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+#endif
+      for (unsigned int i=0; i<iterations; ++i)
+      {
+        x_backup = viennacl::linalg::prod(A, x);
+        x_backup = rhs_smooth - x_backup;
+        x += viennacl::linalg::element_div(x_backup, l1_diag);
+      }
+      break;
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Chebyshev polynomial smoother for the Jacobi-preconditioned operator D^{-1}A. See host_based::amg::smooth_chebyshev() for the parameters. */
+template<typename NumericT>
+void smooth_chebyshev(unsigned int iterations,
+                      compressed_matrix<NumericT> const & A,
+                      vector<NumericT> & x,
+                      vector<NumericT> & x_backup,
+                      vector<NumericT> const & rhs_smooth,
+                      vector<NumericT> const & diag,
+                      vector<NumericT> & d,
+                      unsigned int degree,
+                      NumericT lambda_min,
+                      NumericT lambda_max)
+{
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::amg::smooth_chebyshev(iterations, A, x, x_backup, rhs_smooth, diag, d, degree, lambda_min, lambda_max);
+      break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+    case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+    case viennacl::CUDA_MEMORY:
+#endif
+    {
+      NumericT theta = (lambda_max + lambda_min) / NumericT(2);
+      NumericT delta = (lambda_max - lambda_min) / NumericT(2);
+      NumericT sigma = theta / delta;
+
+      for (unsigned int i=0; i<iterations; ++i)
+      {
+        NumericT rho = NumericT(1) / sigma;
+        for (unsigned int k=0; k<degree; ++k)
+        {
+          NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+
+          x_backup = viennacl::linalg::prod(A, x);
+          x_backup = rhs_smooth - x_backup;
+          x_backup = viennacl::linalg::element_div(x_backup, diag);
+          if (k == 0)
+            d = x_backup / theta;
+          else
+          {
+            d = (rho_new * rho) * d + (NumericT(2) * rho_new / delta) * x_backup;
+            rho = rho_new;
+          }
+          x += d;
+        }
+      }
+      break;
+    }
+#endif
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
 } //namespace amg
 } //namespace detail
 } //namespace linalg
@@ -351,10 +351,9 @@ namespace detail
       omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
 
       result += alpha * p + omega * s;
-      residual = s - omega * tmp1;
+      detail::residual_norm_2_assigner<VectorT>::apply(residual, s - omega * tmp1, residual_norm);
 
       new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
-      residual_norm = viennacl::linalg::norm_2(residual);
       if (monitor && monitor(result, std::fabs(residual_norm / norm_rhs_host), monitor_data))
         break;
       if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance() || residual_norm < tag.abs_tolerance())
@@ -457,9 +456,8 @@ namespace detail
       omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
 
       result += alpha * p + omega * s;
-      residual = s - omega * tmp1;
+      detail::residual_norm_2_assigner<VectorT>::apply(residual, s - omega * tmp1, residual_norm);
 
-      residual_norm = viennacl::linalg::norm_2(residual);
       if (monitor && monitor(result, std::fabs(residual_norm / norm_rhs_host), monitor_data))
         break;
       if (residual_norm / norm_rhs_host < tag.tolerance() || residual_norm < tag.abs_tolerance())
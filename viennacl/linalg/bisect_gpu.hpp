@@ -40,6 +40,7 @@
 #include "viennacl/linalg/detail/bisect/gerschgorin.hpp"
 #include "viennacl/linalg/detail/bisect/bisect_large.hpp"
 #include "viennacl/linalg/detail/bisect/bisect_small.hpp"
+#include "viennacl/linalg/detail/bisect/bisect_host.hpp"
 
 
 namespace viennacl
@@ -68,6 +69,13 @@ bisect(const std::vector<NumericT> & diagonal, const std::vector<NumericT> & sup
   NumericT  precision = static_cast<NumericT>(0.00001);
   const unsigned int mat_size = static_cast<unsigned int>(diagonal.size());
 
+  // multithreaded bisection if the computations are carried out in host memory
+  if (viennacl::backend::default_memory_type() == viennacl::MAIN_MEMORY)
+  {
+    viennacl::linalg::detail::bisect_host(diagonal, superdiagonal, eigenvalues, 0, mat_size, precision);
+    return true;
+  }
+
   // set up input
   viennacl::linalg::detail::InputData<NumericT> input(diagonal, superdiagonal, mat_size);
 
@@ -130,6 +138,17 @@ bisect(const viennacl::vector<NumericT> & diagonal, const viennacl::vector<Numer
   NumericT  precision = static_cast<NumericT>(0.00001);
   const unsigned int mat_size = static_cast<unsigned int>(diagonal.size());
 
+  // multithreaded bisection if the computations are carried out in host memory
+  if (viennacl::traits::active_handle_id(diagonal) == viennacl::MAIN_MEMORY)
+  {
+    std::vector<NumericT> std_diagonal(mat_size), std_superdiagonal(mat_size), std_eigenvalues;
+    viennacl::copy(diagonal, std_diagonal);
+    viennacl::copy(superdiagonal, std_superdiagonal);
+    viennacl::linalg::detail::bisect_host(std_diagonal, std_superdiagonal, std_eigenvalues, 0, mat_size, precision);
+    viennacl::copy(std_eigenvalues, eigenvalues);
+    return true;
+  }
+
   // set up input
   viennacl::linalg::detail::InputData<NumericT> input(diagonal, superdiagonal, mat_size);
 
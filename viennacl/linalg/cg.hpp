@@ -26,6 +26,7 @@
 #include <map>
 #include <cmath>
 #include <numeric>
+#include <algorithm>
 
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
@@ -37,6 +38,8 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/detail/block_krylov.hpp"
 
 namespace viennacl
 {
@@ -53,7 +56,7 @@ public:
   * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
   * @param max_iterations   The maximum number of iterations
   */
-  cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), abs_tol_(0), iterations_(max_iterations) {}
+  cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), abs_tol_(0), iterations_(max_iterations), s_steps_(1) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -66,6 +69,14 @@ public:
   /** @brief Returns the maximum number of iterations */
   unsigned int max_iterations() const { return iterations_; }
 
+  /** @brief Returns the number of CG steps per outer iteration of the s-step (communication-avoiding) variant. A value of 1 disables the s-step variant. */
+  unsigned int s_steps() const { return s_steps_; }
+  /** @brief Sets the number of CG steps per outer iteration of the s-step variant, which is used for unpreconditioned systems in main memory.
+  *
+  * The s-step variant needs only one global reduction per s steps, but the Krylov basis loses linear independence quickly for large s. Values up to about 5 are safe.
+  */
+  void s_steps(unsigned int s) { s_steps_ = (s > 0) ? s : 1; }
+
   /** @brief Return the number of solver iterations: */
   unsigned int iters() const { return iters_taken_; }
   void iters(unsigned int i) const { iters_taken_ = i; }
@@ -80,6 +91,7 @@ private:
   double tol_;
   double abs_tol_;
   unsigned int iterations_;
+  unsigned int s_steps_;
 
   //return values from solver
   mutable unsigned int iters_taken_;
@@ -113,6 +125,183 @@ namespace detail
 namespace detail
 {
 
+  /** @brief Returns x^T G y for the Gram matrix G (column-major) of the s-step basis */
+  template<typename NumericT>
+  NumericT s_step_bilinear_form(std::vector<NumericT> const & G, std::vector<NumericT> const & x, std::vector<NumericT> const & y)
+  {
+    vcl_size_t n = x.size();
+    NumericT result = 0;
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      if (y[j] <= 0 && y[j] >= 0)
+        continue;
+      NumericT G_x_j = 0;
+      for (vcl_size_t i = 0; i < n; ++i)
+        G_x_j += G[i + j * n] * x[i];
+      result += G_x_j * y[j];
+    }
+    return result;
+  }
+
+  /** @brief Implementation of the s-step (communication-avoiding) conjugate gradient algorithm without preconditioner for systems in main memory.
+  *
+  * Follows the CA-CG formulation in E. Carson, Communication-Avoiding Krylov Subspace Methods in Theory and Practice, PhD thesis, UC Berkeley (2015):
+  * Each outer iteration computes the basis V = [p, A p, ..., A^s p, r, A r, ..., A^{s-1} r] using matrix-vector products only and obtains all inner products from the Gram matrix V^T V in a single reduction.
+  * The s CG steps are then carried out on the coefficient vectors with respect to V on the host, and the iterates are recovered in a single pass at the end.
+  * The monomial basis is scaled by an estimate of the norm of A in order to delay the loss of linear independence.
+  * Convergence is confirmed with the true residual b - A x, which is also reported by tag.error().
+  *
+  * @param A            The system matrix
+  * @param rhs          The load vector
+  * @param tag          Solver configuration tag
+  * @param monitor      A callback routine which is called after each outer iteration
+  * @param monitor_data Data pointer to be passed to the callback routine to pass on user-specific data
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> s_step_solve(MatrixT const & A,
+                                          viennacl::vector<NumericT> const & rhs,
+                                          cg_tag const & tag,
+                                          bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                          void *monitor_data = NULL)
+  {
+    vcl_size_t s           = tag.s_steps();
+    vcl_size_t num_vectors = 2 * s + 1;
+    vcl_size_t size        = rhs.size();
+    vcl_size_t stride      = rhs.internal_size();
+
+    viennacl::vector<NumericT> result(rhs);
+    viennacl::traits::clear(result);
+
+    tag.iters(0);
+    tag.error(0);
+
+    NumericT norm_rhs_squared = viennacl::linalg::norm_2(rhs); norm_rhs_squared *= norm_rhs_squared;
+
+    if (norm_rhs_squared <= tag.abs_tolerance() * tag.abs_tolerance()) //check for early convergence of A*x = 0
+      return result;
+
+    // basis vectors p, A p, ..., A^s p in columns 0, ..., s and r, A r, ..., A^{s-1} r in columns s+1, ..., 2s:
+    viennacl::vector<NumericT> krylov_basis = viennacl::zero_vector<NumericT>(num_vectors * stride, viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> device_gram_matrix(num_vectors * num_vectors, viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> device_coefficients(3 * num_vectors, viennacl::traits::context(rhs));
+    std::vector<NumericT>      gram_matrix(num_vectors * num_vectors);
+    std::vector<NumericT>      coefficients(3 * num_vectors);
+
+    std::vector<NumericT> x_coeff(num_vectors);
+    std::vector<NumericT> r_coeff(num_vectors);
+    std::vector<NumericT> p_coeff(num_vectors);
+    std::vector<NumericT> Ap_coeff(num_vectors);
+
+    viennacl::vector_range<viennacl::vector<NumericT> > p(krylov_basis, viennacl::range(0, size));
+    viennacl::vector_range<viennacl::vector<NumericT> > r(krylov_basis, viennacl::range((s+1) * stride, (s+1) * stride + size));
+    p = rhs;
+    r = rhs;
+
+    // scaling factor for the monomial basis:
+    NumericT sigma = 1;
+    {
+      viennacl::vector_range<viennacl::vector<NumericT> > Ap(krylov_basis, viennacl::range(stride, stride + size));
+      viennacl::linalg::prod_impl(A, p, NumericT(1), Ap, NumericT(0));
+      sigma = viennacl::linalg::norm_2(Ap) / std::sqrt(norm_rhs_squared);
+      if (sigma <= 0)
+        sigma = 1;
+    }
+
+    NumericT inner_prod_rr = norm_rhs_squared;
+    bool converged = false;
+
+    while (tag.iters() < tag.max_iterations() && !converged)
+    {
+      //
+      // Matrix powers: A^j p / sigma^j and A^j r / sigma^j. No reductions involved.
+      //
+      viennacl::linalg::s_step_matrix_powers(A, krylov_basis, size, stride, 0,   s,   NumericT(1) / sigma);
+      viennacl::linalg::s_step_matrix_powers(A, krylov_basis, size, stride, s+1, s-1, NumericT(1) / sigma);
+
+      //
+      // Gram matrix V^T V in a single reduction:
+      //
+      viennacl::linalg::s_step_inner_products(krylov_basis, size, stride, num_vectors, 0, num_vectors, device_gram_matrix);
+      viennacl::fast_copy(device_gram_matrix.begin(), device_gram_matrix.end(), gram_matrix.begin());
+
+      //
+      // s steps of CG on the coefficient vectors:
+      //
+      std::fill(x_coeff.begin(), x_coeff.end(), NumericT(0));
+      std::fill(r_coeff.begin(), r_coeff.end(), NumericT(0));
+      std::fill(p_coeff.begin(), p_coeff.end(), NumericT(0));
+      r_coeff[s+1] = NumericT(1);
+      p_coeff[0]   = NumericT(1);
+
+      for (vcl_size_t j = 0; j < s && tag.iters() < tag.max_iterations(); ++j)
+      {
+        tag.iters(tag.iters() + 1);
+
+        // coefficients of A p: shift within the p- and r-blocks of the basis
+        std::fill(Ap_coeff.begin(), Ap_coeff.end(), NumericT(0));
+        for (vcl_size_t k = 0; k < s; ++k)
+          Ap_coeff[k+1] = sigma * p_coeff[k];
+        for (vcl_size_t k = s+1; k < 2*s; ++k)
+          Ap_coeff[k+1] = sigma * p_coeff[k];
+
+        NumericT alpha = inner_prod_rr / s_step_bilinear_form(gram_matrix, p_coeff, Ap_coeff);
+
+        for (vcl_size_t k = 0; k < num_vectors; ++k)
+        {
+          x_coeff[k] += alpha * p_coeff[k];
+          r_coeff[k] -= alpha * Ap_coeff[k];
+        }
+
+        NumericT new_inner_prod_rr = s_step_bilinear_form(gram_matrix, r_coeff, r_coeff);
+
+        if (std::fabs(new_inner_prod_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance() || std::fabs(new_inner_prod_rr) < tag.abs_tolerance() * tag.abs_tolerance())    //squared norms involved here
+          converged = true;
+
+        NumericT beta = new_inner_prod_rr / inner_prod_rr;
+        inner_prod_rr = new_inner_prod_rr;
+
+        if (converged)
+          break;
+
+        for (vcl_size_t k = 0; k < num_vectors; ++k)
+          p_coeff[k] = r_coeff[k] + beta * p_coeff[k];
+      }
+
+      //
+      // Recover x, r, and p in a single pass:
+      //
+      std::copy(x_coeff.begin(), x_coeff.end(), coefficients.begin());
+      std::copy(r_coeff.begin(), r_coeff.end(), coefficients.begin() +     static_cast<long>(num_vectors));
+      std::copy(p_coeff.begin(), p_coeff.end(), coefficients.begin() + 2 * static_cast<long>(num_vectors));
+      viennacl::fast_copy(coefficients.begin(), coefficients.end(), device_coefficients.begin());
+
+      viennacl::linalg::s_step_cg_vector_update(result, krylov_basis, size, stride, s, device_coefficients);
+
+      //
+      // The recursively updated residual drifts from the true residual, in particular for larger s.
+      // Hence, convergence is only accepted for the true residual. Otherwise, CG is restarted from the true residual.
+      //
+      if (converged || tag.iters() >= tag.max_iterations())
+      {
+        viennacl::linalg::prod_impl(A, result, NumericT(-1), r, NumericT(0));
+        r += rhs;
+        inner_prod_rr = viennacl::linalg::norm_2(r); inner_prod_rr *= inner_prod_rr;
+
+        converged = (inner_prod_rr / norm_rhs_squared < tag.tolerance() * tag.tolerance() || inner_prod_rr < tag.abs_tolerance() * tag.abs_tolerance());
+        if (!converged)
+          p = r;
+      }
+
+      tag.error(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+
+      if (monitor && monitor(result, std::sqrt(std::fabs(inner_prod_rr / norm_rhs_squared)), monitor_data))
+        break;
+    }
+
+    return result;
+  }
+
   /** @brief Implementation of a pipelined conjugate gradient algorithm (no preconditioner), specialized for ViennaCL types.
   *
   * Pipelined version from A. T. Chronopoulos and C. W. Gear, J. Comput. Appl. Math. 25(2), 153–168 (1989)
@@ -135,6 +324,9 @@ namespace detail
   {
     typedef typename viennacl::vector<NumericT>::difference_type   difference_type;
 
+    if (tag.s_steps() > 1 && viennacl::traits::active_handle_id(rhs) == viennacl::MAIN_MEMORY)
+      return s_step_solve(A, rhs, tag, monitor, monitor_data);
+
     viennacl::vector<NumericT> result(rhs);
     viennacl::traits::clear(result);
 
@@ -294,14 +486,20 @@ namespace detail
       alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
 
       result += alpha * p;
-      residual -= alpha * tmp;
-      z = residual;
-      precond.apply(z);
 
       if (static_cast<VectorT*>(&residual)==static_cast<VectorT*>(&z))
-        new_ip_rr = std::pow(viennacl::linalg::norm_2(residual),2);
+      {
+        CPU_NumericType norm_residual;
+        detail::residual_norm_2_assigner<VectorT>::apply(residual, residual - alpha * tmp, norm_residual);
+        new_ip_rr = norm_residual * norm_residual;
+      }
       else
+      {
+        residual -= alpha * tmp;
+        z = residual;
+        precond.apply(z);
         new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+      }
 
       new_ipp_rr_over_norm_rhs = new_ip_rr / norm_rhs_squared;
       if (monitor && monitor(result, std::sqrt(std::fabs(new_ipp_rr_over_norm_rhs)), monitor_data))
@@ -321,6 +519,131 @@ namespace detail
     return result;
   }
 
+
+  /** @brief Implementation of the breakdown-free block conjugate gradient method for a matrix of right hand sides.
+  *
+  * Following H. Ji and Y. Li, A breakdown-free block conjugate gradient method, BIT Numerical Mathematics 57 (2017):
+  * The search directions of all right hand sides are kept in one orthonormal block P, so sparse matrix-vector products become a sparse times dense matrix product
+  * and the inner products become small Gram matrices. Linearly dependent search directions are dropped when P is orthonormalized.
+  * Columns are deflated from the block as soon as they are converged.
+  *
+  * @param A         The system matrix
+  * @param B         The right hand sides, one per column
+  * @param result    The result matrix of the same size as B
+  * @param tag       Solver configuration tag. The number of iterations refers to block iterations, the error is the largest relative residual of all columns.
+  * @param precond   A preconditioner, which is applied to each column of the residual block
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  void block_solve_impl(MatrixT const & A,
+                        viennacl::matrix_base<NumericT> const & B,
+                        viennacl::matrix_base<NumericT> & result,
+                        cg_tag const & tag,
+                        PreconditionerT const & precond)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::row_major>   BlockType;
+    typedef viennacl::matrix_range<BlockType>                 BlockRangeType;
+
+    vcl_size_t n = B.size1();
+    vcl_size_t m = B.size2();
+    viennacl::context ctx = viennacl::traits::context(B);
+    viennacl::range all_rows(0, n);
+
+    // all blocks are row-major, so that the product with the sparse matrix streams each row of A once:
+    BlockType X(n, m, ctx), R(n, m, ctx), Z(n, m, ctx), P(n, m, ctx), AP(n, m, ctx);
+    BlockType device_coefficients(m, m, ctx);
+    viennacl::vector<NumericT> temp(n, ctx);
+    X.clear();
+    detail::block_copy(B, R);
+
+    std::vector<NumericT> rhs_norms;
+    std::vector<NumericT> residual_norms;
+    std::vector<NumericT> relative_residuals(m);
+    std::vector<vcl_size_t> active(m);
+    detail::block_column_norms(R, rhs_norms);
+    for (vcl_size_t j = 0; j < m; ++j)
+      active[j] = j;
+
+    NumericT rel_tol = NumericT(tag.tolerance());
+    NumericT abs_tol = NumericT(tag.abs_tolerance());
+
+    tag.iters(0);
+    vcl_size_t num_active = detail::block_deflate(rhs_norms, rhs_norms, NumericT(0), abs_tol, active, X, R, result);
+    for (vcl_size_t j = 0; j < num_active; ++j)
+      relative_residuals[active[j]] = 1;
+
+    std::vector<NumericT> S, PtAP, alpha, beta;
+    vcl_size_t q = 0;
+    if (num_active > 0)
+    {
+      BlockRangeType R_a(R, all_rows, viennacl::range(0, num_active));
+      BlockRangeType Z_a(Z, all_rows, viennacl::range(0, num_active));
+      Z_a = R_a;
+      detail::block_precond_apply(precond, Z_a, temp);
+      q = detail::block_orthonormalize(Z_a, P, AP, S);
+    }
+
+    while (num_active > 0 && q > 0 && tag.iters() < tag.max_iterations())
+    {
+      tag.iters(tag.iters() + 1);
+
+      BlockRangeType X_a(X, all_rows, viennacl::range(0, num_active));
+      BlockRangeType R_a(R, all_rows, viennacl::range(0, num_active));
+      BlockRangeType P_q(P, all_rows, viennacl::range(0, q));
+      BlockRangeType AP_q(AP, all_rows, viennacl::range(0, q));
+
+      AP_q = viennacl::linalg::prod(A, P_q);
+
+      BlockType G(q, q, ctx);
+      G = viennacl::linalg::prod(viennacl::trans(P_q), AP_q);
+      detail::block_read(G, PtAP);
+
+      // alpha = (P^T A P)^{-1} P^T R
+      BlockType F(q, num_active, ctx);
+      F = viennacl::linalg::prod(viennacl::trans(P_q), R_a);
+      detail::block_read(F, alpha);
+      if (!detail::block_cholesky_solve(PtAP, q, alpha, num_active)) // A is not positive definite
+        break;
+      detail::block_write(alpha, q, num_active, device_coefficients);
+
+      X_a += viennacl::linalg::prod(P_q, device_coefficients);
+      R_a -= viennacl::linalg::prod(AP_q, device_coefficients);
+
+      // deflate converged columns:
+      detail::block_column_norms(R_a, residual_norms);
+      for (vcl_size_t j = 0; j < num_active; ++j)
+        relative_residuals[active[j]] = (rhs_norms[active[j]] > 0) ? residual_norms[j] / rhs_norms[active[j]] : NumericT(0);
+      num_active = detail::block_deflate(residual_norms, rhs_norms, rel_tol, abs_tol, active, X, R, result);
+      if (num_active == 0)
+        break;
+
+      // new search directions: P = orth(Z - P (P^T A P)^{-1} (A P)^T Z)
+      BlockRangeType R_new(R, all_rows, viennacl::range(0, num_active));
+      BlockRangeType Z_a(Z, all_rows, viennacl::range(0, num_active));
+      Z_a = R_new;
+      detail::block_precond_apply(precond, Z_a, temp);
+
+      BlockType F_new(q, num_active, ctx);
+      F_new = viennacl::linalg::prod(viennacl::trans(AP_q), Z_a);
+      detail::block_read(F_new, beta);
+      detail::block_cholesky_solve(PtAP, q, beta, num_active);
+      for (vcl_size_t i = 0; i < beta.size(); ++i)
+        beta[i] = -beta[i];
+      detail::block_write(beta, q, num_active, device_coefficients);
+      Z_a += viennacl::linalg::prod(P_q, device_coefficients);
+
+      q = detail::block_orthonormalize(Z_a, P, AP, S);
+    }
+
+    // columns which did not converge:
+    for (vcl_size_t j = 0; j < num_active; ++j)
+    {
+      viennacl::vector_base<NumericT> result_column = detail::block_column(result, active[j]);
+      result_column = detail::block_column(X, j);
+    }
+
+    tag.error(m > 0 ? *std::max_element(relative_residuals.begin(), relative_residuals.end()) : NumericT(0));
+  }
+
 }
 
 
@@ -374,6 +697,32 @@ VectorT solve(MatrixT const & matrix, VectorT const & rhs, cg_tag const & tag)
   return solve(matrix, rhs, tag, viennacl::linalg::no_precond());
 }
 
+/** @brief Solves A X = B for a matrix B of right hand sides sharing the same system matrix using the block CG method.
+*
+* All right hand sides are iterated simultaneously, so each iteration reads the system matrix only once.
+* Converged columns are removed from the block. The iteration count of the tag refers to block iterations, the error is the largest relative residual of all columns.
+*
+* @param matrix     The system matrix
+* @param rhs        The right hand sides, one per column
+* @param tag        Solver configuration tag
+* @param precond    A preconditioner, which is applied to each column separately
+* @return The matrix of solution vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, cg_tag const & tag, PreconditionerT const & precond)
+{
+  viennacl::matrix<NumericT, F, AlignmentV> result(rhs.size1(), rhs.size2(), viennacl::traits::context(rhs));
+  detail::block_solve_impl(matrix, rhs, result, tag, precond);
+  return result;
+}
+
+/** @brief Entry point for the unpreconditioned block CG method for a matrix of right hand sides. */
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & matrix, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, cg_tag const & tag)
+{
+  return solve(matrix, rhs, tag, viennacl::linalg::no_precond());
+}
+
 
 
 template<typename VectorT>
@@ -23,7 +23,9 @@
 */
 
 #include "viennacl/forwards.h"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -40,6 +42,7 @@ namespace linalg
 /** @brief Carries out matrix-vector multiplication with a circulant_matrix
 *
 * Implementation of the convenience expression result = prod(mat, vec);
+* The Fourier transform of the matrix entries is computed in the first product and only recomputed after non-const access to the entries, cf. circulant_matrix::convolution_cache().
 *
 * @param mat    The matrix
 * @param vec    The vector
@@ -52,20 +55,8 @@ void prod_impl(viennacl::circulant_matrix<NumericT, AlignmentV> const & mat,
 {
   assert(mat.size1() == result.size() && bool("Dimension mismatch"));
   assert(mat.size2() == vec.size() && bool("Dimension mismatch"));
-  //result.clear();
-
-  //std::cout << "prod(circulant_matrix" << ALIGNMENT << ", vector) called with internal_nnz=" << mat.internal_nnz() << std::endl;
-
-  viennacl::vector<NumericT> circ(mat.elements().size() * 2);
-  viennacl::linalg::real_to_complex(mat.elements(), circ, mat.elements().size());
-
-  viennacl::vector<NumericT> tmp(vec.size() * 2);
-  viennacl::vector<NumericT> tmp2(vec.size() * 2);
-
-  viennacl::linalg::real_to_complex(vec, tmp, vec.size());
-  viennacl::linalg::convolve(circ, tmp, tmp2);
-  viennacl::linalg::complex_to_real(tmp2, result, vec.size());
-
+  // cyclic convolution with the cached transform of the matrix entries:
+  mat.convolution_cache().apply(mat.elements(), vec, result, vec.size());
 }
 
 } //namespace linalg
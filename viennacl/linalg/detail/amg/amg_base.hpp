@@ -58,6 +58,14 @@ enum amg_interpolation_method
   AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION
 };
 
+/** @brief Enumeration of smoothers for algebraic multigrid. */
+enum amg_smoother_type
+{
+  AMG_SMOOTHER_JACOBI = 1,
+  AMG_SMOOTHER_CHEBYSHEV,
+  AMG_SMOOTHER_L1_GAUSS_SEIDEL
+};
+
 
 /** @brief A tag for algebraic multigrid (AMG). Used to transport information from the user to the implementation.
 */
@@ -69,7 +77,10 @@ public:
     * Default coarsening routine: Aggreggation based on maximum independent sets of distance (MIS-2)
     * Default interpolation routine: Smoothed aggregation
     * Default threshold for strong connections: 0.1 (customizations are recommeded!)
+    * Default smoother: Damped Jacobi
     * Default weight for Jacobi smoother: 1.0
+    * Default degree of the Chebyshev smoother: 2
+    * Default lower end of the Chebyshev smoothing interval: 1/30 of the estimated largest eigenvalue
     * Default number of pre-smooth operations: 2
     * Default number of post-smooth operations: 2
     * Default number of coarse levels: 0 (this indicates that as many coarse levels as needed are constructed until the cutoff is reached)
@@ -78,6 +89,7 @@ public:
   amg_tag()
   : coarsening_method_(AMG_COARSENING_METHOD_MIS2_AGGREGATION), interpolation_method_(AMG_INTERPOLATION_METHOD_AGGREGATION),
     strong_connection_threshold_(0.1), jacobi_weight_(1.0),
+    smoother_type_(AMG_SMOOTHER_JACOBI), chebyshev_degree_(2), chebyshev_eigenvalue_ratio_(1.0 / 30.0),
     presmooth_steps_(2), postsmooth_steps_(2),
     coarse_levels_(0), coarse_cutoff_(50) {}
 
@@ -104,6 +116,26 @@ public:
     */
   double get_strong_connection_threshold() const { return strong_connection_threshold_; }
 
+  /** @brief Sets the smoother used on all levels except the coarsest.
+    *
+    * AMG_SMOOTHER_JACOBI:            Damped Jacobi, see set_jacobi_weight().
+    * AMG_SMOOTHER_CHEBYSHEV:         Chebyshev polynomial of D^{-1}A. The largest eigenvalue is estimated once during setup, see set_chebyshev_degree() and set_chebyshev_eigenvalue_ratio().
+    * AMG_SMOOTHER_L1_GAUSS_SEIDEL:   Hybrid l1-Gauss-Seidel: Sequential Gauss-Seidel within the rows of each thread, Jacobi-like across threads. Backends other than the host use l1-Jacobi instead.
+    */
+  void set_smoother_type(amg_smoother_type type) { smoother_type_ = type; }
+  /** @brief Returns the smoother used on all levels except the coarsest. */
+  amg_smoother_type get_smoother_type() const { return smoother_type_; }
+
+  /** @brief Sets the degree of the Chebyshev smoother polynomial, i.e. the number of sparse matrix-vector products per smoother application. */
+  void set_chebyshev_degree(unsigned int degree) { if (degree > 0) chebyshev_degree_ = degree; }
+  /** @brief Returns the degree of the Chebyshev smoother polynomial. */
+  unsigned int get_chebyshev_degree() const { return chebyshev_degree_; }
+
+  /** @brief Sets the lower end of the eigenvalue interval damped by the Chebyshev smoother relative to the estimated largest eigenvalue of D^{-1}A. */
+  void set_chebyshev_eigenvalue_ratio(double ratio) { if (ratio > 0 && ratio < 1) chebyshev_eigenvalue_ratio_ = ratio; }
+  /** @brief Returns the lower end of the eigenvalue interval damped by the Chebyshev smoother relative to the largest eigenvalue. */
+  double get_chebyshev_eigenvalue_ratio() const { return chebyshev_eigenvalue_ratio_; }
+
   /** @brief Sets the weight (damping) for the Jacobi smoother.
     *
     * The optimal value depends on the problem at hand. Values of 0.67 or 1.0 are usually a good starting point for further experiments.
@@ -153,6 +185,9 @@ private:
   amg_coarsening_method coarsening_method_;
   amg_interpolation_method interpolation_method_;
   double strong_connection_threshold_, jacobi_weight_;
+  amg_smoother_type smoother_type_;
+  unsigned int chebyshev_degree_;
+  double chebyshev_eigenvalue_ratio_;
   vcl_size_t presmooth_steps_, postsmooth_steps_, coarse_levels_, coarse_cutoff_;
   viennacl::context setup_ctx_, target_ctx_;
 };
@@ -0,0 +1,250 @@
+#ifndef VIENNACL_LINALG_DETAIL_BISECT_BISECT_HOST_HPP_
+#define VIENNACL_LINALG_DETAIL_BISECT_BISECT_HOST_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/linalg/detail/bisect/bisect_host.hpp
+    @brief Multithreaded bisection for the eigenvalues of a symmetric tridiagonal matrix on the host.
+
+    The Gerschgorin interval is split into subintervals holding few eigenvalues each, which are then refined independently by the threads.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <cfloat>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/detail/bisect/gerschgorin.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Returns the number of eigenvalues smaller than x of the symmetric tridiagonal matrix with diagonal d and squared off-diagonal entries e2 (e2[i] couples rows i-1 and i, e2[0] is ignored).
+*
+* Pivots of the LDL^T factorization of T - x I smaller than pivmin in magnitude are replaced by -pivmin.
+*/
+template<typename NumericT>
+vcl_size_t sturm_count(std::vector<NumericT> const & d, std::vector<NumericT> const & e2, NumericT x, NumericT pivmin)
+{
+  vcl_size_t count = 0;
+  NumericT q = d[0] - x;
+  if (q <= pivmin && q >= -pivmin)
+    q = -pivmin;
+  if (q < 0)
+    ++count;
+
+  for (vcl_size_t i = 1; i < d.size(); ++i)
+  {
+    q = d[i] - x - e2[i] / q;
+    if (q <= pivmin && q >= -pivmin)
+      q = -pivmin;
+    if (q < 0)
+      ++count;
+  }
+  return count;
+}
+
+/** @brief A half-open interval [lower, upper) of the spectrum together with the number of eigenvalues below its end points */
+template<typename NumericT>
+struct bisect_interval
+{
+  bisect_interval(NumericT lo, NumericT hi, vcl_size_t count_lo, vcl_size_t count_hi)
+    : lower(lo), upper(hi), count_lower(count_lo), count_upper(count_hi) {}
+
+  NumericT lower;
+  NumericT upper;
+  vcl_size_t count_lower;
+  vcl_size_t count_upper;
+};
+
+/** @brief Settings shared by all intervals of a bisection run */
+template<typename NumericT>
+struct bisect_setup
+{
+  std::vector<NumericT> d;
+  std::vector<NumericT> e2;
+  NumericT pivmin;
+  NumericT abs_tol;
+  vcl_size_t first;
+  vcl_size_t last;
+
+  bool converged(bisect_interval<NumericT> const & iv) const
+  {
+    NumericT tol = abs_tol + NumericT(2) * std::numeric_limits<NumericT>::epsilon() * std::max(std::fabs(iv.lower), std::fabs(iv.upper));
+    return iv.upper - iv.lower <= tol;
+  }
+
+  /** @brief True if the interval holds eigenvalues with indices in the requested range [first, last) */
+  bool wanted(bisect_interval<NumericT> const & iv) const
+  {
+    return iv.count_upper > iv.count_lower && iv.count_upper > first && iv.count_lower < last;
+  }
+};
+
+/** @brief Bisects the interval once. Children without wanted eigenvalues are dropped. */
+template<typename NumericT>
+void bisect_split(bisect_setup<NumericT> const & setup, bisect_interval<NumericT> const & iv, std::vector<bisect_interval<NumericT> > & children)
+{
+  NumericT mid = (iv.lower + iv.upper) / NumericT(2);
+  vcl_size_t count_mid = sturm_count(setup.d, setup.e2, mid, setup.pivmin);
+
+  // rounding in the Sturm sequence might produce counts slightly out of order:
+  count_mid = std::min(std::max(count_mid, iv.count_lower), iv.count_upper);
+
+  bisect_interval<NumericT> left(iv.lower, mid, iv.count_lower, count_mid);
+  bisect_interval<NumericT> right(mid, iv.upper, count_mid, iv.count_upper);
+  if (setup.wanted(left))
+    children.push_back(left);
+  if (setup.wanted(right))
+    children.push_back(right);
+}
+
+/** @brief Refines all eigenvalues inside the interval until convergence. Eigenvalue k (global index) is written to eigenvalues[k - first]. */
+template<typename NumericT>
+void bisect_refine(bisect_setup<NumericT> const & setup, bisect_interval<NumericT> const & iv, std::vector<NumericT> & eigenvalues)
+{
+  std::vector<bisect_interval<NumericT> > stack(1, iv);
+  while (!stack.empty())
+  {
+    bisect_interval<NumericT> current = stack.back();
+    stack.pop_back();
+
+    if (setup.converged(current))
+    {
+      NumericT lambda = (current.lower + current.upper) / NumericT(2);
+      for (vcl_size_t k = std::max(current.count_lower, setup.first); k < std::min(current.count_upper, setup.last); ++k)
+        eigenvalues[k - setup.first] = lambda;
+    }
+    else
+      bisect_split(setup, current, stack);
+  }
+}
+
+/** @brief Sets up the data for the bisection of the eigenvalues with indices [first, last). See bisect_host() for the parameters. */
+template<typename NumericT>
+void bisect_init(bisect_setup<NumericT> & setup, std::vector<NumericT> const & diagonal, std::vector<NumericT> const & superdiagonal,
+                 vcl_size_t first, vcl_size_t last, NumericT abs_tol)
+{
+  vcl_size_t n = diagonal.size();
+  setup.d = diagonal;
+  setup.e2.resize(n);
+  setup.e2[0] = 0;
+  NumericT max_e2 = 0;
+  for (vcl_size_t i = 1; i < n; ++i)
+  {
+    setup.e2[i] = superdiagonal[i] * superdiagonal[i];
+    max_e2 = std::max(max_e2, setup.e2[i]);
+  }
+  setup.pivmin = std::numeric_limits<NumericT>::min() * std::max(NumericT(1), max_e2);
+  setup.abs_tol = std::max(abs_tol, NumericT(2) * setup.pivmin);
+  setup.first = first;
+  setup.last = last;
+}
+
+/** @brief Computes the eigenvalues with indices [first, last) (in ascending order) of the symmetric tridiagonal matrix with diagonal 'diagonal' and off-diagonal 'superdiagonal' using multiple threads.
+*
+* The convention for the off-diagonal follows bisect(): superdiagonal[i] couples rows i-1 and i, superdiagonal[0] is ignored.
+* The Gerschgorin interval is first split into subintervals (at least eight per thread unless the spectrum is too clustered), which are then refined independently.
+*
+* @param diagonal        Diagonal entries
+* @param superdiagonal   Off-diagonal entries, shifted by one
+* @param eigenvalues     Output: the eigenvalues with indices first, ..., last-1
+* @param first           Index of the smallest eigenvalue to be computed
+* @param last            One past the index of the largest eigenvalue to be computed
+* @param abs_tol         Absolute tolerance for the eigenvalues. A relative tolerance of twice the machine epsilon is always added.
+*/
+template<typename NumericT>
+void bisect_host(std::vector<NumericT> const & diagonal, std::vector<NumericT> const & superdiagonal,
+                 std::vector<NumericT> & eigenvalues, vcl_size_t first, vcl_size_t last, NumericT abs_tol)
+{
+  vcl_size_t n = diagonal.size();
+  assert(superdiagonal.size() >= n && first <= last && last <= n && bool("Size mismatch"));
+
+  eigenvalues.resize(last - first);
+  if (first == last)
+    return;
+  if (n == 1)
+  {
+    eigenvalues[0] = diagonal[0];
+    return;
+  }
+
+  bisect_setup<NumericT> setup;
+  bisect_init(setup, diagonal, superdiagonal, first, last, abs_tol);
+
+  // Gerschgorin interval:
+  std::vector<NumericT> s(superdiagonal.begin(), superdiagonal.begin() + vcl_ptrdiff_t(n));
+  NumericT lg =  std::numeric_limits<NumericT>::max();
+  NumericT ug = -std::numeric_limits<NumericT>::max();
+  computeGerschgorin(setup.d, s, static_cast<unsigned int>(n), lg, ug);
+
+  std::vector<bisect_interval<NumericT> > intervals(1, bisect_interval<NumericT>(lg, ug, sturm_count(setup.d, setup.e2, lg, setup.pivmin),
+                                                                                            sturm_count(setup.d, setup.e2, ug, setup.pivmin)));
+  // the interval is enlarged for rounding errors, so its end points are outside of the spectrum:
+  intervals[0].count_lower = 0;
+  intervals[0].count_upper = n;
+
+  // split the interval holding the most eigenvalues until there is enough work for all threads:
+  vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  num_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+  vcl_size_t target_intervals = 8 * num_threads;
+  vcl_size_t target_count     = std::max<vcl_size_t>(1, (last - first) / target_intervals);
+  if (num_threads > 1)
+  {
+    std::vector<bisect_interval<NumericT> > children;
+    for (vcl_size_t iter = 0; iter < 64 * target_intervals && intervals.size() < target_intervals; ++iter)
+    {
+      vcl_size_t largest = intervals.size();
+      for (vcl_size_t i = 0; i < intervals.size(); ++i)
+        if (!setup.converged(intervals[i]) && (largest == intervals.size() || intervals[i].count_upper - intervals[i].count_lower > intervals[largest].count_upper - intervals[largest].count_lower))
+          largest = i;
+
+      if (largest == intervals.size() || intervals[largest].count_upper - intervals[largest].count_lower <= target_count)
+        break;
+
+      children.clear();
+      bisect_split(setup, intervals[largest], children);
+      intervals.erase(intervals.begin() + vcl_ptrdiff_t(largest));
+      intervals.insert(intervals.end(), children.begin(), children.end());
+    }
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic) if (num_threads > 1)
+#endif
+  for (long i = 0; i < static_cast<long>(intervals.size()); ++i)
+    bisect_refine(setup, intervals[static_cast<vcl_size_t>(i)], eigenvalues);
+}
+
+} // namespace detail
+} // namespace linalg
+} // namespace viennacl
+
+#endif
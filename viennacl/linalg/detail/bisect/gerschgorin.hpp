@@ -59,7 +59,7 @@ namespace detail
       {
 
           // sum over the absolute values of all elements of row i
-          NumericT sum_abs_ni = fabsf(s[i]) + fabsf(s[i + 1]);
+          NumericT sum_abs_ni = std::fabs(s[i]) + std::fabs(s[i + 1]);
 
           lg = min(lg, d[i] - sum_abs_ni);
           ug = max(ug, d[i] + sum_abs_ni);
@@ -68,15 +68,15 @@ namespace detail
       // first and last row, only one superdiagonal element
 
       // first row
-      lg = min(lg, d[0] - fabsf(s[1]));
-      ug = max(ug, d[0] + fabsf(s[1]));
+      lg = min(lg, d[0] - std::fabs(s[1]));
+      ug = max(ug, d[0] + std::fabs(s[1]));
 
       // last row
-      lg = min(lg, d[n-1] - fabsf(s[n-1]));
-      ug = max(ug, d[n-1] + fabsf(s[n-1]));
+      lg = min(lg, d[n-1] - std::fabs(s[n-1]));
+      ug = max(ug, d[n-1] + std::fabs(s[n-1]));
 
       // increase interval to avoid side effects of fp arithmetic
-      NumericT bnorm = max(fabsf(ug), fabsf(lg));
+      NumericT bnorm = max(std::fabs(ug), std::fabs(lg));
 
       // these values depend on the implmentation of floating count that is
       // employed in the following
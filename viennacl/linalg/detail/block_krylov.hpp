@@ -0,0 +1,415 @@
+#ifndef VIENNACL_LINALG_DETAIL_BLOCK_KRYLOV_HPP_
+#define VIENNACL_LINALG_DETAIL_BLOCK_KRYLOV_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/block_krylov.hpp
+    @brief Helper routines for the block Krylov solvers operating on a matrix of right hand sides.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Returns a vector view of column j of a dense matrix */
+template<typename NumericT>
+viennacl::vector_base<NumericT> block_column(viennacl::matrix_base<NumericT> & A, vcl_size_t j)
+{
+  if (A.row_major())
+    return viennacl::vector_base<NumericT>(A.handle(), A.size1(), A.start1() * A.internal_size2() + A.start2() + j * A.stride2(), A.stride1() * A.internal_size2());
+  return viennacl::vector_base<NumericT>(A.handle(), A.size1(), (A.start2() + j * A.stride2()) * A.internal_size1() + A.start1(), A.stride1());
+}
+
+/** @brief Copies the dense matrix src to dst. Unlike matrix assignment, the two matrices may have different memory layouts. */
+template<typename NumericT>
+void block_copy(viennacl::matrix_base<NumericT> const & src, viennacl::matrix_base<NumericT> & dst)
+{
+  if (src.row_major() == dst.row_major())
+    dst = src;
+  else
+    for (vcl_size_t j = 0; j < src.size2(); ++j)
+    {
+      viennacl::vector_base<NumericT> dst_column = block_column(dst, j);
+      dst_column = block_column(const_cast<viennacl::matrix_base<NumericT> &>(src), j);
+    }
+}
+
+/** @brief Copies column src_index of A to column dst_index */
+template<typename NumericT>
+void block_copy_column(viennacl::matrix_base<NumericT> & A, vcl_size_t src_index, vcl_size_t dst_index)
+{
+  viennacl::vector_base<NumericT> dst_column = block_column(A, dst_index);
+  dst_column = block_column(A, src_index);
+}
+
+/** @brief Reads a small dense row-major matrix into a row-major array on the host without padding */
+template<typename NumericT>
+void block_read(viennacl::matrix<NumericT, viennacl::row_major> const & A, std::vector<NumericT> & host_A)
+{
+  std::vector<NumericT> buffer(A.internal_size());
+  viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+
+  host_A.resize(A.size1() * A.size2());
+  for (vcl_size_t i = 0; i < A.size1(); ++i)
+    for (vcl_size_t j = 0; j < A.size2(); ++j)
+      host_A[i * A.size2() + j] = buffer[i * A.internal_size2() + j];
+}
+
+/** @brief Writes a row-major array with rows x cols entries from the host to a small dense matrix, which is resized if necessary */
+template<typename NumericT>
+void block_write(std::vector<NumericT> const & host_A, vcl_size_t rows, vcl_size_t cols, viennacl::matrix<NumericT, viennacl::row_major> & A)
+{
+  if (A.size1() != rows || A.size2() != cols)
+    A.resize(rows, cols, false);
+
+  std::vector<NumericT> buffer(A.internal_size());
+  for (vcl_size_t i = 0; i < rows; ++i)
+    for (vcl_size_t j = 0; j < cols; ++j)
+      buffer[i * A.internal_size2() + j] = host_A[i * cols + j];
+  viennacl::backend::memory_write(A.handle(), 0, sizeof(NumericT) * buffer.size(), &(buffer[0]));
+}
+
+/** @brief Computes the Euclidean norms of all columns of A from the diagonal of the Gram matrix A^T A */
+template<typename NumericT>
+void block_column_norms(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & norms)
+{
+  viennacl::matrix<NumericT, viennacl::row_major> G(A.size2(), A.size2(), viennacl::traits::context(A));
+  G = viennacl::linalg::prod(viennacl::trans(A), A);
+  std::vector<NumericT> host_G;
+  block_read(G, host_G);
+
+  norms.resize(A.size2());
+  for (vcl_size_t j = 0; j < norms.size(); ++j)
+    norms[j] = std::sqrt(host_G[j * A.size2() + j]);
+}
+
+/** @brief One pass of a Cholesky QR factorization W = Q S, which drops numerically linearly dependent columns of W.
+*
+* The orthonormal columns are written to the first q columns of Q, which needs to have at least as many columns as W.
+* S is returned in row-major layout with q rows and as many columns as W.
+*
+* @return The number q of linearly independent columns
+*/
+template<typename NumericT>
+vcl_size_t block_cholesky_qr(viennacl::matrix_base<NumericT> const & W,
+                             viennacl::matrix_base<NumericT> & Q,
+                             std::vector<NumericT> & S,
+                             NumericT & condition_estimate)
+{
+  typedef viennacl::matrix<NumericT, viennacl::row_major>   SmallMatrixType;
+
+  vcl_size_t p = W.size2();
+  NumericT drop_tolerance = NumericT(1e4) * std::numeric_limits<NumericT>::epsilon();
+
+  SmallMatrixType G(p, p, viennacl::traits::context(W));
+  G = viennacl::linalg::prod(viennacl::trans(W), W);
+  std::vector<NumericT> host_G;
+  block_read(G, host_G);
+
+  // Cholesky factorization, skipping columns with a (relatively) vanishing pivot:
+  std::vector<vcl_size_t> pivot_columns;
+  std::vector<NumericT> R(p * p); // row-major, row r belongs to the r-th accepted column
+  for (vcl_size_t c = 0; c < p; ++c)
+  {
+    vcl_size_t q = pivot_columns.size();
+    NumericT diag = host_G[c * p + c];
+    for (vcl_size_t r = 0; r < q; ++r)
+    {
+      NumericT value = host_G[pivot_columns[r] * p + c];
+      for (vcl_size_t t = 0; t < r; ++t)
+        value -= R[t * p + pivot_columns[r]] * R[t * p + c];
+      R[r * p + c] = value / R[r * p + pivot_columns[r]];
+      diag -= R[r * p + c] * R[r * p + c];
+    }
+
+    if (diag > drop_tolerance * host_G[c * p + c])
+    {
+      for (vcl_size_t j = 0; j < c; ++j)
+        R[q * p + j] = 0;
+      R[q * p + c] = std::sqrt(diag);
+      pivot_columns.push_back(c);
+    }
+  }
+
+  vcl_size_t q = pivot_columns.size();
+  S.resize(q * p);
+  for (vcl_size_t r = 0; r < q; ++r)
+    for (vcl_size_t c = 0; c < p; ++c)
+      S[r * p + c] = (c < pivot_columns[r]) ? NumericT(0) : R[r * p + c];
+
+  if (q == 0)
+    return 0;
+
+  // ratio of the largest and smallest pivot relative to the column norms, a lower bound for the condition number of W with scaled columns:
+  NumericT min_pivot = S[pivot_columns[0]] / std::sqrt(host_G[pivot_columns[0] * p + pivot_columns[0]]);
+  NumericT max_pivot = min_pivot;
+  for (vcl_size_t r = 1; r < q; ++r)
+  {
+    NumericT pivot = S[r * p + pivot_columns[r]] / std::sqrt(host_G[pivot_columns[r] * p + pivot_columns[r]]);
+    min_pivot = std::min(min_pivot, pivot);
+    max_pivot = std::max(max_pivot, pivot);
+  }
+  condition_estimate = max_pivot / min_pivot;
+
+  // Q = W T, where T (p x q) holds the inverse of the triangular factor of the accepted columns in the rows of these columns:
+  std::vector<NumericT> T(p * q);
+  for (vcl_size_t s = 0; s < q; ++s)
+  {
+    T[pivot_columns[s] * q + s] = NumericT(1) / S[s * p + pivot_columns[s]];
+    for (vcl_size_t r2 = 0; r2 < s; ++r2)
+    {
+      vcl_size_t r = s - r2 - 1;
+      NumericT value = 0;
+      for (vcl_size_t t = r + 1; t <= s; ++t)
+        value -= S[r * p + pivot_columns[t]] * T[pivot_columns[t] * q + s];
+      T[pivot_columns[r] * q + s] = value / S[r * p + pivot_columns[r]];
+    }
+  }
+
+  SmallMatrixType device_T(p, q, viennacl::traits::context(W));
+  block_write(T, p, q, device_T);
+  viennacl::matrix_range<viennacl::matrix_base<NumericT> > Q_range(Q, viennacl::range(0, Q.size1()), viennacl::range(0, q));
+  Q_range = viennacl::linalg::prod(W, device_T);
+
+  return q;
+}
+
+/** @brief Orthonormalizes the columns of W by Cholesky QR: W = Q S
+*
+* Numerically linearly dependent columns are dropped, hence Q has q <= p orthonormal columns and S (row-major) is of size q x p.
+* The loss of orthogonality after one pass is about cond(W)^2 times the machine epsilon, so a second pass (CholQR2) is only carried out if the pivots of the first pass indicate an ill-conditioned block.
+*
+* @param W           The (n x p) block to orthonormalize. Not modified.
+* @param Q           Matrix with n rows and at least p columns. The orthonormal basis is written to the first q columns.
+* @param workspace   Matrix with n rows and at least p columns used for intermediate results
+* @param S           The coefficients of W with respect to Q
+* @return The number q of orthonormal columns
+*/
+template<typename NumericT>
+vcl_size_t block_orthonormalize(viennacl::matrix_base<NumericT> const & W,
+                                viennacl::matrix_base<NumericT> & Q,
+                                viennacl::matrix_base<NumericT> & workspace,
+                                std::vector<NumericT> & S)
+{
+  vcl_size_t p = W.size2();
+
+  NumericT condition_estimate = 0;
+  std::vector<NumericT> S1;
+  vcl_size_t q1 = block_cholesky_qr(W, Q, S1, condition_estimate);
+  if (q1 == 0 || condition_estimate < NumericT(32))
+  {
+    S = S1;
+    return q1;
+  }
+
+  std::vector<NumericT> S2;
+  viennacl::matrix_range<viennacl::matrix_base<NumericT> > Q1(Q, viennacl::range(0, W.size1()), viennacl::range(0, q1));
+  vcl_size_t q = block_cholesky_qr(Q1, workspace, S2, condition_estimate);
+  viennacl::matrix_range<viennacl::matrix_base<NumericT> > Q_range(Q, viennacl::range(0, W.size1()), viennacl::range(0, q));
+  Q_range = viennacl::matrix_range<viennacl::matrix_base<NumericT> >(workspace, viennacl::range(0, W.size1()), viennacl::range(0, q));
+
+  // S = S2 * S1:
+  S.resize(q * p);
+  for (vcl_size_t i = 0; i < q; ++i)
+    for (vcl_size_t j = 0; j < p; ++j)
+    {
+      NumericT value = 0;
+      for (vcl_size_t k = 0; k < q1; ++k)
+        value += S2[i * q1 + k] * S1[k * p + j];
+      S[i * p + j] = value;
+    }
+
+  return q;
+}
+
+/** @brief Solves G Y = F in place for a symmetric positive definite (k x k) matrix G and a right hand side F with m columns, both row-major.
+*
+* @return False if G is not (numerically) positive definite
+*/
+template<typename NumericT>
+bool block_cholesky_solve(std::vector<NumericT> G, vcl_size_t k, std::vector<NumericT> & F, vcl_size_t m)
+{
+  // G = L L^T, L stored in the lower triangle of G:
+  for (vcl_size_t j = 0; j < k; ++j)
+  {
+    for (vcl_size_t i = 0; i < j; ++i)
+    {
+      NumericT value = G[j * k + i];
+      for (vcl_size_t t = 0; t < i; ++t)
+        value -= G[j * k + t] * G[i * k + t];
+      G[j * k + i] = value / G[i * k + i];
+    }
+    NumericT diag = G[j * k + j];
+    for (vcl_size_t t = 0; t < j; ++t)
+      diag -= G[j * k + t] * G[j * k + t];
+    if (diag <= 0)
+      return false;
+    G[j * k + j] = std::sqrt(diag);
+  }
+
+  for (vcl_size_t c = 0; c < m; ++c)
+  {
+    for (vcl_size_t i = 0; i < k; ++i)
+    {
+      NumericT value = F[i * m + c];
+      for (vcl_size_t t = 0; t < i; ++t)
+        value -= G[i * k + t] * F[t * m + c];
+      F[i * m + c] = value / G[i * k + i];
+    }
+    for (vcl_size_t i2 = 0; i2 < k; ++i2)
+    {
+      vcl_size_t i = k - i2 - 1;
+      NumericT value = F[i * m + c];
+      for (vcl_size_t t = i + 1; t < k; ++t)
+        value -= G[t * k + i] * F[t * m + c];
+      F[i * m + c] = value / G[i * k + i];
+    }
+  }
+  return true;
+}
+
+/** @brief Removes converged columns from the active block of a block Krylov solver.
+*
+* Column j of the active block is converged if residual_norms[j] is at most max(rel_tol * rhs_norms[active[j]], abs_tol).
+* The converged columns of X are written to the columns active[j] of result, the remaining columns of X and Y are moved to the front.
+*
+* @param residual_norms  The residual norms of the active columns
+* @param rhs_norms       The norms of all right hand sides
+* @param rel_tol         Relative tolerance
+* @param abs_tol         Absolute tolerance
+* @param active          The indices of the active columns in the system, updated in place
+* @param X               The current approximations for the active columns
+* @param Y               Another block with data for each active column, for example the residuals
+* @param result          The result matrix of the solver
+* @return The number of remaining active columns
+*/
+template<typename NumericT>
+vcl_size_t block_deflate(std::vector<NumericT> const & residual_norms,
+                         std::vector<NumericT> const & rhs_norms,
+                         NumericT rel_tol, NumericT abs_tol,
+                         std::vector<vcl_size_t> & active,
+                         viennacl::matrix_base<NumericT> & X,
+                         viennacl::matrix_base<NumericT> & Y,
+                         viennacl::matrix_base<NumericT> & result)
+{
+  vcl_size_t num_active = 0;
+  for (vcl_size_t j = 0; j < active.size(); ++j)
+  {
+    if (residual_norms[j] <= std::max(rel_tol * rhs_norms[active[j]], abs_tol))
+    {
+      viennacl::vector_base<NumericT> result_column = block_column(result, active[j]);
+      result_column = block_column(X, j);
+    }
+    else
+    {
+      if (num_active < j)
+      {
+        block_copy_column(X, j, num_active);
+        block_copy_column(Y, j, num_active);
+      }
+      active[num_active++] = active[j];
+    }
+  }
+  active.resize(num_active);
+  return num_active;
+}
+
+/** @brief A Householder reflector I - beta v v^T acting on the entries starting at row_start, used for the least squares problem of block GMRES */
+template<typename NumericT>
+struct block_householder_reflector
+{
+  vcl_size_t            row_start;
+  NumericT              beta;
+  std::vector<NumericT> v;
+};
+
+/** @brief Applies a Householder reflector to column col of the row-major (rows x cols) array x */
+template<typename NumericT>
+void block_householder_apply(block_householder_reflector<NumericT> const & reflector, NumericT * x, vcl_size_t cols, vcl_size_t col)
+{
+  NumericT const * v = &(reflector.v[0]);
+  NumericT * x_start = x + reflector.row_start * cols + col;
+
+  NumericT v_dot_x = 0;
+  for (vcl_size_t i = 0; i < reflector.v.size(); ++i)
+    v_dot_x += v[i] * x_start[i * cols];
+  v_dot_x *= reflector.beta;
+  for (vcl_size_t i = 0; i < reflector.v.size(); ++i)
+    x_start[i * cols] -= v_dot_x * v[i];
+}
+
+/** @brief Computes the Householder reflector which maps x(row_start:row_end) to a multiple of the first unit vector. Returns the new value of x(row_start). */
+template<typename NumericT>
+NumericT block_householder_setup(NumericT const * x, vcl_size_t row_start, vcl_size_t row_end, block_householder_reflector<NumericT> & reflector)
+{
+  reflector.row_start = row_start;
+  reflector.v.assign(x + row_start, x + row_end);
+
+  NumericT norm_x = 0;
+  for (vcl_size_t i = 0; i < reflector.v.size(); ++i)
+    norm_x += reflector.v[i] * reflector.v[i];
+  norm_x = std::sqrt(norm_x);
+
+  NumericT alpha = (reflector.v[0] < 0) ? norm_x : -norm_x;
+  reflector.v[0] -= alpha;
+
+  NumericT norm_v_squared = 0;
+  for (vcl_size_t i = 0; i < reflector.v.size(); ++i)
+    norm_v_squared += reflector.v[i] * reflector.v[i];
+  reflector.beta = (norm_v_squared > 0) ? NumericT(2) / norm_v_squared : NumericT(0);
+
+  return (norm_v_squared > 0) ? alpha : x[row_start];
+}
+
+/** @brief Applies the preconditioner to each column of Z */
+template<typename NumericT, typename PreconditionerT>
+void block_precond_apply(PreconditionerT const & precond, viennacl::matrix_base<NumericT> & Z, viennacl::vector<NumericT> & temp)
+{
+  for (vcl_size_t j = 0; j < Z.size2(); ++j)
+  {
+    viennacl::vector_base<NumericT> column = block_column(Z, j);
+    temp = column;
+    precond.apply(temp);
+    column = temp;
+  }
+}
+
+/** @brief Overload for the identity preconditioner */
+template<typename NumericT>
+void block_precond_apply(viennacl::linalg::no_precond const &, viennacl::matrix_base<NumericT> &, viennacl::vector<NumericT> &) {}
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
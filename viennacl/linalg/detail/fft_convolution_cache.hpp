@@ -0,0 +1,149 @@
+#ifndef VIENNACL_LINALG_DETAIL_FFT_CONVOLUTION_CACHE_HPP_
+#define VIENNACL_LINALG_DETAIL_FFT_CONVOLUTION_CACHE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/fft_convolution_cache.hpp
+    @brief Cached spectrum and work vectors for the matrix-vector products of circulant and Toeplitz matrices.
+*/
+
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/fft.hpp"
+#include "viennacl/backend/cpu_ram.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/fft_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Cyclic convolution with the generating vector of a structured matrix.
+*
+* The Fourier transform of the generating vector is computed on first use and kept for subsequent products,
+* so each product only transforms the input vector forth and back. The work vectors are kept as well, hence no memory is allocated in subsequent products.
+* The cache is rebuilt after invalidate() or if the length of the convolution or the memory domain of the generating vector changes.
+* The entries of the generating vector are not compared, hence the owning matrix calls invalidate() from all its non-const accessors.
+* Products are serialized by a mutex, so several threads may multiply with the same (const) matrix.
+*/
+template<typename NumericT>
+class fft_convolution_cache
+{
+public:
+  fft_convolution_cache() : valid_(false), size_(0), memory_(viennacl::MEMORY_NOT_INITIALIZED) {}
+
+  /** @brief Marks the transformed generating vector as outdated. To be called whenever the generating vector changes. */
+  void invalidate()
+  {
+    viennacl::backend::cpu_ram::detail::pool_lock guard(mutex_);
+    valid_ = false;
+  }
+
+  /** @brief Computes the first result.size() entries of the cyclic convolution of length 'size' of 'kernel' and 'vec' (padded with zeros).
+  *
+  * @param kernel  The generating vector of the matrix, of length 'size'
+  * @param vec     The vector to be multiplied
+  * @param result  The result vector
+  * @param size    Length of the cyclic convolution
+  */
+  void apply(viennacl::vector_base<NumericT> const & kernel,
+             viennacl::vector_base<NumericT> const & vec,
+             viennacl::vector_base<NumericT>       & result,
+             vcl_size_t size)
+  {
+    assert(kernel.size() == size && vec.size() <= size && result.size() <= size && bool("Size mismatch"));
+
+    viennacl::backend::cpu_ram::detail::pool_lock guard(mutex_);
+
+    viennacl::memory_types memory = viennacl::traits::handle(kernel).get_active_handle_id();
+    if (!valid_ || size != size_ || memory != memory_)
+      init(kernel, size, memory);
+
+    if (memory == viennacl::MAIN_MEMORY)
+    {
+      host_convolution_.apply(vec, result);
+      return;
+    }
+
+    // transform input, multiply with the cached spectrum, transform back:
+    work_real_.clear();
+    viennacl::copy(vec.begin(), vec.end(), work_real_.begin());
+    viennacl::linalg::real_to_complex(work_real_, work_complex1_, size);
+    viennacl::fft(work_complex1_, work_complex2_);
+    viennacl::linalg::multiply_complex(spectrum_, work_complex2_, work_complex1_);
+    viennacl::ifft(work_complex1_, work_complex2_);
+    viennacl::linalg::complex_to_real(work_complex2_, work_real_, size);
+    viennacl::copy(work_real_.begin(), work_real_.begin() + static_cast<vcl_ptrdiff_t>(result.size()), result.begin());
+  }
+
+private:
+  fft_convolution_cache(fft_convolution_cache const &);
+  fft_convolution_cache & operator=(fft_convolution_cache const &);
+
+  void init(viennacl::vector_base<NumericT> const & kernel, vcl_size_t size, viennacl::memory_types memory)
+  {
+    if (memory == viennacl::MAIN_MEMORY)
+      host_convolution_.init(kernel, size);
+    else
+    {
+      viennacl::context ctx = viennacl::traits::context(kernel);
+      resize_work_vector(spectrum_,      2 * size, ctx);
+      resize_work_vector(work_real_,         size, ctx);
+      resize_work_vector(work_complex1_, 2 * size, ctx);
+      resize_work_vector(work_complex2_, 2 * size, ctx);
+
+      viennacl::linalg::real_to_complex(kernel, work_complex1_, size);
+      viennacl::fft(work_complex1_, spectrum_);
+    }
+
+    size_ = size;
+    memory_ = memory;
+    valid_ = true;
+  }
+
+  static void resize_work_vector(viennacl::vector<NumericT> & v, vcl_size_t size, viennacl::context ctx)
+  {
+    v.switch_memory_context(ctx);
+    v.resize(size, ctx, false);
+  }
+
+  viennacl::backend::cpu_ram::detail::pool_mutex mutex_;
+
+  bool valid_;
+  vcl_size_t size_;
+  viennacl::memory_types memory_;
+
+  viennacl::linalg::host_based::fft_convolution<NumericT> host_convolution_;
+
+  viennacl::vector<NumericT> spectrum_;
+  viennacl::vector<NumericT> work_real_;
+  viennacl::vector<NumericT> work_complex1_;
+  viennacl::vector<NumericT> work_complex2_;
+};
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
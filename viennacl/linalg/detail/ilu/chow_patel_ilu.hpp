@@ -32,6 +32,7 @@
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/linalg/ilu_operations.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/backend/memory.hpp"
 
 namespace viennacl
@@ -40,6 +41,10 @@ namespace linalg
 {
 
 /** @brief A tag for incomplete LU and incomplete Cholesky factorization with static pattern (Parallel-ILU0, Parallel ICC0)
+*
+* In host memory, the sweeps are asynchronous (entries are updated in place) and each Jacobi iteration works Gauss-Seidel-like within one block of rows per thread.
+* Hence, the factors and the preconditioner differ from the ones obtained on OpenCL or CUDA devices for the same tag, and depend on the number of OpenMP threads.
+* Fewer sweeps and Jacobi iterations are usually sufficient on the host.
 */
 class chow_patel_tag
 {
@@ -49,7 +54,7 @@ public:
     * @param num_sweeps        Number of sweeps in setup phase
     * @param num_jacobi_iters  Number of Jacobi iterations for each triangular 'solve' when applying the preconditioner to a vector
     */
-  chow_patel_tag(vcl_size_t num_sweeps = 3, vcl_size_t num_jacobi_iters = 2) : sweeps_(num_sweeps), jacobi_iters_(num_jacobi_iters) {}
+  chow_patel_tag(vcl_size_t num_sweeps = 3, vcl_size_t num_jacobi_iters = 2) : sweeps_(num_sweeps), jacobi_iters_(num_jacobi_iters), sweep_tolerance_(0), jacobi_tolerance_(0) {}
 
   /** @brief Returns the number of sweeps (i.e. number of nonlinear iterations) in the solver setup stage */
   vcl_size_t sweeps() const { return sweeps_; }
@@ -61,9 +66,24 @@ public:
   /** @brief Sets the number of Jacobi iterations for each triangular 'solve' when applying the preconditioner to a vector. */
   void       jacobi_iters(vcl_size_t num) { jacobi_iters_ = num; }
 
+  /** @brief Returns the tolerance for the relative nonlinear residual at which the sweeps in host memory stop early. Zero (default) runs all sweeps. */
+  double     sweep_tolerance() const { return sweep_tolerance_; }
+  /** @brief Sets the tolerance for the relative nonlinear residual at which the sweeps in host memory stop early, sweeps() is then the maximum number of sweeps. */
+  void       sweep_tolerance(double tol) { sweep_tolerance_ = tol; }
+
+  /** @brief Returns the tolerance for the relative update at which the Jacobi iterations in host memory stop early. Zero (default) runs all iterations. */
+  double     jacobi_tolerance() const { return jacobi_tolerance_; }
+  /** @brief Sets the tolerance for the relative update at which the Jacobi iterations in host memory stop early, jacobi_iters() is then the maximum number of iterations.
+    *
+    * Note that the preconditioner is no longer a fixed linear operator if a tolerance is set, which may affect the convergence of e.g. CG.
+    */
+  void       jacobi_tolerance(double tol) { jacobi_tolerance_ = tol; }
+
 private:
   vcl_size_t sweeps_;
   vcl_size_t jacobi_iters_;
+  double     sweep_tolerance_;
+  double     jacobi_tolerance_;
 };
 
 namespace detail
@@ -93,8 +113,19 @@ namespace detail
     viennacl::backend::memory_copy(L.handle(), aij_L.handle(), 0, 0, sizeof(NumericT) * L.nnz());
 
     // run sweeps:
-    for (vcl_size_t i=0; i<tag.sweeps(); ++i)
-      viennacl::linalg::icc_chow_patel_sweep(L, aij_L);
+    if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+    {
+      NumericT aij_norm_squared = viennacl::linalg::inner_prod(aij_L, aij_L);
+      NumericT tolerance = static_cast<NumericT>(tag.sweep_tolerance());
+      for (vcl_size_t i=0; i<tag.sweeps(); ++i)
+        if (viennacl::linalg::host_based::icc_chow_patel_sweep_async(L, aij_L) <= tolerance * tolerance * aij_norm_squared)
+          break;
+    }
+    else
+    {
+      for (vcl_size_t i=0; i<tag.sweeps(); ++i)
+        viennacl::linalg::icc_chow_patel_sweep(L, aij_L);
+    }
 
     // transpose L to obtain L_trans:
     viennacl::linalg::ilu_transpose(L, L_trans);
@@ -136,8 +167,19 @@ namespace detail
     viennacl::backend::memory_copy(U_trans.handle(), aij_U_trans.handle(), 0, 0, sizeof(NumericT) * U_trans.nnz());
 
     // run sweeps:
-    for (vcl_size_t i=0; i<tag.sweeps(); ++i)
-      viennacl::linalg::ilu_chow_patel_sweep(L, aij_L, U_trans, aij_U_trans);
+    if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+    {
+      NumericT aij_norm_squared = viennacl::linalg::inner_prod(aij_L, aij_L) + viennacl::linalg::inner_prod(aij_U_trans, aij_U_trans);
+      NumericT tolerance = static_cast<NumericT>(tag.sweep_tolerance());
+      for (vcl_size_t i=0; i<tag.sweeps(); ++i)
+        if (viennacl::linalg::host_based::ilu_chow_patel_sweep_async(L, aij_L, U_trans, aij_U_trans) <= tolerance * tolerance * aij_norm_squared)
+          break;
+    }
+    else
+    {
+      for (vcl_size_t i=0; i<tag.sweeps(); ++i)
+        viennacl::linalg::ilu_chow_patel_sweep(L, aij_L, U_trans, aij_U_trans);
+    }
 
     // transpose U_trans back:
     viennacl::linalg::ilu_transpose(U_trans, U);
@@ -189,6 +231,14 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
+    if (viennacl::traits::handle(vec).get_active_handle_id() == viennacl::MAIN_MEMORY)
+    {
+      NumericT tolerance = static_cast<NumericT>(tag_.jacobi_tolerance());
+      viennacl::linalg::host_based::ilu_jacobi_solve(L_,       diag_L_, vec, x_k_, b_, true,  tag_.jacobi_iters(), tolerance);
+      viennacl::linalg::host_based::ilu_jacobi_solve(L_trans_, diag_L_, vec, x_k_, b_, false, tag_.jacobi_iters(), tolerance);
+      return;
+    }
+
     //
     // y = L^{-1} b through Jacobi iteration y_{k+1} = (I - D^{-1}L)y_k + D^{-1}x
     //
@@ -268,6 +318,14 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
+    if (viennacl::traits::handle(vec).get_active_handle_id() == viennacl::MAIN_MEMORY)
+    {
+      NumericT tolerance = static_cast<NumericT>(tag_.jacobi_tolerance());
+      viennacl::linalg::host_based::ilu_jacobi_solve(L_, diag_L_, vec, x_k_, b_, true,  tag_.jacobi_iters(), tolerance);
+      viennacl::linalg::host_based::ilu_jacobi_solve(U_, diag_U_, vec, x_k_, b_, false, tag_.jacobi_iters(), tolerance);
+      return;
+    }
+
     //
     // y = L^{-1} b through Jacobi iteration y_{k+1} = (I - D^{-1}L)y_k + D^{-1}x
     //
@@ -45,6 +45,7 @@
 #include "viennacl/backend/memory.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 
 #include <map>
 
@@ -163,8 +164,8 @@ public:
     unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle2());
     NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(LU_.handle());
 
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), unit_lower_tag());
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), upper_tag());
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), L_schedule_, unit_lower_tag());
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LU_.size2(), U_schedule_, upper_tag());
   }
 
 private:
@@ -175,10 +176,15 @@ private:
 
     viennacl::copy(mat, LU_);
     viennacl::linalg::precondition(LU_, tag_);
+
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(LU_, L_schedule_, true);
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(LU_, U_schedule_, false);
   }
 
   ilu0_tag                                   tag_;
   viennacl::compressed_matrix<NumericType>   LU_;
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule U_schedule_;
 };
 
 
@@ -230,8 +236,7 @@ public:
       {
         viennacl::context old_context = viennacl::traits::context(vec);
         viennacl::switch_memory_context(vec, host_context);
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+        apply_host(vec);
         viennacl::switch_memory_context(vec, old_context);
       }
     }
@@ -257,16 +262,25 @@ public:
                                             multifrontal_U_row_elimination_num_list_);
       }
       else
-      {
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
-      }
+        apply_host(vec);
     }
   }
 
   vcl_size_t levels() const { return multifrontal_L_row_index_arrays_.size(); }
 
 private:
+  /** @brief Forward and backward substitution in host memory, level-scheduled in parallel if the dependency graphs of L and U are shallow enough */
+  void apply_host(viennacl::vector<NumericT> & vec) const
+  {
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle2());
+    NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU_.handle());
+    NumericT           * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, LU_.size2(), L_schedule_, unit_lower_tag());
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, LU_.size2(), U_schedule_, upper_tag());
+  }
+
   void init(MatrixType const & mat)
   {
     viennacl::context host_context(viennacl::MAIN_MEMORY);
@@ -275,7 +289,11 @@ private:
     viennacl::linalg::precondition(LU_, tag_);
 
     if (!tag_.use_level_scheduling())
+    {
+      viennacl::linalg::host_based::detail::csr_level_schedule_setup(LU_, L_schedule_, true);
+      viennacl::linalg::host_based::detail::csr_level_schedule_setup(LU_, U_schedule_, false);
       return;
+    }
 
     // multifrontal part:
     viennacl::switch_memory_context(multifrontal_U_diagonal_, host_context);
@@ -353,6 +371,8 @@ private:
 
   ilu0_tag tag_;
   viennacl::compressed_matrix<NumericT> LU_;
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule U_schedule_;
 
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_index_arrays_;
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_buffers_;
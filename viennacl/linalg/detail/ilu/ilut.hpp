@@ -25,6 +25,8 @@
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
+#include <functional>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 
@@ -32,8 +34,12 @@
 #include "viennacl/compressed_matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
+
+#if defined(VIENNACL_WITH_OPENMP) && !defined(_WIN32)
+#include <sched.h>
+#endif
 
-#include <map>
 
 namespace viennacl
 {
@@ -41,6 +47,10 @@ namespace linalg
 {
 
 /** @brief A tag for incomplete LU factorization with threshold (ILUT)
+*
+* On the host, each thread of the factorization holds a dense working row of the size of the matrix,
+* i.e. about (sizeof(NumericT) + sizeof(unsigned int)) * n bytes per thread for n rows (about 120 MB per thread for n = 10^7 in double precision).
+* Limit the number of OpenMP threads if this exceeds the available memory.
 */
 class ilut_tag
 {
@@ -85,96 +95,219 @@ class ilut_tag
 
 namespace detail
 {
-  /** @brief Helper struct for holding a sparse vector in linear memory. For internal use only.
-    *
-    * Unfortunately, the 'naive' implementation using a std::map<> is almost always too slow.
+  /** @brief Per-thread working row of the ILUT factorization. For internal use only.
     *
+    * The row is scattered to a dense array, a marker array flags the columns occupied in the current row.
+    * Column indices left of the diagonal are kept in a min-heap, so that they are eliminated in increasing order including fill-in.
     */
   template<typename NumericT>
-  struct ilut_sparse_vector
+  struct ilut_working_row
   {
-    ilut_sparse_vector(vcl_size_t alloc_size = 0) : size_(0), col_indices_(alloc_size), elements_(alloc_size) {}
+    ilut_working_row(vcl_size_t size) : values_(size), marker_(size, static_cast<unsigned int>(size)) {}
+
+    std::vector<NumericT>     values_;
+    std::vector<unsigned int> marker_;
+    std::vector<unsigned int> columns_;
+    std::vector<unsigned int> lower_columns_; // min-heap
+    std::vector<std::pair<unsigned int, NumericT> > entries_L_;
+    std::vector<std::pair<unsigned int, NumericT> > entries_U_;
+  };
 
-    void resize_if_bigger(vcl_size_t s)
+  /** @brief Orders entries by decreasing magnitude, ties are broken by increasing column index. */
+  template<typename NumericT>
+  struct ilut_larger_magnitude
+  {
+    bool operator()(std::pair<unsigned int, NumericT> const & a, std::pair<unsigned int, NumericT> const & b) const
     {
-      if (s > elements_.size())
-      {
-        col_indices_.resize(s);
-        elements_.resize(s);
-      }
-      size_ = s;
+      NumericT abs_a = std::fabs(a.second);
+      NumericT abs_b = std::fabs(b.second);
+      return abs_a > abs_b || (abs_a >= abs_b && a.first < b.first);
     }
-
-    vcl_size_t size_;
-    std::vector<unsigned int> col_indices_;
-    std::vector<NumericT>     elements_;
   };
 
-  /** @brief Subtracts a scaled sparse vector u from a sparse vector w and writes the output to z: z = w - alpha * u
+  /** @brief Keeps the max_entries entries of largest magnitude (partial selection) and sorts them by column index. */
+  template<typename NumericT>
+  void ilut_keep_largest(std::vector<std::pair<unsigned int, NumericT> > & entries, vcl_size_t max_entries)
+  {
+    if (entries.size() > max_entries)
+    {
+      std::nth_element(entries.begin(), entries.begin() + static_cast<long>(max_entries), entries.end(), ilut_larger_magnitude<NumericT>());
+      entries.resize(max_entries);
+    }
+    std::sort(entries.begin(), entries.end());
+  }
+
+  /** @brief Waits until the given row of U has been computed by another thread. */
+  inline void ilut_wait_for_row(std::vector<char> const & row_done, vcl_size_t row)
+  {
+    volatile char const * flag = &(row_done[row]);
+    for (vcl_size_t spins = 0; !*flag; ++spins)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp flush
+#endif
+#if defined(VIENNACL_WITH_OPENMP) && !defined(_WIN32)
+      if (spins > 1000) // give up the time slice if threads outnumber cores
+        sched_yield();
+#endif
+    }
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp flush
+#endif
+  }
+
+  /** @brief Computes row i of L and U (refer to Algorithm 10.6 by Saad's book, 1996 edition).
     *
-    * Sparsity pattern of u and w are usually different.
+    * Rows of L and U are stored in fixed slots of entries_per_row and entries_per_row+1 entries. The diagonal is the first entry of each row of U.
     *
-    * @return Length of new vector
+    * @return False if the diagonal entry of U computed to zero
     */
-  template<typename IndexT, typename NumericT>
-  IndexT merge_subtract_sparse_rows(IndexT const * w_coords, NumericT const * w_elements, IndexT w_size,
-                                    IndexT const * u_coords, NumericT const * u_elements, IndexT u_size, NumericT alpha,
-                                    IndexT       * z_coords, NumericT       * z_elements)
+  template<typename NumericT>
+  bool ilut_factor_row(vcl_size_t i,
+                       unsigned int const * row_buffer_A, unsigned int const * col_buffer_A, NumericT const * elements_A,
+                       unsigned int * row_length_L, unsigned int * col_buffer_L, NumericT * elements_L,
+                       unsigned int * row_length_U, unsigned int * col_buffer_U, NumericT * elements_U,
+                       std::vector<char> const & row_done, bool wait_for_rows,
+                       ilut_tag const & tag,
+                       ilut_working_row<NumericT> & w)
   {
-    IndexT index_w = 0;
-    IndexT index_u = 0;
-    IndexT index_z = 0;
+    vcl_size_t entries_per_row = tag.get_entries_per_row();
+    unsigned int row = static_cast<unsigned int>(i);
+    std::greater<unsigned int> heap_order;
 
-    while (1)
+    w.columns_.clear();
+    w.lower_columns_.clear();
+
+    //line 2: set up w
+    NumericT row_norm = 0;
+    for (unsigned int j = row_buffer_A[i]; j < row_buffer_A[i+1]; ++j)
     {
-      if (index_w < w_size && index_u < u_size)
+      unsigned int col = col_buffer_A[j];
+      NumericT entry = elements_A[j];
+      row_norm += entry * entry;
+
+      if (w.marker_[col] != row)
       {
-        if (w_coords[index_w] < u_coords[index_u])
+        w.marker_[col] = row;
+        w.values_[col] = entry;
+        w.columns_.push_back(col);
+        if (col < row)
         {
-          z_coords[index_z]     = w_coords[index_w];
-          z_elements[index_z++] = w_elements[index_w++];
+          w.lower_columns_.push_back(col);
+          std::push_heap(w.lower_columns_.begin(), w.lower_columns_.end(), heap_order);
         }
-        else if (w_coords[index_w] == u_coords[index_u])
+      }
+      else
+        w.values_[col] = entry;
+    }
+    row_norm = std::sqrt(row_norm);
+    NumericT tau_i = static_cast<NumericT>(tag.get_drop_tolerance()) * row_norm;
+
+    //line 3: Iterate over lower diagonal parts of w in increasing order, including fill-in:
+    while (w.lower_columns_.size() > 0)
+    {
+      std::pop_heap(w.lower_columns_.begin(), w.lower_columns_.end(), heap_order);
+      unsigned int k = w.lower_columns_.back();
+      w.lower_columns_.pop_back();
+
+      if (wait_for_rows)
+        ilut_wait_for_row(row_done, k);
+
+      //line 4:
+      NumericT const * row_U_elements = elements_U   + k * (entries_per_row + 1);
+      unsigned int const * row_U_cols = col_buffer_U + k * (entries_per_row + 1);
+      NumericT w_k_entry = w.values_[k] / row_U_elements[0];
+
+      //lines 5,6: (dropping rule to w_k)
+      if (std::fabs(w_k_entry) <= tau_i)
+      {
+        w.values_[k] = 0;
+        continue;
+      }
+      w.values_[k] = w_k_entry;
+
+      //line 7:
+      for (unsigned int j = 1; j < row_length_U[k]; ++j)
+      {
+        unsigned int col = row_U_cols[j];
+        if (w.marker_[col] != row)
         {
-          z_coords[index_z]     = w_coords[index_w];
-          z_elements[index_z++] = w_elements[index_w++] - alpha * u_elements[index_u++];
+          w.marker_[col] = row;
+          w.values_[col] = - w_k_entry * row_U_elements[j];
+          w.columns_.push_back(col);
+          if (col < row)
+          {
+            w.lower_columns_.push_back(col);
+            std::push_heap(w.lower_columns_.begin(), w.lower_columns_.end(), heap_order);
+          }
         }
         else
-        {
-          z_coords[index_z]     = u_coords[index_u];
-          z_elements[index_z++] = - alpha * u_elements[index_u++];
-        }
+          w.values_[col] -= w_k_entry * row_U_elements[j];
       }
-      else if (index_w == w_size && index_u < u_size)
-      {
-        z_coords[index_z]     = u_coords[index_u];
-        z_elements[index_z++] = - alpha * u_elements[index_u++];
-      }
-      else if (index_w < w_size && index_u == u_size)
+    }
+
+    // Line 10: Apply a dropping rule to w
+    w.entries_L_.clear();
+    w.entries_U_.clear();
+    NumericT diagonal = 0;
+    for (vcl_size_t r = 0; r < w.columns_.size(); ++r)
+    {
+      unsigned int col   = w.columns_[r];
+      NumericT     value = w.values_[col];
+
+      if (col == row) // do not drop diagonal element
+        diagonal = value;
+      else if (value > 0 || value < 0)
       {
-        z_coords[index_z]     = w_coords[index_w];
-        z_elements[index_z++] = w_elements[index_w++];
+        if (col < row) // entry for L:
+          w.entries_L_.push_back(std::make_pair(col, value));
+        else // entry for U:
+          w.entries_U_.push_back(std::make_pair(col, value));
       }
-      else
-        return index_z;
     }
+
+    //Lines 10-12: write the largest p values to L and U
+    ilut_keep_largest(w.entries_L_, entries_per_row);
+    ilut_keep_largest(w.entries_U_, entries_per_row);
+
+    unsigned int * row_L_cols = col_buffer_L + i * entries_per_row;
+    NumericT     * row_L_elements = elements_L + i * entries_per_row;
+    for (vcl_size_t j = 0; j < w.entries_L_.size(); ++j)
+    {
+      row_L_cols[j]     = w.entries_L_[j].first;
+      row_L_elements[j] = w.entries_L_[j].second;
+    }
+    row_length_L[i] = static_cast<unsigned int>(w.entries_L_.size());
+
+    unsigned int * row_U_cols = col_buffer_U + i * (entries_per_row + 1);
+    NumericT     * row_U_elements = elements_U + i * (entries_per_row + 1);
+    row_U_cols[0]     = row;
+    row_U_elements[0] = diagonal;
+    for (vcl_size_t j = 0; j < w.entries_U_.size(); ++j)
+    {
+      row_U_cols[j+1]     = w.entries_U_[j].first;
+      row_U_elements[j+1] = w.entries_U_[j].second;
+    }
+    row_length_U[i] = static_cast<unsigned int>(w.entries_U_.size() + 1);
+
+    return w.marker_[row] != row || diagonal > 0 || diagonal < 0;
   }
 
-  template<typename SizeT, typename NumericT>
-  void insert_with_value_sort(std::vector<std::pair<SizeT, NumericT> > & map,
-                              SizeT index, NumericT value)
+  /** @brief Moves the rows of a CSR matrix stored in fixed slots of slot_size entries to consecutive positions and sets up the row array. */
+  template<typename NumericT>
+  void ilut_compress_rows(vcl_size_t size, vcl_size_t slot_size, unsigned int const * row_length,
+                          unsigned int * row_buffer, unsigned int * col_buffer, NumericT * elements)
   {
-    NumericT abs_value = std::fabs(value);
-    if (abs_value > 0)
+    row_buffer[0] = 0;
+    for (vcl_size_t i = 0; i < size; ++i)
     {
-      // find first element with smaller absolute value:
-      std::size_t first_smaller_index = 0;
-      while (first_smaller_index < map.size() && std::fabs(map[first_smaller_index].second) > abs_value)
-        ++first_smaller_index;
-
-      std::pair<SizeT, NumericT> tmp(index, value);
-      for (std::size_t j=first_smaller_index; j<map.size(); ++j)
-        std::swap(map[j], tmp);
+      unsigned int offset = row_buffer[i];
+      for (unsigned int j = 0; j < row_length[i]; ++j)
+      {
+        col_buffer[offset + j] = col_buffer[i * slot_size + j];
+        elements[offset + j]   = elements[i * slot_size + j];
+      }
+      row_buffer[i+1] = offset + row_length[i];
     }
   }
 
@@ -184,6 +317,11 @@ namespace detail
 *
 * refer to Algorithm 10.6 by Saad's book (1996 edition)
 *
+* The working row is scattered to a dense array, the largest entries of each row are obtained by partial selection.
+* With OpenMP, rows are distributed cyclically over the threads. A row waits only for the rows of U it actually eliminates with,
+* so independent rows are factored concurrently and the result is identical to the sequential factorization.
+* Each thread holds a dense working row of the size of the matrix.
+*
 *  @param A       The input matrix. Either a compressed_matrix or of type std::vector< std::map<T, U> >
 *  @param L       The output matrix for L.
 *  @param U       The output matrix for U.
@@ -198,151 +336,75 @@ void precondition(viennacl::compressed_matrix<NumericT> const & A,
   assert(A.size1() == L.size1() && bool("Output matrix size mismatch") );
   assert(A.size1() == U.size1() && bool("Output matrix size mismatch") );
 
-  L.reserve( tag.get_entries_per_row()      * A.size1());
-  U.reserve((tag.get_entries_per_row() + 1) * A.size1());
+  vcl_size_t size = A.size1();
+  vcl_size_t entries_per_row = tag.get_entries_per_row();
 
-  vcl_size_t avg_nnz_per_row = static_cast<vcl_size_t>(A.nnz() / A.size1());
-  detail::ilut_sparse_vector<NumericT> w1(tag.get_entries_per_row() * (avg_nnz_per_row + 10));
-  detail::ilut_sparse_vector<NumericT> w2(tag.get_entries_per_row() * (avg_nnz_per_row + 10));
-  detail::ilut_sparse_vector<NumericT> * w_in  = &w1;
-  detail::ilut_sparse_vector<NumericT> * w_out = &w2;
-  std::vector<NumericT> diagonal_U(A.size1());
+  L.reserve( entries_per_row      * size);
+  U.reserve((entries_per_row + 1) * size);
 
   NumericT     const * elements_A   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
   unsigned int const * row_buffer_A = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
   unsigned int const * col_buffer_A = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
 
   NumericT           * elements_L   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L.handle());
-  unsigned int       * row_buffer_L = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle1()); row_buffer_L[0] = 0;
+  unsigned int       * row_buffer_L = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle1());
   unsigned int       * col_buffer_L = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle2());
 
   NumericT           * elements_U   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(U.handle());
-  unsigned int       * row_buffer_U = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.handle1()); row_buffer_U[0] = 0;
+  unsigned int       * row_buffer_U = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.handle1());
   unsigned int       * col_buffer_U = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.handle2());
 
-  std::vector<std::pair<unsigned int, NumericT> > sorted_entries_L(tag.get_entries_per_row());
-  std::vector<std::pair<unsigned int, NumericT> > sorted_entries_U(tag.get_entries_per_row());
+  // rows are computed into fixed slots first, lengths are kept separately:
+  std::vector<unsigned int> row_length_L(size + 1);
+  std::vector<unsigned int> row_length_U(size + 1);
+  std::vector<char> row_done(size + 1, 0);
+  vcl_size_t zero_diagonal_row = size;
 
-  for (vcl_size_t i=0; i<viennacl::traits::size1(A); ++i)  // Line 1
+  bool wait_for_rows = false;
+#ifdef VIENNACL_WITH_OPENMP
+  wait_for_rows = omp_get_max_threads() > 1 && size > 1000;
+  #pragma omp parallel if (wait_for_rows)
+#endif
   {
-    std::fill(sorted_entries_L.begin(), sorted_entries_L.end(), std::pair<unsigned int, NumericT>(0, NumericT(0)));
-    std::fill(sorted_entries_U.begin(), sorted_entries_U.end(), std::pair<unsigned int, NumericT>(0, NumericT(0)));
-
-    //line 2: set up w
-    w_in->resize_if_bigger(row_buffer_A[i+1] - row_buffer_A[i]);
-    NumericT row_norm = 0;
-    unsigned int k = 0;
-    for (unsigned int j = row_buffer_A[i]; j < row_buffer_A[i+1]; ++j, ++k)
-    {
-      w_in->col_indices_[k] = col_buffer_A[j];
-      NumericT entry = elements_A[j];
-      w_in->elements_[k] = entry;
-      row_norm += entry * entry;
-    }
-    row_norm = std::sqrt(row_norm);
-    NumericT tau_i = static_cast<NumericT>(tag.get_drop_tolerance()) * row_norm;
+    detail::ilut_working_row<NumericT> w(size);
 
-    //line 3: Iterate over lower diagonal parts of A:
-    k = 0;
-    unsigned int current_col = (row_buffer_A[i+1] > row_buffer_A[i]) ? w_in->col_indices_[k] : static_cast<unsigned int>(i); // mind empty rows here!
-    while (current_col < i)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(static, 16)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(size); ++i2)  // Line 1
     {
-      //line 4:
-      NumericT a_kk = diagonal_U[current_col];
-
-      NumericT w_k_entry = w_in->elements_[k] / a_kk;
-      w_in->elements_[k] = w_k_entry;
-
-      //lines 5,6: (dropping rule to w_k)
-      if ( std::fabs(w_k_entry) > tau_i)
-      {
-        //line 7:
-        unsigned int row_U_begin = row_buffer_U[current_col];
-        unsigned int row_U_end   = row_buffer_U[current_col + 1];
-
-        if (row_U_end > row_U_begin)
-        {
-          w_out->resize_if_bigger(w_in->size_ + (row_U_end - row_U_begin) - 1);
-          w_out->size_ = detail::merge_subtract_sparse_rows(&(w_in->col_indices_[0]), &(w_in->elements_[0]), static_cast<unsigned int>(w_in->size_),
-                                                            col_buffer_U + row_U_begin + 1, elements_U + row_U_begin + 1, (row_U_end - row_U_begin) - 1, w_k_entry,
-                                                            &(w_out->col_indices_[0]), &(w_out->elements_[0])
-                                                           );
-          ++k;
-        }
-      }
-      else // drop element
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      if (!detail::ilut_factor_row(i,
+                                   row_buffer_A, col_buffer_A, elements_A,
+                                   &(row_length_L[0]), col_buffer_L, elements_L,
+                                   &(row_length_U[0]), col_buffer_U, elements_U,
+                                   row_done, wait_for_rows, tag, w))
       {
-        w_out->resize_if_bigger(w_in->size_ - 1);
-        for (unsigned int r = 0; r < k; ++r)
-        {
-          w_out->col_indices_[r] = w_in->col_indices_[r];
-          w_out->elements_[r]    = w_in->elements_[r];
-        }
-        for (unsigned int r = k+1; r < w_in->size_; ++r)
-        {
-          w_out->col_indices_[r-1] = w_in->col_indices_[r];
-          w_out->elements_[r-1]    = w_in->elements_[r];
-        }
-
-        // Note: No increment to k here, element was dropped!
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp critical (viennacl_ilut_zero_diagonal)
+#endif
+        zero_diagonal_row = std::min(zero_diagonal_row, i);
       }
 
-      // swap pointers to w1 and w2
-      std::swap(w_in, w_out);
-
-      // process next entry:
-      current_col = (k < w_in->size_) ? w_in->col_indices_[k] : static_cast<unsigned int>(i);
-    } // while()
-
-    // Line 10: Apply a dropping rule to w
-    // To do so, we write values to a temporary array
-    for (unsigned int r = 0; r < w_in->size_; ++r)
-    {
-      unsigned int col   = w_in->col_indices_[r];
-      NumericT     value = w_in->elements_[r];
-
-      if (col < i) // entry for L:
-        detail::insert_with_value_sort(sorted_entries_L, col, value);
-      else if (col == i) // do not drop diagonal element
-      {
-        diagonal_U[i] = value;
-        if (value <= 0 && value >= 0)
-        {
-          std::cerr << "ViennaCL: FATAL ERROR in ILUT(): Diagonal entry computed to zero (" << value << ") in row " << i << "!" << std::endl;
-          throw zero_on_diagonal_exception("ILUT zero diagonal!");
-        }
-      }
-      else // entry for U:
-        detail::insert_with_value_sort(sorted_entries_U, col, value);
+      // publish the row to threads waiting for it:
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp flush
+#endif
+      row_done[i] = 1;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp flush
+#endif
     }
+  }
 
-    //Lines 10-12: Apply a dropping rule to w, write the largest p values to L and U
-    unsigned int offset_L = row_buffer_L[i];
-    std::sort(sorted_entries_L.begin(), sorted_entries_L.end());
-    for (unsigned int j=0; j<tag.get_entries_per_row(); ++j)
-      if (std::fabs(sorted_entries_L[j].second) > 0)
-      {
-        col_buffer_L[offset_L] = sorted_entries_L[j].first;
-        elements_L[offset_L]   = sorted_entries_L[j].second;
-        ++offset_L;
-      }
-    row_buffer_L[i+1] = offset_L;
-
-    unsigned int offset_U = row_buffer_U[i];
-    col_buffer_U[offset_U] = static_cast<unsigned int>(i);
-    elements_U[offset_U]   = diagonal_U[i];
-    ++offset_U;
-    std::sort(sorted_entries_U.begin(), sorted_entries_U.end());
-    for (unsigned int j=0; j<tag.get_entries_per_row(); ++j)
-      if (std::fabs(sorted_entries_U[j].second) > 0)
-      {
-        col_buffer_U[offset_U] = sorted_entries_U[j].first;
-        elements_U[offset_U]   = sorted_entries_U[j].second;
-        ++offset_U;
-      }
-    row_buffer_U[i+1] = offset_U;
+  if (zero_diagonal_row < size)
+  {
+    std::cerr << "ViennaCL: FATAL ERROR in ILUT(): Diagonal entry computed to zero in row " << zero_diagonal_row << "!" << std::endl;
+    throw zero_on_diagonal_exception("ILUT zero diagonal!");
+  }
 
-  } //for i
+  detail::ilut_compress_rows(size, entries_per_row,     &(row_length_L[0]), row_buffer_L, col_buffer_L, elements_L);
+  detail::ilut_compress_rows(size, entries_per_row + 1, &(row_length_U[0]), row_buffer_U, col_buffer_U, elements_U);
 }
 
 
@@ -371,14 +433,14 @@ public:
       unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle2());
       NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(L_.handle());
 
-      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, L_.size2(), unit_lower_tag());
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, L_.size2(), L_schedule_, unit_lower_tag());
     }
     {
       unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U_.handle1());
       unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U_.handle2());
       NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(U_.handle());
 
-      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, U_.size2(), upper_tag());
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, U_.size2(), U_schedule_, upper_tag());
     }
   }
 
@@ -394,11 +456,16 @@ private:
     viennacl::copy(mat, temp);
 
     viennacl::linalg::precondition(temp, L_, U_, tag_);
+
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(L_, L_schedule_, true);
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(U_, U_schedule_, false);
   }
 
   ilut_tag tag_;
   viennacl::compressed_matrix<NumericType> L_;
   viennacl::compressed_matrix<NumericType> U_;
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule U_schedule_;
 };
 
 
@@ -452,19 +519,35 @@ public:
         viennacl::context host_context(viennacl::MAIN_MEMORY);
         viennacl::context old_context = viennacl::traits::context(vec);
         viennacl::switch_memory_context(vec, host_context);
-        viennacl::linalg::inplace_solve(L_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(U_, vec, upper_tag());
+        apply_host(vec);
         viennacl::switch_memory_context(vec, old_context);
       }
     }
     else //apply ILUT directly:
+      apply_host(vec);
+  }
+
+private:
+  /** @brief Forward and backward substitution in host memory, level-scheduled in parallel if the dependency graphs of L and U are shallow enough */
+  void apply_host(viennacl::vector<NumericT> & vec) const
+  {
+    NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+    {
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle2());
+      NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L_.handle());
+
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, L_.size2(), L_schedule_, unit_lower_tag());
+    }
     {
-      viennacl::linalg::inplace_solve(L_, vec, unit_lower_tag());
-      viennacl::linalg::inplace_solve(U_, vec, upper_tag());
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U_.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U_.handle2());
+      NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(U_.handle());
+
+      viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, U_.size2(), U_schedule_, upper_tag());
     }
   }
 
-private:
   void init(MatrixType const & mat)
   {
     viennacl::context host_context(viennacl::MAIN_MEMORY);
@@ -486,7 +569,11 @@ private:
     }
 
     if (!tag_.use_level_scheduling())
+    {
+      viennacl::linalg::host_based::detail::csr_level_schedule_setup(L_, L_schedule_, true);
+      viennacl::linalg::host_based::detail::csr_level_schedule_setup(U_, U_schedule_, false);
       return;
+    }
 
     //
     // multifrontal part:
@@ -570,6 +657,8 @@ private:
   ilut_tag tag_;
   viennacl::compressed_matrix<NumericT> L_;
   viennacl::compressed_matrix<NumericT> U_;
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule U_schedule_;
 
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_index_arrays_;
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_buffers_;
@@ -445,6 +445,162 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
   }
 }
 
+/**
+ * @brief Real-to-complex 1D Fourier transformation of batch_num real sequences of length size. Writes the size/2+1 non-redundant complex entries of each spectrum.
+ *
+ * Native implementation on the host. Other backends transform a host copy of the data.
+ */
+template<typename NumericT>
+void real_fft(viennacl::vector_base<NumericT> const & in,
+              viennacl::vector_base<NumericT>       & out, vcl_size_t size, vcl_size_t batch_num)
+{
+  switch (viennacl::traits::handle(in).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::real_fft(in, out, size, batch_num);
+    break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+#endif
+  {
+    viennacl::vector<NumericT> in_host(in);
+    in_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::vector<NumericT> out_host(out.size(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::linalg::host_based::real_fft(in_host, out_host, size, batch_num);
+    out_host.switch_memory_context(viennacl::traits::context(out));
+    out = out_host;
+    break;
+  }
+#endif
+
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/**
+ * @brief Complex-to-real 1D Fourier transformation, the unnormalized inverse of real_fft().
+ *
+ * Native implementation on the host. Other backends transform a host copy of the data.
+ */
+template<typename NumericT>
+void inverse_real_fft(viennacl::vector_base<NumericT> const & in,
+                      viennacl::vector_base<NumericT>       & out, vcl_size_t size, vcl_size_t batch_num)
+{
+  switch (viennacl::traits::handle(in).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::inverse_real_fft(in, out, size, batch_num);
+    break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+#endif
+  {
+    viennacl::vector<NumericT> in_host(in);
+    in_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::vector<NumericT> out_host(out.size(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::linalg::host_based::inverse_real_fft(in_host, out_host, size, batch_num);
+    out_host.switch_memory_context(viennacl::traits::context(out));
+    out = out_host;
+    break;
+  }
+#endif
+
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/**
+ * @brief Real-to-complex 2D Fourier transformation of a real M x N matrix into its M x (N/2+1) half-spectrum (M x 2(N/2+1) interleaved matrix).
+ *
+ * Native implementation on the host. Other backends transform a host copy of the data.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void real_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & in,
+              viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & out)
+{
+  switch (viennacl::traits::handle(in).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::real_fft(in, out);
+    break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+#endif
+  {
+    viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> in_host(in);
+    viennacl::backend::switch_memory_context<NumericT>(in_host.handle(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> out_host(out.size1(), out.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::linalg::host_based::real_fft(in_host, out_host);
+    viennacl::backend::switch_memory_context<NumericT>(out_host.handle(), viennacl::traits::context(out));
+    out = out_host;
+    break;
+  }
+#endif
+
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/**
+ * @brief Complex-to-real 2D Fourier transformation, the unnormalized inverse of the 2D real_fft().
+ *
+ * Native implementation on the host. Other backends transform a host copy of the data.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void inverse_real_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & in,
+                      viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & out)
+{
+  switch (viennacl::traits::handle(in).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::inverse_real_fft(in, out);
+    break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+#endif
+  {
+    viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> in_host(in);
+    viennacl::backend::switch_memory_context<NumericT>(in_host.handle(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> out_host(out.size1(), out.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::linalg::host_based::inverse_real_fft(in_host, out_host);
+    viennacl::backend::switch_memory_context<NumericT>(out_host.handle(), viennacl::traits::context(out));
+    out = out_host;
+    break;
+  }
+#endif
+
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
 /**
  * @brief Reverse vector to oposite order and save it in input vector
  */
@@ -25,6 +25,7 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/norm_2.hpp"
@@ -37,6 +38,7 @@
 
 #include "viennacl/linalg/iterative_operations.hpp"
 #include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/detail/block_krylov.hpp"
 
 
 namespace viennacl
@@ -56,7 +58,7 @@ public:
   * @param krylov_dim     The maximum dimension of the Krylov space before restart (number of restarts is found by max_iterations / krylov_dim)
   */
   gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
-   : tol_(tol), abs_tol_(0), iterations_(max_iterations), krylov_dim_(krylov_dim), iters_taken_(0) {}
+   : tol_(tol), abs_tol_(0), iterations_(max_iterations), krylov_dim_(krylov_dim), s_steps_(1), iters_taken_(0) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -79,6 +81,15 @@ public:
     return ret;
   }
 
+  /** @brief Returns the number of Krylov vectors generated per block in the s-step (communication-avoiding) variant. A value of 1 disables the s-step variant. */
+  unsigned int s_steps() const { return s_steps_; }
+  /** @brief Sets the number of Krylov vectors generated per block in the s-step variant, which is used for unpreconditioned systems in main memory.
+  *
+  * The s-step variant needs only two global reductions per block of s basis vectors, but the monomial basis of each block loses linear independence quickly for large s.
+  * Values up to about 8 are safe, linearly dependent vectors at the end of a block are dropped.
+  */
+  void s_steps(unsigned int s) { s_steps_ = (s > 0) ? s : 1; }
+
   /** @brief Return the number of solver iterations: */
   unsigned int iters() const { return iters_taken_; }
   /** @brief Set the number of solver iterations (should only be modified by the solver) */
@@ -94,6 +105,7 @@ private:
   double abs_tol_;
   unsigned int iterations_;
   unsigned int krylov_dim_;
+  unsigned int s_steps_;
 
   //return values from solver
   mutable unsigned int iters_taken_;
@@ -166,6 +178,288 @@ namespace detail
   }
 
 
+  /** @brief Implementation of the s-step (communication-avoiding) GMRES solver without preconditioner for systems in main memory
+  *
+  * Follows CA-GMRES as described by M. Hoemmen, Communication-Avoiding Krylov Subspace Methods, PhD thesis, UC Berkeley (2010):
+  * Starting from the last orthonormal basis vector q_j, a block W of s vectors is generated by the matrix powers kernel (scaled monomial basis).
+  * W is orthogonalized against the previous basis Q by block classical Gram-Schmidt with reorthogonalization, and within the block by a Cholesky QR factorization of the Gram matrix.
+  * Each pass requires only a single reduction for all inner products of the block. The Hessenberg matrix is then recovered from the change of basis on the host:
+  * With A [q_j, w_1, ..., w_{s-1}] = sigma [w_1, ..., w_s] and [q_j, w_1, ..., w_{s-1}] = [Q, Q_new] M, the new columns of H are (sigma [C; R] - H_old M_top) M_sq^{-1}.
+  * Convergence is decided on the true residual b - A x at the end of each cycle, which is also reported by tag.error(). If it misses the tolerance, GMRES restarts.
+  *
+  * @param A            The system matrix
+  * @param rhs          The load vector
+  * @param tag          Solver configuration tag
+  * @param monitor      A callback routine which is called at each GMRES restart
+  * @param monitor_data Data pointer to be passed to the callback routine to pass on user-specific data
+  * @return The result vector
+  */
+  template <typename MatrixType, typename ScalarType>
+  viennacl::vector<ScalarType> s_step_solve(MatrixType const & A,
+                                            viennacl::vector<ScalarType> const & rhs,
+                                            gmres_tag const & tag,
+                                            bool (*monitor)(viennacl::vector<ScalarType> const &, ScalarType, void*) = NULL,
+                                            void *monitor_data = NULL)
+  {
+    vcl_size_t size       = rhs.size();
+    vcl_size_t stride     = rhs.internal_size();
+    vcl_size_t s          = tag.s_steps();
+    vcl_size_t krylov_dim = std::min<vcl_size_t>(tag.krylov_dim(), size);
+    vcl_size_t H_rows     = krylov_dim + 1;
+
+    viennacl::vector<ScalarType> residual(rhs);
+    viennacl::vector<ScalarType> result = viennacl::zero_vector<ScalarType>(size, viennacl::traits::context(rhs));
+
+    viennacl::vector<ScalarType> krylov_basis = viennacl::zero_vector<ScalarType>((krylov_dim + s + 1) * stride, viennacl::traits::context(rhs));
+    viennacl::vector<ScalarType> device_inner_prods((krylov_dim + 2 * s + 1) * s, viennacl::traits::context(rhs));
+    viennacl::vector<ScalarType> device_coefficients((krylov_dim + 2 * s + 1) * s, viennacl::traits::context(rhs));
+    std::vector<ScalarType>      inner_prods(device_inner_prods.size());
+    std::vector<ScalarType>      coefficients(device_coefficients.size());
+
+    std::vector<ScalarType> H(H_rows * krylov_dim);   // Hessenberg matrix, column-major
+    std::vector<ScalarType> H_rot(H_rows * krylov_dim); // Hessenberg matrix after Givens rotations (upper triangular)
+    std::vector<ScalarType> C((krylov_dim + 1) * s);  // coefficients of the block with respect to the previous basis, column-major
+    std::vector<ScalarType> R(s * s);                 // triangular factor of the block, column-major
+    std::vector<ScalarType> X((krylov_dim + s + 1) * s);
+    std::vector<ScalarType> givens_c(krylov_dim);
+    std::vector<ScalarType> givens_s(krylov_dim);
+    std::vector<ScalarType> g(H_rows);
+
+    viennacl::vector_range<viennacl::vector<ScalarType> > q0(krylov_basis, viennacl::range(0, size));
+
+    ScalarType norm_rhs = viennacl::linalg::norm_2(residual);
+    ScalarType rho_0 = norm_rhs;
+    ScalarType sigma = 0;
+
+    tag.iters(0);
+    tag.error(0);
+
+    bool converged = (rho_0 <= ScalarType(tag.abs_tolerance()) || rho_0 / norm_rhs < tag.tolerance());
+    while (!converged && tag.iters() < tag.max_iterations())
+    {
+      //
+      // prepare restart:
+      //
+      q0 = residual / rho_0;
+
+      if (sigma <= 0) // scaling factor for the monomial basis
+      {
+        viennacl::linalg::s_step_matrix_powers(A, krylov_basis, size, stride, 0, 1, ScalarType(1));
+        viennacl::vector_range<viennacl::vector<ScalarType> > q1(krylov_basis, viennacl::range(stride, stride + size));
+        sigma = viennacl::linalg::norm_2(q1);
+        if (sigma <= 0)
+          sigma = 1;
+      }
+
+      std::fill(H.begin(), H.end(), ScalarType(0));
+      std::fill(H_rot.begin(), H_rot.end(), ScalarType(0));
+      std::fill(g.begin(), g.end(), ScalarType(0));
+      g[0] = rho_0;
+
+      vcl_size_t j = 0;
+      bool breakdown = false;
+      while (j < krylov_dim && !converged && !breakdown && tag.iters() < tag.max_iterations())
+      {
+        vcl_size_t num_previous = j + 1;
+        vcl_size_t block_size   = std::min<vcl_size_t>(s, krylov_dim - j);
+
+        //
+        // Matrix powers: W = [A q_j, A^2 q_j, ...] / sigma^i in columns j+1, ..., j+block_size
+        //
+        viennacl::linalg::s_step_matrix_powers(A, krylov_basis, size, stride, j, block_size, ScalarType(1) / sigma);
+
+        //
+        // First pass of block Gram-Schmidt: C1 = Q^T W, W -= Q C1
+        //
+        viennacl::linalg::s_step_inner_products(krylov_basis, size, stride, num_previous, num_previous, block_size, device_inner_prods);
+        viennacl::fast_copy(device_inner_prods.begin(), device_inner_prods.begin() + static_cast<long>(num_previous * block_size), inner_prods.begin());
+
+        for (vcl_size_t i = 0; i < num_previous * block_size; ++i)
+        {
+          C[i] = inner_prods[i];
+          coefficients[i] = inner_prods[i];
+        }
+        for (vcl_size_t col = 0; col < block_size; ++col)
+          for (vcl_size_t row = 0; row < block_size; ++row)
+            coefficients[num_previous * block_size + row + col * block_size] = (row == col) ? ScalarType(1) : ScalarType(0);
+        viennacl::fast_copy(coefficients.begin(), coefficients.begin() + static_cast<long>((num_previous + block_size) * block_size), device_coefficients.begin());
+        viennacl::linalg::s_step_gmres_orthogonalize(krylov_basis, size, stride, num_previous, block_size, device_coefficients);
+
+        //
+        // Second pass: C2 = Q^T W and G = W^T W in a single reduction
+        //
+        vcl_size_t num_vectors = num_previous + block_size;
+        viennacl::linalg::s_step_inner_products(krylov_basis, size, stride, num_vectors, num_previous, block_size, device_inner_prods);
+        viennacl::fast_copy(device_inner_prods.begin(), device_inner_prods.begin() + static_cast<long>(num_vectors * block_size), inner_prods.begin());
+
+        // Cholesky factorization of the Gram matrix of W - Q C2, i.e. G - C2^T C2 = R^T R. Stop at the first (numerically) linearly dependent vector:
+        vcl_size_t new_vectors = block_size;
+        for (vcl_size_t col = 0; col < block_size; ++col)
+        {
+          for (vcl_size_t row = 0; row <= col; ++row)
+          {
+            ScalarType value = inner_prods[num_previous + row + col * num_vectors];
+            for (vcl_size_t i = 0; i < num_previous; ++i)
+              value -= inner_prods[i + row * num_vectors] * inner_prods[i + col * num_vectors];
+            for (vcl_size_t i = 0; i < row; ++i)
+              value -= R[i + row * s] * R[i + col * s];
+
+            if (row < col)
+              R[row + col * s] = value / R[row + row * s];
+            else if (value > ScalarType(100) * std::numeric_limits<ScalarType>::epsilon() * inner_prods[num_previous + col + col * num_vectors])
+              R[col + col * s] = std::sqrt(value);
+            else
+              new_vectors = col;
+          }
+          if (new_vectors < block_size)
+            break;
+        }
+
+        for (vcl_size_t col = 0; col < block_size; ++col)
+          for (vcl_size_t i = 0; i < num_previous; ++i)
+            C[i + col * num_previous] += inner_prods[i + col * num_vectors];
+
+        vcl_size_t new_columns = new_vectors;
+        if (new_vectors == 0) // A q_j is in the span of Q: Krylov space is invariant
+        {
+          breakdown = true;
+          new_columns = 1;
+          R[0] = 0;
+        }
+        else
+        {
+          //
+          // W = (W - Q C2) R^{-1} for the linearly independent part of the block
+          //
+          for (vcl_size_t col = 0; col < new_vectors; ++col)
+            for (vcl_size_t i = 0; i < num_previous; ++i)
+              coefficients[i + col * num_previous] = inner_prods[i + col * num_vectors];
+          ScalarType * R_inv = &(coefficients[num_previous * new_vectors]);
+          for (vcl_size_t col = 0; col < new_vectors; ++col)
+          {
+            for (vcl_size_t row = 0; row < new_vectors; ++row)
+              R_inv[row + col * new_vectors] = 0;
+            R_inv[col + col * new_vectors] = ScalarType(1) / R[col + col * s];
+            for (vcl_size_t row2 = 0; row2 < col; ++row2)
+            {
+              vcl_size_t row = col - row2 - 1;
+              ScalarType value = 0;
+              for (vcl_size_t i = row + 1; i <= col; ++i)
+                value -= R[row + i * s] * R_inv[i + col * new_vectors];
+              R_inv[row + col * new_vectors] = value / R[row + row * s];
+            }
+          }
+          viennacl::fast_copy(coefficients.begin(), coefficients.begin() + static_cast<long>((num_previous + new_vectors) * new_vectors), device_coefficients.begin());
+          viennacl::linalg::s_step_gmres_orthogonalize(krylov_basis, size, stride, num_previous, new_vectors, device_coefficients);
+        }
+
+        //
+        // New columns of the Hessenberg matrix: H(:, j:j+new_columns) = (sigma [C; R] - H_old M_top) M_sq^{-1}
+        //
+        vcl_size_t X_rows = num_previous + new_columns;
+        for (vcl_size_t col = 0; col < new_columns; ++col)
+        {
+          ScalarType * X_col = &(X[col * X_rows]);
+          for (vcl_size_t row = 0; row < num_previous; ++row)
+            X_col[row] = sigma * C[row + col * num_previous];
+          for (vcl_size_t row = 0; row < new_columns; ++row)
+            X_col[num_previous + row] = (row <= col) ? sigma * R[row + col * s] : ScalarType(0);
+
+          if (col > 0) // M_top(:, col) = C(0:j, col-1)
+            for (vcl_size_t l = 0; l < j; ++l)
+            {
+              ScalarType M_l = C[l + (col - 1) * num_previous];
+              for (vcl_size_t row = 0; row <= l + 1; ++row)
+                X_col[row] -= H[row + l * H_rows] * M_l;
+            }
+        }
+
+        for (vcl_size_t col = 0; col < new_columns; ++col)
+        {
+          // M_sq(0, 0) = 1, M_sq(0, c) = C(j, c-1), M_sq(r, c) = R(r-1, c-1):
+          ScalarType * H_col = &(H[(j + col) * H_rows]);
+          for (vcl_size_t row = 0; row < X_rows; ++row)
+          {
+            ScalarType value = X[row + col * X_rows];
+            for (vcl_size_t l = 0; l < col; ++l)
+            {
+              ScalarType M_lc = (l == 0) ? C[j + (col - 1) * num_previous] : R[(l - 1) + (col - 1) * s];
+              value -= H[row + (j + l) * H_rows] * M_lc;
+            }
+            ScalarType M_cc = (col == 0) ? ScalarType(1) : R[(col - 1) + (col - 1) * s];
+            H_col[row] = (row <= j + col + 1) ? value / M_cc : ScalarType(0);
+          }
+        }
+
+        //
+        // Apply Givens rotations to the new columns and update the residual estimate:
+        //
+        vcl_size_t block_end = j + new_columns;
+        for (vcl_size_t col = j; col < block_end; ++col)
+        {
+          ScalarType * H_col = &(H_rot[col * H_rows]);
+          for (vcl_size_t i = 0; i <= col + 1; ++i)
+            H_col[i] = H[i + col * H_rows];
+          for (vcl_size_t i = 0; i < col; ++i)
+          {
+            ScalarType tmp = givens_c[i] * H_col[i] + givens_s[i] * H_col[i+1];
+            H_col[i+1]     = givens_c[i] * H_col[i+1] - givens_s[i] * H_col[i];
+            H_col[i]       = tmp;
+          }
+
+          ScalarType denom = std::sqrt(H_col[col] * H_col[col] + H_col[col+1] * H_col[col+1]);
+          givens_c[col] = (denom > 0) ? H_col[col]   / denom : ScalarType(1);
+          givens_s[col] = (denom > 0) ? H_col[col+1] / denom : ScalarType(0);
+          H_col[col]   = denom;
+          H_col[col+1] = 0;
+          g[col+1] = -givens_s[col] * g[col];
+          g[col]   =  givens_c[col] * g[col];
+
+          tag.iters(tag.iters() + 1);
+          j = col + 1;
+
+          if (std::fabs(g[col+1]) / norm_rhs < tag.tolerance() || std::fabs(g[col+1]) < tag.abs_tolerance() || denom <= 0)
+          {
+            converged = true;
+            break;
+          }
+        }
+      }
+
+      //
+      // Solve the triangular system for the coefficients and update x += Q y:
+      //
+      for (vcl_size_t i2 = 0; i2 < j; ++i2)
+      {
+        vcl_size_t i = j - i2 - 1;
+        ScalarType value = g[i];
+        for (vcl_size_t k = i + 1; k < j; ++k)
+          value -= H_rot[i + k * H_rows] * coefficients[k];
+        coefficients[i] = (H_rot[i + i * H_rows] > 0 || H_rot[i + i * H_rows] < 0) ? value / H_rot[i + i * H_rows] : ScalarType(0);
+      }
+      viennacl::fast_copy(coefficients.begin(), coefficients.begin() + static_cast<long>(j), device_coefficients.begin());
+      viennacl::linalg::s_step_gmres_update_result(result, krylov_basis, size, stride, device_coefficients, j);
+
+      //
+      // The residual estimate |g[j]| may be far off the true residual after loss of orthogonality in the s-step basis.
+      // Hence, convergence is decided on the true residual, which is also the residual for the next restart:
+      //
+      residual = viennacl::linalg::prod(A, result);
+      residual = rhs - residual;
+      rho_0 = viennacl::linalg::norm_2(residual);
+
+      converged = (rho_0 <= ScalarType(tag.abs_tolerance()) || rho_0 / norm_rhs < tag.tolerance());
+
+      tag.error(rho_0 / norm_rhs);
+
+      if (monitor && monitor(result, rho_0 / norm_rhs, monitor_data))
+        break;
+    }
+
+    return result;
+  }
+
+
   /** @brief Implementation of a pipelined GMRES solver without preconditioner
   *
   * Following algorithm 2.1 proposed by Walker in "A Simpler GMRES", but uses classical Gram-Schmidt instead of modified Gram-Schmidt for better parallelization.
@@ -186,6 +480,9 @@ namespace detail
                                                bool (*monitor)(viennacl::vector<ScalarType> const &, ScalarType, void*) = NULL,
                                                void *monitor_data = NULL)
   {
+    if (tag.s_steps() > 1 && viennacl::traits::active_handle_id(rhs) == viennacl::MAIN_MEMORY)
+      return s_step_solve(A, rhs, tag, monitor, monitor_data);
+
     viennacl::vector<ScalarType> residual(rhs);
     viennacl::vector<ScalarType> result = viennacl::zero_vector<ScalarType>(rhs.size(), viennacl::traits::context(rhs));
 
@@ -630,6 +927,218 @@ namespace detail
     return result;
   }
 
+
+  /** @brief Implementation of the right-preconditioned block GMRES method for a matrix of right hand sides.
+  *
+  * The block Arnoldi process orthogonalizes each new block against the previous basis by block classical Gram-Schmidt with reorthogonalization,
+  * followed by a Cholesky QR factorization of the block, which drops numerically linearly dependent vectors.
+  * The band Hessenberg least squares problem is solved incrementally with Householder reflections, which provides the residual norms of all columns in each step.
+  * Converged columns are removed from the block at each restart.
+  *
+  * @param A         The system matrix
+  * @param B         The right hand sides, one per column
+  * @param result    The result matrix of the same size as B
+  * @param tag       Solver configuration tag. krylov_dim() is the number of block steps before a restart, the iteration count refers to block steps as well.
+  * @param precond   A right preconditioner, which is applied to each column separately
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  void block_solve_impl(MatrixT const & A,
+                        viennacl::matrix_base<NumericT> const & B,
+                        viennacl::matrix_base<NumericT> & result,
+                        gmres_tag const & tag,
+                        PreconditionerT const & precond)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::row_major>   BlockType;
+    typedef viennacl::matrix_range<BlockType>                 BlockRangeType;
+
+    vcl_size_t n = B.size1();
+    vcl_size_t m = B.size2();
+    vcl_size_t krylov_steps = std::max<vcl_size_t>(tag.krylov_dim(), 1);
+    viennacl::context ctx = viennacl::traits::context(B);
+    viennacl::range all_rows(0, n);
+
+    // all blocks are row-major, so that the product with the sparse matrix streams each row of A once:
+    BlockType rhs(n, m, ctx), X(n, m, ctx), R(n, m, ctx), Z(n, m, ctx), W(n, m, ctx);
+    BlockType V(n, (krylov_steps + 1) * m, ctx);
+    BlockType device_coefficients(m, m, ctx);
+    viennacl::vector<NumericT> temp(n, ctx);
+    X.clear();
+    detail::block_copy(B, rhs);
+
+    std::vector<NumericT> rhs_norms;
+    std::vector<NumericT> residual_norms;
+    std::vector<NumericT> relative_residuals(m);
+    std::vector<vcl_size_t> active(m);
+    detail::block_column_norms(rhs, rhs_norms);
+    for (vcl_size_t j = 0; j < m; ++j)
+      active[j] = j;
+
+    NumericT rel_tol = NumericT(tag.tolerance());
+    NumericT abs_tol = NumericT(tag.abs_tolerance());
+
+    std::vector<NumericT> S, H, H_correction, G, Y;
+    std::vector<vcl_size_t> offsets;
+    std::vector<std::vector<NumericT> > triangular_columns; // upper triangular factor of the Hessenberg matrix, column by column
+    std::vector<detail::block_householder_reflector<NumericT> > reflectors;
+
+    tag.iters(0);
+    vcl_size_t num_active = m;
+    while (true)
+    {
+      //
+      // residual of the current approximation, deflation of converged columns:
+      //
+      BlockRangeType X_a(X, all_rows, viennacl::range(0, num_active));
+      BlockRangeType R_a(R, all_rows, viennacl::range(0, num_active));
+      BlockRangeType rhs_a(rhs, all_rows, viennacl::range(0, num_active));
+      R_a = viennacl::linalg::prod(A, X_a);
+      R_a = rhs_a - R_a;
+
+      detail::block_column_norms(R_a, residual_norms);
+      for (vcl_size_t j = 0; j < num_active; ++j)
+        relative_residuals[active[j]] = (rhs_norms[active[j]] > 0) ? residual_norms[j] / rhs_norms[active[j]] : NumericT(0);
+
+      std::vector<vcl_size_t> active_before(active);
+      num_active = detail::block_deflate(residual_norms, rhs_norms, rel_tol, abs_tol, active, X, rhs, result);
+      if (num_active == 0 || tag.iters() >= tag.max_iterations())
+        break;
+
+      // keep residuals of active columns at the front:
+      for (vcl_size_t j = 0, k = 0; j < active_before.size() && k < num_active; ++j)
+        if (active_before[j] == active[k])
+        {
+          if (j != k)
+            detail::block_copy_column(R, j, k);
+          ++k;
+        }
+
+      //
+      // first block of the Krylov basis: R = V_0 S_0
+      //
+      BlockRangeType R_new(R, all_rows, viennacl::range(0, num_active));
+      vcl_size_t q = detail::block_orthonormalize(R_new, V, W, S);
+      if (q == 0)
+        break;
+
+      G.assign((krylov_steps + 1) * m * num_active, NumericT(0));
+      std::copy(S.begin(), S.end(), G.begin());
+      offsets.assign(1, 0);
+      offsets.push_back(q);
+      triangular_columns.clear();
+      reflectors.clear();
+
+      //
+      // block Arnoldi process:
+      //
+      for (vcl_size_t j = 0; j < krylov_steps && tag.iters() < tag.max_iterations(); ++j)
+      {
+        tag.iters(tag.iters() + 1);
+
+        vcl_size_t q_j = offsets[j+1] - offsets[j];
+        vcl_size_t num_previous = offsets[j+1];
+
+        BlockRangeType V_j(V, all_rows, viennacl::range(offsets[j], offsets[j+1]));
+        BlockRangeType V_previous(V, all_rows, viennacl::range(0, num_previous));
+        BlockRangeType Z_j(Z, all_rows, viennacl::range(0, q_j));
+        BlockRangeType W_j(W, all_rows, viennacl::range(0, q_j));
+
+        Z_j = V_j;
+        detail::block_precond_apply(precond, Z_j, temp);
+        W_j = viennacl::linalg::prod(A, Z_j);
+
+        // block classical Gram-Schmidt, twice:
+        BlockType device_H(num_previous, q_j, ctx);
+        device_H = viennacl::linalg::prod(viennacl::trans(V_previous), W_j);
+        W_j -= viennacl::linalg::prod(V_previous, device_H);
+        detail::block_read(device_H, H);
+
+        device_H = viennacl::linalg::prod(viennacl::trans(V_previous), W_j);
+        W_j -= viennacl::linalg::prod(V_previous, device_H);
+        detail::block_read(device_H, H_correction);
+        for (vcl_size_t i = 0; i < H.size(); ++i)
+          H[i] += H_correction[i];
+
+        // W = V_{j+1} S:
+        BlockRangeType V_next(V, all_rows, viennacl::range(num_previous, num_previous + q_j));
+        vcl_size_t q_next = detail::block_orthonormalize(W_j, V_next, Z, S);
+        offsets.push_back(num_previous + q_next);
+        vcl_size_t num_rows = num_previous + q_next;
+
+        //
+        // QR factorization of the new block column [H; S] of the Hessenberg matrix, applied to the right hand side G:
+        //
+        std::vector<NumericT> column(num_rows);
+        for (vcl_size_t c = 0; c < q_j; ++c)
+        {
+          for (vcl_size_t i = 0; i < num_previous; ++i)
+            column[i] = H[i * q_j + c];
+          for (vcl_size_t i = 0; i < q_next; ++i)
+            column[num_previous + i] = S[i * q_j + c];
+
+          for (vcl_size_t k = 0; k < reflectors.size(); ++k)
+            detail::block_householder_apply(reflectors[k], &(column[0]), 1, 0);
+
+          vcl_size_t diag_row = offsets[j] + c;
+          detail::block_householder_reflector<NumericT> reflector;
+          column[diag_row] = detail::block_householder_setup(&(column[0]), diag_row, num_rows, reflector);
+          for (vcl_size_t k = 0; k < num_active; ++k)
+            detail::block_householder_apply(reflector, &(G[0]), num_active, k);
+          reflectors.push_back(reflector);
+
+          triangular_columns.push_back(std::vector<NumericT>(column.begin(), column.begin() + static_cast<long>(diag_row) + 1));
+        }
+
+        // residual norms are the norms of the columns of G below the triangular part:
+        bool converged = true;
+        for (vcl_size_t k = 0; k < num_active; ++k)
+        {
+          NumericT residual_norm = 0;
+          for (vcl_size_t i = num_previous; i < num_rows; ++i)
+            residual_norm += G[i * num_active + k] * G[i * num_active + k];
+          if (std::sqrt(residual_norm) > std::max(rel_tol * rhs_norms[active[k]], abs_tol))
+            converged = false;
+        }
+
+        if (converged || q_next == 0)
+          break;
+      }
+
+      //
+      // solve the triangular system and update X += M^{-1} V Y:
+      //
+      vcl_size_t N = triangular_columns.size();
+      Y.assign(G.begin(), G.begin() + static_cast<long>(N * num_active));
+      for (vcl_size_t k = 0; k < num_active; ++k)
+        for (vcl_size_t i2 = 0; i2 < N; ++i2)
+        {
+          vcl_size_t i = N - i2 - 1;
+          NumericT value = Y[i * num_active + k];
+          for (vcl_size_t t = i + 1; t < N; ++t)
+            value -= triangular_columns[t][i] * Y[t * num_active + k];
+          NumericT diag = triangular_columns[i][i];
+          Y[i * num_active + k] = (diag > 0 || diag < 0) ? value / diag : NumericT(0);
+        }
+
+      detail::block_write(Y, N, num_active, device_coefficients);
+      BlockRangeType V_basis(V, all_rows, viennacl::range(0, N));
+      BlockRangeType update(W, all_rows, viennacl::range(0, num_active));
+      update = viennacl::linalg::prod(V_basis, device_coefficients);
+      detail::block_precond_apply(precond, update, temp);
+
+      BlockRangeType X_new(X, all_rows, viennacl::range(0, num_active));
+      X_new += update;
+    }
+
+    // columns which did not converge:
+    for (vcl_size_t j = 0; j < num_active; ++j)
+    {
+      viennacl::vector_base<NumericT> result_column = detail::block_column(result, active[j]);
+      result_column = detail::block_column(X, j);
+    }
+
+    tag.error(m > 0 ? *std::max_element(relative_residuals.begin(), relative_residuals.end()) : NumericT(0));
+  }
+
 }
 
 template<typename MatrixT, typename VectorT, typename PreconditionerT>
@@ -672,6 +1181,33 @@ VectorT solve(MatrixT const & A, VectorT const & rhs, gmres_tag const & tag)
   return solve(A, rhs, tag, no_precond());
 }
 
+/** @brief Solves A X = B for a matrix B of right hand sides sharing the same system matrix using the block GMRES method.
+*
+* All right hand sides are iterated simultaneously, so each step reads the system matrix only once.
+* The basis holds (krylov_dim() + 1) blocks with up to one vector per right hand side, krylov_dim() is the number of block steps before a restart.
+* Converged columns are removed from the block at each restart. The iteration count of the tag refers to block steps, the error is the largest relative residual of all columns.
+*
+* @param A          The system matrix
+* @param rhs        The right hand sides, one per column
+* @param tag        Solver configuration tag
+* @param precond    A right preconditioner, which is applied to each column separately
+* @return The matrix of solution vectors
+*/
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV, typename PreconditionerT>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & A, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, gmres_tag const & tag, PreconditionerT const & precond)
+{
+  viennacl::matrix<NumericT, F, AlignmentV> result(rhs.size1(), rhs.size2(), viennacl::traits::context(rhs));
+  detail::block_solve_impl(A, rhs, result, tag, precond);
+  return result;
+}
+
+/** @brief Entry point for the unpreconditioned block GMRES method for a matrix of right hand sides. */
+template<typename MatrixT, typename NumericT, typename F, unsigned int AlignmentV>
+viennacl::matrix<NumericT, F, AlignmentV> solve(MatrixT const & A, viennacl::matrix<NumericT, F, AlignmentV> const & rhs, gmres_tag const & tag)
+{
+  return solve(A, rhs, tag, no_precond());
+}
+
 
 
 template<typename VectorT>
@@ -24,7 +24,10 @@
 
 #include <cstdlib>
 #include <cmath>
+#include <cassert>
+#include <algorithm>
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
+#include "viennacl/linalg/host_based/spgemm_vector.hpp"
 
 #include <map>
 #include <set>
@@ -1346,6 +1349,85 @@ void amg_interpol_sa(compressed_matrix<NumericT> const & A,
 }
 
 
+/** @brief Recomputes the values of a smoothed aggregation interpolation matrix P obtained from amg_interpol_sa() for new values of A with unchanged sparsity pattern.
+ *
+ * With the tentative prolongation operator P_tentative(j, J) = 1 for j in aggregate J, the entries of P = Jacobi * P_tentative are P(i, J) = sum of Jacobi(i, j) over all j in aggregate J.
+ * The aggregates are taken from the AMG hierarchy datastructures, the sparsity pattern of P is reused.
+ *
+ * @param A            Operator matrix with the same sparsity pattern as the one P was computed for
+ * @param P            Prolongation matrix from amg_interpol_sa()
+ * @param amg_context  AMG hierarchy datastructures
+ * @param tag          AMG configuration tag
+ * @return             False if an entry of A maps to an aggregate not in the sparsity pattern of P. The values of P are invalid then and P needs to be recomputed.
+*/
+template<typename NumericT>
+bool amg_interpol_sa_values(compressed_matrix<NumericT> const & A,
+                            compressed_matrix<NumericT> & P,
+                            viennacl::linalg::detail::amg::amg_level_context & amg_context,
+                            viennacl::linalg::amg_tag & tag)
+{
+  unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+  NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+
+  unsigned int const * P_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(P.handle1());
+  unsigned int const * P_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(P.handle2());
+  NumericT           * P_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(P.handle());
+
+  unsigned int const * coarse_id_ptr = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(amg_context.coarse_id_.handle());
+
+  NumericT omega = NumericT(tag.get_jacobi_weight());
+
+  if (A.size1() != P.size1() || A.size1() != amg_context.coarse_id_.size())
+    return false;
+
+  bool pattern_changed = false;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(||: pattern_changed)
+#endif
+  for (long row2=0; row2<static_cast<long>(A.size1()); ++row2)
+  {
+    unsigned int row = static_cast<unsigned int>(row2);
+    unsigned int row_begin = A_row_buffer[row];
+    unsigned int row_end   = A_row_buffer[row+1];
+
+    unsigned int const * P_cols_begin = P_col_buffer + P_row_buffer[row];
+    unsigned int const * P_cols_end   = P_col_buffer + P_row_buffer[row+1];
+    NumericT           * P_values     = P_elements   + P_row_buffer[row];
+
+    for (unsigned int const * it = P_cols_begin; it != P_cols_end; ++it)
+      P_values[it - P_cols_begin] = NumericT(0);
+
+    NumericT diag = 0;
+    for (unsigned int j = row_begin; j < row_end; ++j)
+    {
+      if (A_col_buffer[j] == row)
+      {
+        diag = A_elements[j];
+        break;
+      }
+    }
+
+    // accumulate the Jacobi matrix entries per aggregate (columns of P are sorted):
+    for (unsigned int j = row_begin; j < row_end; ++j)
+    {
+      unsigned int col_index = A_col_buffer[j];
+      NumericT jacobi_entry = (col_index == row) ? NumericT(1) - omega : - omega * A_elements[j] / diag;
+
+      unsigned int const * pos = std::lower_bound(P_cols_begin, P_cols_end, coarse_id_ptr[col_index]);
+      if (pos == P_cols_end || *pos != coarse_id_ptr[col_index])
+      {
+        pattern_changed = true;
+        break;
+      }
+      P_values[pos - P_cols_begin] += jacobi_entry;
+    }
+  }
+
+  return !pattern_changed;
+}
+
 /** @brief Dispatcher for building the interpolation matrix
  *
  * @param A            Operator matrix
@@ -1369,6 +1451,31 @@ void amg_interpol(MatrixT const & A,
 }
 
 
+/** @brief Dispatcher for recomputing the values of the interpolation matrix for new values of A with unchanged sparsity pattern
+ *
+ * Aggregation-based interpolation operators keep their sparsity pattern, so only the values are updated. Direct interpolation is recomputed.
+ *
+ * @param A            Operator matrix
+ * @param P            Prolongation matrix
+ * @param amg_context  AMG hierarchy datastructures
+ * @param tag          AMG configuration tag
+ * @return             False if the sparsity pattern of A no longer fits P, in which case the AMG hierarchy needs to be set up again
+*/
+template<typename MatrixT>
+bool amg_interpol_values(MatrixT const & A,
+                         MatrixT & P,
+                         viennacl::linalg::detail::amg::amg_level_context & amg_context,
+                         viennacl::linalg::amg_tag & tag)
+{
+  switch (tag.get_interpolation_method())
+  {
+  case viennacl::linalg::AMG_INTERPOLATION_METHOD_DIRECT:               amg_interpol_direct(A, P, amg_context, tag); return true;
+  case viennacl::linalg::AMG_INTERPOLATION_METHOD_AGGREGATION:          return A.size1() == P.size1(); // values do not depend on A
+  case viennacl::linalg::AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION: return amg_interpol_sa_values(A, P, amg_context, tag);
+  default: throw std::runtime_error("Not implemented yet!");
+  }
+}
+
 /** @brief Computes B = trans(A).
   *
   * To be replaced by native functionality in ViennaCL.
@@ -1490,6 +1597,344 @@ void amg_transpose(compressed_matrix<NumericT> const & A,
   free(scratchpad);
 }
 
+/** @brief Determines the lengths of the work buffers for the row-wise Galerkin product: Upper bounds for the length of the rows of t = R(I,:) * A_fine and of t * P. */
+template<typename NumericT>
+void amg_galerkin_buffer_lengths(compressed_matrix<NumericT> const & A_fine,
+                                 compressed_matrix<NumericT> const & P,
+                                 compressed_matrix<NumericT> const & R,
+                                 std::size_t & buffer_len_t,
+                                 std::size_t & buffer_len_C)
+{
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A_fine.handle1());
+  unsigned int const * P_row_buffer = detail::extract_raw_pointer<unsigned int>(P.handle1());
+  unsigned int const * R_row_buffer = detail::extract_raw_pointer<unsigned int>(R.handle1());
+  unsigned int const * R_col_buffer = detail::extract_raw_pointer<unsigned int>(R.handle2());
+
+  unsigned int fine_size = static_cast<unsigned int>(A_fine.size2());
+
+#ifdef VIENNACL_WITH_OPENMP
+  unsigned int max_threads = static_cast<unsigned int>(omp_get_max_threads());
+#else
+  unsigned int max_threads = 1;
+#endif
+
+  unsigned int max_length_row_P = 0;
+  for (std::size_t i=0; i<P.size1(); ++i)
+    max_length_row_P = std::max(max_length_row_P, P_row_buffer[i+1] - P_row_buffer[i]);
+
+  std::vector<unsigned int> max_length_row_t(max_threads);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long I=0; I<long(R.size1()); ++I)
+  {
+    unsigned int thread_id = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    thread_id = static_cast<unsigned int>(omp_get_thread_num());
+#endif
+
+    unsigned int upper_bound_row_t = 0;
+    for (unsigned int j = R_row_buffer[I]; j < R_row_buffer[I+1]; ++j)
+    {
+      unsigned int row_A = R_col_buffer[j];
+      upper_bound_row_t += A_row_buffer[row_A+1] - A_row_buffer[row_A];
+    }
+
+    max_length_row_t[thread_id] = std::max(max_length_row_t[thread_id], std::min(upper_bound_row_t, fine_size));
+  }
+
+  for (std::size_t i=1; i<max_length_row_t.size(); ++i)
+    max_length_row_t[0] = std::max(max_length_row_t[0], max_length_row_t[i]);
+
+  buffer_len_t = max_length_row_t[0];
+  buffer_len_C = std::min<std::size_t>(buffer_len_t * max_length_row_P, P.size2());
+}
+
+/** @brief Computes the Galerkin product A_coarse = R * A_fine * P row by row without forming A_fine * P.
+  *
+  * Row I of the coarse operator is obtained by first merging the rows of A_fine selected by row I of R into a temporary sparse row t = R(I,:) * A_fine,
+  * which is then merged with the rows of P into A_coarse(I,:) = t * P. Both merges reuse the row merge kernels of the host-based sparse matrix-matrix product.
+  * Since each coarse row is computed only once, the rows are collected in buffers for blocks of consecutive rows and copied to A_coarse at the end.
+  * R is the transpose of P (as computed by amg_transpose()), which is also needed for the restriction in the AMG cycle.
+  *
+  * @param A_fine    Operator matrix on the fine grid
+  * @param P         Prolongation operator
+  * @param R         Restriction operator, R = trans(P)
+  * @param A_coarse  Result matrix: Galerkin operator on the coarse grid
+  */
+template<typename NumericT>
+void amg_galerkin_prod(compressed_matrix<NumericT> const & A_fine,
+                       compressed_matrix<NumericT> const & P,
+                       compressed_matrix<NumericT> const & R,
+                       compressed_matrix<NumericT> & A_coarse)
+{
+  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A_fine.handle());
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A_fine.handle1());
+  unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A_fine.handle2());
+
+  NumericT     const * P_elements   = detail::extract_raw_pointer<NumericT>(P.handle());
+  unsigned int const * P_row_buffer = detail::extract_raw_pointer<unsigned int>(P.handle1());
+  unsigned int const * P_col_buffer = detail::extract_raw_pointer<unsigned int>(P.handle2());
+
+  NumericT     const * R_elements   = detail::extract_raw_pointer<NumericT>(R.handle());
+  unsigned int const * R_row_buffer = detail::extract_raw_pointer<unsigned int>(R.handle1());
+  unsigned int const * R_col_buffer = detail::extract_raw_pointer<unsigned int>(R.handle2());
+
+  unsigned int fine_size   = static_cast<unsigned int>(A_fine.size2());
+  unsigned int coarse_size = static_cast<unsigned int>(P.size2());
+  long         coarse_rows = long(R.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+  unsigned int max_threads = static_cast<unsigned int>(omp_get_max_threads());
+#else
+  unsigned int max_threads = 1;
+#endif
+  long num_blocks = std::min(long(10 * max_threads), coarse_rows) + 1;
+  long block_size = coarse_rows / num_blocks + 1;
+
+  std::size_t buffer_len_t = 0;
+  std::size_t buffer_len_C = 0;
+  amg_galerkin_buffer_lengths(A_fine, P, R, buffer_len_t, buffer_len_C);
+  std::size_t buffer_size  = 4 * buffer_len_t + 4 * buffer_len_C + 1;
+
+  // per thread: three merge buffers and the result for t, three merge buffers and the result for t * P
+  std::vector<unsigned int *> index_buffers(max_threads);
+  std::vector<NumericT *>     value_buffers(max_threads);
+  for (unsigned int i=0; i<max_threads; ++i)
+  {
+    index_buffers[i] = (unsigned int *)malloc(sizeof(unsigned int) * buffer_size);
+    value_buffers[i] = (NumericT *)malloc(sizeof(NumericT) * buffer_size);
+  }
+
+  /*
+   * Stage 1: Compute the rows of A_coarse, collecting them per block of rows:
+   */
+  std::vector<unsigned int> C_row_lengths(std::size_t(coarse_rows) + 1);
+  std::vector<std::vector<unsigned int> > block_col_buffers(static_cast<std::size_t>(num_blocks));
+  std::vector<std::vector<NumericT> >     block_elements(static_cast<std::size_t>(num_blocks));
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (long block_id = 0; block_id < num_blocks; ++block_id)
+  {
+    unsigned int thread_id = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    thread_id = static_cast<unsigned int>(omp_get_thread_num());
+#endif
+
+    unsigned int *t_vector_1     = index_buffers[thread_id];
+    unsigned int *t_vector_2     = t_vector_1 + buffer_len_t;
+    unsigned int *t_vector_3     = t_vector_2 + buffer_len_t;
+    unsigned int *t_col          = t_vector_3 + buffer_len_t;
+    unsigned int *row_C_vector_1 = t_col + buffer_len_t;
+    unsigned int *row_C_vector_2 = row_C_vector_1 + buffer_len_C;
+    unsigned int *row_C_vector_3 = row_C_vector_2 + buffer_len_C;
+    unsigned int *row_C_col      = row_C_vector_3 + buffer_len_C;
+
+    NumericT *t_vector_1_values     = value_buffers[thread_id];
+    NumericT *t_vector_2_values     = t_vector_1_values + buffer_len_t;
+    NumericT *t_vector_3_values     = t_vector_2_values + buffer_len_t;
+    NumericT *t_values              = t_vector_3_values + buffer_len_t;
+    NumericT *row_C_vector_1_values = t_values + buffer_len_t;
+    NumericT *row_C_vector_2_values = row_C_vector_1_values + buffer_len_C;
+    NumericT *row_C_vector_3_values = row_C_vector_2_values + buffer_len_C;
+    NumericT *row_C_values          = row_C_vector_3_values + buffer_len_C;
+
+    std::vector<unsigned int> & C_cols = block_col_buffers[static_cast<std::size_t>(block_id)];
+    std::vector<NumericT>     & C_vals = block_elements[static_cast<std::size_t>(block_id)];
+
+    long block_end = std::min(coarse_rows, (block_id + 1) * block_size);
+    for (long I = block_id * block_size; I < block_end; ++I)
+    {
+      unsigned int t_len = row_C_scan_numeric_vector(R_row_buffer[I], R_row_buffer[I+1], R_col_buffer, R_elements,
+                                                     A_row_buffer, A_col_buffer, A_elements, fine_size,
+                                                     0, 0, t_col, t_values,
+                                                     t_vector_1, t_vector_1_values,
+                                                     t_vector_2, t_vector_2_values,
+                                                     t_vector_3, t_vector_3_values);
+
+      unsigned int C_len = row_C_scan_numeric_vector(0, t_len, t_col, t_values,
+                                                     P_row_buffer, P_col_buffer, P_elements, coarse_size,
+                                                     0, 0, row_C_col, row_C_values,
+                                                     row_C_vector_1, row_C_vector_1_values,
+                                                     row_C_vector_2, row_C_vector_2_values,
+                                                     row_C_vector_3, row_C_vector_3_values);
+
+      C_cols.insert(C_cols.end(), row_C_col,    row_C_col    + C_len);
+      C_vals.insert(C_vals.end(), row_C_values, row_C_values + C_len);
+      C_row_lengths[std::size_t(I)] = C_len;
+    }
+  }
+
+  for (unsigned int i=0; i<max_threads; ++i)
+  {
+    free(index_buffers[i]);
+    free(value_buffers[i]);
+  }
+
+  /*
+   * Stage 2: Copy the blocks of rows to A_coarse:
+   */
+  A_coarse = compressed_matrix<NumericT>(R.size1(), P.size2(), 0, viennacl::traits::context(A_fine));
+  unsigned int * C_row_buffer = detail::extract_raw_pointer<unsigned int>(A_coarse.handle1());
+
+  // exclusive scan to obtain row start indices:
+  unsigned int current_offset = 0;
+  for (std::size_t i=0; i<A_coarse.size1(); ++i)
+  {
+    C_row_buffer[i] = current_offset;
+    current_offset += C_row_lengths[i];
+  }
+  C_row_buffer[A_coarse.size1()] = current_offset;
+  A_coarse.reserve(current_offset, false);
+
+  NumericT     * C_elements   = detail::extract_raw_pointer<NumericT>(A_coarse.handle());
+  unsigned int * C_col_buffer = detail::extract_raw_pointer<unsigned int>(A_coarse.handle2());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long block_id = 0; block_id < num_blocks; ++block_id)
+  {
+    std::vector<unsigned int> const & C_cols = block_col_buffers[static_cast<std::size_t>(block_id)];
+    std::vector<NumericT>     const & C_vals = block_elements[static_cast<std::size_t>(block_id)];
+
+    if (C_cols.size() > 0)
+    {
+      unsigned int offset = C_row_buffer[block_id * block_size];
+      std::copy(C_cols.begin(), C_cols.end(), C_col_buffer + offset);
+      std::copy(C_vals.begin(), C_vals.end(), C_elements + offset);
+    }
+  }
+
+  A_coarse.generate_row_block_information();
+}
+
+/** @brief Recomputes the values of the Galerkin product A_coarse = R * A_fine * P for an A_coarse previously obtained from amg_galerkin_prod().
+  *
+  * The sparsity patterns of A_fine, P, and R must be the same as in the call to amg_galerkin_prod() that created A_coarse.
+  * Since the row merges keep all entries of the patterns, the existing sparsity pattern of A_coarse is reused and only the values are written.
+  * Each row is merged into a scratch buffer first and only copied to A_coarse if its column indices match the existing ones.
+  *
+  * @param A_fine    Operator matrix on the fine grid
+  * @param P         Prolongation operator
+  * @param R         Restriction operator, R = trans(P)
+  * @param A_coarse  Galerkin operator on the coarse grid with sparsity pattern from a previous call to amg_galerkin_prod()
+  * @return          False if the sparsity pattern of some row differs. The values of A_coarse are invalid then and A_coarse needs to be recomputed.
+  */
+template<typename NumericT>
+bool amg_galerkin_prod_values(compressed_matrix<NumericT> const & A_fine,
+                              compressed_matrix<NumericT> const & P,
+                              compressed_matrix<NumericT> const & R,
+                              compressed_matrix<NumericT> & A_coarse)
+{
+  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A_fine.handle());
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A_fine.handle1());
+  unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A_fine.handle2());
+
+  NumericT     const * P_elements   = detail::extract_raw_pointer<NumericT>(P.handle());
+  unsigned int const * P_row_buffer = detail::extract_raw_pointer<unsigned int>(P.handle1());
+  unsigned int const * P_col_buffer = detail::extract_raw_pointer<unsigned int>(P.handle2());
+
+  NumericT     const * R_elements   = detail::extract_raw_pointer<NumericT>(R.handle());
+  unsigned int const * R_row_buffer = detail::extract_raw_pointer<unsigned int>(R.handle1());
+  unsigned int const * R_col_buffer = detail::extract_raw_pointer<unsigned int>(R.handle2());
+
+  NumericT           * C_elements   = detail::extract_raw_pointer<NumericT>(A_coarse.handle());
+  unsigned int const * C_row_buffer = detail::extract_raw_pointer<unsigned int>(A_coarse.handle1());
+  unsigned int const * C_col_buffer = detail::extract_raw_pointer<unsigned int>(A_coarse.handle2());
+
+  if (A_coarse.size1() != R.size1() || A_coarse.size2() != P.size2() || R.size2() != A_fine.size1() || A_fine.size2() != P.size1())
+    return false;
+
+  unsigned int fine_size   = static_cast<unsigned int>(A_fine.size2());
+  unsigned int coarse_size = static_cast<unsigned int>(P.size2());
+
+#ifdef VIENNACL_WITH_OPENMP
+  unsigned int max_threads = static_cast<unsigned int>(omp_get_max_threads());
+#else
+  unsigned int max_threads = 1;
+#endif
+
+  std::size_t buffer_len_t = 0;
+  std::size_t buffer_len_C = 0;
+  amg_galerkin_buffer_lengths(A_fine, P, R, buffer_len_t, buffer_len_C);
+  std::size_t buffer_size  = 4 * buffer_len_t + 4 * buffer_len_C + 1;
+
+  // per thread: three merge buffers and the result for t, three merge buffers and the result for t * P
+  std::vector<unsigned int *> index_buffers(max_threads);
+  std::vector<NumericT *>     value_buffers(max_threads);
+  for (unsigned int i=0; i<max_threads; ++i)
+  {
+    index_buffers[i] = (unsigned int *)malloc(sizeof(unsigned int) * buffer_size);
+    value_buffers[i] = (NumericT *)malloc(sizeof(NumericT) * buffer_size);
+  }
+
+  bool pattern_changed = false;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64) reduction(||: pattern_changed)
+#endif
+  for (long I=0; I<long(R.size1()); ++I)
+  {
+    unsigned int thread_id = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    thread_id = static_cast<unsigned int>(omp_get_thread_num());
+#endif
+
+    unsigned int *t_vector_1     = index_buffers[thread_id];
+    unsigned int *t_vector_2     = t_vector_1 + buffer_len_t;
+    unsigned int *t_vector_3     = t_vector_2 + buffer_len_t;
+    unsigned int *t_col          = t_vector_3 + buffer_len_t;
+    unsigned int *row_C_vector_1 = t_col + buffer_len_t;
+    unsigned int *row_C_vector_2 = row_C_vector_1 + buffer_len_C;
+    unsigned int *row_C_vector_3 = row_C_vector_2 + buffer_len_C;
+    unsigned int *row_C_col      = row_C_vector_3 + buffer_len_C;
+
+    NumericT *t_vector_1_values     = value_buffers[thread_id];
+    NumericT *t_vector_2_values     = t_vector_1_values + buffer_len_t;
+    NumericT *t_vector_3_values     = t_vector_2_values + buffer_len_t;
+    NumericT *t_values              = t_vector_3_values + buffer_len_t;
+    NumericT *row_C_vector_1_values = t_values + buffer_len_t;
+    NumericT *row_C_vector_2_values = row_C_vector_1_values + buffer_len_C;
+    NumericT *row_C_vector_3_values = row_C_vector_2_values + buffer_len_C;
+    NumericT *row_C_values          = row_C_vector_3_values + buffer_len_C;
+
+    unsigned int t_len = row_C_scan_numeric_vector(R_row_buffer[I], R_row_buffer[I+1], R_col_buffer, R_elements,
+                                                   A_row_buffer, A_col_buffer, A_elements, fine_size,
+                                                   0, 0, t_col, t_values,
+                                                   t_vector_1, t_vector_1_values,
+                                                   t_vector_2, t_vector_2_values,
+                                                   t_vector_3, t_vector_3_values);
+
+    unsigned int C_len = row_C_scan_numeric_vector(0, t_len, t_col, t_values,
+                                                   P_row_buffer, P_col_buffer, P_elements, coarse_size,
+                                                   0, 0, row_C_col, row_C_values,
+                                                   row_C_vector_1, row_C_vector_1_values,
+                                                   row_C_vector_2, row_C_vector_2_values,
+                                                   row_C_vector_3, row_C_vector_3_values);
+
+    // only write the values if the column indices are identical to the existing ones:
+    unsigned int row_start_C = C_row_buffer[I];
+    if (C_len != C_row_buffer[I+1] - row_start_C || !std::equal(row_C_col, row_C_col + C_len, C_col_buffer + row_start_C))
+    {
+      pattern_changed = true;
+      continue;
+    }
+    std::copy(row_C_values, row_C_values + C_len, C_elements + row_start_C);
+  }
+
+  for (unsigned int i=0; i<max_threads; ++i)
+  {
+    free(index_buffers[i]);
+    free(value_buffers[i]);
+  }
+
+  return !pattern_changed;
+}
+
 /** Assign sparse matrix A to dense matrix B */
 template<typename NumericT, unsigned int AlignmentV>
 void assign_to_dense(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
@@ -1568,6 +2013,210 @@ void smooth_jacobi(unsigned int iterations,
   }
 }
 
+/** @brief Computes the diagonal used by the hybrid l1-Gauss-Seidel smoother.
+*
+* Rows are split into num_blocks contiguous blocks, which are processed by different threads. Entry i of the result is a_ii plus the sum of |a_ij| over all columns j outside the block of row i.
+*
+* @param A           Operator matrix
+* @param l1_diag     Result vector
+* @param num_blocks  Number of row blocks of the smoother
+*/
+template<typename NumericT>
+void amg_l1_diagonal(compressed_matrix<NumericT> const & A,
+                     vector<NumericT> & l1_diag,
+                     vcl_size_t num_blocks)
+{
+  NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT * l1_diag_elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(l1_diag.handle());
+
+  vcl_size_t size = A.size1();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+  {
+    vcl_size_t row_start = (static_cast<vcl_size_t>(block)     * size) / num_blocks;
+    vcl_size_t row_stop  = (static_cast<vcl_size_t>(block + 1) * size) / num_blocks;
+
+    for (vcl_size_t row = row_start; row < row_stop; ++row)
+    {
+      NumericT value = NumericT(0);
+      for (unsigned int index = A_row_buffer[row]; index != A_row_buffer[row+1]; ++index)
+      {
+        vcl_size_t col = A_col_buffer[index];
+        if (col == row)
+          value += A_elements[index];
+        else if (col < row_start || col >= row_stop)
+          value += std::fabs(A_elements[index]);
+      }
+      l1_diag_elements[row] = value;
+    }
+  }
+}
+
+/** @brief Hybrid l1-Gauss-Seidel smoother
+*
+* Each of the num_blocks contiguous row blocks is processed by one thread with a sequential Gauss-Seidel sweep.
+* Values from other blocks are taken from the previous iteration (Jacobi-like), which is compensated by the l1-diagonal obtained from amg_l1_diagonal().
+*
+* @param iterations  Number of smoother iterations
+* @param A           Operator matrix for the smoothing
+* @param x           The vector smoothing is applied to
+* @param x_backup    Work vector of the same size as x
+* @param rhs_smooth  The right hand side of the equation for the smoother
+* @param l1_diag     The l1-diagonal for the given number of blocks
+* @param num_blocks  Number of row blocks
+* @param forward     If true, the rows within each block are processed in ascending order, otherwise in descending order (use opposite directions for pre- and postsmoothing to obtain a symmetric preconditioner)
+*/
+template<typename NumericT>
+void smooth_l1_gauss_seidel(unsigned int iterations,
+                            compressed_matrix<NumericT> const & A,
+                            vector<NumericT> & x,
+                            vector<NumericT> & x_backup,
+                            vector<NumericT> const & rhs_smooth,
+                            vector<NumericT> const & l1_diag,
+                            vcl_size_t num_blocks,
+                            bool forward)
+{
+  NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+  NumericT     const * rhs_elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs_smooth.handle());
+  NumericT     const * l1_elements  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(l1_diag.handle());
+
+  NumericT           * x_elements     = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x.handle());
+  NumericT     const * x_old_elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x_backup.handle());
+
+  vcl_size_t size = A.size1();
+
+  for (unsigned int i=0; i<iterations; ++i)
+  {
+    if (num_blocks > 1)
+      x_backup = x;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+    {
+      vcl_size_t row_start = (static_cast<vcl_size_t>(block)     * size) / num_blocks;
+      vcl_size_t row_stop  = (static_cast<vcl_size_t>(block + 1) * size) / num_blocks;
+
+      for (vcl_size_t k = row_start; k < row_stop; ++k)
+      {
+        vcl_size_t row = forward ? k : row_start + row_stop - 1 - k;
+
+        NumericT sum = rhs_elements[row];
+        for (unsigned int index = A_row_buffer[row]; index != A_row_buffer[row+1]; ++index)
+        {
+          vcl_size_t col = A_col_buffer[index];
+          if (col >= row_start && col < row_stop)
+            sum -= A_elements[index] * x_elements[col];
+          else
+            sum -= A_elements[index] * x_old_elements[col];
+        }
+
+        x_elements[row] += sum / l1_elements[row];
+      }
+    }
+  }
+}
+
+/** @brief Chebyshev polynomial smoother for the Jacobi-preconditioned operator D^{-1}A.
+*
+* Each smoother application reduces the error components in the eigenvalue interval [lambda_min, lambda_max] of D^{-1}A with a Chebyshev polynomial of the given degree.
+* Each of the degree steps requires one pass over A, in which the residual, the update direction and the new iterate are computed at once.
+*
+* @param iterations  Number of smoother applications
+* @param A           Operator matrix for the smoothing
+* @param x           The vector smoothing is applied to
+* @param x_backup    Work vector of the same size as x
+* @param rhs_smooth  The right hand side of the equation for the smoother
+* @param diag        The diagonal of A
+* @param d           Work vector of the same size as x (update direction)
+* @param degree      Degree of the Chebyshev polynomial
+* @param lambda_min  Lower bound of the eigenvalue interval to be damped
+* @param lambda_max  Upper bound of the eigenvalue interval to be damped (estimate for the largest eigenvalue of D^{-1}A)
+*/
+template<typename NumericT>
+void smooth_chebyshev(unsigned int iterations,
+                      compressed_matrix<NumericT> const & A,
+                      vector<NumericT> & x,
+                      vector<NumericT> & x_backup,
+                      vector<NumericT> const & rhs_smooth,
+                      vector<NumericT> const & diag,
+                      vector<NumericT> & d,
+                      unsigned int degree,
+                      NumericT lambda_min,
+                      NumericT lambda_max)
+{
+  NumericT     const * A_elements    = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+  NumericT     const * rhs_elements  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs_smooth.handle());
+  NumericT     const * diag_elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(diag.handle());
+
+  NumericT * x_elements        = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x.handle());
+  NumericT * x_backup_elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x_backup.handle());
+  NumericT * d_elements        = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(d.handle());
+
+  long size = static_cast<long>(A.size1());
+
+  NumericT theta = (lambda_max + lambda_min) / NumericT(2);
+  NumericT delta = (lambda_max - lambda_min) / NumericT(2);
+  NumericT sigma = theta / delta;
+
+  for (unsigned int i=0; i<iterations; ++i)
+  {
+    NumericT rho = NumericT(1) / sigma;
+
+    // the iterate alternates between x and x_backup:
+    NumericT * x_old = x_elements;
+    NumericT * x_new = x_backup_elements;
+
+    for (unsigned int k=0; k<degree; ++k)
+    {
+      NumericT rho_new = NumericT(1) / (NumericT(2) * sigma - rho);
+      NumericT d_scale = (k == 0) ? NumericT(0)         : rho_new * rho;
+      NumericT r_scale = (k == 0) ? NumericT(1) / theta : NumericT(2) * rho_new / delta;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long row2 = 0; row2 < size; ++row2)
+      {
+        vcl_size_t row = static_cast<vcl_size_t>(row2);
+
+        NumericT residual = rhs_elements[row];
+        for (unsigned int index = A_row_buffer[row]; index != A_row_buffer[row+1]; ++index)
+          residual -= A_elements[index] * x_old[A_col_buffer[index]];
+
+        NumericT d_row = d_scale * d_elements[row] + r_scale * residual / diag_elements[row];
+        d_elements[row] = d_row;
+        x_new[row] = x_old[row] + d_row;
+      }
+
+      if (k > 0)
+        rho = rho_new;
+      std::swap(x_old, x_new);
+    }
+
+    // result is in x_old:
+    if (x_old != x_elements)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long row = 0; row < size; ++row)
+        x_elements[row] = x_old[row];
+    }
+  }
+}
+
 } //namespace amg
 } //namespace host_based
 } //namespace linalg
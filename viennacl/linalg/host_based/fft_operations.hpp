@@ -27,6 +27,7 @@
 #include <viennacl/matrix.hpp>
 
 #include "viennacl/linalg/host_based/vector_operations.hpp"
+#include "viennacl/linalg/host_based/fft_plan.hpp"
 
 #include <stdexcept>
 #include <cmath>
@@ -194,58 +195,28 @@ namespace detail
       }
     }
 
-  } //namespace fft
-
-} //namespace detail
-
-/**
- * @brief Direct algoritm kenrnel
- */
-template<typename NumericT>
-void fft_direct(std::complex<NumericT> * input_complex, std::complex<NumericT> * output,
-                vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num, NumericT sign,
-                viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
-{
-  NumericT const NUM_PI = NumericT(3.14159265358979323846);
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel
-#endif
-  for (long batch_id2 = 0; batch_id2 < long(batch_num); batch_id2++)
-  {
-    vcl_size_t batch_id = vcl_size_t(batch_id2);
-    for (vcl_size_t k = 0; k < size; k += 1)
+    /** @brief Executes the cached plan of the given size and sign on interleaved complex data, where batch_num sequences are laid out according to stride and data_order. */
+    template<typename NumericT>
+    void execute_plan(NumericT const * in, NumericT * out,
+                      vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num, NumericT sign,
+                      FFT_DATA_ORDER::DATA_ORDER data_order)
     {
-      std::complex<NumericT> f = 0;
-      for (vcl_size_t n = 0; n < size; n++)
-      {
-        std::complex<NumericT> input;
-        if (!data_order)
-          input = input_complex[batch_id * stride + n]; //input index here
-        else
-          input = input_complex[n * stride + batch_id];
-        NumericT arg = sign * 2 * NUM_PI * NumericT(k) / NumericT(size * n);
-        NumericT sn  = std::sin(arg);
-        NumericT cs  = std::cos(arg);
-
-        std::complex<NumericT> ex(cs, sn);
-        std::complex<NumericT> tmp(input.real() * ex.real() - input.imag() * ex.imag(),
-                                   input.real() * ex.imag() + input.imag() * ex.real());
-        f = f + tmp;
-      }
-      if (!data_order)
-        output[batch_id * stride + k] = f;   // output index here
+      fft_plan_handle<fft_plan<NumericT> > plan = get_fft_plan<NumericT>(size, sign);
+      if (data_order == FFT_DATA_ORDER::ROW_MAJOR)
+        plan->execute(in, out, batch_num, 1, stride);
       else
-        output[k * stride + batch_id] = f;
+        plan->execute(in, out, batch_num, stride, 1);
     }
-  }
 
-}
+  } //namespace fft
+
+} //namespace detail
 
 /**
  * @brief Direct 1D algorithm for computing Fourier transformation.
  *
  * Works on any sizes of data.
- * Serial implementation has o(n^2) complexity
+ * Uses a cached mixed-radix plan (cf. fft_plan.hpp), hence has o(n * lg n) complexity.
  */
 template<typename NumericT, unsigned int AlignmentV>
 void direct(viennacl::vector<NumericT, AlignmentV> const & in,
@@ -254,21 +225,17 @@ void direct(viennacl::vector<NumericT, AlignmentV> const & in,
             vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
-  std::vector<std::complex<NumericT> > input_complex(size * batch_num);
-  std::vector<std::complex<NumericT> > output(size * batch_num);
-
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], in, size * batch_num);
-
-  fft_direct(&input_complex[0], &output[0], size, stride, batch_num, sign, data_order);
+  NumericT const * data_A = detail::extract_raw_pointer<NumericT>(in);
+  NumericT       * data_B = detail::extract_raw_pointer<NumericT>(out);
 
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&output[0], out, size * batch_num);
+  viennacl::linalg::host_based::detail::fft::execute_plan(data_A, data_B, size, stride, batch_num, sign, data_order);
 }
 
 /**
  * @brief Direct 2D algorithm for computing Fourier transformation.
  *
  * Works on any sizes of data.
- * Serial implementation has o(n^2) complexity
+ * Uses a cached mixed-radix plan (cf. fft_plan.hpp), hence has o(n * lg n) complexity.
  */
 template<typename NumericT, unsigned int AlignmentV>
 void direct(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & in,
@@ -276,22 +243,10 @@ void direct(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const &
             vcl_size_t stride, vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
-  vcl_size_t row_num = in.internal_size1();
-  vcl_size_t col_num = in.internal_size2() >> 1;
-
-  vcl_size_t size_mat = row_num * col_num;
-
-  std::vector<std::complex<NumericT> > input_complex(size_mat);
-  std::vector<std::complex<NumericT> > output(size_mat);
-
   NumericT const * data_A = detail::extract_raw_pointer<NumericT>(in);
   NumericT       * data_B = detail::extract_raw_pointer<NumericT>(out);
 
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], data_A, size_mat);
-
-  fft_direct(&input_complex[0], &output[0], size, stride, batch_num, sign, data_order);
-
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&output[0], data_B, size_mat);
+  viennacl::linalg::host_based::detail::fft::execute_plan(data_A, data_B, size, stride, batch_num, sign, data_order);
 }
 
 /*
@@ -381,170 +336,21 @@ void reorder(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& in,
   viennacl::linalg::host_based::detail::fft::copy_to_vector(&input[0], data, size_mat);
 }
 
-/**
- * @brief Radix-2 algorithm for computing Fourier transformation.
- * Kernel for computing smaller amount of data
- */
-template<typename NumericT>
-void fft_radix2(std::complex<NumericT> * input_complex, vcl_size_t batch_num,
-                vcl_size_t bit_size, vcl_size_t size, vcl_size_t stride, NumericT sign,
-                viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
-{
-  NumericT const NUM_PI = NumericT(3.14159265358979323846);
-
-  for (vcl_size_t step = 0; step < bit_size; step++)
-  {
-    vcl_size_t ss = 1 << step;
-    vcl_size_t half_size = size >> 1;
-
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-#endif
-    for (long batch_id2 = 0; batch_id2 < long(batch_num); batch_id2++)
-    {
-      vcl_size_t batch_id = vcl_size_t(batch_id2);
-      for (vcl_size_t tid = 0; tid < half_size; tid++)
-      {
-        vcl_size_t group = (tid & (ss - 1));
-        vcl_size_t pos = ((tid >> step) << (step + 1)) + group;
-        std::complex<NumericT> in1;
-        std::complex<NumericT> in2;
-        vcl_size_t offset;
-        if (!data_order)
-        {
-          offset = batch_id * stride + pos;
-          in1 = input_complex[offset];
-          in2 = input_complex[offset + ss];
-        }
-        else
-        {
-          offset = pos * stride + batch_id;
-          in1 = input_complex[offset];
-          in2 = input_complex[offset + ss * stride];
-        }
-        NumericT arg = NumericT(group) * sign * NUM_PI / NumericT(ss);
-        NumericT sn = std::sin(arg);
-        NumericT cs = std::cos(arg);
-        std::complex<NumericT> ex(cs, sn);
-        std::complex<NumericT> tmp(in2.real() * ex.real() - in2.imag() * ex.imag(),
-                                   in2.real() * ex.imag() + in2.imag() * ex.real());
-        if (!data_order)
-          input_complex[offset + ss] = in1 - tmp;
-        else
-          input_complex[offset + ss * stride] = in1 - tmp;
-        input_complex[offset] = in1 + tmp;
-      }
-    }
-  }
-
-}
-
-/**
- * @brief Radix-2 algorithm for computing Fourier transformation.
- * Kernel for computing bigger amount of data
- */
-template<typename NumericT>
-void fft_radix2_local(std::complex<NumericT> * input_complex,
-                      std::complex<NumericT> * lcl_input, vcl_size_t batch_num, vcl_size_t bit_size,
-                      vcl_size_t size, vcl_size_t stride, NumericT sign,
-                      viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
-{
-  NumericT const NUM_PI = NumericT(3.14159265358979323846);
-
-  for (vcl_size_t batch_id = 0; batch_id < batch_num; batch_id++)
-  {
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-#endif
-    for (long p2 = 0; p2 < long(size); p2 += 1)
-    {
-      vcl_size_t p = vcl_size_t(p2);
-      vcl_size_t v = viennacl::linalg::host_based::detail::fft::get_reorder_num(p, bit_size);
-
-      if (!data_order)
-        lcl_input[v] = input_complex[batch_id * stride + p]; //index
-      else
-        lcl_input[v] = input_complex[p * stride + batch_id];
-    }
-
-    for (vcl_size_t s = 0; s < bit_size; s++)
-    {
-      vcl_size_t ss = 1 << s;
-#ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for
-#endif
-      for (long tid2 = 0; tid2 < long(size)/2; tid2++)
-      {
-        vcl_size_t tid = vcl_size_t(tid2);
-        vcl_size_t group = (tid & (ss - 1));
-        vcl_size_t pos = ((tid >> s) << (s + 1)) + group;
-
-        std::complex<NumericT> in1 = lcl_input[pos];
-        std::complex<NumericT> in2 = lcl_input[pos + ss];
-
-        NumericT arg = NumericT(group) * sign * NUM_PI / NumericT(ss);
-
-        NumericT sn = std::sin(arg);
-        NumericT cs = std::cos(arg);
-        std::complex<NumericT> ex(cs, sn);
-
-        std::complex<NumericT> tmp(in2.real() * ex.real() - in2.imag() * ex.imag(),
-                                   in2.real() * ex.imag() + in2.imag() * ex.real());
-
-        lcl_input[pos + ss] = in1 - tmp;
-        lcl_input[pos] = in1 + tmp;
-      }
-
-    }
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-#endif
-    //copy local array back to global memory
-    for (long p2 = 0; p2 < long(size); p2 += 1)
-    {
-      vcl_size_t p = vcl_size_t(p2);
-      if (!data_order)
-        input_complex[batch_id * stride + p] = lcl_input[p];
-      else
-        input_complex[p * stride + batch_id] = lcl_input[p];
-
-    }
-
-  }
-
-}
-
 /**
  * @brief Radix-2 1D algorithm for computing Fourier transformation.
  *
  * Works only on power-of-two sizes of data.
  * Serial implementation has o(n * lg n) complexity.
- * This is a Cooley-Tukey algorithm
+ * Computed in place with a cached radix-8/4/2 Stockham plan (cf. fft_plan.hpp).
  */
 template<typename NumericT, unsigned int AlignmentV>
 void radix2(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_size_t stride,
             vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
+  NumericT * data = detail::extract_raw_pointer<NumericT>(in);
 
-  vcl_size_t bit_size = viennacl::linalg::host_based::detail::fft::num_bits(size);
-
-  std::vector<std::complex<NumericT> > input_complex(size * batch_num);
-  std::vector<std::complex<NumericT> > lcl_input(size * batch_num);
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], in, size * batch_num);
-
-  if (size <= viennacl::linalg::host_based::detail::fft::MAX_LOCAL_POINTS_NUM)
-  {
-    viennacl::linalg::host_based::fft_radix2_local(&input_complex[0], &lcl_input[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-  else
-  {
-    viennacl::linalg::host_based::reorder<NumericT>(in, size, stride, bit_size, batch_num, data_order);
-    viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], in, size * batch_num);
-    viennacl::linalg::host_based::fft_radix2(&input_complex[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&input_complex[0], in, size * batch_num);
+  viennacl::linalg::host_based::detail::fft::execute_plan(data, data, size, stride, batch_num, sign, data_order);
 }
 
 /**
@@ -552,129 +358,33 @@ void radix2(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_siz
  *
  * Works only on power-of-two sizes of data.
  * Serial implementation has o(n * lg n) complexity.
- * This is a Cooley-Tukey algorithm
+ * Computed in place with a cached radix-8/4/2 Stockham plan (cf. fft_plan.hpp).
  */
 template<typename NumericT, unsigned int AlignmentV>
 void radix2(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& in, vcl_size_t size,
             vcl_size_t stride, vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
-
-  vcl_size_t bit_size = viennacl::linalg::host_based::detail::fft::num_bits(size);
-
   NumericT * data = detail::extract_raw_pointer<NumericT>(in);
 
-  vcl_size_t row_num = in.internal_size1();
-  vcl_size_t col_num = in.internal_size2() >> 1;
-  vcl_size_t size_mat = row_num * col_num;
-
-  std::vector<std::complex<NumericT> > input_complex(size_mat);
-
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], data, size_mat);
-  if (size <= viennacl::linalg::host_based::detail::fft::MAX_LOCAL_POINTS_NUM)
-  {
-    //std::cout<<bit_size<<","<<size<<","<<stride<<","<<batch_num<<","<<size<<","<<sign<<","<<data_order<<std::endl;
-    std::vector<std::complex<NumericT> > lcl_input(size_mat);
-    viennacl::linalg::host_based::fft_radix2_local(&input_complex[0], &lcl_input[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-  else
-  {
-    viennacl::linalg::host_based::reorder<NumericT>(in, size, stride, bit_size, batch_num, data_order);
-    viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], data, size_mat);
-    viennacl::linalg::host_based::fft_radix2(&input_complex[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&input_complex[0], data, size_mat);
-
+  viennacl::linalg::host_based::detail::fft::execute_plan(data, data, size, stride, batch_num, sign, data_order);
 }
 
 /**
  * @brief Bluestein's algorithm for computing Fourier transformation.
  *
- * Currently,  Works only for sizes of input data which less than 2^16.
- * Uses a lot of additional memory, but should be fast for any size of data.
- * Serial implementation has something about o(n * lg n) complexity
+ * Works on any sizes of data. The chirp sequence and the transformed convolution kernel are stored in the cached plan (cf. fft_plan.hpp),
+ * which falls back to Bluestein's algorithm only if the size has large prime factors.
  */
 template<typename NumericT, unsigned int AlignmentV>
 void bluestein(viennacl::vector<NumericT, AlignmentV>& in, viennacl::vector<NumericT, AlignmentV>& out, vcl_size_t /*batch_num*/)
 {
-
   vcl_size_t size = in.size() >> 1;
-  vcl_size_t ext_size = viennacl::linalg::host_based::detail::fft::next_power_2(2 * size - 1);
-
-  viennacl::vector<NumericT, AlignmentV> A(ext_size << 1);
-  viennacl::vector<NumericT, AlignmentV> B(ext_size << 1);
-  viennacl::vector<NumericT, AlignmentV> Z(ext_size << 1);
-
-  std::vector<std::complex<NumericT> > input_complex(size);
-  std::vector<std::complex<NumericT> > output_complex(size);
-
-  std::vector<std::complex<NumericT> > A_complex(ext_size);
-  std::vector<std::complex<NumericT> > B_complex(ext_size);
-  std::vector<std::complex<NumericT> > Z_complex(ext_size);
-
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], in, size);
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long i2 = 0; i2 < long(ext_size); i2++)
-  {
-    vcl_size_t i = vcl_size_t(i2);
-    A_complex[i] = 0;
-    B_complex[i] = 0;
-  }
-
-  vcl_size_t double_size = size << 1;
-
-  NumericT const NUM_PI = NumericT(3.14159265358979323846);
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long i2 = 0; i2 < long(size); i2++)
-  {
-    vcl_size_t i = vcl_size_t(i2);
-    vcl_size_t rm = i * i % (double_size);
-    NumericT angle = NumericT(rm) / NumericT(size) * NumericT(NUM_PI);
-
-    NumericT sn_a = std::sin(-angle);
-    NumericT cs_a = std::cos(-angle);
-
-    std::complex<NumericT> a_i(cs_a, sn_a);
-    std::complex<NumericT> b_i(cs_a, -sn_a);
-
-    A_complex[i] = std::complex<NumericT>(input_complex[i].real() * a_i.real() - input_complex[i].imag() * a_i.imag(),
-                                          input_complex[i].real() * a_i.imag() + input_complex[i].imag() * a_i.real());
-    B_complex[i] = b_i;
-
-    // very bad instruction, to be fixed
-    if (i)
-      B_complex[ext_size - i] = b_i;
-  }
 
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&input_complex[0], in, size);
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&A_complex[0], A, ext_size);
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&B_complex[0], B, ext_size);
-
-  viennacl::linalg::convolve_i(A, B, Z);
-
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&Z_complex[0], Z, ext_size);
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long i2 = 0; i2 < long(size); i2++)
-  {
-    vcl_size_t i = vcl_size_t(i2);
-    vcl_size_t rm = i * i % (double_size);
-    NumericT angle = NumericT(rm) / NumericT(size) * NumericT(-NUM_PI);
-    NumericT sn_a = std::sin(angle);
-    NumericT cs_a = std::cos(angle);
-    std::complex<NumericT> b_i(cs_a, sn_a);
-    output_complex[i] = std::complex<NumericT>(Z_complex[i].real() * b_i.real() - Z_complex[i].imag() * b_i.imag(),
-                                               Z_complex[i].real() * b_i.imag() + Z_complex[i].imag() * b_i.real());
-  }
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&output_complex[0], out, size);
+  NumericT const * data_A = detail::extract_raw_pointer<NumericT>(in);
+  NumericT       * data_B = detail::extract_raw_pointer<NumericT>(out);
 
+  get_fft_plan<NumericT>(size, NumericT(-1))->execute(data_A, data_B, 1, 1, size);
 }
 
 /**
@@ -828,6 +538,206 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
     data_out[i] = data_in[2*i];
 }
 
+/**
+ * @brief Real-to-complex 1D Fourier transformation of batch_num real sequences of length size.
+ *
+ * For each sequence, the size/2+1 non-redundant entries of the Hermitian spectrum are written to 'out' (interleaved real and imaginary parts).
+ */
+template<typename NumericT>
+void real_fft(viennacl::vector_base<NumericT> const & in,
+              viennacl::vector_base<NumericT>       & out, vcl_size_t size, vcl_size_t batch_num)
+{
+  fft_plan_handle<fft_real_plan<NumericT> > plan = get_fft_real_plan<NumericT>(size);
+
+  NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in)  + viennacl::traits::start(in);
+  NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out) + viennacl::traits::start(out);
+  vcl_size_t inc_in  = viennacl::traits::stride(in);
+  vcl_size_t inc_out = viennacl::traits::stride(out);
+
+  plan->execute_forward(data_in,  inc_in,  size * inc_in,
+                        data_out, inc_out, 2 * plan->spectrum_size() * inc_out, batch_num);
+}
+
+/**
+ * @brief Complex-to-real 1D Fourier transformation, the unnormalized inverse of real_fft().
+ *
+ * Reads batch_num half-spectra of size/2+1 complex entries each and writes batch_num real sequences of length size.
+ */
+template<typename NumericT>
+void inverse_real_fft(viennacl::vector_base<NumericT> const & in,
+                      viennacl::vector_base<NumericT>       & out, vcl_size_t size, vcl_size_t batch_num)
+{
+  fft_plan_handle<fft_real_plan<NumericT> > plan = get_fft_real_plan<NumericT>(size);
+
+  NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in)  + viennacl::traits::start(in);
+  NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out) + viennacl::traits::start(out);
+  vcl_size_t inc_in  = viennacl::traits::stride(in);
+  vcl_size_t inc_out = viennacl::traits::stride(out);
+
+  plan->execute_backward(data_in,  inc_in,  2 * plan->spectrum_size() * inc_in,
+                         data_out, inc_out, size * inc_out, batch_num);
+}
+
+/**
+ * @brief Real-to-complex 2D Fourier transformation of a real M x N matrix.
+ *
+ * The result is the M x (N/2+1) half-spectrum, stored as an M x 2(N/2+1) matrix with interleaved real and imaginary parts.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void real_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & in,
+              viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & out)
+{
+  vcl_size_t rows_num = in.size1();
+  vcl_size_t cols_num = in.size2();
+
+  fft_plan_handle<fft_real_plan<NumericT> > plan = get_fft_real_plan<NumericT>(cols_num);
+  vcl_size_t spectrum_size = plan->spectrum_size();
+
+  assert(out.size1() == rows_num && out.size2() == 2 * spectrum_size && bool("Size mismatch"));
+  assert(out.internal_size2() % 2 == 0 && bool("Interleaved complex rows require an even internal row length"));
+
+  NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in);
+  NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
+
+  // R2C transformation of the rows:
+  plan->execute_forward(data_in, 1, in.internal_size2(), data_out, 1, out.internal_size2(), rows_num);
+
+  // complex transformation of the N/2+1 columns:
+  get_fft_plan<NumericT>(rows_num, NumericT(-1))->execute(data_out, data_out, spectrum_size, out.internal_size2() / 2, 1);
+}
+
+/**
+ * @brief Complex-to-real 2D Fourier transformation, the unnormalized inverse of the 2D real_fft().
+ *
+ * Reads the M x (N/2+1) half-spectrum stored in an M x 2(N/2+1) matrix and writes the real M x N matrix 'out'. The input is not modified.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void inverse_real_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & in,
+                      viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & out)
+{
+  vcl_size_t rows_num = out.size1();
+  vcl_size_t cols_num = out.size2();
+
+  fft_plan_handle<fft_real_plan<NumericT> > plan = get_fft_real_plan<NumericT>(cols_num);
+  vcl_size_t spectrum_size = plan->spectrum_size();
+
+  assert(in.size1() == rows_num && in.size2() == 2 * spectrum_size && bool("Size mismatch"));
+
+  NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in);
+  NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
+
+  // inverse complex transformation of the columns on a packed copy:
+  std::vector<NumericT> temp(rows_num * 2 * spectrum_size);
+  for (vcl_size_t i = 0; i < rows_num; ++i)
+    std::copy(data_in + i * in.internal_size2(), data_in + i * in.internal_size2() + 2 * spectrum_size, temp.begin() + vcl_ptrdiff_t(i * 2 * spectrum_size));
+
+  if (rows_num > 0)
+  {
+    get_fft_plan<NumericT>(rows_num, NumericT(1))->execute(&(temp[0]), &(temp[0]), spectrum_size, spectrum_size, 1);
+
+    // C2R transformation of the rows:
+    plan->execute_backward(&(temp[0]), 1, 2 * spectrum_size, data_out, 1, out.internal_size2(), rows_num);
+  }
+}
+
+/**
+ * @brief Cyclic convolution of length 'size' with a fixed real kernel using R2C/C2R transformations.
+ *
+ * The transformed kernel and the work arrays are kept, so each application costs one forward transformation, a pointwise product, and one backward transformation.
+ * Since the work arrays are reused, an object must not be applied by several threads at the same time.
+ */
+template<typename NumericT>
+class fft_convolution
+{
+public:
+  fft_convolution() : size_(0) {}
+
+  /** @brief Sets up the convolution with 'kernel', which is padded with zeros to length 'size'. */
+  fft_convolution(viennacl::vector_base<NumericT> const & kernel, vcl_size_t size) : size_(0) { init(kernel, size); }
+
+  /** @brief Transforms the kernel, which is padded with zeros to length 'size'. Also resizes the work arrays. */
+  void init(viennacl::vector_base<NumericT> const & kernel, vcl_size_t size)
+  {
+    assert(kernel.size() <= size && bool("Size mismatch"));
+
+    fft_plan_handle<fft_real_plan<NumericT> > plan = get_fft_real_plan<NumericT>(size);
+    size_ = size;
+    spectrum_.resize(2 * plan->spectrum_size());
+    work_spectrum_.resize(2 * plan->spectrum_size());
+    work_.resize(size);
+
+    copy_padded(kernel);
+    plan->execute_forward(&(work_[0]), 1, size, &(spectrum_[0]), 1, spectrum_.size(), 1);
+
+    // the normalization of the backward transformation is applied to the kernel once:
+    NumericT scale = NumericT(1) / NumericT(size);
+    for (vcl_size_t k = 0; k < spectrum_.size(); ++k)
+      spectrum_[k] *= scale;
+  }
+
+  /** @brief Returns the length of the cyclic convolution, or zero if init() has not been called yet */
+  vcl_size_t size() const { return size_; }
+
+  /** @brief Writes the first output.size() entries of the cyclic convolution of the kernel with 'input' (padded with zeros) to 'output'. */
+  void apply(viennacl::vector_base<NumericT> const & input, viennacl::vector_base<NumericT> & output)
+  {
+    assert(input.size() <= size_ && output.size() <= size_ && bool("Size mismatch"));
+
+    fft_plan_handle<fft_real_plan<NumericT> > plan = get_fft_real_plan<NumericT>(size_);
+    vcl_size_t spectrum_size = plan->spectrum_size();
+
+    copy_padded(input);
+    plan->execute_forward(&(work_[0]), 1, size_, &(work_spectrum_[0]), 1, 2 * spectrum_size, 1);
+
+    for (vcl_size_t k = 0; k < spectrum_size; ++k)
+    {
+      NumericT re = spectrum_[2*k] * work_spectrum_[2*k]   - spectrum_[2*k+1] * work_spectrum_[2*k+1];
+      NumericT im = spectrum_[2*k] * work_spectrum_[2*k+1] + spectrum_[2*k+1] * work_spectrum_[2*k];
+      work_spectrum_[2*k]   = re;
+      work_spectrum_[2*k+1] = im;
+    }
+
+    plan->execute_backward(&(work_spectrum_[0]), 1, 2 * spectrum_size, &(work_[0]), 1, size_, 1);
+
+    NumericT * data_out = detail::extract_raw_pointer<NumericT>(output) + viennacl::traits::start(output);
+    vcl_size_t inc_out = viennacl::traits::stride(output);
+    for (vcl_size_t i = 0; i < output.size(); ++i)
+      data_out[i * inc_out] = work_[i];
+  }
+
+private:
+  void copy_padded(viennacl::vector_base<NumericT> const & v)
+  {
+    NumericT const * data_v = detail::extract_raw_pointer<NumericT>(v) + viennacl::traits::start(v);
+    vcl_size_t inc_v = viennacl::traits::stride(v);
+    for (vcl_size_t i = 0; i < v.size(); ++i)
+      work_[i] = data_v[i * inc_v];
+    std::fill(work_.begin() + vcl_ptrdiff_t(v.size()), work_.end(), NumericT(0));
+  }
+
+  vcl_size_t size_;
+  std::vector<NumericT> spectrum_;
+  std::vector<NumericT> work_;
+  std::vector<NumericT> work_spectrum_;
+};
+
+/**
+ * @brief Cyclic convolution of length 'size' of two real vectors using R2C/C2R transformations.
+ *
+ * Inputs shorter than 'size' are padded with zeros. The first output.size() entries of the convolution are written to 'output'.
+ * Use fft_convolution if one of the inputs is convolved repeatedly.
+ */
+template<typename NumericT>
+void convolve_real(viennacl::vector_base<NumericT> const & input1,
+                   viennacl::vector_base<NumericT> const & input2,
+                   viennacl::vector_base<NumericT>       & output, vcl_size_t size)
+{
+  assert(input1.size() <= size && input2.size() <= size && output.size() <= size && bool("Size mismatch"));
+
+  fft_convolution<NumericT> conv(input1, size);
+  conv.apply(input2, output);
+}
+
 /**
  * @brief Reverse vector to opposite order and save it in input vector
  */
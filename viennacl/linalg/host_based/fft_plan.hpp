@@ -0,0 +1,1076 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_FFT_PLAN_HPP_
+#define VIENNACL_LINALG_HOST_BASED_FFT_PLAN_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/fft_plan.hpp
+    @brief Plan-based mixed-radix Fast Fourier Transformation for the host backend.
+
+    A plan holds the decomposition of the transform size into radix-8, -4, -2, -3, -5 (and small generic prime) stages together with all twiddle factors,
+    hence executing a plan does not evaluate any trigonometric functions. Sizes with a prime factor larger than detail::fft::MAX_GENERIC_RADIX are computed with Bluestein's algorithm on top of a power-of-two plan.
+    The stages are self-sorting (Stockham) and work on split real and imaginary arrays, so that the butterflies are simple loops which are vectorized by the compiler.
+    Plans are built once per size and sign and kept in a bounded, thread-safe cache, cf. get_fft_plan(). Real-to-complex transformations are provided by fft_real_plan, cf. get_fft_real_plan().
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/cpu_ram.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum vector size for using OpenMP on vector operations:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+  namespace fft
+  {
+    /** @brief Largest prime factor of the transform size handled by a generic O(p^2) butterfly. Sizes with larger prime factors use Bluestein's algorithm. */
+    const vcl_size_t MAX_GENERIC_RADIX = 32;
+
+    /** @brief One self-sorting stage: m * s butterflies of the given radix, reading with stride s * m and writing with stride s. */
+    struct fft_stage
+    {
+      vcl_size_t radix;
+      vcl_size_t m;
+      vcl_size_t s;
+      vcl_size_t twiddle_offset;   // m * (radix - 1) twiddle factors, p-major
+      vcl_size_t root_offset;      // radix roots of unity for generic butterflies
+    };
+
+    /** @brief Splits [0, n) evenly among num_threads threads and returns the part of thread_id. */
+    inline void fft_range(vcl_size_t n, vcl_size_t thread_id, vcl_size_t num_threads, vcl_size_t & begin, vcl_size_t & end)
+    {
+      begin = (n * thread_id) / num_threads;
+      end   = (n * (thread_id + 1)) / num_threads;
+    }
+
+    /** @brief Synchronizes the threads of the enclosing parallel region if the work is shared among several threads. */
+    inline void fft_barrier(vcl_size_t num_threads)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      if (num_threads > 1)
+      {
+        #pragma omp barrier
+      }
+#else
+      (void)num_threads;
+#endif
+    }
+
+    /** @brief Multiplies (re, im) by the twiddle factor (wr, wi) and stores the result in (yr, yi). */
+    template<typename NumericT>
+    inline void fft_twiddle(NumericT re, NumericT im, NumericT wr, NumericT wi, NumericT & yr, NumericT & yi)
+    {
+      yr = re * wr - im * wi;
+      yi = re * wi + im * wr;
+    }
+
+    //
+    // Butterflies. Inputs are x[t * xs], t = 0, ..., radix-1, outputs are y[u * ys] = (DFT_radix x)_u * w[u-1].
+    //
+
+    template<typename NumericT>
+    struct fft_butterfly_2
+    {
+      explicit fft_butterfly_2(NumericT /*sign*/) {}
+
+      void operator()(NumericT const * xr, NumericT const * xi, vcl_size_t xs,
+                      NumericT * yr, NumericT * yi, vcl_size_t ys,
+                      NumericT const * wr, NumericT const * wi) const
+      {
+        NumericT a0r = xr[0],  a0i = xi[0];
+        NumericT a1r = xr[xs], a1i = xi[xs];
+
+        yr[0] = a0r + a1r;
+        yi[0] = a0i + a1i;
+        fft_twiddle(a0r - a1r, a0i - a1i, wr[0], wi[0], yr[ys], yi[ys]);
+      }
+    };
+
+    template<typename NumericT>
+    struct fft_butterfly_4
+    {
+      explicit fft_butterfly_4(NumericT sign) : sign_(sign) {}
+
+      void operator()(NumericT const * xr, NumericT const * xi, vcl_size_t xs,
+                      NumericT * yr, NumericT * yi, vcl_size_t ys,
+                      NumericT const * wr, NumericT const * wi) const
+      {
+        NumericT t0r = xr[0]    + xr[2*xs], t0i = xi[0]    + xi[2*xs];
+        NumericT t1r = xr[0]    - xr[2*xs], t1i = xi[0]    - xi[2*xs];
+        NumericT t2r = xr[xs]   + xr[3*xs], t2i = xi[xs]   + xi[3*xs];
+        NumericT d3r = xr[xs]   - xr[3*xs], d3i = xi[xs]   - xi[3*xs];
+        NumericT t3r = -sign_ * d3i,        t3i = sign_ * d3r;          // (x[1] - x[3]) * sign * i
+
+        yr[0] = t0r + t2r;
+        yi[0] = t0i + t2i;
+        fft_twiddle(t1r + t3r, t1i + t3i, wr[0], wi[0], yr[ys],   yi[ys]);
+        fft_twiddle(t0r - t2r, t0i - t2i, wr[1], wi[1], yr[2*ys], yi[2*ys]);
+        fft_twiddle(t1r - t3r, t1i - t3i, wr[2], wi[2], yr[3*ys], yi[3*ys]);
+      }
+
+      NumericT sign_;
+    };
+
+    template<typename NumericT>
+    struct fft_butterfly_8
+    {
+      explicit fft_butterfly_8(NumericT sign) : sign_(sign), sqrt_half_(NumericT(0.70710678118654752440)) {}
+
+      void operator()(NumericT const * xr, NumericT const * xi, vcl_size_t xs,
+                      NumericT * yr, NumericT * yi, vcl_size_t ys,
+                      NumericT const * wr, NumericT const * wi) const
+      {
+        // radix-4 transforms of the even and the odd entries:
+        NumericT e0r = xr[0]    + xr[4*xs], e0i = xi[0]    + xi[4*xs];
+        NumericT e1r = xr[0]    - xr[4*xs], e1i = xi[0]    - xi[4*xs];
+        NumericT e2r = xr[2*xs] + xr[6*xs], e2i = xi[2*xs] + xi[6*xs];
+        NumericT e3r = xr[2*xs] - xr[6*xs], e3i = xi[2*xs] - xi[6*xs];
+        NumericT o0r = xr[xs]   + xr[5*xs], o0i = xi[xs]   + xi[5*xs];
+        NumericT o1r = xr[xs]   - xr[5*xs], o1i = xi[xs]   - xi[5*xs];
+        NumericT o2r = xr[3*xs] + xr[7*xs], o2i = xi[3*xs] + xi[7*xs];
+        NumericT o3r = xr[3*xs] - xr[7*xs], o3i = xi[3*xs] - xi[7*xs];
+
+        NumericT E0r = e0r + e2r,           E0i = e0i + e2i;
+        NumericT E2r = e0r - e2r,           E2i = e0i - e2i;
+        NumericT E1r = e1r - sign_ * e3i,   E1i = e1i + sign_ * e3r;
+        NumericT E3r = e1r + sign_ * e3i,   E3i = e1i - sign_ * e3r;
+        NumericT O0r = o0r + o2r,           O0i = o0i + o2i;
+        NumericT O2r = o0r - o2r,           O2i = o0i - o2i;
+        NumericT O1r = o1r - sign_ * o3i,   O1i = o1i + sign_ * o3r;
+        NumericT O3r = o1r + sign_ * o3i,   O3i = o1i - sign_ * o3r;
+
+        // multiply odd part by powers of the eighth root of unity:
+        NumericT P1r = sqrt_half_ * (O1r - sign_ * O1i), P1i = sqrt_half_ * (O1i + sign_ * O1r);
+        NumericT P2r = -sign_ * O2i,                     P2i = sign_ * O2r;
+        NumericT P3r = sqrt_half_ * (-O3r - sign_ * O3i), P3i = sqrt_half_ * (-O3i + sign_ * O3r);
+
+        yr[0] = E0r + O0r;
+        yi[0] = E0i + O0i;
+        fft_twiddle(E1r + P1r, E1i + P1i, wr[0], wi[0], yr[ys],   yi[ys]);
+        fft_twiddle(E2r + P2r, E2i + P2i, wr[1], wi[1], yr[2*ys], yi[2*ys]);
+        fft_twiddle(E3r + P3r, E3i + P3i, wr[2], wi[2], yr[3*ys], yi[3*ys]);
+        fft_twiddle(E0r - O0r, E0i - O0i, wr[3], wi[3], yr[4*ys], yi[4*ys]);
+        fft_twiddle(E1r - P1r, E1i - P1i, wr[4], wi[4], yr[5*ys], yi[5*ys]);
+        fft_twiddle(E2r - P2r, E2i - P2i, wr[5], wi[5], yr[6*ys], yi[6*ys]);
+        fft_twiddle(E3r - P3r, E3i - P3i, wr[6], wi[6], yr[7*ys], yi[7*ys]);
+      }
+
+      NumericT sign_;
+      NumericT sqrt_half_;
+    };
+
+    template<typename NumericT>
+    struct fft_butterfly_3
+    {
+      explicit fft_butterfly_3(NumericT sign) : s3_(sign * NumericT(0.86602540378443864676)) {}
+
+      void operator()(NumericT const * xr, NumericT const * xi, vcl_size_t xs,
+                      NumericT * yr, NumericT * yi, vcl_size_t ys,
+                      NumericT const * wr, NumericT const * wi) const
+      {
+        NumericT tr = xr[xs] + xr[2*xs], ti = xi[xs] + xi[2*xs];
+        NumericT dr = xr[xs] - xr[2*xs], di = xi[xs] - xi[2*xs];
+        NumericT mr = xr[0] - NumericT(0.5) * tr, mi = xi[0] - NumericT(0.5) * ti;
+
+        yr[0] = xr[0] + tr;
+        yi[0] = xi[0] + ti;
+        fft_twiddle(mr - s3_ * di, mi + s3_ * dr, wr[0], wi[0], yr[ys],   yi[ys]);
+        fft_twiddle(mr + s3_ * di, mi - s3_ * dr, wr[1], wi[1], yr[2*ys], yi[2*ys]);
+      }
+
+      NumericT s3_;   // sign * sin(2 pi / 3)
+    };
+
+    template<typename NumericT>
+    struct fft_butterfly_5
+    {
+      explicit fft_butterfly_5(NumericT sign)
+        : c1_(NumericT( 0.30901699437494742410)), c2_(NumericT(-0.80901699437494742410)),
+          s1_(sign * NumericT(0.95105651629515357212)), s2_(sign * NumericT(0.58778525229247312917)) {}
+
+      void operator()(NumericT const * xr, NumericT const * xi, vcl_size_t xs,
+                      NumericT * yr, NumericT * yi, vcl_size_t ys,
+                      NumericT const * wr, NumericT const * wi) const
+      {
+        NumericT t1r = xr[xs]   + xr[4*xs], t1i = xi[xs]   + xi[4*xs];
+        NumericT t2r = xr[2*xs] + xr[3*xs], t2i = xi[2*xs] + xi[3*xs];
+        NumericT d1r = xr[xs]   - xr[4*xs], d1i = xi[xs]   - xi[4*xs];
+        NumericT d2r = xr[2*xs] - xr[3*xs], d2i = xi[2*xs] - xi[3*xs];
+
+        NumericT m1r = xr[0] + c1_ * t1r + c2_ * t2r, m1i = xi[0] + c1_ * t1i + c2_ * t2i;
+        NumericT m2r = xr[0] + c2_ * t1r + c1_ * t2r, m2i = xi[0] + c2_ * t1i + c1_ * t2i;
+
+        // n1 = i * (s1 d1 + s2 d2), n2 = i * (s2 d1 - s1 d2):
+        NumericT n1r = -(s1_ * d1i + s2_ * d2i), n1i = s1_ * d1r + s2_ * d2r;
+        NumericT n2r = -(s2_ * d1i - s1_ * d2i), n2i = s2_ * d1r - s1_ * d2r;
+
+        yr[0] = xr[0] + t1r + t2r;
+        yi[0] = xi[0] + t1i + t2i;
+        fft_twiddle(m1r + n1r, m1i + n1i, wr[0], wi[0], yr[ys],   yi[ys]);
+        fft_twiddle(m2r + n2r, m2i + n2i, wr[1], wi[1], yr[2*ys], yi[2*ys]);
+        fft_twiddle(m2r - n2r, m2i - n2i, wr[2], wi[2], yr[3*ys], yi[3*ys]);
+        fft_twiddle(m1r - n1r, m1i - n1i, wr[3], wi[3], yr[4*ys], yi[4*ys]);
+      }
+
+      NumericT c1_, c2_, s1_, s2_;   // cos(2 pi k/5) and sign * sin(2 pi k/5) for k = 1, 2
+    };
+
+    /** @brief Butterfly for an arbitrary (small, prime) radix with precomputed roots of unity. */
+    template<typename NumericT>
+    struct fft_butterfly_generic
+    {
+      fft_butterfly_generic(vcl_size_t radix, NumericT const * roots_re, NumericT const * roots_im)
+        : radix_(radix), roots_re_(roots_re), roots_im_(roots_im) {}
+
+      void operator()(NumericT const * xr, NumericT const * xi, vcl_size_t xs,
+                      NumericT * yr, NumericT * yi, vcl_size_t ys,
+                      NumericT const * wr, NumericT const * wi) const
+      {
+        for (vcl_size_t u = 0; u < radix_; ++u)
+        {
+          NumericT br = 0, bi = 0;
+          vcl_size_t k = 0;   // (t * u) mod radix
+          for (vcl_size_t t = 0; t < radix_; ++t)
+          {
+            br += xr[t*xs] * roots_re_[k] - xi[t*xs] * roots_im_[k];
+            bi += xr[t*xs] * roots_im_[k] + xi[t*xs] * roots_re_[k];
+            k += u;
+            if (k >= radix_)
+              k -= radix_;
+          }
+          if (u == 0)
+          {
+            yr[0] = br;
+            yi[0] = bi;
+          }
+          else
+            fft_twiddle(br, bi, wr[u-1], wi[u-1], yr[u*ys], yi[u*ys]);
+        }
+      }
+
+      vcl_size_t radix_;
+      NumericT const * roots_re_;
+      NumericT const * roots_im_;
+    };
+
+    /** @brief Runs the butterflies [begin, end) of a stage, where butterfly index f corresponds to group p = f / s and offset q = f % s. */
+    template<typename NumericT, typename ButterflyT>
+    void fft_stage_loop(ButterflyT const & butterfly, fft_stage const & stage,
+                        NumericT const * xr, NumericT const * xi, NumericT * yr, NumericT * yi,
+                        NumericT const * twiddle_re, NumericT const * twiddle_im,
+                        vcl_size_t begin, vcl_size_t end)
+    {
+      vcl_size_t const r  = stage.radix;
+      vcl_size_t const s  = stage.s;
+      vcl_size_t const xs = stage.s * stage.m;
+
+      for (vcl_size_t p = begin / s; p * s < end; ++p)
+      {
+        vcl_size_t q_begin = (p * s < begin) ? begin - p * s : 0;
+        vcl_size_t q_end   = std::min(s, end - p * s);
+
+        NumericT const * wr = twiddle_re + stage.twiddle_offset + p * (r - 1);
+        NumericT const * wi = twiddle_im + stage.twiddle_offset + p * (r - 1);
+
+        NumericT const * x_re = xr + s * p;
+        NumericT const * x_im = xi + s * p;
+        NumericT       * y_re = yr + s * r * p;
+        NumericT       * y_im = yi + s * r * p;
+
+        for (vcl_size_t q = q_begin; q < q_end; ++q)
+          butterfly(x_re + q, x_im + q, xs, y_re + q, y_im + q, s, wr, wi);
+      }
+    }
+
+    inline vcl_size_t fft_next_power_2(vcl_size_t n)
+    {
+      vcl_size_t p = 1;
+      while (p < n)
+        p <<= 1;
+      return p;
+    }
+
+  } //namespace fft
+} //namespace detail
+
+
+/** @brief A precomputed plan for complex-to-complex Fourier transformations of a fixed size and sign on the host.
+  *
+  * Data is interleaved (real part followed by imaginary part). Plans are immutable after construction, hence a single plan may be executed concurrently.
+  */
+template<typename NumericT>
+class fft_plan
+{
+public:
+  /** @brief Builds the plan for transformations of length 'size' with exponent sign 'sign' (-1 for the forward, +1 for the backward transform). */
+  fft_plan(vcl_size_t size, NumericT sign) : size_(size), sign_(sign < 0 ? NumericT(-1) : NumericT(1)), bluestein_size_(0)
+  {
+    // decomposition of the size into radices:
+    std::vector<vcl_size_t> radices;
+    vcl_size_t n = size_;
+    vcl_size_t power_of_two = 0;
+    while (n > 1 && n % 2 == 0)
+    {
+      n /= 2;
+      ++power_of_two;
+    }
+    for (; power_of_two >= 3; power_of_two -= 3)
+      radices.push_back(8);
+    if (power_of_two > 0)
+      radices.push_back(vcl_size_t(1) << power_of_two);
+    for (vcl_size_t p = 3; p * p <= n; p += 2)
+      while (n % p == 0)
+      {
+        radices.push_back(p);
+        n /= p;
+      }
+    if (n > 1)
+      radices.push_back(n);
+
+    for (vcl_size_t i = 0; i < radices.size(); ++i)
+      if (radices[i] > detail::fft::MAX_GENERIC_RADIX)
+      {
+        init_bluestein();
+        return;
+      }
+
+    init_stages(radices);
+  }
+
+  /** @brief Returns the length of the transformation. */
+  vcl_size_t size() const { return size_; }
+
+  /** @brief Returns the sign of the exponent. */
+  NumericT sign() const { return sign_; }
+
+  /** @brief Number of entries of the scratch buffer required by transform(). */
+  vcl_size_t scratch_size() const
+  {
+    if (bluestein_size_ > 0)
+      return 2 * bluestein_size_ + bluestein_plan_->scratch_size();
+    return 2 * size_;
+  }
+
+  /** @brief Transforms a single sequence stored as split real and imaginary parts in place.
+    *
+    * If num_threads > 1, the function must be called by all threads of the enclosing OpenMP parallel region, which then share the work.
+    *
+    * @param re           Real parts, overwritten with the result
+    * @param im           Imaginary parts, overwritten with the result
+    * @param scratch      Work array of size scratch_size()
+    * @param thread_id    Index of the calling thread
+    * @param num_threads  Number of threads sharing the transformation
+    */
+  void transform(NumericT * re, NumericT * im, NumericT * scratch,
+                 vcl_size_t thread_id = 0, vcl_size_t num_threads = 1) const
+  {
+    if (bluestein_size_ > 0)
+      transform_bluestein(re, im, scratch, thread_id, num_threads);
+    else
+      transform_stockham(re, im, scratch, thread_id, num_threads);
+  }
+
+  /** @brief Transforms batch_num interleaved complex sequences. Entry i of sequence b is located at complex index b * batch_stride + i * element_stride. 'in' and 'out' may coincide. */
+  void execute(NumericT const * in, NumericT * out,
+               vcl_size_t batch_num, vcl_size_t element_stride, vcl_size_t batch_stride) const
+  {
+    if (size_ == 0 || batch_num == 0)
+      return;
+
+    vcl_size_t work_size = 2 * size_ + scratch_size();
+
+    vcl_size_t max_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    if (size_ * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      max_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+    if (batch_num >= max_threads || size_ <= VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+    {
+      // one thread per sequence:
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel if (max_threads > 1)
+#endif
+      {
+        std::vector<NumericT> work(work_size);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long batch_id = 0; batch_id < long(batch_num); ++batch_id)
+        {
+          gather(in, &(work[0]), vcl_size_t(batch_id), element_stride, batch_stride, 0, size_);
+          transform(&(work[0]), &(work[size_]), &(work[2 * size_]));
+          scatter(&(work[0]), out, vcl_size_t(batch_id), element_stride, batch_stride, 0, size_);
+        }
+      }
+    }
+    else
+    {
+      // all threads share each sequence:
+      std::vector<NumericT> work(work_size);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel
+#endif
+      {
+        vcl_size_t thread_id = 0;
+        vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        thread_id   = static_cast<vcl_size_t>(omp_get_thread_num());
+        num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+        vcl_size_t begin, end;
+        detail::fft::fft_range(size_, thread_id, num_threads, begin, end);
+
+        for (vcl_size_t batch_id = 0; batch_id < batch_num; ++batch_id)
+        {
+          gather(in, &(work[0]), batch_id, element_stride, batch_stride, begin, end);
+          detail::fft::fft_barrier(num_threads);
+          transform(&(work[0]), &(work[size_]), &(work[2 * size_]), thread_id, num_threads);
+          scatter(&(work[0]), out, batch_id, element_stride, batch_stride, begin, end);
+          detail::fft::fft_barrier(num_threads);
+        }
+      }
+    }
+  }
+
+private:
+  void gather(NumericT const * in, NumericT * work, vcl_size_t batch_id,
+              vcl_size_t element_stride, vcl_size_t batch_stride, vcl_size_t begin, vcl_size_t end) const
+  {
+    NumericT const * src = in + 2 * batch_id * batch_stride;
+    for (vcl_size_t i = begin; i < end; ++i)
+    {
+      work[i]         = src[2 * i * element_stride];
+      work[size_ + i] = src[2 * i * element_stride + 1];
+    }
+  }
+
+  void scatter(NumericT const * work, NumericT * out, vcl_size_t batch_id,
+               vcl_size_t element_stride, vcl_size_t batch_stride, vcl_size_t begin, vcl_size_t end) const
+  {
+    NumericT * dst = out + 2 * batch_id * batch_stride;
+    for (vcl_size_t i = begin; i < end; ++i)
+    {
+      dst[2 * i * element_stride]     = work[i];
+      dst[2 * i * element_stride + 1] = work[size_ + i];
+    }
+  }
+
+  /** @brief Computes exp(sign * 2 pi i * k / n) in double precision. */
+  static void root_of_unity(vcl_size_t k, vcl_size_t n, NumericT sign, NumericT & re, NumericT & im)
+  {
+    double const NUM_PI = 3.14159265358979323846;
+    double angle = double(sign) * 2.0 * NUM_PI * double(k % n) / double(n);
+    re = static_cast<NumericT>(std::cos(angle));
+    im = static_cast<NumericT>(std::sin(angle));
+  }
+
+  void init_stages(std::vector<vcl_size_t> const & radices)
+  {
+    vcl_size_t n = size_;
+    vcl_size_t s = 1;
+    for (vcl_size_t i = 0; i < radices.size(); ++i)
+    {
+      detail::fft::fft_stage stage;
+      stage.radix          = radices[i];
+      stage.m              = n / stage.radix;
+      stage.s              = s;
+      stage.twiddle_offset = twiddle_re_.size();
+      stage.root_offset    = roots_re_.size();
+
+      for (vcl_size_t p = 0; p < stage.m; ++p)
+        for (vcl_size_t u = 1; u < stage.radix; ++u)
+        {
+          NumericT wr, wi;
+          root_of_unity(p * u, n, sign_, wr, wi);
+          twiddle_re_.push_back(wr);
+          twiddle_im_.push_back(wi);
+        }
+
+      if (stage.radix != 2 && stage.radix != 3 && stage.radix != 4 && stage.radix != 5 && stage.radix != 8)
+        for (vcl_size_t k = 0; k < stage.radix; ++k)
+        {
+          NumericT wr, wi;
+          root_of_unity(k, stage.radix, sign_, wr, wi);
+          roots_re_.push_back(wr);
+          roots_im_.push_back(wi);
+        }
+
+      stages_.push_back(stage);
+      n = stage.m;
+      s *= stage.radix;
+    }
+  }
+
+  /** @brief Sets up Bluestein's algorithm: X_k = w_k * sum_j (x_j w_j) conj(w_{k-j}) with the chirp w_k = exp(sign * pi i k^2 / n), where the convolution is carried out by a power-of-two plan. */
+  void init_bluestein()
+  {
+    bluestein_size_ = detail::fft::fft_next_power_2(2 * size_ - 1);
+    bluestein_plan_ = tools::shared_ptr<fft_plan<NumericT> >(new fft_plan<NumericT>(bluestein_size_, NumericT(-1)));
+
+    chirp_re_.resize(size_);
+    chirp_im_.resize(size_);
+    for (vcl_size_t k = 0; k < size_; ++k)
+      root_of_unity((k * k) % (2 * size_), 2 * size_, sign_, chirp_re_[k], chirp_im_[k]);
+
+    // Fourier transform of the convolution kernel conj(w_k), k = -(n-1), ..., n-1:
+    filter_re_.assign(bluestein_size_, NumericT(0));
+    filter_im_.assign(bluestein_size_, NumericT(0));
+    for (vcl_size_t k = 0; k < size_; ++k)
+    {
+      filter_re_[k] =  chirp_re_[k];
+      filter_im_[k] = -chirp_im_[k];
+      if (k > 0)
+      {
+        filter_re_[bluestein_size_ - k] =  chirp_re_[k];
+        filter_im_[bluestein_size_ - k] = -chirp_im_[k];
+      }
+    }
+    std::vector<NumericT> scratch(bluestein_plan_->scratch_size());
+    bluestein_plan_->transform(&(filter_re_[0]), &(filter_im_[0]), &(scratch[0]));
+  }
+
+  void transform_stockham(NumericT * re, NumericT * im, NumericT * scratch,
+                          vcl_size_t thread_id, vcl_size_t num_threads) const
+  {
+    NumericT * xr = re;
+    NumericT * xi = im;
+    NumericT * yr = scratch;
+    NumericT * yi = scratch + size_;
+
+    for (vcl_size_t i = 0; i < stages_.size(); ++i)
+    {
+      detail::fft::fft_stage const & stage = stages_[i];
+      vcl_size_t begin, end;
+      detail::fft::fft_range(stage.m * stage.s, thread_id, num_threads, begin, end);
+
+      NumericT const * twr = twiddle_re_.size() ? &(twiddle_re_[0]) : NULL;
+      NumericT const * twi = twiddle_im_.size() ? &(twiddle_im_[0]) : NULL;
+      switch (stage.radix)
+      {
+      case 2:  detail::fft::fft_stage_loop(detail::fft::fft_butterfly_2<NumericT>(sign_), stage, xr, xi, yr, yi, twr, twi, begin, end); break;
+      case 3:  detail::fft::fft_stage_loop(detail::fft::fft_butterfly_3<NumericT>(sign_), stage, xr, xi, yr, yi, twr, twi, begin, end); break;
+      case 4:  detail::fft::fft_stage_loop(detail::fft::fft_butterfly_4<NumericT>(sign_), stage, xr, xi, yr, yi, twr, twi, begin, end); break;
+      case 5:  detail::fft::fft_stage_loop(detail::fft::fft_butterfly_5<NumericT>(sign_), stage, xr, xi, yr, yi, twr, twi, begin, end); break;
+      case 8:  detail::fft::fft_stage_loop(detail::fft::fft_butterfly_8<NumericT>(sign_), stage, xr, xi, yr, yi, twr, twi, begin, end); break;
+      default:
+        detail::fft::fft_stage_loop(detail::fft::fft_butterfly_generic<NumericT>(stage.radix, &(roots_re_[stage.root_offset]), &(roots_im_[stage.root_offset])),
+                                    stage, xr, xi, yr, yi, twr, twi, begin, end);
+      }
+      detail::fft::fft_barrier(num_threads);
+
+      std::swap(xr, yr);
+      std::swap(xi, yi);
+    }
+
+    if (xr != re) // result is in the scratch buffer
+    {
+      vcl_size_t begin, end;
+      detail::fft::fft_range(size_, thread_id, num_threads, begin, end);
+      for (vcl_size_t i = begin; i < end; ++i)
+      {
+        re[i] = xr[i];
+        im[i] = xi[i];
+      }
+      detail::fft::fft_barrier(num_threads);
+    }
+  }
+
+  void transform_bluestein(NumericT * re, NumericT * im, NumericT * scratch,
+                           vcl_size_t thread_id, vcl_size_t num_threads) const
+  {
+    vcl_size_t const M = bluestein_size_;
+    NumericT * ar = scratch;
+    NumericT * ai = scratch + M;
+    NumericT * sub_scratch = scratch + 2 * M;
+
+    vcl_size_t begin, end;
+    detail::fft::fft_range(M, thread_id, num_threads, begin, end);
+
+    // a = x .* w, zero-padded:
+    for (vcl_size_t i = begin; i < end; ++i)
+    {
+      if (i < size_)
+        detail::fft::fft_twiddle(re[i], im[i], chirp_re_[i], chirp_im_[i], ar[i], ai[i]);
+      else
+        ar[i] = ai[i] = NumericT(0);
+    }
+    detail::fft::fft_barrier(num_threads);
+
+    bluestein_plan_->transform(ar, ai, sub_scratch, thread_id, num_threads);
+
+    // inverse transform of A .* filter via conj(FFT(conj(.))):
+    for (vcl_size_t i = begin; i < end; ++i)
+    {
+      NumericT tr, ti;
+      detail::fft::fft_twiddle(ar[i], ai[i], filter_re_[i], filter_im_[i], tr, ti);
+      ar[i] = tr;
+      ai[i] = -ti;
+    }
+    detail::fft::fft_barrier(num_threads);
+
+    bluestein_plan_->transform(ar, ai, sub_scratch, thread_id, num_threads);
+
+    detail::fft::fft_range(size_, thread_id, num_threads, begin, end);
+    NumericT scale = NumericT(1) / NumericT(M);
+    for (vcl_size_t i = begin; i < end; ++i)
+      detail::fft::fft_twiddle(ar[i] * scale, -ai[i] * scale, chirp_re_[i], chirp_im_[i], re[i], im[i]);
+    detail::fft::fft_barrier(num_threads);
+  }
+
+  vcl_size_t size_;
+  NumericT   sign_;
+
+  // Stockham stages:
+  std::vector<detail::fft::fft_stage> stages_;
+  std::vector<NumericT> twiddle_re_;
+  std::vector<NumericT> twiddle_im_;
+  std::vector<NumericT> roots_re_;
+  std::vector<NumericT> roots_im_;
+
+  // Bluestein's algorithm (bluestein_size_ > 0):
+  vcl_size_t bluestein_size_;
+  tools::shared_ptr<fft_plan<NumericT> > bluestein_plan_;
+  std::vector<NumericT> chirp_re_;
+  std::vector<NumericT> chirp_im_;
+  std::vector<NumericT> filter_re_;
+  std::vector<NumericT> filter_im_;
+};
+
+
+/** @brief A precomputed plan for real-to-complex (R2C) and complex-to-real (C2R) Fourier transformations of a fixed size on the host.
+  *
+  * The R2C transformation of n real values returns the n/2+1 non-redundant entries of the Hermitian spectrum (interleaved), the C2R transformation is its unnormalized inverse.
+  * For even n, the real sequence is packed into a complex sequence of length n/2 whose transform is then split into the even and odd parts, which halves the work and the memory traffic of a complex transformation.
+  */
+template<typename NumericT>
+class fft_real_plan
+{
+public:
+  explicit fft_real_plan(vcl_size_t size) : size_(size), half_(size / 2)
+  {
+    vcl_size_t complex_size = (size_ % 2 == 0) ? half_ : size_;
+    forward_plan_  = tools::shared_ptr<fft_plan<NumericT> >(new fft_plan<NumericT>(complex_size, NumericT(-1)));
+    backward_plan_ = tools::shared_ptr<fft_plan<NumericT> >(new fft_plan<NumericT>(complex_size, NumericT( 1)));
+
+    if (size_ % 2 == 0)
+    {
+      // W^k = exp(-2 pi i k / n), k = 0, ..., n/2:
+      double const NUM_PI = 3.14159265358979323846;
+      w_re_.resize(half_ + 1);
+      w_im_.resize(half_ + 1);
+      for (vcl_size_t k = 0; k <= half_; ++k)
+      {
+        w_re_[k] = static_cast<NumericT>( std::cos(2.0 * NUM_PI * double(k) / double(size_)));
+        w_im_[k] = static_cast<NumericT>(-std::sin(2.0 * NUM_PI * double(k) / double(size_)));
+      }
+    }
+  }
+
+  /** @brief Returns the number of real values transformed. */
+  vcl_size_t size() const { return size_; }
+
+  /** @brief Returns the number of complex values of the half-spectrum, i.e. size()/2 + 1. */
+  vcl_size_t spectrum_size() const { return half_ + 1; }
+
+  /** @brief Transforms batch_num real sequences. Entry j of sequence b is in[b * in_dist + j * in_inc], real and imaginary part of the spectral entry k are out[b * out_dist + 2 * k * out_inc] and out[b * out_dist + (2 * k + 1) * out_inc]. */
+  void execute_forward(NumericT const * in, vcl_size_t in_inc, vcl_size_t in_dist,
+                       NumericT       * out, vcl_size_t out_inc, vcl_size_t out_dist, vcl_size_t batch_num) const
+  {
+    execute(true, in, in_inc, in_dist, out, out_inc, out_dist, batch_num);
+  }
+
+  /** @brief Unnormalized inverse of execute_forward(): maps batch_num half-spectra (layout as the output of execute_forward()) to real sequences. The imaginary parts of the entries 0 and n/2 (n even) are ignored. */
+  void execute_backward(NumericT const * in, vcl_size_t in_inc, vcl_size_t in_dist,
+                        NumericT       * out, vcl_size_t out_inc, vcl_size_t out_dist, vcl_size_t batch_num) const
+  {
+    execute(false, in, in_inc, in_dist, out, out_inc, out_dist, batch_num);
+  }
+
+private:
+  vcl_size_t complex_size() const { return forward_plan_->size(); }
+
+  vcl_size_t work_size() const { return 2 * complex_size() + forward_plan_->scratch_size(); }
+
+  void execute(bool forward,
+               NumericT const * in, vcl_size_t in_inc, vcl_size_t in_dist,
+               NumericT       * out, vcl_size_t out_inc, vcl_size_t out_dist, vcl_size_t batch_num) const
+  {
+    if (size_ == 0 || batch_num == 0)
+      return;
+
+    vcl_size_t max_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    if (size_ * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      max_threads = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+
+    if (batch_num >= max_threads || size_ <= VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+    {
+      // one thread per sequence:
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel if (max_threads > 1)
+#endif
+      {
+        std::vector<NumericT> work(work_size());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long batch_id = 0; batch_id < long(batch_num); ++batch_id)
+        {
+          vcl_size_t b = vcl_size_t(batch_id);
+          if (forward)
+            forward_one(in + b * in_dist, in_inc, out + b * out_dist, out_inc, &(work[0]), 0, 1);
+          else
+            backward_one(in + b * in_dist, in_inc, out + b * out_dist, out_inc, &(work[0]), 0, 1);
+        }
+      }
+    }
+    else
+    {
+      // all threads share each sequence:
+      std::vector<NumericT> work(work_size());
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel
+#endif
+      {
+        vcl_size_t thread_id = 0;
+        vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        thread_id   = static_cast<vcl_size_t>(omp_get_thread_num());
+        num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+        for (vcl_size_t b = 0; b < batch_num; ++b)
+        {
+          if (forward)
+            forward_one(in + b * in_dist, in_inc, out + b * out_dist, out_inc, &(work[0]), thread_id, num_threads);
+          else
+            backward_one(in + b * in_dist, in_inc, out + b * out_dist, out_inc, &(work[0]), thread_id, num_threads);
+        }
+      }
+    }
+  }
+
+  void forward_one(NumericT const * in, vcl_size_t in_inc, NumericT * out, vcl_size_t out_inc,
+                   NumericT * work, vcl_size_t thread_id, vcl_size_t num_threads) const
+  {
+    vcl_size_t const m = complex_size();
+    NumericT * zr = work;
+    NumericT * zi = work + m;
+    vcl_size_t begin, end;
+
+    // pack:
+    detail::fft::fft_range(m, thread_id, num_threads, begin, end);
+    if (size_ % 2 == 0)
+      for (vcl_size_t j = begin; j < end; ++j)
+      {
+        zr[j] = in[(2 * j)     * in_inc];
+        zi[j] = in[(2 * j + 1) * in_inc];
+      }
+    else
+      for (vcl_size_t j = begin; j < end; ++j)
+      {
+        zr[j] = in[j * in_inc];
+        zi[j] = NumericT(0);
+      }
+    detail::fft::fft_barrier(num_threads);
+
+    forward_plan_->transform(zr, zi, work + 2 * m, thread_id, num_threads);
+
+    // unpack X_k = E_k + W^k O_k with E_k = (Z_k + conj(Z_{m-k}))/2, O_k = -i (Z_k - conj(Z_{m-k}))/2:
+    detail::fft::fft_range(half_ + 1, thread_id, num_threads, begin, end);
+    if (size_ % 2 == 0)
+      for (vcl_size_t k = begin; k < end; ++k)
+      {
+        vcl_size_t k1 = (k == m) ? 0 : k;
+        vcl_size_t k2 = (k == 0) ? 0 : m - k;
+        NumericT er = NumericT(0.5) * (zr[k1] + zr[k2]);
+        NumericT ei = NumericT(0.5) * (zi[k1] - zi[k2]);
+        NumericT orr = NumericT(0.5) * (zi[k1] + zi[k2]);
+        NumericT oi  = NumericT(0.5) * (zr[k2] - zr[k1]);
+        NumericT tr, ti;
+        detail::fft::fft_twiddle(orr, oi, w_re_[k], w_im_[k], tr, ti);
+        out[(2 * k)     * out_inc] = er + tr;
+        out[(2 * k + 1) * out_inc] = ei + ti;
+      }
+    else
+      for (vcl_size_t k = begin; k < end; ++k)
+      {
+        out[(2 * k)     * out_inc] = zr[k];
+        out[(2 * k + 1) * out_inc] = zi[k];
+      }
+    detail::fft::fft_barrier(num_threads);
+  }
+
+  void backward_one(NumericT const * in, vcl_size_t in_inc, NumericT * out, vcl_size_t out_inc,
+                    NumericT * work, vcl_size_t thread_id, vcl_size_t num_threads) const
+  {
+    vcl_size_t const m = complex_size();
+    NumericT * zr = work;
+    NumericT * zi = work + m;
+    vcl_size_t begin, end;
+
+    detail::fft::fft_range(m, thread_id, num_threads, begin, end);
+    if (size_ % 2 == 0)
+    {
+      // Z_k = A_k + i B_k with A_k = X_k + conj(X_{m-k}) and B_k = (X_k - conj(X_{m-k})) conj(W^k):
+      for (vcl_size_t k = begin; k < end; ++k)
+      {
+        NumericT xr = in[(2 * k)     * in_inc], xi = in[(2 * k + 1) * in_inc];
+        NumericT cr = in[(2 * (m - k)) * in_inc], ci = -in[(2 * (m - k) + 1) * in_inc];
+        NumericT ar = xr + cr, ai = xi + ci;
+        NumericT br, bi;
+        detail::fft::fft_twiddle(xr - cr, xi - ci, w_re_[k], -w_im_[k], br, bi);
+        zr[k] = ar - bi;
+        zi[k] = ai + br;
+      }
+    }
+    else
+    {
+      // rebuild the full Hermitian spectrum:
+      for (vcl_size_t k = begin; k < end; ++k)
+      {
+        if (k <= half_)
+        {
+          zr[k] = in[(2 * k)     * in_inc];
+          zi[k] = in[(2 * k + 1) * in_inc];
+        }
+        else
+        {
+          zr[k] =  in[(2 * (m - k))     * in_inc];
+          zi[k] = -in[(2 * (m - k) + 1) * in_inc];
+        }
+      }
+    }
+    detail::fft::fft_barrier(num_threads);
+
+    backward_plan_->transform(zr, zi, work + 2 * m, thread_id, num_threads);
+
+    if (size_ % 2 == 0)
+      for (vcl_size_t j = begin; j < end; ++j)
+      {
+        out[(2 * j)     * out_inc] = zr[j];
+        out[(2 * j + 1) * out_inc] = zi[j];
+      }
+    else
+      for (vcl_size_t j = begin; j < end; ++j)
+        out[j * out_inc] = zr[j];
+    detail::fft::fft_barrier(num_threads);
+  }
+
+  vcl_size_t size_;
+  vcl_size_t half_;
+  tools::shared_ptr<fft_plan<NumericT> > forward_plan_;
+  tools::shared_ptr<fft_plan<NumericT> > backward_plan_;
+  std::vector<NumericT> w_re_;
+  std::vector<NumericT> w_im_;
+};
+
+
+/** @brief Maximum number of plans kept per floating point type in each of the complex and the real-to-complex plan caches. The least recently used plan is released first. */
+#ifndef VIENNACL_FFT_PLAN_CACHE_SIZE
+  #define VIENNACL_FFT_PLAN_CACHE_SIZE  64
+#endif
+
+namespace detail
+{
+  namespace fft
+  {
+    /** @brief Mutex protecting the plan caches and the reference counts of cached plans. Transformations may be started from several threads, with or without OpenMP. */
+    inline viennacl::backend::cpu_ram::detail::pool_mutex & fft_plan_cache_mutex()
+    {
+      static viennacl::backend::cpu_ram::detail::pool_mutex m;
+      return m;
+    }
+
+    /** @brief Least recently used cache of at most VIENNACL_FFT_PLAN_CACHE_SIZE plans. All members must be called with fft_plan_cache_mutex() locked. */
+    template<typename KeyT, typename PlanT>
+    class fft_plan_cache
+    {
+      struct entry
+      {
+        tools::shared_ptr<PlanT> plan;
+        vcl_size_t               last_use;
+      };
+
+      typedef std::map<KeyT, entry>  map_type;
+
+    public:
+      static fft_plan_cache & instance()
+      {
+        static fft_plan_cache cache;
+        return cache;
+      }
+
+      /** @brief Returns the cached plan for 'key', or NULL if there is none. */
+      tools::shared_ptr<PlanT> const * find(KeyT const & key)
+      {
+        typename map_type::iterator it = plans_.find(key);
+        if (it == plans_.end())
+          return NULL;
+        it->second.last_use = ++use_counter_;
+        return &(it->second.plan);
+      }
+
+      /** @brief Takes ownership of 'plan' and stores it for 'key'. Evicts the least recently used plan if the cache is full. */
+      tools::shared_ptr<PlanT> const & insert(KeyT const & key, PlanT * plan)
+      {
+        if (plans_.size() >= VIENNACL_FFT_PLAN_CACHE_SIZE && !plans_.empty())
+        {
+          typename map_type::iterator oldest = plans_.begin();
+          for (typename map_type::iterator it = plans_.begin(); it != plans_.end(); ++it)
+            if (it->second.last_use < oldest->second.last_use)
+              oldest = it;
+          plans_.erase(oldest); // plans still in use are kept alive by their handles
+        }
+
+        entry & e = plans_[key];
+        e.plan = tools::shared_ptr<PlanT>(plan);
+        e.last_use = ++use_counter_;
+        return e.plan;
+      }
+
+      void clear() { plans_.clear(); }
+
+      vcl_size_t size() const { return plans_.size(); }
+
+    private:
+      fft_plan_cache() : use_counter_(0) {}
+
+      map_type   plans_;
+      vcl_size_t use_counter_;
+    };
+  }
+}
+
+/** @brief Shared handle to a cached plan. The plan stays alive as long as a handle refers to it, even if it is evicted from the cache or fft_plan_cache_clear() is called meanwhile.
+  *
+  * The reference count of tools::shared_ptr is not atomic, hence handles copy and release their plan with the cache mutex locked.
+  */
+template<typename PlanT>
+class fft_plan_handle
+{
+public:
+  /** @brief Takes over the reference held by 'plan', which is left empty. Does not touch the reference count, hence needs no lock. */
+  explicit fft_plan_handle(tools::shared_ptr<PlanT> & plan) { plan_.swap(plan); }
+
+  fft_plan_handle(fft_plan_handle const & other)
+  {
+    viennacl::backend::cpu_ram::detail::pool_lock guard(detail::fft::fft_plan_cache_mutex());
+    plan_ = other.plan_;
+  }
+
+  ~fft_plan_handle()
+  {
+    viennacl::backend::cpu_ram::detail::pool_lock guard(detail::fft::fft_plan_cache_mutex());
+    plan_.reset();
+  }
+
+  PlanT const & operator*()  const { return *plan_; }
+  PlanT const * operator->() const { return plan_.get(); }
+
+private:
+  fft_plan_handle & operator=(fft_plan_handle const &);
+
+  tools::shared_ptr<PlanT> plan_;
+};
+
+/** @brief Returns the cached plan for transformations of length 'size' and exponent sign 'sign'. The plan is built on first use. Thread-safe. */
+template<typename NumericT>
+fft_plan_handle<fft_plan<NumericT> > get_fft_plan(vcl_size_t size, NumericT sign)
+{
+  typedef detail::fft::fft_plan_cache<std::pair<vcl_size_t, int>, fft_plan<NumericT> >  CacheType;
+
+  // take the reference under the lock, but build the handle only after releasing it: copying or destroying a handle locks the same mutex
+  tools::shared_ptr<fft_plan<NumericT> > plan;
+  {
+    viennacl::backend::cpu_ram::detail::pool_lock guard(detail::fft::fft_plan_cache_mutex());
+
+    CacheType & cache = CacheType::instance();
+    std::pair<vcl_size_t, int> key(size, sign < 0 ? -1 : 1);
+    tools::shared_ptr<fft_plan<NumericT> > const * cached = cache.find(key);
+    if (!cached)
+      cached = &cache.insert(key, new fft_plan<NumericT>(size, sign));
+    plan = *cached;
+  }
+  return fft_plan_handle<fft_plan<NumericT> >(plan);
+}
+
+/** @brief Returns the cached real-to-complex plan for transformations of length 'size'. The plan is built on first use. Thread-safe. */
+template<typename NumericT>
+fft_plan_handle<fft_real_plan<NumericT> > get_fft_real_plan(vcl_size_t size)
+{
+  typedef detail::fft::fft_plan_cache<vcl_size_t, fft_real_plan<NumericT> >  CacheType;
+
+  tools::shared_ptr<fft_real_plan<NumericT> > plan;
+  {
+    viennacl::backend::cpu_ram::detail::pool_lock guard(detail::fft::fft_plan_cache_mutex());
+
+    CacheType & cache = CacheType::instance();
+    tools::shared_ptr<fft_real_plan<NumericT> > const * cached = cache.find(size);
+    if (!cached)
+      cached = &cache.insert(size, new fft_real_plan<NumericT>(size));
+    plan = *cached;
+  }
+  return fft_plan_handle<fft_real_plan<NumericT> >(plan);
+}
+
+/** @brief Releases all cached FFT plans of the given floating point type. Plans still referenced by a handle are destroyed when their last handle goes away. Thread-safe. */
+template<typename NumericT>
+void fft_plan_cache_clear()
+{
+  viennacl::backend::cpu_ram::detail::pool_lock guard(detail::fft::fft_plan_cache_mutex());
+
+  detail::fft::fft_plan_cache<std::pair<vcl_size_t, int>, fft_plan<NumericT> >::instance().clear();
+  detail::fft::fft_plan_cache<vcl_size_t, fft_real_plan<NumericT> >::instance().clear();
+}
+
+/** @brief Returns the number of plans of the given floating point type held by the complex and the real-to-complex plan caches. */
+template<typename NumericT>
+vcl_size_t fft_plan_cache_size()
+{
+  viennacl::backend::cpu_ram::detail::pool_lock guard(detail::fft::fft_plan_cache_mutex());
+
+  return detail::fft::fft_plan_cache<std::pair<vcl_size_t, int>, fft_plan<NumericT> >::instance().size()
+       + detail::fft::fft_plan_cache<vcl_size_t, fft_real_plan<NumericT> >::instance().size();
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
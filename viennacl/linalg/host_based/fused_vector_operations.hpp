@@ -0,0 +1,469 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_FUSED_VECTOR_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_FUSED_VECTOR_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/fused_vector_operations.hpp
+    @brief Single-pass evaluation of element-wise vector expressions such as x = a*y + b*z - c*w + v in host memory.
+
+    The expression template tree is flattened into one loop over the entries of the result, so no temporaries are created and every operand is read only once.
+    Optionally, the norm or an inner product of the result is accumulated in the same pass.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/scalar.hpp"
+#include "viennacl/meta/predicate.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/detail/op_applier.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum vector size for using OpenMP on vector operations:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Location of the entries of the result vector, used for detecting operands which overlap with the result. */
+template<typename NumericT>
+struct fused_result_range
+{
+  fused_result_range(vector_base<NumericT> const & x)
+    : first(extract_raw_pointer<NumericT>(x) + viennacl::traits::start(x)),
+      stride(viennacl::traits::stride(x)),
+      size(viennacl::traits::size(x)) {}
+
+  NumericT const * first;
+  vcl_size_t stride;
+  vcl_size_t size;
+};
+
+/** @brief Only floating point results are evaluated by the fused kernels. Integer vectors keep the semantics of the individual kernels. */
+template<typename NumericT> struct fused_numeric_type         { enum { value = false }; };
+template<>                  struct fused_numeric_type<float>  { enum { value = true }; };
+template<>                  struct fused_numeric_type<double> { enum { value = true }; };
+
+template<typename T> struct fused_remove_const            { typedef T type; };
+template<typename T> struct fused_remove_const<const T>   { typedef T type; };
+
+/** @brief Element-wise evaluation of an expression operand. The primary template is used for all operands which cannot be fused (e.g. matrix-vector products or scalar expressions).
+*
+* Fusable operands provide:
+*  - is_fusable:  true if the operand can be evaluated entry by entry
+*  - num_vectors: the number of vector operands (leaves) in the subtree
+*  - needs_temp:  true if the evaluation through the individual kernels creates a temporary or requires several passes
+*  - is_leaf:     true for vectors and scalars
+*  - in_host_memory(e), overlaps(e, range), unit_stride(e): checks carried out before the evaluator is set up
+*  - get<UnitStrideV>(i): the value of the i-th entry
+*/
+template<typename NumericT, typename E, bool IsScalarV = viennacl::is_cpu_scalar<E>::value>
+struct fused_evaluator
+{
+  enum { is_fusable = false, num_vectors = 0, needs_temp = false, is_leaf = false };
+};
+
+/** @brief Vector operand */
+template<typename NumericT>
+struct fused_evaluator<NumericT, vector_base<NumericT>, false>
+{
+  enum { is_fusable = true, num_vectors = 1, needs_temp = false, is_leaf = true };
+
+  fused_evaluator(vector_base<NumericT> const & v)
+    : data_(extract_raw_pointer<NumericT>(v) + viennacl::traits::start(v)), inc_(viennacl::traits::stride(v)) {}
+
+  static bool in_host_memory(vector_base<NumericT> const & v) { return viennacl::traits::handle(v).get_active_handle_id() == viennacl::MAIN_MEMORY; }
+
+  /** @brief An operand may only share entries with the result if each entry is read at the same index as it is written */
+  static bool overlaps(vector_base<NumericT> const & v, fused_result_range<NumericT> const & range)
+  {
+    NumericT const * first = extract_raw_pointer<NumericT>(v) + viennacl::traits::start(v);
+    vcl_size_t stride = viennacl::traits::stride(v);
+    if (first == range.first && stride == range.stride)
+      return false;
+
+    NumericT const * last       = first + (viennacl::traits::size(v) - 1) * stride;
+    NumericT const * range_last = range.first + (range.size - 1) * range.stride;
+    return !(last < range.first || range_last < first);
+  }
+
+  static bool unit_stride(vector_base<NumericT> const & v) { return viennacl::traits::stride(v) == 1; }
+
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t i) const { return UnitStrideV ? data_[i] : data_[i * inc_]; }
+
+private:
+  NumericT const * data_;
+  vcl_size_t inc_;
+};
+
+/** @brief Scalar operand on the host */
+template<typename NumericT, typename ScalarT>
+struct fused_evaluator<NumericT, ScalarT, true>
+{
+  enum { is_fusable = true, num_vectors = 0, needs_temp = false, is_leaf = true };
+
+  fused_evaluator(ScalarT const & s) : value_(static_cast<NumericT>(s)) {}
+
+  static bool in_host_memory(ScalarT const &) { return true; }
+  static bool overlaps(ScalarT const &, fused_result_range<NumericT> const &) { return false; }
+  static bool unit_stride(ScalarT const &) { return true; }
+
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t) const { return value_; }
+
+private:
+  NumericT value_;
+};
+
+/** @brief Scalar operand of type viennacl::scalar<>. Its value is read once before the loop starts. */
+template<typename NumericT>
+struct fused_evaluator<NumericT, viennacl::scalar<NumericT>, false>
+{
+  enum { is_fusable = true, num_vectors = 0, needs_temp = false, is_leaf = true };
+
+  fused_evaluator(viennacl::scalar<NumericT> const & s) : value_(*extract_raw_pointer<NumericT>(s)) {}
+
+  static bool in_host_memory(viennacl::scalar<NumericT> const & s) { return viennacl::traits::handle(s).get_active_handle_id() == viennacl::MAIN_MEMORY; }
+  static bool overlaps(viennacl::scalar<NumericT> const &, fused_result_range<NumericT> const &) { return false; }
+  static bool unit_stride(viennacl::scalar<NumericT> const &) { return true; }
+
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t) const { return value_; }
+
+private:
+  NumericT value_;
+};
+
+
+/** @brief Applies the binary operation of an expression node to the values of its operands. Unsupported operations are not fusable. */
+template<typename OpT>
+struct fused_binary_op { enum { is_fusable = false, is_elementwise = false }; };
+
+template<> struct fused_binary_op<op_add>
+{
+  enum { is_fusable = true, is_elementwise = false };
+  template<typename T> static T apply(T x, T y) { return x + y; }
+};
+
+template<> struct fused_binary_op<op_sub>
+{
+  enum { is_fusable = true, is_elementwise = false };
+  template<typename T> static T apply(T x, T y) { return x - y; }
+};
+
+template<> struct fused_binary_op<op_mult>
+{
+  enum { is_fusable = true, is_elementwise = true };
+  template<typename T> static T apply(T x, T y) { return x * y; }
+};
+
+template<> struct fused_binary_op<op_div>
+{
+  enum { is_fusable = true, is_elementwise = true };
+  template<typename T> static T apply(T x, T y) { return x / y; }
+};
+
+template<typename OpT> struct fused_binary_op<op_element_binary<OpT> >
+{
+  enum { is_fusable = true, is_elementwise = true };
+  template<typename T> static T apply(T x, T y) { T result; viennacl::linalg::detail::op_applier<op_element_binary<OpT> >::apply(result, x, y); return result; }
+};
+
+/** @brief Inner node of the expression tree: binary operation */
+template<typename NumericT, typename LHS, typename RHS, typename OP>
+struct fused_evaluator<NumericT, vector_expression<LHS, RHS, OP>, false>
+{
+  typedef vector_expression<LHS, RHS, OP>                                              expression_type;
+  typedef fused_evaluator<NumericT, typename fused_remove_const<LHS>::type>            lhs_evaluator;
+  typedef fused_evaluator<NumericT, typename fused_remove_const<RHS>::type>            rhs_evaluator;
+
+  enum { is_fusable  = fused_binary_op<OP>::is_fusable && lhs_evaluator::is_fusable && rhs_evaluator::is_fusable,
+         num_vectors = lhs_evaluator::num_vectors + rhs_evaluator::num_vectors,
+         needs_temp  = lhs_evaluator::needs_temp || rhs_evaluator::needs_temp
+                       || (fused_binary_op<OP>::is_elementwise && !(lhs_evaluator::is_leaf && rhs_evaluator::is_leaf)),
+         is_leaf     = false };
+
+  fused_evaluator(expression_type const & e) : lhs_(e.lhs()), rhs_(e.rhs()) {}
+
+  static bool in_host_memory(expression_type const & e) { return lhs_evaluator::in_host_memory(e.lhs()) && rhs_evaluator::in_host_memory(e.rhs()); }
+  static bool overlaps(expression_type const & e, fused_result_range<NumericT> const & range) { return lhs_evaluator::overlaps(e.lhs(), range) || rhs_evaluator::overlaps(e.rhs(), range); }
+  static bool unit_stride(expression_type const & e) { return lhs_evaluator::unit_stride(e.lhs()) && rhs_evaluator::unit_stride(e.rhs()); }
+
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t i) const { return fused_binary_op<OP>::apply(lhs_.template get<UnitStrideV>(i), rhs_.template get<UnitStrideV>(i)); }
+
+private:
+  lhs_evaluator lhs_;
+  rhs_evaluator rhs_;
+};
+
+/** @brief Inner node of the expression tree: element-wise unary function. Both operands of the expression refer to the argument. */
+template<typename NumericT, typename LHS, typename RHS, typename OpT>
+struct fused_evaluator<NumericT, vector_expression<LHS, RHS, op_element_unary<OpT> >, false>
+{
+  typedef vector_expression<LHS, RHS, op_element_unary<OpT> >                          expression_type;
+  typedef fused_evaluator<NumericT, typename fused_remove_const<LHS>::type>            lhs_evaluator;
+
+  enum { is_fusable  = lhs_evaluator::is_fusable,
+         num_vectors = lhs_evaluator::num_vectors,
+         needs_temp  = lhs_evaluator::needs_temp || !lhs_evaluator::is_leaf,
+         is_leaf     = false };
+
+  fused_evaluator(expression_type const & e) : lhs_(e.lhs()) {}
+
+  static bool in_host_memory(expression_type const & e) { return lhs_evaluator::in_host_memory(e.lhs()); }
+  static bool overlaps(expression_type const & e, fused_result_range<NumericT> const & range) { return lhs_evaluator::overlaps(e.lhs(), range); }
+  static bool unit_stride(expression_type const & e) { return lhs_evaluator::unit_stride(e.lhs()); }
+
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t i) const
+  {
+    NumericT result;
+    viennacl::linalg::detail::op_applier<op_element_unary<OpT> >::apply(result, lhs_.template get<UnitStrideV>(i));
+    return result;
+  }
+
+private:
+  lhs_evaluator lhs_;
+};
+
+
+/** @brief Combines the value of the expression with the current entry of the result */
+template<typename OpT> struct fused_assigner {};
+
+template<> struct fused_assigner<op_assign>
+{
+  template<typename T> static void apply(T & x, T value) { x = value; }
+};
+
+template<> struct fused_assigner<op_inplace_add>
+{
+  template<typename T> static void apply(T & x, T value) { x += value; }
+};
+
+template<> struct fused_assigner<op_inplace_sub>
+{
+  template<typename T> static void apply(T & x, T value) { x -= value; }
+};
+
+
+/** @brief Reductions over the entries of the result which are accumulated in the same pass. */
+template<typename NumericT>
+struct fused_norm_2_reduction
+{
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t, NumericT x_i) const { return x_i * x_i; }
+};
+
+template<typename NumericT>
+struct fused_inner_prod_reduction
+{
+  fused_inner_prod_reduction(vector_base<NumericT> const & y) : y_(y) {}
+
+  template<bool UnitStrideV>
+  NumericT get(vcl_size_t i, NumericT x_i) const { return x_i * y_.template get<UnitStrideV>(i); }
+
+private:
+  fused_evaluator<NumericT, vector_base<NumericT> > y_;
+};
+
+
+template<typename OpT, bool UnitStrideV, typename NumericT, typename EvaluatorT>
+void fused_assign_loop(NumericT * x, vcl_size_t inc, vcl_size_t size, EvaluatorT const & e)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < static_cast<long>(size); ++i)
+  {
+    vcl_size_t row = static_cast<vcl_size_t>(i);
+    fused_assigner<OpT>::apply(x[UnitStrideV ? row : row * inc], e.template get<UnitStrideV>(row));
+  }
+}
+
+template<typename OpT, bool UnitStrideV, typename NumericT, typename EvaluatorT, typename ReductionT>
+NumericT fused_assign_reduce_loop(NumericT * x, vcl_size_t inc, vcl_size_t size, EvaluatorT const & e, ReductionT const & reduction)
+{
+  NumericT sum = 0;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: sum) if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = 0; i < static_cast<long>(size); ++i)
+  {
+    vcl_size_t row = static_cast<vcl_size_t>(i);
+    NumericT & x_i = x[UnitStrideV ? row : row * inc];
+    fused_assigner<OpT>::apply(x_i, e.template get<UnitStrideV>(row));
+    sum += reduction.template get<UnitStrideV>(row, x_i);
+  }
+  return sum;
+}
+
+/** @brief Returns true if the expression can be evaluated for the result vector x in a single pass: all operands in host memory and no operand overlapping with x other than x itself. */
+template<typename NumericT, typename ExpressionT>
+bool fused_applicable(vector_base<NumericT> const & x, ExpressionT const & proxy)
+{
+  typedef fused_evaluator<NumericT, ExpressionT> evaluator_type;
+
+  if (viennacl::traits::size(x) == 0 || viennacl::traits::handle(x).get_active_handle_id() != viennacl::MAIN_MEMORY)
+    return false;
+  if (!evaluator_type::in_host_memory(proxy))
+    return false;
+  return !evaluator_type::overlaps(proxy, fused_result_range<NumericT>(x));
+}
+
+template<typename OpT, typename NumericT, typename ExpressionT>
+void fused_assign_impl(vector_base<NumericT> & x, ExpressionT const & proxy)
+{
+  typedef fused_evaluator<NumericT, ExpressionT> evaluator_type;
+
+  NumericT * data_x = extract_raw_pointer<NumericT>(x) + viennacl::traits::start(x);
+  vcl_size_t inc_x  = viennacl::traits::stride(x);
+  vcl_size_t size_x = viennacl::traits::size(x);
+  evaluator_type e(proxy);
+
+  if (inc_x == 1 && evaluator_type::unit_stride(proxy))
+    fused_assign_loop<OpT, true>(data_x, inc_x, size_x, e);
+  else
+    fused_assign_loop<OpT, false>(data_x, inc_x, size_x, e);
+}
+
+template<typename OpT, typename NumericT, typename ExpressionT, typename ReductionT>
+NumericT fused_assign_reduce_impl(vector_base<NumericT> & x, ExpressionT const & proxy, ReductionT const & reduction, bool unit_stride_reduction)
+{
+  typedef fused_evaluator<NumericT, ExpressionT> evaluator_type;
+
+  NumericT * data_x = extract_raw_pointer<NumericT>(x) + viennacl::traits::start(x);
+  vcl_size_t inc_x  = viennacl::traits::stride(x);
+  vcl_size_t size_x = viennacl::traits::size(x);
+  evaluator_type e(proxy);
+
+  if (inc_x == 1 && unit_stride_reduction && evaluator_type::unit_stride(proxy))
+    return fused_assign_reduce_loop<OpT, true>(data_x, inc_x, size_x, e, reduction);
+  return fused_assign_reduce_loop<OpT, false>(data_x, inc_x, size_x, e, reduction);
+}
+
+
+/** @brief Compile-time switch between expressions which are evaluated in a single pass and those left to the individual kernels. */
+template<bool FuseV>
+struct fused_dispatcher
+{
+  template<typename OpT, typename NumericT, typename ExpressionT>
+  static bool apply(vector_base<NumericT> &, ExpressionT const &) { return false; }
+
+  template<typename NumericT, typename ExpressionT>
+  static bool apply_norm_2(vector_base<NumericT> &, ExpressionT const &, NumericT &) { return false; }
+
+  template<typename NumericT, typename ExpressionT>
+  static bool apply_inner_prod(vector_base<NumericT> &, ExpressionT const &, vector_base<NumericT> const &, NumericT &) { return false; }
+};
+
+template<>
+struct fused_dispatcher<true>
+{
+  template<typename OpT, typename NumericT, typename ExpressionT>
+  static bool apply(vector_base<NumericT> & x, ExpressionT const & proxy)
+  {
+    if (!fused_applicable(x, proxy))
+      return false;
+    fused_assign_impl<OpT>(x, proxy);
+    return true;
+  }
+
+  template<typename NumericT, typename ExpressionT>
+  static bool apply_norm_2(vector_base<NumericT> & x, ExpressionT const & proxy, NumericT & squared_norm)
+  {
+    if (!fused_applicable(x, proxy))
+      return false;
+    squared_norm = fused_assign_reduce_impl<op_assign>(x, proxy, fused_norm_2_reduction<NumericT>(), true);
+    return true;
+  }
+
+  template<typename NumericT, typename ExpressionT>
+  static bool apply_inner_prod(vector_base<NumericT> & x, ExpressionT const & proxy, vector_base<NumericT> const & y, NumericT & result)
+  {
+    typedef fused_evaluator<NumericT, vector_base<NumericT> > y_evaluator;
+
+    if (!fused_applicable(x, proxy) || !y_evaluator::in_host_memory(y) || y_evaluator::overlaps(y, fused_result_range<NumericT>(x)))
+      return false;
+    result = fused_assign_reduce_impl<op_assign>(x, proxy, fused_inner_prod_reduction<NumericT>(y), y_evaluator::unit_stride(y));
+    return true;
+  }
+};
+
+} //namespace detail
+
+
+/** @brief Evaluates x = proxy, x += proxy, or x -= proxy in a single pass over host memory if this saves temporaries or passes over the data.
+*
+* Expressions which map to a single kernel (e.g. x = a*y + b*z) as well as expressions with operands in OpenCL or CUDA memory,
+* operands overlapping with x at other positions, or non-elementwise operations (e.g. matrix-vector products) are not touched.
+*
+* @return true if the expression has been evaluated, false if the caller needs to evaluate it through the individual kernels.
+*/
+template<typename OpT, typename NumericT, typename ExpressionT>
+bool fused_vector_assign(vector_base<NumericT> & x, ExpressionT const & proxy)
+{
+  typedef detail::fused_evaluator<NumericT, ExpressionT> evaluator_type;
+
+  return detail::fused_dispatcher<   detail::fused_numeric_type<NumericT>::value
+                                  && evaluator_type::is_fusable
+                                  && (evaluator_type::num_vectors > 2 || evaluator_type::needs_temp) >::template apply<OpT>(x, proxy);
+}
+
+/** @brief Computes x = proxy and the squared 2-norm of the new x in the same pass.
+*
+* @return true if the expression has been evaluated, false if it needs to be evaluated through the individual kernels.
+*/
+template<typename NumericT, typename ExpressionT>
+bool fused_assign_norm_2(vector_base<NumericT> & x, ExpressionT const & proxy, NumericT & squared_norm)
+{
+  return detail::fused_dispatcher<   detail::fused_numeric_type<NumericT>::value
+                                  && detail::fused_evaluator<NumericT, ExpressionT>::is_fusable >::apply_norm_2(x, proxy, squared_norm);
+}
+
+/** @brief Computes x = proxy and the inner product of the new x with y in the same pass.
+*
+* @return true if the expression has been evaluated, false if it needs to be evaluated through the individual kernels.
+*/
+template<typename NumericT, typename ExpressionT>
+bool fused_assign_inner_prod(vector_base<NumericT> & x, ExpressionT const & proxy, vector_base<NumericT> const & y, NumericT & result)
+{
+  return detail::fused_dispatcher<   detail::fused_numeric_type<NumericT>::value
+                                  && detail::fused_evaluator<NumericT, ExpressionT>::is_fusable >::apply_inner_prod(x, proxy, y, result);
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
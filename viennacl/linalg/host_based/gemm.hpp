@@ -0,0 +1,236 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_GEMM_HPP_
+#define VIENNACL_LINALG_HOST_BASED_GEMM_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/gemm.hpp
+    @brief Packed-panel dense matrix-matrix multiplication (GotoBLAS/BLIS-style) for the host backend.
+
+    C is computed in three levels of cache blocking: NC columns of B (L3), KC entries along the inner dimension (packed panels in L2/L1), and MC rows of A (L2).
+    The innermost loop is a register-blocked MR x NR micro-kernel operating on packed, zero-padded micro-panels of A and B.
+    Threads share the MC row blocks. If there are fewer row blocks than threads, each row block is further split into groups of NR panels of B.
+    The micro-kernel and the blocking parameters are taken from the runtime-dispatched kernel table in simd_kernels.hpp.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/simd_kernels.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum Matrix size(size1*size2) for using OpenMP on matrix operations:
+#ifndef VIENNACL_OPENMP_MATRIX_MIN_SIZE
+  #define VIENNACL_OPENMP_MATRIX_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Packs the block A(row_start:row_start+mc, col_start:col_start+kc) into micro-panels of mr rows. Each micro-panel is stored k-major and zero-padded to mr rows. */
+template<typename MatrixAccT, typename NumericT>
+void gemm_pack_A(MatrixAccT & A, NumericT * buffer, vcl_size_t mr,
+                 vcl_size_t row_start, vcl_size_t mc,
+                 vcl_size_t col_start, vcl_size_t kc)
+{
+  for (vcl_size_t i0 = 0; i0 < mc; i0 += mr)
+  {
+    vcl_size_t m_r = std::min(mr, mc - i0);
+    for (vcl_size_t k = 0; k < kc; ++k)
+    {
+      for (vcl_size_t i = 0; i < m_r; ++i)
+        buffer[k * mr + i] = A(row_start + i0 + i, col_start + k);
+      for (vcl_size_t i = m_r; i < mr; ++i)
+        buffer[k * mr + i] = NumericT(0);
+    }
+    buffer += mr * kc;
+  }
+}
+
+/** @brief Packs the micro-panel B(row_start:row_start+kc, col_start:col_start+n_r) of nr columns. The micro-panel is stored k-major and zero-padded to nr columns. */
+template<typename MatrixAccT, typename NumericT>
+void gemm_pack_B_panel(MatrixAccT & B, NumericT * buffer, vcl_size_t nr,
+                       vcl_size_t row_start, vcl_size_t kc,
+                       vcl_size_t col_start, vcl_size_t n_r)
+{
+  for (vcl_size_t k = 0; k < kc; ++k)
+  {
+    for (vcl_size_t j = 0; j < n_r; ++j)
+      buffer[k * nr + j] = B(row_start + k, col_start + j);
+    for (vcl_size_t j = n_r; j < nr; ++j)
+      buffer[k * nr + j] = NumericT(0);
+  }
+}
+
+
+/** @brief Writes the m_r x n_r leading part of the register tile AB back to C(row_start:, col_start:) as C = alpha * AB + beta * C. C is not read if beta is zero. */
+template<typename MatrixAccT, typename NumericT>
+void gemm_write_back(MatrixAccT & C, NumericT const * ab, vcl_size_t nr,
+                     vcl_size_t row_start, vcl_size_t m_r,
+                     vcl_size_t col_start, vcl_size_t n_r,
+                     NumericT alpha, NumericT beta)
+{
+  if (beta > 0 || beta < 0)
+  {
+    for (vcl_size_t i = 0; i < m_r; ++i)
+      for (vcl_size_t j = 0; j < n_r; ++j)
+        C(row_start + i, col_start + j) = beta * C(row_start + i, col_start + j) + alpha * ab[i * nr + j];
+  }
+  else
+  {
+    for (vcl_size_t i = 0; i < m_r; ++i)
+      for (vcl_size_t j = 0; j < n_r; ++j)
+        C(row_start + i, col_start + j) =                                          alpha * ab[i * nr + j];
+  }
+}
+
+
+/** @brief Computes C = alpha * A * B + beta * C, where A, B, C are accessed through matrix_array_wrapper objects (hence any layout and transposition).
+  *
+  * @param A        Accessor for the C_size1 x A_size2 matrix A
+  * @param B        Accessor for the A_size2 x C_size2 matrix B
+  * @param C        Accessor for the result matrix C
+  * @param C_size1  Number of rows of C
+  * @param C_size2  Number of columns of C
+  * @param A_size2  Inner dimension of the product
+  * @param alpha    Scaling factor for A * B
+  * @param beta     Scaling factor for C
+  */
+template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
+void gemm(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
+          vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
+          NumericT alpha, NumericT beta)
+{
+  if (C_size1 == 0 || C_size2 == 0 || A_size2 == 0)
+    return;
+
+  host_kernels<NumericT> const & kernels = get_host_kernels<NumericT>();
+
+  typename host_kernels<NumericT>::gemm_kernel micro_kernel = kernels.gemm_micro_kernel;
+  vcl_size_t const MR = kernels.gemm_mr;
+  vcl_size_t const NR = kernels.gemm_nr;
+  vcl_size_t const MC = kernels.gemm_mc;
+  vcl_size_t const KC = kernels.gemm_kc;
+  vcl_size_t const NC = kernels.gemm_nc;
+
+  // packed panel of B, shared by all threads:
+  vcl_size_t nc_max = std::min(NC, ((C_size2 - 1) / NR + 1) * NR);
+  std::vector<NumericT> buffer_B(std::min(KC, A_size2) * nc_max);
+
+  vcl_size_t num_blocks_C1 = (C_size1 - 1) / MC + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if ((C_size1*C_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+  {
+    // thread-local packed block of A and register tile:
+    std::vector<NumericT> buffer_A(std::min(MC, ((C_size1 - 1) / MR + 1) * MR) * std::min(KC, A_size2));
+    std::vector<NumericT> ab(MR * NR);
+
+    vcl_size_t num_threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+#endif
+
+    for (vcl_size_t jc = 0; jc < C_size2; jc += NC)
+    {
+      vcl_size_t nc = std::min(NC, C_size2 - jc);
+      vcl_size_t num_panels_B = (nc - 1) / NR + 1;
+
+      // split each row block into groups of panels of B if there are not enough row blocks for all threads:
+      vcl_size_t num_groups_B = 1;
+      if (num_blocks_C1 < num_threads)
+        num_groups_B = std::min(num_panels_B, (num_threads - 1) / num_blocks_C1 + 1);
+      vcl_size_t panels_per_group = (num_panels_B - 1) / num_groups_B + 1;
+      num_groups_B = (num_panels_B - 1) / panels_per_group + 1;
+
+      for (vcl_size_t pc = 0; pc < A_size2; pc += KC)
+      {
+        vcl_size_t kc = std::min(KC, A_size2 - pc);
+
+        // beta is only applied once, all further panels accumulate:
+        NumericT beta_panel = (pc == 0) ? beta : NumericT(1);
+
+        // pack B(pc:pc+kc, jc:jc+nc):
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long panel_B = 0; panel_B < static_cast<long>(num_panels_B); ++panel_B)
+        {
+          vcl_size_t jr = static_cast<vcl_size_t>(panel_B) * NR;
+          gemm_pack_B_panel(B, &(buffer_B[jr * kc]), NR, pc, kc, jc + jr, std::min(NR, nc - jr));
+        }
+
+        // multiply row blocks of A with groups of panels of B (implicit barrier above ensures B is packed).
+        // Consecutive work items of a thread share the row block, which is then only packed once:
+        long packed_block_idx_i = -1;
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long work_idx = 0; work_idx < static_cast<long>(num_blocks_C1 * num_groups_B); ++work_idx)
+        {
+          long block_idx_i = work_idx / static_cast<long>(num_groups_B);
+          vcl_size_t ic = static_cast<vcl_size_t>(block_idx_i) * MC;
+          vcl_size_t mc = std::min(MC, C_size1 - ic);
+
+          if (block_idx_i != packed_block_idx_i)
+          {
+            gemm_pack_A(A, &(buffer_A[0]), MR, ic, mc, pc, kc);
+            packed_block_idx_i = block_idx_i;
+          }
+
+          vcl_size_t group_B = static_cast<vcl_size_t>(work_idx) % num_groups_B;
+          vcl_size_t jr_start = group_B * panels_per_group * NR;
+          vcl_size_t jr_end   = std::min(nc, jr_start + panels_per_group * NR);
+          for (vcl_size_t jr = jr_start; jr < jr_end; jr += NR)
+          {
+            vcl_size_t n_r = std::min(NR, nc - jr);
+            NumericT const * panel_B = &(buffer_B[jr * kc]);
+
+            for (vcl_size_t ir = 0; ir < mc; ir += MR)
+            {
+              vcl_size_t m_r = std::min(MR, mc - ir);
+
+              micro_kernel(kc, &(buffer_A[ir * kc]), panel_B, &(ab[0]));
+              gemm_write_back(C, &(ab[0]), NR, ic + ir, m_r, jc + jr, n_r, alpha, beta_panel);
+            }
+          }
+        }
+      } // for pc
+    } // for jc
+  } // omp parallel
+
+}
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
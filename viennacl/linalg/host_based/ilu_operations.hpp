@@ -252,6 +252,70 @@ void icc_chow_patel_sweep(compressed_matrix<NumericT> & L,
 
 
 
+/** @brief Performs one asynchronous nonlinear relaxation step in the Chow-Patel-ICC using OpenMP (cf. Algorithm 3 in paper, but for L rather than U)
+  *
+  * Unlike icc_chow_patel_sweep(), entries of L are updated in place without a backup copy and without synchronization between threads,
+  * so each update uses the most recent values available. This is the asynchronous iteration proposed in the paper.
+  *
+  * @return The squared Euclidean norm of the changes of all entries of L, which is the nonlinear residual of the previous iterate up to scaling
+  */
+template<typename NumericT>
+NumericT icc_chow_patel_sweep_async(compressed_matrix<NumericT> & L,
+                                    vector<NumericT>      const & aij_L)
+{
+  unsigned int const *L_row_buffer = detail::extract_raw_pointer<unsigned int>(L.handle1());
+  unsigned int const *L_col_buffer = detail::extract_raw_pointer<unsigned int>(L.handle2());
+  NumericT           *L_elements   = detail::extract_raw_pointer<NumericT>(L.handle());
+
+  NumericT     const *aij_ptr      = detail::extract_raw_pointer<NumericT>(aij_L.handle());
+
+  NumericT change = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: change) if (L.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(L.size1()); ++row)
+  {
+    unsigned int row_Li_start = L_row_buffer[row];
+    unsigned int row_Li_end   = L_row_buffer[row + 1];
+
+    for (unsigned int i = row_Li_start; i < row_Li_end; ++i)
+    {
+      unsigned int col = L_col_buffer[i];
+
+      unsigned int row_Lj_start = L_row_buffer[col];
+      unsigned int row_Lj_end   = L_row_buffer[col+1];
+
+      // compute \sum_{k=1}^{j-1} l_ik l_jk
+      unsigned int index_Lj = row_Lj_start;
+      unsigned int col_Lj = L_col_buffer[index_Lj];
+      NumericT s = aij_ptr[i];
+      for (unsigned int index_Li = row_Li_start; index_Li < i; ++index_Li)
+      {
+        unsigned int col_Li = L_col_buffer[index_Li];
+
+        // find element in row j
+        while (col_Lj < col_Li)
+        {
+          ++index_Lj;
+          col_Lj = L_col_buffer[index_Lj];
+        }
+
+        if (col_Lj == col_Li)
+          s -= L_elements[index_Li] * L_elements[index_Lj];
+      }
+
+      NumericT new_value = (long(col) != row) ? s / L_elements[row_Lj_end - 1] // diagonal element is last in row!
+                                              : std::sqrt(s);
+      change += (new_value - L_elements[i]) * (new_value - L_elements[i]);
+      L_elements[i] = new_value;
+    }
+  }
+
+  return change;
+}
+
+
 //////////////////////// ILU ////////////////////////
 
 template<typename NumericT>
@@ -622,6 +686,123 @@ void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
 }
 
 
+/** @brief Performs one asynchronous nonlinear relaxation step in the Chow-Patel-ILU using OpenMP (cf. Algorithm 2 in paper)
+  *
+  * Unlike ilu_chow_patel_sweep(), entries of L and U are updated in place without backup copies and without synchronization between threads,
+  * so each update uses the most recent values available. This is the asynchronous iteration proposed in the paper.
+  *
+  * @return The squared Euclidean norm of the changes of all entries of L and U, which is the nonlinear residual of the previous iterate up to scaling
+  */
+template<typename NumericT>
+NumericT ilu_chow_patel_sweep_async(compressed_matrix<NumericT>       & L,
+                                    vector<NumericT>            const & aij_L,
+                                    compressed_matrix<NumericT>       & U_trans,
+                                    vector<NumericT>            const & aij_U_trans)
+{
+  unsigned int const *L_row_buffer = detail::extract_raw_pointer<unsigned int>(L.handle1());
+  unsigned int const *L_col_buffer = detail::extract_raw_pointer<unsigned int>(L.handle2());
+  NumericT           *L_elements   = detail::extract_raw_pointer<NumericT>(L.handle());
+
+  NumericT     const *aij_L_ptr    = detail::extract_raw_pointer<NumericT>(aij_L.handle());
+
+  unsigned int const *U_row_buffer = detail::extract_raw_pointer<unsigned int>(U_trans.handle1());
+  unsigned int const *U_col_buffer = detail::extract_raw_pointer<unsigned int>(U_trans.handle2());
+  NumericT           *U_elements   = detail::extract_raw_pointer<NumericT>(U_trans.handle());
+
+  NumericT     const *aij_U_trans_ptr = detail::extract_raw_pointer<NumericT>(aij_U_trans.handle());
+
+  NumericT change = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: change) if (L.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+#endif
+  for (long row = 0; row < static_cast<long>(L.size1()); ++row)
+  {
+    //
+    // update L:
+    //
+    unsigned int row_L_start = L_row_buffer[row];
+    unsigned int row_L_end   = L_row_buffer[row + 1];
+
+    for (unsigned int j = row_L_start; j < row_L_end; ++j)
+    {
+      unsigned int col = L_col_buffer[j];
+
+      if (col == row)
+        continue;
+
+      unsigned int row_U_start = U_row_buffer[col];
+      unsigned int row_U_end   = U_row_buffer[col + 1];
+
+      // compute \sum_{k=1}^{j-1} l_ik u_kj
+      unsigned int index_U = row_U_start;
+      unsigned int col_U = (index_U < row_U_end) ? U_col_buffer[index_U] : static_cast<unsigned int>(U_trans.size2());
+      NumericT sum = 0;
+      for (unsigned int k = row_L_start; k < j; ++k)
+      {
+        unsigned int col_L = L_col_buffer[k];
+
+        // find element in U
+        while (col_U < col_L)
+        {
+          ++index_U;
+          col_U = U_col_buffer[index_U];
+        }
+
+        if (col_U == col_L)
+          sum += L_elements[k] * U_elements[index_U];
+      }
+
+      // update l_ij:
+      assert(U_col_buffer[row_U_end - 1] == col && bool("Accessing U element which is not a diagonal element!"));
+      NumericT new_value = (aij_L_ptr[j] - sum) / U_elements[row_U_end - 1];  // diagonal element is last entry in U
+      change += (new_value - L_elements[j]) * (new_value - L_elements[j]);
+      L_elements[j] = new_value;
+    }
+
+
+    //
+    // update U:
+    //
+    unsigned int row_U_start = U_row_buffer[row];
+    unsigned int row_U_end   = U_row_buffer[row + 1];
+    for (unsigned int j = row_U_start; j < row_U_end; ++j)
+    {
+      unsigned int col = U_col_buffer[j];
+
+      row_L_start = L_row_buffer[col];
+      row_L_end   = L_row_buffer[col + 1];
+
+      // compute \sum_{k=1}^{j-1} l_ik u_kj
+      unsigned int index_L = row_L_start;
+      unsigned int col_L = (index_L < row_L_end) ? L_col_buffer[index_L] : static_cast<unsigned int>(L.size1());
+      NumericT sum = 0;
+      for (unsigned int k = row_U_start; k < j; ++k)
+      {
+        unsigned int col_U = U_col_buffer[k];
+
+        // find element in L
+        while (col_L < col_U)
+        {
+          ++index_L;
+          col_L = L_col_buffer[index_L];
+        }
+
+        if (col_U == col_L)
+          sum += L_elements[index_L] * U_elements[k];
+      }
+
+      // update u_ij:
+      NumericT new_value = aij_U_trans_ptr[j] - sum;
+      change += (new_value - U_elements[j]) * (new_value - U_elements[j]);
+      U_elements[j] = new_value;
+    }
+  }
+
+  return change;
+}
+
+
 template<typename NumericT>
 void ilu_form_neumann_matrix(compressed_matrix<NumericT> & R,
                              vector<NumericT> & diag_R)
@@ -664,6 +845,102 @@ void ilu_form_neumann_matrix(compressed_matrix<NumericT> & R,
   //std::cout << "diag_R: " << diag_R << std::endl;
 }
 
+
+/** @brief Approximately solves the triangular system T x = b for the Chow-Patel preconditioners by Jacobi iterations x_{k+1} = R x_k + D^{-1} b with R = I - D^{-1} T.
+  *
+  * Each iteration is a single fused pass over R, which also scales the right hand side on the fly.
+  * The rows are split into one contiguous block per thread. Within a block, rows are processed in the order of the substitution
+  * and the values already updated in the same pass are used (Gauss-Seidel within the block), values from other blocks are taken from the previous iterate.
+  * Thus, the preconditioner is a fixed linear operator for a given number of threads, and a single iteration computes the exact solution if only one thread is used.
+  *
+  * @param R            Matrix I - D^{-1}T as obtained from ilu_form_neumann_matrix()
+  * @param diag_R       Diagonal D of the triangular matrix
+  * @param vec          On input the right hand side b, on output the approximate solution x
+  * @param x_old        Work vector of the same size as vec
+  * @param x_new        Work vector of the same size as vec
+  * @param is_lower     True if T is lower triangular, false if it is upper triangular
+  * @param max_iters    Maximum number of iterations
+  * @param tolerance    If positive, iterations stop once the norm of the update relative to the norm of the iterate drops below this value
+  */
+template<typename NumericT>
+void ilu_jacobi_solve(compressed_matrix<NumericT> const & R,
+                      vector<NumericT>            const & diag_R,
+                      vector_base<NumericT>             & vec,
+                      vector<NumericT>                  & x_old,
+                      vector<NumericT>                  & x_new,
+                      bool is_lower,
+                      vcl_size_t max_iters,
+                      NumericT tolerance)
+{
+  unsigned int const *R_row_buffer = detail::extract_raw_pointer<unsigned int>(R.handle1());
+  unsigned int const *R_col_buffer = detail::extract_raw_pointer<unsigned int>(R.handle2());
+  NumericT     const *R_elements   = detail::extract_raw_pointer<NumericT>(R.handle());
+  NumericT     const *diag_R_ptr   = detail::extract_raw_pointer<NumericT>(diag_R.handle());
+
+  NumericT           *rhs          = detail::extract_raw_pointer<NumericT>(vec.handle()) + viennacl::traits::start(vec);
+  vcl_size_t          rhs_inc      = viennacl::traits::stride(vec);
+  NumericT           *x_k          = detail::extract_raw_pointer<NumericT>(x_old.handle());
+  NumericT           *x_next       = detail::extract_raw_pointer<NumericT>(x_new.handle());
+
+  long size = static_cast<long>(R.size1());
+  long num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+  if (size > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    num_blocks = std::max<long>(1, std::min<long>(omp_get_max_threads(), size));
+#endif
+
+  // x_1 = D^{-1} b if x_0 \equiv 0:
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_ILU_MIN_SIZE)
+#endif
+  for (long row = 0; row < size; ++row)
+    x_k[row] = rhs[row * static_cast<long>(rhs_inc)] / diag_R_ptr[row];
+
+  for (vcl_size_t iter = 0; iter < max_iters; ++iter)
+  {
+    NumericT change = 0;
+    NumericT norm = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: change, norm) if (num_blocks > 1)
+#endif
+    for (long block = 0; block < num_blocks; ++block)
+    {
+      long block_start = (size * block) / num_blocks;
+      long block_end   = (size * (block + 1)) / num_blocks;
+
+      for (long i = 0; i < block_end - block_start; ++i)
+      {
+        long row = is_lower ? block_start + i : block_end - i - 1;
+
+        NumericT value = rhs[row * static_cast<long>(rhs_inc)] / diag_R_ptr[row];
+        for (unsigned int j = R_row_buffer[row]; j < R_row_buffer[row+1]; ++j)
+        {
+          long col = static_cast<long>(R_col_buffer[j]);
+          bool updated = is_lower ? (col >= block_start && col < row) : (col > row && col < block_end);
+          value += R_elements[j] * (updated ? x_next[col] : x_k[col]);
+        }
+
+        change += (value - x_k[row]) * (value - x_k[row]);
+        norm   += value * value;
+        x_next[row] = value;
+      }
+    }
+
+    std::swap(x_k, x_next);
+
+    if (tolerance > 0 && change <= tolerance * tolerance * norm)
+      break;
+  }
+
+  // return result:
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_ILU_MIN_SIZE)
+#endif
+  for (long row = 0; row < size; ++row)
+    rhs[row * static_cast<long>(rhs_inc)] = x_k[row];
+}
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
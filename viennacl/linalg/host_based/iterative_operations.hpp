@@ -23,6 +23,7 @@
 */
 
 #include <cmath>
+#include <vector>
 #include <algorithm>  //for std::max and std::min
 
 #include "viennacl/forwards.h"
@@ -33,6 +34,8 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/simd_kernels.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
@@ -239,42 +242,36 @@ namespace detail
     IndexT     const * block_start       = detail::extract_raw_pointer<IndexT>(A.handle3());
     value_type         * data_buffer     = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
-    vcl_size_t num_blocks = A.size1() / A.rows_per_block() + 1;
+    detail::host_kernels<value_type> const & kernels = detail::get_host_kernels<value_type>();
+
+    vcl_size_t rows_per_block = A.rows_per_block();
+    vcl_size_t num_blocks = (A.size1() > 0) ? (A.size1() - 1) / rows_per_block + 1 : 0;
 
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for reduction(+: inner_prod_ApAp, inner_prod_pAp, inner_prod_Ap_r0star)
+    #pragma omp parallel
 #endif
-    for (vcl_size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
     {
-      vcl_size_t current_columns_per_block = columns_per_block[block_idx];
-
-      std::vector<value_type> result_values(A.rows_per_block());
+      std::vector<value_type> result_values(rows_per_block);
 
-      for (IndexT column_entry_index = 0;
-                  column_entry_index < current_columns_per_block;
-                ++column_entry_index)
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for reduction(+: inner_prod_ApAp, inner_prod_pAp, inner_prod_Ap_r0star)
+#endif
+      for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
       {
-        vcl_size_t stride_start = block_start[block_idx] + column_entry_index * A.rows_per_block();
-        // Note: This for-loop may be unrolled by hand for exploiting vectorization
-        //       Careful benchmarking recommended first, memory channels may be saturated already!
-        for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
-        {
-          value_type val = elements[stride_start + row_in_block];
+        vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
 
-          result_values[row_in_block] += val ? p_buf[column_indices[stride_start + row_in_block]] * val : 0;
-        }
-      }
+        detail::sell_slice(kernels, elements + block_start[block_idx], column_indices + block_start[block_idx], columns_per_block[block_idx], rows_per_block,
+                           p_buf, 0, 1, &(result_values[0]));
 
-      vcl_size_t first_row_in_matrix = block_idx * A.rows_per_block();
-      for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
-      {
-        vcl_size_t row = first_row_in_matrix + row_in_block;
-        if (row < Ap.size())
+        vcl_size_t first_row_in_matrix = block_idx * rows_per_block;
+        vcl_size_t rows_in_block = std::min(rows_per_block, Ap.size() - first_row_in_matrix);
+        for (vcl_size_t row_in_block = 0; row_in_block < rows_in_block; ++row_in_block)
         {
+          vcl_size_t row = first_row_in_matrix + row_in_block;
           value_type row_result = result_values[row_in_block];
 
           Ap_buf[row] = row_result;
@@ -937,6 +934,324 @@ void pipelined_gmres_prod(MatrixType const & A,
 }
 
 
+
+/////////////////////////////////////////////////////////////
+
+/** @brief Matrix powers kernel for the s-step (communication-avoiding) Krylov solvers: Computes v_{first+j+1} = scaling * A v_{first+j} for j=0..count-1.
+ *
+ *  All vectors v_i are stored column-major in the array 'krylov_basis' with padding 'v_internal_size'.
+ *  All matrix-vector products are carried out within a single parallel region with the row kernel and the cached work partition of the sparse matrix-vector product.
+ *  The only synchronization is the barrier after each product (and after adding the carry-out of rows split among threads).
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void s_step_matrix_powers(compressed_matrix<NumericT, AlignmentV> const & A,
+                          vector_base<NumericT> & krylov_basis,
+                          vcl_size_t v_internal_size,
+                          vcl_size_t first,
+                          vcl_size_t count,
+                          NumericT scaling)
+{
+  NumericT           * data_krylov_basis = detail::extract_raw_pointer<NumericT>(krylov_basis);
+  NumericT     const * elements          = detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer        = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer        = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  typename detail::host_kernels<NumericT>::csr_row_dot_kernel row_dot = detail::get_host_kernels<NumericT>().csr_row_dot;
+
+  vcl_size_t num_threads = detail::spmv_num_threads();
+  if (detail::csr_use_partition(A, num_threads))
+  {
+    viennacl::detail::csr_host_partition const & partition = detail::csr_partition(A, num_threads);
+    long num_parts = static_cast<long>(partition.num_parts);
+    std::vector<NumericT> carry(partition.num_parts);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    for (vcl_size_t j = 0; j < count; ++j)
+    {
+      NumericT const * v_in  = data_krylov_basis + (first + j) * v_internal_size;
+      detail::csr_result_axpby<NumericT> v_out(data_krylov_basis + (first + j + 1) * v_internal_size, 0, 1, scaling, NumericT(0));
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(static, 1)
+#endif
+      for (long part = 0; part < num_parts; ++part)
+        detail::csr_prod_part(partition, vcl_size_t(part), elements, row_buffer, col_buffer, v_in, v_out, &(carry[0]));
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp single
+#endif
+      detail::csr_prod_add_carries(partition, &(carry[0]), v_out);
+    }
+    return;
+  }
+
+  // single thread or small matrix:
+  for (vcl_size_t j = 0; j < count; ++j)
+  {
+    NumericT const * v_in  = data_krylov_basis + (first + j) * v_internal_size;
+    NumericT       * v_out = data_krylov_basis + (first + j + 1) * v_internal_size;
+
+    for (long row = 0; row < static_cast<long>(A.size1()); ++row)
+    {
+      unsigned int row_start = row_buffer[row];
+      v_out[row] = scaling * row_dot(elements + row_start, col_buffer + row_start, v_in, row_buffer[row+1] - row_start);
+    }
+  }
+}
+
+
+/** @brief Computes the inner products <v_i, v_j> for i=0..num_vectors-1 and j=block_start..block_start+block_size-1 in a single pass, as needed by the s-step (communication-avoiding) Krylov solvers.
+ *
+ *  All vectors v_i are stored column-major in the array 'krylov_basis', where each vector has an actual length 'v_size', but might be padded to have 'v_internal_size'.
+ *  The result <v_i, v_{block_start+j}> is written to inner_prod_result[i + j * num_vectors].
+ */
+template <typename T>
+void s_step_inner_products(vector_base<T> const & krylov_basis,
+                           vcl_size_t v_size,
+                           vcl_size_t v_internal_size,
+                           vcl_size_t num_vectors,
+                           vcl_size_t block_start,
+                           vcl_size_t block_size,
+                           vector_base<T> & inner_prod_result)
+{
+  typedef T        value_type;
+
+  value_type const * data_krylov_basis = detail::extract_raw_pointer<value_type>(krylov_basis);
+  value_type       * data_result       = detail::extract_raw_pointer<value_type>(inner_prod_result);
+
+#ifdef VIENNACL_WITH_OPENMP
+  unsigned int max_threads = static_cast<unsigned int>(omp_get_max_threads());
+#else
+  unsigned int max_threads = 1;
+#endif
+
+  vcl_size_t num_results = num_vectors * block_size;
+  std::vector<T> scratchpad(num_results * max_threads); // num_results values per thread
+
+  // rows are processed in chunks, so that the inner products are computed on contiguous, cached pieces of the vectors:
+  long chunk_size = 512;
+  long num_chunks = (long(v_size) + chunk_size - 1) / chunk_size;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    long thread_id = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    thread_id    = static_cast<long>(omp_get_thread_num());
+#endif
+
+    T *thread_scratchpad = &(scratchpad[num_results * static_cast<vcl_size_t>(thread_id)]);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      vcl_size_t chunk_start  = static_cast<vcl_size_t>(chunk * chunk_size);
+      vcl_size_t chunk_length = std::min<vcl_size_t>(static_cast<vcl_size_t>(chunk_size), v_size - chunk_start);
+
+      for (vcl_size_t j = 0; j < block_size; ++j)
+      {
+        value_type const * data_vj = data_krylov_basis + (block_start + j) * v_internal_size + chunk_start;
+
+        // vectors v_k with k in [block_start, block_start + j) are skipped, because <v_k, v_j> is a symmetric entry within the block (set below)
+        vcl_size_t k = 0;
+        while (k < num_vectors)
+        {
+          if (k >= block_start && k < block_start + j)
+          {
+            k = block_start + j;
+            continue;
+          }
+
+          vcl_size_t k_end = (k < block_start) ? std::min(num_vectors, block_start) : num_vectors;
+
+          // four inner products at a time for independent accumulations:
+          for (; k + 4 <= k_end; k += 4)
+          {
+            value_type const * data_vk = data_krylov_basis + k * v_internal_size + chunk_start;
+            value_type inner_prod_0 = 0;
+            value_type inner_prod_1 = 0;
+            value_type inner_prod_2 = 0;
+            value_type inner_prod_3 = 0;
+            for (vcl_size_t i = 0; i < chunk_length; ++i)
+            {
+              value_type value_vj = data_vj[i];
+              inner_prod_0 += data_vk[i                      ] * value_vj;
+              inner_prod_1 += data_vk[i +     v_internal_size] * value_vj;
+              inner_prod_2 += data_vk[i + 2 * v_internal_size] * value_vj;
+              inner_prod_3 += data_vk[i + 3 * v_internal_size] * value_vj;
+            }
+            thread_scratchpad[k     + j * num_vectors] += inner_prod_0;
+            thread_scratchpad[k + 1 + j * num_vectors] += inner_prod_1;
+            thread_scratchpad[k + 2 + j * num_vectors] += inner_prod_2;
+            thread_scratchpad[k + 3 + j * num_vectors] += inner_prod_3;
+          }
+          for (; k < k_end; ++k)
+          {
+            value_type const * data_vk = data_krylov_basis + k * v_internal_size + chunk_start;
+            value_type inner_prod_vk_vj = 0;
+            for (vcl_size_t i = 0; i < chunk_length; ++i)
+              inner_prod_vk_vj += data_vk[i] * data_vj[i];
+            thread_scratchpad[k + j * num_vectors] += inner_prod_vk_vj;
+          }
+        }
+      }
+    }
+  }
+
+  for (vcl_size_t j = 0; j < num_results; ++j)
+  {
+    T tmp = 0;
+    for (vcl_size_t i=0; i<max_threads; ++i)
+      tmp += scratchpad[j + i*num_results];
+    data_result[j] = tmp;
+  }
+
+  // fill symmetric entries within the block:
+  for (vcl_size_t j = 0; j < block_size; ++j)
+    for (vcl_size_t k = block_start; k < block_start + j && k < num_vectors; ++k)
+      data_result[k + j * num_vectors] = data_result[block_start + j + (k - block_start) * num_vectors];
+}
+
+
+/** @brief Recovers the iterates of s-step CG from their coefficients in the s-step basis.
+ *
+ *  The basis holds the 2s+1 vectors [p, A p, ..., A^s p, r, A r, ..., A^{s-1} r] column-major with padding 'v_internal_size'.
+ *  With V denoting the basis, this routine computes result += V * coefficients[0:2s+1], r = V * coefficients[2s+1:4s+2], p = V * coefficients[4s+2:6s+3],
+ *  where p and r are overwritten in place (columns 0 and s+1 of the basis).
+ */
+template <typename T>
+void s_step_cg_vector_update(vector_base<T> & result,
+                             vector_base<T> & krylov_basis,
+                             vcl_size_t v_size,
+                             vcl_size_t v_internal_size,
+                             vcl_size_t s,
+                             vector_base<T> const & coefficients)
+{
+  typedef T        value_type;
+
+  value_type       * data_result       = detail::extract_raw_pointer<value_type>(result);
+  value_type       * data_krylov_basis = detail::extract_raw_pointer<value_type>(krylov_basis);
+  value_type const * data_coefficients = detail::extract_raw_pointer<value_type>(coefficients);
+
+  vcl_size_t num_vectors = 2 * s + 1;
+  value_type const * coeff_x = data_coefficients;
+  value_type const * coeff_r = data_coefficients +     num_vectors;
+  value_type const * coeff_p = data_coefficients + 2 * num_vectors;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i = 0; i < static_cast<long>(v_size); ++i)
+  {
+    value_type * data_row = data_krylov_basis + static_cast<vcl_size_t>(i);
+
+    value_type value_x = 0;
+    value_type value_r = 0;
+    value_type value_p = 0;
+    for (vcl_size_t k = 0; k < num_vectors; ++k)
+    {
+      value_type value_vk = data_row[k * v_internal_size];
+      value_x += coeff_x[k] * value_vk;
+      value_r += coeff_r[k] * value_vk;
+      value_p += coeff_p[k] * value_vk;
+    }
+
+    data_result[static_cast<vcl_size_t>(i)] += value_x;
+    data_row[0]                             = value_p;
+    data_row[(s + 1) * v_internal_size]     = value_r;
+  }
+}
+
+
+/** @brief Block orthogonalization step of s-step GMRES: Computes W = (W - Q * C) * R^{-1} for the block W of the Krylov basis.
+ *
+ *  Q denotes the first 'num_previous' vectors of the basis, W the following 'block_size' vectors.
+ *  The coefficients hold C (num_previous x block_size, column-major) followed by the upper triangular matrix R^{-1} (block_size x block_size, column-major).
+ */
+template <typename T>
+void s_step_gmres_orthogonalize(vector_base<T> & krylov_basis,
+                                vcl_size_t v_size,
+                                vcl_size_t v_internal_size,
+                                vcl_size_t num_previous,
+                                vcl_size_t block_size,
+                                vector_base<T> const & coefficients)
+{
+  typedef T        value_type;
+
+  value_type       * data_krylov_basis = detail::extract_raw_pointer<value_type>(krylov_basis);
+  value_type const * data_C            = detail::extract_raw_pointer<value_type>(coefficients);
+  value_type const * data_R_inv        = data_C + num_previous * block_size;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<value_type> values_w(block_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long i = 0; i < static_cast<long>(v_size); ++i)
+    {
+      value_type * data_row = data_krylov_basis + static_cast<vcl_size_t>(i);
+
+      // w_j -= sum_k C(k, j) q_k
+      for (vcl_size_t j = 0; j < block_size; ++j)
+      {
+        value_type value_w = data_row[(num_previous + j) * v_internal_size];
+        for (vcl_size_t k = 0; k < num_previous; ++k)
+          value_w -= data_C[k + j * num_previous] * data_row[k * v_internal_size];
+        values_w[j] = value_w;
+      }
+
+      // w_j = sum_{k<=j} R^{-1}(k, j) w_k
+      for (vcl_size_t j = 0; j < block_size; ++j)
+      {
+        value_type value_w = 0;
+        for (vcl_size_t k = 0; k <= j; ++k)
+          value_w += data_R_inv[k + j * block_size] * values_w[k];
+        data_row[(num_previous + j) * v_internal_size] = value_w;
+      }
+    }
+  }
+}
+
+
+/** @brief Computes x += sum_{i=0}^{k-1} coefficients_i v_i for the vectors v_i in the Krylov basis of s-step GMRES */
+template <typename T>
+void s_step_gmres_update_result(vector_base<T> & result,
+                                vector_base<T> const & krylov_basis,
+                                vcl_size_t v_size,
+                                vcl_size_t v_internal_size,
+                                vector_base<T> const & coefficients,
+                                vcl_size_t k)
+{
+  typedef T        value_type;
+
+  value_type       * data_result       = detail::extract_raw_pointer<value_type>(result);
+  value_type const * data_krylov_basis = detail::extract_raw_pointer<value_type>(krylov_basis);
+  value_type const * data_coefficients = detail::extract_raw_pointer<value_type>(coefficients);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i = 0; i < static_cast<long>(v_size); ++i)
+  {
+    value_type value_result = data_result[static_cast<vcl_size_t>(i)];
+
+    for (vcl_size_t j = 0; j < k; ++j)
+      value_result += data_coefficients[j] * data_krylov_basis[static_cast<vcl_size_t>(i) + j * v_internal_size];
+
+    data_result[static_cast<vcl_size_t>(i)] = value_result;
+  }
+}
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
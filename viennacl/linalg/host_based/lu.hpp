@@ -0,0 +1,386 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_LU_HPP_
+#define VIENNACL_LINALG_HOST_BASED_LU_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/lu.hpp
+    @brief Blocked right-looking LU factorization with partial pivoting for the host backend.
+
+    Each panel of VIENNACL_LU_BLOCK_SIZE columns is factored recursively (left half, update, right half), so that most of the panel work is done in matrix-matrix products.
+    The trailing update uses the packed-panel GEMM from gemm.hpp. With OpenMP, one thread updates and factors the next panel (lookahead)
+    while the remaining threads update the rest of the trailing matrix, so the panel factorization is taken off the critical path.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/meta/predicate.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/gemm.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Number of columns per panel of the blocked LU factorization. */
+#ifndef VIENNACL_LU_BLOCK_SIZE
+  #define VIENNACL_LU_BLOCK_SIZE  64
+#endif
+
+/** @brief Panels up to this width are factored column by column instead of being split further. */
+#ifndef VIENNACL_LU_PANEL_MIN_WIDTH
+  #define VIENNACL_LU_PANEL_MIN_WIDTH  16
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Lightweight view on the dense matrix being factored. Hands out accessors for submatrices starting at a given position. */
+template<typename NumericT, typename LayoutT>
+class lu_matrix_view
+{
+public:
+  typedef matrix_array_wrapper<NumericT, LayoutT, false>   accessor_type;
+
+  lu_matrix_view(NumericT * data,
+                 vcl_size_t start1, vcl_size_t start2,
+                 vcl_size_t inc1,   vcl_size_t inc2,
+                 vcl_size_t internal_size1, vcl_size_t internal_size2)
+    : data_(data), start1_(start1), start2_(start2), inc1_(inc1), inc2_(inc2),
+      internal_size1_(internal_size1), internal_size2_(internal_size2) {}
+
+  /** @brief Accessor for the submatrix whose (0,0)-entry is the entry (row, col) of the full matrix. */
+  accessor_type block(vcl_size_t row, vcl_size_t col) const
+  {
+    return accessor_type(data_, start1_ + row * inc1_, start2_ + col * inc2_, inc1_, inc2_, internal_size1_, internal_size2_);
+  }
+
+private:
+  NumericT * data_;
+  vcl_size_t start1_, start2_;
+  vcl_size_t inc1_, inc2_;
+  vcl_size_t internal_size1_, internal_size2_;
+};
+
+
+/** @brief Applies the row interchanges ipiv[k_begin], ..., ipiv[k_end-1] to the columns [col_begin, col_end). */
+template<typename NumericT, typename LayoutT>
+void lu_apply_row_swaps(lu_matrix_view<NumericT, LayoutT> const & M, std::vector<vcl_size_t> const & ipiv,
+                        vcl_size_t k_begin, vcl_size_t k_end,
+                        vcl_size_t col_begin, vcl_size_t col_end)
+{
+  if (k_begin >= k_end || col_begin >= col_end)
+    return;
+
+  vcl_size_t const chunk_size = VIENNACL_LU_BLOCK_SIZE;
+  long num_chunks = static_cast<long>((col_end - col_begin - 1) / chunk_size + 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((k_end - k_begin) * (col_end - col_begin) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+  for (long chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    typename lu_matrix_view<NumericT, LayoutT>::accessor_type A = M.block(0, 0);
+    vcl_size_t j_begin = col_begin + static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t j_end   = std::min(j_begin + chunk_size, col_end);
+
+    if (viennacl::is_row_major<LayoutT>::value)
+    {
+      for (vcl_size_t k = k_begin; k < k_end; ++k)
+      {
+        vcl_size_t p = ipiv[k];
+        if (p != k)
+          for (vcl_size_t j = j_begin; j < j_end; ++j)
+            std::swap(A(k, j), A(p, j));
+      }
+    }
+    else
+    {
+      for (vcl_size_t j = j_begin; j < j_end; ++j)
+        for (vcl_size_t k = k_begin; k < k_end; ++k)
+          if (ipiv[k] != k)
+            std::swap(A(k, j), A(ipiv[k], j));
+    }
+  }
+}
+
+/** @brief Computes A(k0:k0+kb, col_begin:col_end) <- L^{-1} A(k0:k0+kb, col_begin:col_end), where L is the unit lower triangular part of A(k0:k0+kb, k0:k0+kb). */
+template<typename NumericT, typename LayoutT>
+void lu_trsm_unit_lower(lu_matrix_view<NumericT, LayoutT> const & M,
+                        vcl_size_t k0, vcl_size_t kb,
+                        vcl_size_t col_begin, vcl_size_t col_end)
+{
+  if (kb < 2 || col_begin >= col_end)
+    return;
+
+  vcl_size_t const chunk_size = VIENNACL_LU_BLOCK_SIZE;
+  long num_chunks = static_cast<long>((col_end - col_begin - 1) / chunk_size + 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (kb * kb * (col_end - col_begin) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+  for (long chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    typename lu_matrix_view<NumericT, LayoutT>::accessor_type A = M.block(k0, 0);
+    vcl_size_t j_begin = col_begin + static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t j_end   = std::min(j_begin + chunk_size, col_end);
+
+    if (viennacl::is_row_major<LayoutT>::value)
+    {
+      for (vcl_size_t i = 1; i < kb; ++i)
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT L_il = A(i, k0 + l);
+          if (L_il != NumericT(0))
+            for (vcl_size_t j = j_begin; j < j_end; ++j)
+              A(i, j) -= L_il * A(l, j);
+        }
+    }
+    else
+    {
+      for (vcl_size_t j = j_begin; j < j_end; ++j)
+        for (vcl_size_t l = 0; l < kb; ++l)
+        {
+          NumericT x_l = A(l, j);
+          if (x_l != NumericT(0))
+            for (vcl_size_t i = l + 1; i < kb; ++i)
+              A(i, j) -= A(i, k0 + l) * x_l;
+        }
+    }
+  }
+}
+
+/** @brief Computes A(row_begin:m, col_begin:col_end) -= A(row_begin:m, k0:k0+kb) * A(k0:k0+kb, col_begin:col_end) using the packed GEMM. */
+template<typename NumericT, typename LayoutT>
+void lu_update_block(lu_matrix_view<NumericT, LayoutT> const & M,
+                     vcl_size_t row_begin, vcl_size_t m,
+                     vcl_size_t col_begin, vcl_size_t col_end,
+                     vcl_size_t k0, vcl_size_t kb)
+{
+  if (row_begin >= m || col_begin >= col_end || kb == 0)
+    return;
+
+  typename lu_matrix_view<NumericT, LayoutT>::accessor_type L = M.block(row_begin, k0);
+  typename lu_matrix_view<NumericT, LayoutT>::accessor_type U = M.block(k0, col_begin);
+  typename lu_matrix_view<NumericT, LayoutT>::accessor_type C = M.block(row_begin, col_begin);
+
+  gemm(L, U, C, m - row_begin, col_end - col_begin, kb, NumericT(-1), NumericT(1));
+}
+
+/** @brief Unblocked (right-looking, rank-1 update) factorization of the panel A(k0:m, k0:k0+nb). Row interchanges are only applied within the panel. */
+template<typename NumericT, typename LayoutT>
+void lu_panel_unblocked(lu_matrix_view<NumericT, LayoutT> const & M,
+                        vcl_size_t m, vcl_size_t k0, vcl_size_t nb,
+                        std::vector<vcl_size_t> & ipiv)
+{
+  typename lu_matrix_view<NumericT, LayoutT>::accessor_type A = M.block(0, 0);
+  vcl_size_t k_end = k0 + nb;
+
+  for (vcl_size_t k = k0; k < k_end; ++k)
+  {
+    // find pivot:
+    vcl_size_t p = k;
+    NumericT max_abs = std::fabs(A(k, k));
+    for (vcl_size_t i = k + 1; i < m; ++i)
+    {
+      NumericT val = std::fabs(A(i, k));
+      if (val > max_abs)
+      {
+        max_abs = val;
+        p = i;
+      }
+    }
+    ipiv[k] = p;
+
+    if (p != k)
+      for (vcl_size_t j = k0; j < k_end; ++j)
+        std::swap(A(k, j), A(p, j));
+
+    // a zero pivot leaves the column as is (singular matrix), as in LAPACK's getrf:
+    NumericT pivot = A(k, k);
+    if (pivot == NumericT(0))
+      continue;
+
+    // scale column k and apply the rank-1 update to the remaining panel columns, in chunks of rows:
+    vcl_size_t const chunk_size = 256;
+    long num_chunks = static_cast<long>((m - k - 1 + chunk_size) / chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((m - k) * (k_end - k) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      vcl_size_t i_begin = k + 1 + static_cast<vcl_size_t>(chunk) * chunk_size;
+      vcl_size_t i_end   = std::min(i_begin + chunk_size, m);
+
+      for (vcl_size_t i = i_begin; i < i_end; ++i)
+        A(i, k) /= pivot;
+
+      if (viennacl::is_row_major<LayoutT>::value)
+      {
+        for (vcl_size_t i = i_begin; i < i_end; ++i)
+          for (vcl_size_t j = k + 1; j < k_end; ++j)
+            A(i, j) -= A(i, k) * A(k, j);
+      }
+      else
+      {
+        for (vcl_size_t j = k + 1; j < k_end; ++j)
+        {
+          NumericT U_kj = A(k, j);
+          for (vcl_size_t i = i_begin; i < i_end; ++i)
+            A(i, j) -= A(i, k) * U_kj;
+        }
+      }
+    }
+  }
+}
+
+/** @brief Recursive factorization of the panel A(k0:m, k0:k0+nb) with partial pivoting. Row interchanges are only applied within the panel.
+*
+* The panel is split into a left and a right half. After factoring the left half, the right half is updated with a triangular solve and a matrix-matrix product before it is factored itself.
+*/
+template<typename NumericT, typename LayoutT>
+void lu_panel_recursive(lu_matrix_view<NumericT, LayoutT> const & M,
+                        vcl_size_t m, vcl_size_t k0, vcl_size_t nb,
+                        std::vector<vcl_size_t> & ipiv)
+{
+  if (nb <= VIENNACL_LU_PANEL_MIN_WIDTH)
+  {
+    lu_panel_unblocked(M, m, k0, nb, ipiv);
+    return;
+  }
+
+  vcl_size_t n1 = nb / 2;
+  vcl_size_t k1 = k0 + n1;
+  vcl_size_t k_end = k0 + nb;
+
+  lu_panel_recursive(M, m, k0, n1, ipiv);
+
+  lu_apply_row_swaps(M, ipiv, k0, k1, k1, k_end);
+  lu_trsm_unit_lower(M, k0, n1, k1, k_end);
+  lu_update_block(M, k1, m, k1, k_end, k0, n1);
+
+  lu_panel_recursive(M, m, k1, nb - n1, ipiv);
+
+  lu_apply_row_swaps(M, ipiv, k1, k_end, k0, k1);
+}
+
+} //namespace detail
+
+
+/** @brief LU factorization with partial pivoting PA = LU of a dense matrix on the host.
+*
+* L (with implicit unit diagonal) and U overwrite A. Row i of PA is row perm[i] of the original A.
+*
+* @param A      The system matrix
+* @param perm   The row permutation. Resized to A.size1().
+*/
+template<typename NumericT, typename F>
+void lu_factorize(matrix<NumericT, F> & A, std::vector<vcl_size_t> & perm)
+{
+  vcl_size_t m = A.size1();
+  vcl_size_t n = A.size2();
+  vcl_size_t k_max = std::min(m, n);
+  vcl_size_t const nb = VIENNACL_LU_BLOCK_SIZE;
+
+  detail::lu_matrix_view<NumericT, F> M(detail::extract_raw_pointer<NumericT>(A),
+                                        viennacl::traits::start1(A), viennacl::traits::start2(A),
+                                        viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                                        viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A));
+
+  std::vector<vcl_size_t> ipiv(k_max);
+
+  if (k_max > 0)
+    detail::lu_panel_recursive(M, m, 0, std::min(nb, k_max), ipiv);
+
+  for (vcl_size_t k = 0; k < k_max; k += nb)
+  {
+    // panel A(k:m, k:k+kb) is already factored, propagate its interchanges to the rest of the matrix:
+    vcl_size_t kb = std::min(nb, k_max - k);
+    vcl_size_t k_next = k + kb;
+
+    detail::lu_apply_row_swaps(M, ipiv, k, k_next, 0, k);
+
+    if (k_next >= n)
+      continue;
+
+    detail::lu_apply_row_swaps(M, ipiv, k, k_next, k_next, n);
+    detail::lu_trsm_unit_lower(M, k, kb, k_next, n);
+
+    // trailing update. The columns of the next panel are updated and factored first (lookahead), the remaining columns are updated concurrently:
+    vcl_size_t kb_next  = (k_next < k_max) ? std::min(nb, k_max - k_next) : 0;
+    vcl_size_t rest_begin = k_next + kb_next;
+
+    vcl_size_t chunk_size = nb;
+#ifdef VIENNACL_WITH_OPENMP
+    if (n > rest_begin)
+      chunk_size = std::max(nb, (n - rest_begin) / (4 * static_cast<vcl_size_t>(omp_get_max_threads())));
+#endif
+    long num_chunks = (n > rest_begin) ? static_cast<long>((n - rest_begin - 1) / chunk_size + 1) : 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if ((m - k_next) * (n - k_next) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp single nowait
+#endif
+      {
+        if (kb_next > 0)
+        {
+          detail::lu_update_block(M, k_next, m, k_next, rest_begin, k, kb);
+          detail::lu_panel_recursive(M, m, k_next, kb_next, ipiv);
+        }
+      }
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (long chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        vcl_size_t col_begin = rest_begin + static_cast<vcl_size_t>(chunk) * chunk_size;
+        detail::lu_update_block(M, k_next, m, col_begin, std::min(col_begin + chunk_size, n), k, kb);
+      }
+    }
+  }
+
+  // convert the sequence of interchanges into a permutation:
+  perm.resize(m);
+  for (vcl_size_t i = 0; i < m; ++i)
+    perm[i] = i;
+  for (vcl_size_t k = 0; k < k_max; ++k)
+    std::swap(perm[k], perm[ipiv[k]]);
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -36,6 +36,7 @@
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/gemm.hpp"
 #include "viennacl/linalg/prod.hpp"
 
 // Minimum Matrix size(size1*size2) for using OpenMP on matrix operations:
@@ -1253,99 +1254,6 @@ void prod_impl(const matrix_base<NumericT> & mat, bool trans,
 /////////////////////////   matrix-matrix products /////////////////////////////////
 //
 
-namespace detail
-{
-  template<typename MatrixAccT1, typename MatrixAccT2, typename MatrixAccT3, typename NumericT>
-  void prod(MatrixAccT1 & A, MatrixAccT2 & B, MatrixAccT3 & C,
-            vcl_size_t C_size1, vcl_size_t C_size2, vcl_size_t A_size2,
-            NumericT alpha, NumericT beta)
-  {
-    if (C_size1 == 0 || C_size2 == 0 || A_size2 == 0)
-      return;
-
-    static const vcl_size_t blocksize = 64;
-
-    vcl_size_t num_blocks_C1 = (C_size1 - 1) / blocksize + 1;
-    vcl_size_t num_blocks_C2 = (C_size2 - 1) / blocksize + 1;
-    vcl_size_t num_blocks_A2 = (A_size2 - 1) / blocksize + 1;
-
-    //
-    // outer loop pair: Run over all blocks with indices (block_idx_i, block_idx_j) of the result matrix C:
-    //
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((C_size1*C_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
-#endif
-    for (long block_idx_i2=0; block_idx_i2<static_cast<long>(num_blocks_C1); ++block_idx_i2)
-    {
-      // thread-local auxiliary buffers
-      std::vector<NumericT> buffer_A(blocksize * blocksize); // row-major
-      std::vector<NumericT> buffer_B(blocksize * blocksize); // column-major
-      std::vector<NumericT> buffer_C(blocksize * blocksize); // row-major
-
-      vcl_size_t block_idx_i = static_cast<vcl_size_t>(block_idx_i2);
-      for (vcl_size_t block_idx_j=0; block_idx_j<num_blocks_C2; ++block_idx_j)
-      {
-        // Reset block matrix:
-        std::fill(buffer_C.begin(), buffer_C.end(), NumericT(0));
-
-        vcl_size_t offset_i = block_idx_i*blocksize;
-        vcl_size_t offset_j = block_idx_j*blocksize;
-
-        //  C(block_idx_i, block_idx_i) += A(block_idx_i, block_idx_k) * B(block_idx_k, block_idx_j)
-        for (vcl_size_t block_idx_k=0; block_idx_k<num_blocks_A2; ++block_idx_k)
-        {
-          // flush buffers:
-          std::fill(buffer_A.begin(), buffer_A.end(), NumericT(0));
-          std::fill(buffer_B.begin(), buffer_B.end(), NumericT(0));
-
-          vcl_size_t offset_k = block_idx_k*blocksize;
-
-          // load current data:
-          for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
-            for (vcl_size_t k = offset_k; k < std::min(offset_k + blocksize, A_size2); ++k)
-              buffer_A[(i - offset_i) * blocksize + (k - offset_k)] = A(i, k);
-
-          for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
-            for (vcl_size_t k = offset_k; k < std::min(offset_k + blocksize, A_size2); ++k)
-              buffer_B[(k - offset_k) + (j - offset_j) * blocksize] = B(k, j);
-
-          // multiply (this is the hot spot in terms of flops)
-          for (vcl_size_t i = 0; i < blocksize; ++i)
-          {
-            NumericT const * ptrA = &(buffer_A[i*blocksize]);
-            for (vcl_size_t j = 0; j < blocksize; ++j)
-            {
-              NumericT const * ptrB = &(buffer_B[j*blocksize]);
-
-              NumericT temp = NumericT(0);
-              for (vcl_size_t k = 0; k < blocksize; ++k)
-                temp += ptrA[k] * ptrB[k];  // buffer_A[i*blocksize + k] * buffer_B[k + j*blocksize];
-
-              buffer_C[i*blocksize + j] += temp;
-            }
-          }
-        }
-
-        // write result:
-        if (beta > 0 || beta < 0)
-        {
-          for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
-            for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
-              C(i,j) = beta * C(i,j) + alpha * buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
-        }
-        else
-        {
-          for (vcl_size_t i = offset_i; i < std::min(offset_i + blocksize, C_size1); ++i)
-            for (vcl_size_t j = offset_j; j < std::min(offset_j + blocksize, C_size2); ++j)
-              C(i,j) =                 alpha * buffer_C[(i - offset_i) * blocksize + (j - offset_j)];
-        }
-
-      } // for block j
-    } // for block i
-
-  } // prod()
-
-} // namespace detail
 
 /** @brief Carries out matrix-matrix multiplication
 *
@@ -1398,7 +1306,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1406,7 +1314,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1414,7 +1322,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && !C.row_major())
     {
@@ -1422,7 +1330,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && C.row_major())
     {
@@ -1430,7 +1338,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1438,7 +1346,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1446,7 +1354,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else
     {
@@ -1454,7 +1362,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
   }
   else if (!trans_A && trans_B)
@@ -1465,7 +1373,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1473,7 +1381,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1481,7 +1389,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && !C.row_major())
     {
@@ -1489,7 +1397,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && C.row_major())
     {
@@ -1497,7 +1405,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1505,7 +1413,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1513,7 +1421,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else
     {
@@ -1521,7 +1429,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size2, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
   }
   else if (trans_A && !trans_B)
@@ -1532,7 +1440,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1540,7 +1448,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1548,7 +1456,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && !C.row_major())
     {
@@ -1556,7 +1464,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && C.row_major())
     {
@@ -1564,7 +1472,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1572,7 +1480,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1580,7 +1488,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else
     {
@@ -1588,7 +1496,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
   }
   else if (trans_A && trans_B)
@@ -1599,7 +1507,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1607,7 +1515,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const,    row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1615,7 +1523,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,          row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (A.row_major() && !B.row_major() && !C.row_major())
     {
@@ -1623,7 +1531,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && C.row_major())
     {
@@ -1631,7 +1539,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const,    row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,          row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && B.row_major() && !C.row_major())
     {
@@ -1639,7 +1547,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const,    row_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else if (!A.row_major() && !B.row_major() && C.row_major())
     {
@@ -1647,7 +1555,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,          row_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
     else
     {
@@ -1655,7 +1563,7 @@ void prod_impl(const matrix_base<NumericT> & A, bool trans_A,
       detail::matrix_array_wrapper<value_type const, column_major, true>    wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
       detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
-      detail::prod(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
+      detail::gemm(wrapper_A, wrapper_B, wrapper_C, C_size1, C_size2, A_size1, static_cast<value_type>(alpha), static_cast<value_type>(beta));
     }
   }
 }
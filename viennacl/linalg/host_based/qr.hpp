@@ -0,0 +1,961 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_QR_HPP_
+#define VIENNACL_LINALG_HOST_BASED_QR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/qr.hpp
+    @brief Blocked Householder QR factorization with compact WY representation for the host backend.
+
+    The product of the Householder reflectors of a panel is written as H_1 ... H_nb = I - Y T Y^T with the unit lower trapezoidal matrix Y of reflectors
+    and an upper triangular nb x nb matrix T. The panel is factored recursively (left half, update, right half), which yields T along the way.
+    The trailing matrix is updated as C - Y T^T (Y^T C) using the packed-panel GEMM from gemm.hpp. The same blocks are used for recovering Q and for applying Q^T.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/gemm.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Number of reflectors per block when recovering Q or applying Q^T. Any block size gives the same reflectors, hence it need not match the one used for the factorization. */
+#ifndef VIENNACL_QR_BLOCK_SIZE
+  #define VIENNACL_QR_BLOCK_SIZE  32
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Lightweight view on a dense matrix. Hands out accessors for submatrices starting at a given position. */
+template<typename NumericT, typename LayoutT>
+class qr_matrix_view
+{
+public:
+  typedef matrix_array_wrapper<NumericT, LayoutT, false>   accessor_type;
+  typedef matrix_array_wrapper<NumericT, LayoutT, true>    transposed_accessor_type;
+
+  template<typename MatrixT>
+  explicit qr_matrix_view(MatrixT & A)
+    : data_(extract_raw_pointer<NumericT>(A)),
+      start1_(viennacl::traits::start1(A)), start2_(viennacl::traits::start2(A)),
+      inc1_(viennacl::traits::stride1(A)),  inc2_(viennacl::traits::stride2(A)),
+      internal_size1_(viennacl::traits::internal_size1(A)), internal_size2_(viennacl::traits::internal_size2(A)) {}
+
+  /** @brief View on a dense buffer with the given internal sizes */
+  qr_matrix_view(NumericT * data, vcl_size_t internal_size1, vcl_size_t internal_size2)
+    : data_(data), start1_(0), start2_(0), inc1_(1), inc2_(1), internal_size1_(internal_size1), internal_size2_(internal_size2) {}
+
+  /** @brief View on the rows row, row+1, ... of the matrix */
+  qr_matrix_view rows_from(vcl_size_t row) const
+  {
+    qr_matrix_view result(*this);
+    result.start1_ += row * inc1_;
+    return result;
+  }
+
+  /** @brief Pointer to the (0,0)-entry for column-major storage with unit strides. Column j starts at offset j * leading_dimension(). */
+  NumericT * column_major_data() const { return data_ + start1_ + start2_ * internal_size1_; }
+  vcl_size_t leading_dimension() const { return internal_size1_; }
+
+  /** @brief Accessor for the submatrix whose (0,0)-entry is the entry (row, col) of the full matrix. */
+  accessor_type block(vcl_size_t row, vcl_size_t col) const
+  {
+    return accessor_type(data_, start1_ + row * inc1_, start2_ + col * inc2_, inc1_, inc2_, internal_size1_, internal_size2_);
+  }
+
+  /** @brief Accessor for the transpose of the submatrix whose (0,0)-entry is the entry (row, col) of the full matrix. */
+  transposed_accessor_type transposed_block(vcl_size_t row, vcl_size_t col) const
+  {
+    return transposed_accessor_type(data_, start1_ + row * inc1_, start2_ + col * inc2_, inc1_, inc2_, internal_size1_, internal_size2_);
+  }
+
+private:
+  NumericT * data_;
+  vcl_size_t start1_, start2_;
+  vcl_size_t inc1_, inc2_;
+  vcl_size_t internal_size1_, internal_size2_;
+};
+
+/** @brief Entry (i, k) of the unit lower trapezoidal matrix Y, whose k-th column is the Householder vector stored below the diagonal in column col+k of A. */
+template<typename MatrixAccT>
+typename MatrixAccT::value_type qr_reflector_entry(MatrixAccT & A, vcl_size_t i, vcl_size_t col, vcl_size_t k)
+{
+  typedef typename MatrixAccT::value_type   NumericT;
+
+  if (i < col + k)
+    return NumericT(0);
+  if (i == col + k)
+    return NumericT(1);
+  return A(i, col + k);
+}
+
+/** @brief Returns the sum of y(i) x(i) over the rows [r0, r1), where y is a Householder vector with implicit unit entry in row y_diag and zeros above.
+*
+* If x_is_reflector is true, x is a Householder vector with unit entry in row x_diag as well. Otherwise, x is a plain column.
+*/
+template<typename NumericT>
+NumericT qr_reflector_dot(NumericT const * y, vcl_size_t y_diag, NumericT const * x, bool x_is_reflector, vcl_size_t x_diag,
+                          vcl_size_t r0, vcl_size_t r1)
+{
+  vcl_size_t first = x_is_reflector ? std::max(y_diag, x_diag) : y_diag; // first row in which both entries may be nonzero
+  if (first >= r1)
+    return 0;
+
+  NumericT sum = 0;
+  vcl_size_t i = r0;
+  if (first >= r0)
+  {
+    NumericT y_first = (first == y_diag)                   ? NumericT(1) : y[first];
+    NumericT x_first = (x_is_reflector && first == x_diag) ? NumericT(1) : x[first];
+    sum = y_first * x_first;
+    i = first + 1;
+  }
+
+  NumericT sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+  for (; i + 3 < r1; i += 4)
+  {
+    sum0 += y[i]     * x[i];
+    sum1 += y[i + 1] * x[i + 1];
+    sum2 += y[i + 2] * x[i + 2];
+    sum3 += y[i + 3] * x[i + 3];
+  }
+  for (; i < r1; ++i)
+    sum0 += y[i] * x[i];
+
+  return sum + (sum0 + sum1) + (sum2 + sum3);
+}
+
+/** @brief Computes x(i) -= alpha y(i) over the rows [r0, r1) for a Householder vector y with implicit unit entry in row y_diag and zeros above. */
+template<typename NumericT>
+void qr_reflector_axpy(NumericT alpha, NumericT const * y, vcl_size_t y_diag, NumericT * x, vcl_size_t r0, vcl_size_t r1)
+{
+  if (y_diag >= r1 || alpha == NumericT(0))
+    return;
+
+  vcl_size_t i = r0;
+  if (y_diag >= r0)
+  {
+    x[y_diag] -= alpha;
+    i = y_diag + 1;
+  }
+  for (; i < r1; ++i)
+    x[i] -= alpha * y[i];
+}
+
+/** @brief Computes W += Y^T X over the rows [r0, r1) for the dense column-major blocks Y and X with leading dimension ld. W is row-major with x_width columns.
+*
+* Pairs of columns of Y and X are processed together, so that each loaded entry is used twice.
+*/
+template<typename NumericT>
+void qr_dense_products(NumericT const * Y, NumericT const * X, vcl_size_t ld, vcl_size_t y_width, vcl_size_t x_width,
+                       vcl_size_t r0, vcl_size_t r1, NumericT * W)
+{
+  if (r0 >= r1)
+    return;
+
+  vcl_size_t k = 0;
+  for (; k + 1 < y_width; k += 2)
+  {
+    NumericT const * y0 = Y + k * ld;
+    NumericT const * y1 = y0 + ld;
+    vcl_size_t l = 0;
+    for (; l + 1 < x_width; l += 2)
+    {
+      NumericT const * x0 = X + l * ld;
+      NumericT const * x1 = x0 + ld;
+      NumericT s00 = 0, s01 = 0, s10 = 0, s11 = 0;
+      for (vcl_size_t i = r0; i < r1; ++i)
+      {
+        s00 += y0[i] * x0[i];
+        s01 += y0[i] * x1[i];
+        s10 += y1[i] * x0[i];
+        s11 += y1[i] * x1[i];
+      }
+      W[k * x_width + l]           += s00;
+      W[k * x_width + l + 1]       += s01;
+      W[(k + 1) * x_width + l]     += s10;
+      W[(k + 1) * x_width + l + 1] += s11;
+    }
+    if (l < x_width)
+    {
+      NumericT const * x0 = X + l * ld;
+      NumericT s00 = 0, s10 = 0;
+      for (vcl_size_t i = r0; i < r1; ++i)
+      {
+        s00 += y0[i] * x0[i];
+        s10 += y1[i] * x0[i];
+      }
+      W[k * x_width + l]       += s00;
+      W[(k + 1) * x_width + l] += s10;
+    }
+  }
+  if (k < y_width)
+  {
+    NumericT const * y0 = Y + k * ld;
+    for (vcl_size_t l = 0; l < x_width; ++l)
+    {
+      NumericT const * x0 = X + l * ld;
+      NumericT s00 = 0;
+      for (vcl_size_t i = r0; i < r1; ++i)
+        s00 += y0[i] * x0[i];
+      W[k * x_width + l] += s00;
+    }
+  }
+}
+
+/** @brief Computes W = Y^T X over the rows [y_col, m) of the column-major matrix P with leading dimension ld, where Y holds the reflectors in the columns [y_col, y_col + y_width).
+*
+* X is either the block of P in the columns [x_col, x_col + x_width), or the reflectors stored in these columns if x_is_reflector is true.
+* W is stored row-major with x_width columns. The rows are processed in chunks, so that each chunk is read from memory only once.
+*/
+template<typename NumericT>
+void qr_reflector_products(NumericT const * P, vcl_size_t ld, vcl_size_t m,
+                           vcl_size_t y_col, vcl_size_t y_width,
+                           vcl_size_t x_col, vcl_size_t x_width, bool x_is_reflector,
+                           NumericT * W)
+{
+  std::fill(W, W + y_width * x_width, NumericT(0));
+  if (y_col >= m)
+    return;
+
+  // below this row, all entries of Y and X are stored explicitly:
+  vcl_size_t dense_begin = std::max(y_col + y_width, x_is_reflector ? x_col + x_width : vcl_size_t(0));
+
+  vcl_size_t const chunk_size = 1024;
+  long num_chunks = static_cast<long>((m - y_col - 1) / chunk_size + 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if ((m - y_col) * y_width * x_width > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+  {
+    std::vector<NumericT> W_local(y_width * x_width);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      vcl_size_t r0 = y_col + static_cast<vcl_size_t>(chunk) * chunk_size;
+      vcl_size_t r1 = std::min(r0 + chunk_size, m);
+      vcl_size_t r_dense = std::min(std::max(r0, dense_begin), r1);
+      if (r0 < r_dense)
+        for (vcl_size_t k = 0; k < y_width; ++k)
+          for (vcl_size_t l = 0; l < x_width; ++l)
+            W_local[k * x_width + l] += qr_reflector_dot(P + (y_col + k) * ld, y_col + k, P + (x_col + l) * ld, x_is_reflector, x_col + l, r0, r_dense);
+      qr_dense_products(P + y_col * ld, P + x_col * ld, ld, y_width, x_width, r_dense, r1, &(W_local[0]));
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp critical
+#endif
+    for (vcl_size_t kl = 0; kl < y_width * x_width; ++kl)
+      W[kl] += W_local[kl];
+  }
+}
+
+/** @brief Computes W_out = T^T W (if transposed) or W_out = T W for the upper triangular matrix T with leading dimension ldt. W and W_out are row-major with 'cols' columns. */
+template<typename NumericT>
+void qr_triangular_product(NumericT const * T, vcl_size_t ldt, vcl_size_t width, bool transposed,
+                           NumericT const * W, vcl_size_t cols, NumericT * W_out)
+{
+  std::fill(W_out, W_out + width * cols, NumericT(0));
+  for (vcl_size_t k = 0; k < width; ++k)
+  {
+    vcl_size_t i_begin = transposed ? 0     : k;
+    vcl_size_t i_end   = transposed ? k + 1 : width;
+    for (vcl_size_t i = i_begin; i < i_end; ++i)
+    {
+      NumericT t = transposed ? T[i * ldt + k] : T[k * ldt + i];
+      if (t != NumericT(0))
+        for (vcl_size_t l = 0; l < cols; ++l)
+          W_out[k * cols + l] += t * W[i * cols + l];
+    }
+  }
+}
+
+/** @brief Forms the upper triangular factor T of the compact WY representation from G = Y^T Y and the scalars beta of the reflectors. */
+template<typename NumericT>
+void qr_form_T(NumericT const * G, NumericT const * betas, vcl_size_t width, NumericT * T, vcl_size_t ldt)
+{
+  for (vcl_size_t k = 0; k < width; ++k)
+  {
+    // T(0:k, k) = -beta_k T(0:k, 0:k) Y(:, 0:k)^T y_k
+    for (vcl_size_t i = 0; i < k; ++i)
+    {
+      NumericT sum = 0;
+      for (vcl_size_t l = i; l < k; ++l)
+        sum += T[i * ldt + l] * G[l * width + k];
+      T[i * ldt + k] = -betas[k] * sum;
+    }
+    for (vcl_size_t i = k + 1; i < width; ++i)
+      T[i * ldt + k] = 0;
+    T[k * ldt + k] = betas[k];
+  }
+}
+
+/** @brief Computes the Householder reflector for column c of the column-major matrix P as in detail::setup_householder_vector_ublas() and applies it to that column.
+*
+* The Householder vector (with implicit unit entry) is stored below the diagonal, the diagonal entry becomes the diagonal entry of R.
+*/
+template<typename NumericT>
+NumericT qr_householder_column(NumericT * P, vcl_size_t ld, vcl_size_t m, vcl_size_t c)
+{
+  NumericT * a = P + c * ld;
+
+  NumericT sigma = 0;
+  long row_begin = static_cast<long>(c + 1);
+  long row_end   = static_cast<long>(m);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: sigma) if (m - c > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = row_begin; i < row_end; ++i)
+    sigma += a[i] * a[i];
+
+  if (sigma <= 0)
+    return 0;
+
+  NumericT a_cc = a[c];
+  NumericT mu = std::sqrt(sigma + a_cc * a_cc);
+  NumericT v1 = (a_cc <= 0) ? (a_cc - mu) : (-sigma / (a_cc + mu));
+  NumericT beta = NumericT(2) * v1 * v1 / (sigma + v1 * v1);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (m - c > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i = row_begin; i < row_end; ++i)
+    a[i] /= v1;
+
+  // (I - beta v v^T) applied to the column itself, where v^T a = a_cc + sigma / v1:
+  a[c] = a_cc - beta * (a_cc + sigma / v1);
+  return beta;
+}
+
+/** @brief Applies (I - Y T Y^T)^T to the columns [c_begin, c_end) of the column-major matrix P in the rows [y_col, m), where Y holds the reflectors in the columns [y_col, y_col + y_width).
+*
+* Used within panels, where the number of columns is small. The trailing matrix is updated by qr_apply_block_gemm().
+*/
+template<typename NumericT>
+void qr_apply_block_panel(NumericT * P, vcl_size_t ld, vcl_size_t m,
+                          vcl_size_t y_col, vcl_size_t y_width, NumericT const * T, vcl_size_t ldt,
+                          vcl_size_t c_begin, vcl_size_t c_end)
+{
+  vcl_size_t cols = c_end - c_begin;
+  std::vector<NumericT> W(y_width * cols), W2(y_width * cols);
+
+  qr_reflector_products(P, ld, m, y_col, y_width, c_begin, cols, false, &(W[0]));
+  qr_triangular_product(T, ldt, y_width, true, &(W[0]), cols, &(W2[0]));
+
+  // C -= Y W2:
+  vcl_size_t const chunk_size = 1024;
+  long num_chunks = static_cast<long>((m - y_col - 1) / chunk_size + 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((m - y_col) * y_width * cols > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+  for (long chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    vcl_size_t r0 = y_col + static_cast<vcl_size_t>(chunk) * chunk_size;
+    vcl_size_t r1 = std::min(r0 + chunk_size, m);
+    vcl_size_t r_dense = std::min(std::max(r0, y_col + y_width), r1);
+    for (vcl_size_t l = 0; l < cols; ++l)
+    {
+      NumericT * c = P + (c_begin + l) * ld;
+      for (vcl_size_t k = 0; k < y_width; ++k)
+        qr_reflector_axpy(W2[k * cols + l], P + (y_col + k) * ld, y_col + k, c, r0, r_dense);
+
+      // four reflectors at a time below the diagonal block:
+      vcl_size_t k = 0;
+      for (; k + 3 < y_width; k += 4)
+      {
+        NumericT const * y0 = P + (y_col + k) * ld;
+        NumericT const * y1 = y0 + ld;
+        NumericT const * y2 = y1 + ld;
+        NumericT const * y3 = y2 + ld;
+        NumericT a0 = W2[k * cols + l],       a1 = W2[(k + 1) * cols + l];
+        NumericT a2 = W2[(k + 2) * cols + l], a3 = W2[(k + 3) * cols + l];
+        for (vcl_size_t i = r_dense; i < r1; ++i)
+          c[i] -= (a0 * y0[i] + a1 * y1[i]) + (a2 * y2[i] + a3 * y3[i]);
+      }
+      for (; k < y_width; ++k)
+        qr_reflector_axpy(W2[k * cols + l], P + (y_col + k) * ld, y_col + k, c, r_dense, r1);
+    }
+  }
+}
+
+/** @brief Recursive factorization of the panel P(c0:m, c0:c0+width) of a column-major matrix, computing the upper triangular factor T (leading dimension ldt) of its compact WY representation.
+*
+* The panel is split into a left and a right half with factors T_1 and T_2. After factoring the left half, its reflectors are applied to the right half before it is factored itself.
+* The off-diagonal block of T is then given by -T_1 (Y_1^T Y_2) T_2.
+*/
+template<typename NumericT>
+void qr_panel_recursive(NumericT * P, vcl_size_t ld, vcl_size_t m, vcl_size_t c0, vcl_size_t width,
+                        NumericT * betas, NumericT * T, vcl_size_t ldt)
+{
+  if (width == 1)
+  {
+    betas[c0] = qr_householder_column(P, ld, m, c0);
+    T[0] = betas[c0];
+    return;
+  }
+
+  vcl_size_t n1 = width / 2;
+  vcl_size_t n2 = width - n1;
+  vcl_size_t c1 = c0 + n1;
+  NumericT * T11 = T;
+  NumericT * T12 = T + n1;
+  NumericT * T22 = T + n1 * ldt + n1;
+
+  qr_panel_recursive(P, ld, m, c0, n1, betas, T11, ldt);
+  qr_apply_block_panel(P, ld, m, c0, n1, T11, ldt, c1, c0 + width);
+  qr_panel_recursive(P, ld, m, c1, n2, betas, T22, ldt);
+
+  // T12 = -T11 (Y1^T Y2) T22:
+  std::vector<NumericT> YY(n1 * n2), TYY(n1 * n2);
+  qr_reflector_products(P, ld, m, c0, n1, c1, n2, true, &(YY[0]));
+  qr_triangular_product(T11, ldt, n1, false, &(YY[0]), n2, &(TYY[0]));
+  for (vcl_size_t k = 0; k < n1; ++k)
+    for (vcl_size_t l = 0; l < n2; ++l)
+    {
+      NumericT sum = 0;
+      for (vcl_size_t i = 0; i <= l; ++i)
+        sum += TYY[k * n2 + i] * T22[i * ldt + l];
+      T12[k * ldt + l] = -sum;
+    }
+  for (vcl_size_t k = 0; k < n2; ++k)
+    for (vcl_size_t l = 0; l < n1; ++l)
+      T[(n1 + k) * ldt + l] = 0;
+}
+
+/** @brief Computes C <- (I - Y T Y^T)^T C (if transposed) or C <- (I - Y T Y^T) C with two matrix-matrix products.
+*
+* @param Y         Accessor for the explicit (rows x width) unit lower trapezoidal matrix of reflectors
+* @param Y_trans   Accessor for the transpose of Y
+* @param C         Accessor for the (rows x cols) matrix to be updated
+*/
+template<typename YAccT, typename YTransAccT, typename CAccT, typename NumericT>
+void qr_apply_block_gemm(YAccT & Y, YTransAccT & Y_trans, CAccT & C,
+                         vcl_size_t rows, vcl_size_t cols, vcl_size_t width,
+                         NumericT const * T, vcl_size_t ldt, bool transposed)
+{
+  if (rows == 0 || cols == 0 || width == 0)
+    return;
+
+  std::vector<NumericT> W(width * cols), W2(width * cols);
+  matrix_array_wrapper<NumericT, viennacl::row_major, false> W_acc(&(W[0]), 0, 0, 1, 1, width, cols);
+  matrix_array_wrapper<NumericT, viennacl::row_major, false> W2_acc(&(W2[0]), 0, 0, 1, 1, width, cols);
+
+  gemm(Y_trans, C, W_acc, width, cols, rows, NumericT(1), NumericT(0));
+  qr_triangular_product(T, ldt, width, transposed, &(W[0]), cols, &(W2[0]));
+  gemm(Y, W2_acc, C, rows, cols, width, NumericT(-1), NumericT(1));
+}
+
+/** @brief Copies the panel A(col:m, col:col+width) to the column-major buffer 'panel' with leading dimension m - col (if to_panel is true) or back to A.
+*
+* If explicit_reflectors is true, the part of the panel on and above the diagonal is replaced by the unit diagonal and zeros in the buffer.
+*/
+template<typename NumericT, typename LayoutT>
+void qr_copy_panel(qr_matrix_view<NumericT, LayoutT> const & M, NumericT * panel,
+                   vcl_size_t m, vcl_size_t col, vcl_size_t width, bool to_panel, bool explicit_reflectors = false)
+{
+  vcl_size_t ld = m - col;
+  long num_rows = static_cast<long>(ld);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (ld * width > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+  for (long row = 0; row < num_rows; ++row)
+  {
+    typename qr_matrix_view<NumericT, LayoutT>::accessor_type A = M.block(col, col);
+    vcl_size_t i = static_cast<vcl_size_t>(row);
+    for (vcl_size_t k = 0; k < width; ++k)
+    {
+      if (!to_panel)
+        A(i, k) = panel[k * ld + i];
+      else if (explicit_reflectors)
+        panel[k * ld + i] = qr_reflector_entry(A, i, 0, k);
+      else
+        panel[k * ld + i] = A(i, k);
+    }
+  }
+}
+
+/** @brief Recomputes the factor T of the compact WY representation of the reflectors in the columns [col, col + width) of the column-major matrix P. */
+template<typename NumericT>
+void qr_block_T(NumericT const * P, vcl_size_t ld, vcl_size_t m, vcl_size_t col, vcl_size_t width,
+                NumericT const * betas, std::vector<NumericT> & T)
+{
+  std::vector<NumericT> G(width * width);
+  T.resize(width * width);
+  qr_reflector_products(P, ld, m, col, width, col, width, true, &(G[0]));
+  qr_form_T(&(G[0]), betas + col, width, &(T[0]), width);
+}
+
+/** @brief Blocked Householder QR factorization of the first m rows of the matrix viewed by M with n columns. See inplace_qr() for the storage of the result.
+*
+* Panels of row-major matrices are factored in a column-major copy.
+*/
+template<typename NumericT, typename LayoutT>
+void qr_factor(qr_matrix_view<NumericT, LayoutT> const & M, vcl_size_t m, vcl_size_t n, NumericT * betas, vcl_size_t block_size)
+{
+  vcl_size_t k_max = std::min(m, n);
+  vcl_size_t nb = std::max<vcl_size_t>(std::min(block_size, k_max), 1);
+  bool row_major = viennacl::is_row_major<LayoutT>::value;
+
+  std::fill(betas, betas + n, NumericT(0));
+  if (k_max == 0)
+    return;
+
+  std::vector<NumericT> T(nb * nb), saved_triangle(nb * nb);
+  std::vector<NumericT> panel(row_major ? m * nb : 0);
+
+  for (vcl_size_t j = 0; j < k_max; j += nb)
+  {
+    vcl_size_t width = std::min(nb, k_max - j);
+
+    if (row_major)
+    {
+      qr_copy_panel(M, &(panel[0]), m, j, width, true);
+      qr_panel_recursive(&(panel[0]), m - j, m - j, vcl_size_t(0), width, betas + j, &(T[0]), nb);
+      qr_copy_panel(M, &(panel[0]), m, j, width, false);
+    }
+    else
+      qr_panel_recursive(M.column_major_data(), M.leading_dimension(), m, j, width, betas, &(T[0]), nb);
+
+    if (j + width >= n)
+      continue;
+
+    // the matrix-matrix products operate directly on the reflectors in A. Hence, the diagonal and the part of R above are temporarily replaced by ones and zeros:
+    typename qr_matrix_view<NumericT, LayoutT>::accessor_type            Y       = M.block(j, j);
+    typename qr_matrix_view<NumericT, LayoutT>::transposed_accessor_type Y_trans = M.transposed_block(j, j);
+    typename qr_matrix_view<NumericT, LayoutT>::accessor_type            C       = M.block(j, j + width);
+
+    for (vcl_size_t i = 0; i < width; ++i)
+      for (vcl_size_t k = i; k < width; ++k)
+      {
+        saved_triangle[i * nb + k] = Y(i, k);
+        Y(i, k) = (i == k) ? NumericT(1) : NumericT(0);
+      }
+
+    qr_apply_block_gemm(Y, Y_trans, C, m - j, n - j - width, width, &(T[0]), nb, true);
+
+    for (vcl_size_t i = 0; i < width; ++i)
+      for (vcl_size_t k = i; k < width; ++k)
+        Y(i, k) = saved_triangle[i * nb + k];
+  }
+}
+
+/** @brief Computes C <- Q C for the first m rows of C, where Q is given by the k_max reflectors stored in the first m rows of the matrix viewed by M.
+*
+* The blocks of reflectors are applied in reverse order. If C is known to hold the identity matrix initially, the block starting at column j only needs to act on the columns j, j+1, ... (skip_leading_columns).
+*/
+template<typename NumericT, typename LayoutT, typename LayoutCT>
+void qr_apply_Q(qr_matrix_view<NumericT, LayoutT> const & M, vcl_size_t m, vcl_size_t k_max, NumericT const * betas, vcl_size_t block_size,
+                qr_matrix_view<NumericT, LayoutCT> const & M_C, vcl_size_t cols, bool skip_leading_columns)
+{
+  vcl_size_t nb = std::max<vcl_size_t>(block_size, 1);
+  if (k_max == 0)
+    return;
+
+  std::vector<NumericT> Y, T;
+  for (vcl_size_t j = ((k_max - 1) / nb) * nb; ; j -= nb)
+  {
+    vcl_size_t width = std::min(nb, k_max - j);
+    vcl_size_t col_begin = skip_leading_columns ? j : 0;
+    if (col_begin < cols)
+    {
+      Y.resize((m - j) * width);
+      qr_copy_panel(M, &(Y[0]), m, j, width, true, true);
+      qr_block_T(&(Y[0]), m - j, m - j, vcl_size_t(0), width, betas + j, T);
+
+      matrix_array_wrapper<NumericT, viennacl::column_major, false> Y_acc(&(Y[0]), 0, 0, 1, 1, m - j, width);
+      matrix_array_wrapper<NumericT, viennacl::column_major, true>  Y_trans(&(Y[0]), 0, 0, 1, 1, m - j, width);
+      typename qr_matrix_view<NumericT, LayoutCT>::accessor_type C = M_C.block(j, col_begin);
+      qr_apply_block_gemm(Y_acc, Y_trans, C, m - j, cols - col_begin, width, &(T[0]), width, false);
+    }
+
+    if (j == 0)
+      break;
+  }
+}
+
+/** @brief Computes Q^T b for the first m entries of b (with stride b_stride), where Q is given by the k_max reflectors stored in the first m rows of the matrix viewed by M.
+*
+* The reflectors are copied block-wise to a contiguous buffer together with the corresponding part of b and then applied one after another.
+* For a single vector, this is cheaper than forming the factor T of each block.
+*/
+template<typename NumericT, typename LayoutT>
+void qr_apply_trans_Q(qr_matrix_view<NumericT, LayoutT> const & M, vcl_size_t m, vcl_size_t k_max, NumericT const * betas, vcl_size_t block_size,
+                      NumericT * b, vcl_size_t b_stride)
+{
+  vcl_size_t nb = std::max<vcl_size_t>(block_size, 1);
+
+  std::vector<NumericT> Y;
+  for (vcl_size_t j = 0; j < k_max; j += nb)
+  {
+    vcl_size_t width = std::min(nb, k_max - j);
+    vcl_size_t rows  = m - j;
+
+    // reflectors of the block, followed by the corresponding part of b as last column:
+    Y.resize(rows * (width + 1));
+    qr_copy_panel(M, &(Y[0]), m, j, width, true);
+    NumericT * b_part = &(Y[0]) + width * rows;
+    for (vcl_size_t i = 0; i < rows; ++i)
+      b_part[i] = b[(j + i) * b_stride];
+
+    for (vcl_size_t k = 0; k < width; ++k)
+    {
+      if (betas[j + k] <= 0 && betas[j + k] >= 0)
+        continue;
+
+      NumericT v_in_b = 0;
+      qr_reflector_products(&(Y[0]), rows, rows, k, vcl_size_t(1), width, vcl_size_t(1), false, &v_in_b);
+      NumericT alpha = betas[j + k] * v_in_b;
+
+      vcl_size_t const chunk_size = 4096;
+      long num_chunks = static_cast<long>((rows - k - 1) / chunk_size + 1);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (rows - k > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        vcl_size_t r0 = k + static_cast<vcl_size_t>(chunk) * chunk_size;
+        qr_reflector_axpy(alpha, &(Y[0]) + k * rows, k, b_part, r0, std::min(r0 + chunk_size, rows));
+      }
+    }
+
+    for (vcl_size_t i = 0; i < rows; ++i)
+      b[(j + i) * b_stride] = b_part[i];
+  }
+}
+
+/** @brief Copies the upper triangular n x n matrix starting at entry (row, 0) of the matrix viewed by M to (to_row, 0) of the matrix viewed by M_to. Entries below the diagonal are set to zero only if zero_lower is true. */
+template<typename NumericT, typename LayoutT, typename LayoutToT>
+void qr_copy_upper_triangle(qr_matrix_view<NumericT, LayoutT> const & M, vcl_size_t row,
+                            qr_matrix_view<NumericT, LayoutToT> const & M_to, vcl_size_t to_row, vcl_size_t n, bool zero_lower)
+{
+  typename qr_matrix_view<NumericT, LayoutT>::accessor_type   A  = M.block(row, 0);
+  typename qr_matrix_view<NumericT, LayoutToT>::accessor_type To = M_to.block(to_row, 0);
+  for (vcl_size_t i = 0; i < n; ++i)
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      if (j >= i)
+        To(i, j) = A(i, j);
+      else if (zero_lower)
+        To(i, j) = 0;
+    }
+}
+
+} //namespace detail
+
+
+/** @brief In-place blocked Householder QR factorization of a dense matrix on the host.
+*
+* On return, R is stored in the upper triangular part of A and the Householder vectors (with implicit unit diagonal) below the diagonal.
+* The reflectors are the same as for viennacl::linalg::inplace_qr() on other backends, i.e. Q = (I - beta_0 v_0 v_0^T) ... (I - beta_k v_k v_k^T).
+*
+* @param A            The matrix to be factored
+* @param betas        The scalars beta_i of the reflectors. Resized to A.size2().
+* @param block_size   Number of columns per panel
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void inplace_qr(matrix<NumericT, F, AlignmentV> & A, std::vector<NumericT> & betas, vcl_size_t block_size)
+{
+  betas.resize(A.size2());
+  if (A.size2() > 0)
+    detail::qr_factor(detail::qr_matrix_view<NumericT, F>(A), A.size1(), A.size2(), &(betas[0]), block_size);
+}
+
+/** @brief Generates Q and R explicitly from the in-place QR factorization computed by inplace_qr(). Q is obtained by applying the blocks of reflectors to the identity matrix in reverse order.
+*
+* Q is resized to A.size1() x A.size1() and R to A.size1() x A.size2() if necessary. Throws if there are fewer betas than reflectors.
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void recoverQ(matrix<NumericT, F, AlignmentV> const & A, std::vector<NumericT> const & betas,
+              matrix<NumericT, F, AlignmentV> & Q, matrix<NumericT, F, AlignmentV> & R, vcl_size_t block_size)
+{
+  vcl_size_t m = A.size1();
+  vcl_size_t n = A.size2();
+  vcl_size_t num_reflectors = std::min(m, n);
+  if (betas.size() < num_reflectors)
+    throw std::runtime_error("ViennaCL: Size mismatch of matrix and betas in recoverQ()!");
+  if (m == 0)
+    return;
+  if (Q.size1() != m || Q.size2() != m)
+    Q.resize(m, m, false);
+  if (n > 0 && (R.size1() != m || R.size2() != n))
+    R.resize(m, n, false);
+
+  detail::qr_matrix_view<NumericT, F> M(const_cast<matrix<NumericT, F, AlignmentV> &>(A));
+  detail::qr_matrix_view<NumericT, F> M_Q(Q);
+  detail::qr_matrix_view<NumericT, F> M_R(R);
+
+  // R from the upper triangular part of A:
+  typename detail::qr_matrix_view<NumericT, F>::accessor_type A_acc = M.block(0, 0);
+  typename detail::qr_matrix_view<NumericT, F>::accessor_type R_acc = M_R.block(0, 0);
+  for (vcl_size_t i = 0; i < m; ++i)
+    for (vcl_size_t j = 0; j < n; ++j)
+      R_acc(i, j) = (j >= i) ? A_acc(i, j) : NumericT(0);
+
+  // Q = identity:
+  typename detail::qr_matrix_view<NumericT, F>::accessor_type Q_acc = M_Q.block(0, 0);
+  for (vcl_size_t i = 0; i < m; ++i)
+    for (vcl_size_t j = 0; j < m; ++j)
+      Q_acc(i, j) = (i == j) ? NumericT(1) : NumericT(0);
+
+  if (num_reflectors == 0)
+    return;
+
+  // the block of reflectors starting at column j only acts on the rows and columns j, j+1, ... of the partial product:
+  detail::qr_apply_Q(M, m, num_reflectors, &(betas[0]), block_size, M_Q, m, true);
+}
+
+/** @brief Computes Q^T b for the implicit Q of the in-place QR factorization computed by inplace_qr(). Throws if the sizes of b or betas do not match A. */
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void inplace_qr_apply_trans_Q(matrix<NumericT, F, AlignmentV> const & A, std::vector<NumericT> const & betas,
+                              vector_base<NumericT> & b, vcl_size_t block_size)
+{
+  vcl_size_t num_reflectors = std::min(A.size1(), A.size2());
+  if (b.size() != A.size1() || betas.size() < num_reflectors)
+    throw std::runtime_error("ViennaCL: Size mismatch of matrix, betas, or vector in inplace_qr_apply_trans_Q()!");
+  if (num_reflectors == 0)
+    return;
+
+  detail::qr_apply_trans_Q(detail::qr_matrix_view<NumericT, F>(const_cast<matrix<NumericT, F, AlignmentV> &>(A)), A.size1(), num_reflectors, &(betas[0]), block_size,
+                           detail::extract_raw_pointer<NumericT>(b) + viennacl::traits::start(b), viennacl::traits::stride(b));
+}
+
+
+/** @brief Tall-skinny QR factorization (TSQR) of A on the host.
+*
+* The rows of A are split into blocks of at least A.size2() rows, which are factored independently by the threads.
+* The R factors of the blocks are then combined pairwise in a binary tree, where each node computes the QR factorization of two stacked triangular factors.
+* Q is kept implicitly: the reflectors of each block are stored in place of the block in A, the reflectors of the tree nodes in 'factors'.
+* On return, R is held in the upper triangular part of the first A.size2() rows of A.
+*
+* @param A            The matrix to be factored. Must not have more columns than rows.
+* @param factors      Output: The row blocks and the reflectors of the blocks and tree nodes
+* @param num_blocks   Number of row blocks. If zero, the number of threads is used.
+* @param block_size   Number of columns per panel in the factorizations of blocks and nodes
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void tsqr(matrix<NumericT, F, AlignmentV> & A, viennacl::linalg::tsqr_factors<NumericT> & factors, vcl_size_t num_blocks, vcl_size_t block_size)
+{
+  vcl_size_t m = A.size1();
+  vcl_size_t n = A.size2();
+  if (m < n)
+    throw std::runtime_error("ViennaCL: TSQR requires at least as many rows as columns!");
+
+  if (num_blocks == 0)
+  {
+    num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    num_blocks = static_cast<vcl_size_t>(omp_get_max_threads());
+#endif
+  }
+  num_blocks = (n == 0) ? 1 : std::max<vcl_size_t>(1, std::min(num_blocks, m / n));
+
+  factors.size1 = m;
+  factors.size2 = n;
+  factors.block_start.resize(num_blocks + 1);
+  for (vcl_size_t b = 0; b <= num_blocks; ++b)
+    factors.block_start[b] = b * m / num_blocks;
+  factors.block_betas.resize(num_blocks);
+  factors.node_upper.clear();
+  factors.node_lower.clear();
+  factors.node_reflectors.clear();
+  factors.node_betas.clear();
+
+  detail::qr_matrix_view<NumericT, F> M(A);
+
+  // leaves:
+  long leaves = static_cast<long>(num_blocks);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic) if (num_blocks > 1)
+#endif
+  for (long b = 0; b < leaves; ++b)
+  {
+    vcl_size_t row_begin = factors.block_start[static_cast<vcl_size_t>(b)];
+    vcl_size_t row_end   = factors.block_start[static_cast<vcl_size_t>(b) + 1];
+    std::vector<NumericT> & betas = factors.block_betas[static_cast<vcl_size_t>(b)];
+    betas.resize(std::max<vcl_size_t>(n, 1));
+    detail::qr_factor(M.rows_from(row_begin), row_end - row_begin, n, &(betas[0]), block_size);
+  }
+
+  // reduction tree: at each level, the R factor of block b + stride is eliminated against the R factor of block b:
+  for (vcl_size_t stride = 1; stride < num_blocks; stride *= 2)
+  {
+    vcl_size_t first_node = factors.node_upper.size();
+    for (vcl_size_t b = 0; b + stride < num_blocks; b += 2 * stride)
+    {
+      factors.node_upper.push_back(factors.block_start[b]);
+      factors.node_lower.push_back(factors.block_start[b + stride]);
+    }
+    factors.node_reflectors.resize(factors.node_upper.size());
+    factors.node_betas.resize(factors.node_upper.size());
+
+    long nodes = static_cast<long>(factors.node_upper.size() - first_node);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (nodes > 1)
+#endif
+    for (long k = 0; k < nodes; ++k)
+    {
+      vcl_size_t node = first_node + static_cast<vcl_size_t>(k);
+      std::vector<NumericT> & S = factors.node_reflectors[node];
+      std::vector<NumericT> & betas = factors.node_betas[node];
+      S.resize(2 * n * n);
+      betas.resize(n);
+
+      detail::qr_matrix_view<NumericT, viennacl::column_major> M_S(&(S[0]), 2 * n, n);
+      detail::qr_copy_upper_triangle(M, factors.node_upper[node], M_S, 0, n, true);
+      detail::qr_copy_upper_triangle(M, factors.node_lower[node], M_S, n, n, true);
+      detail::qr_factor(M_S, 2 * n, n, &(betas[0]), block_size);
+      detail::qr_copy_upper_triangle(M_S, 0, M, factors.node_upper[node], n, false);
+    }
+  }
+}
+
+/** @brief Computes Q^T b for the implicit Q of a TSQR factorization computed by tsqr(). The first A.size2() entries of b then hold the right hand side for R in a least squares problem. */
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void tsqr_apply_trans_Q(matrix<NumericT, F, AlignmentV> const & A, viennacl::linalg::tsqr_factors<NumericT> const & factors,
+                        vector_base<NumericT> & b, vcl_size_t block_size)
+{
+  vcl_size_t n = factors.size2;
+  if (A.size1() != factors.size1 || A.size2() != n || b.size() != factors.size1)
+    throw std::runtime_error("ViennaCL: Size mismatch of matrix, TSQR factors, or vector in tsqr_apply_trans_Q()!");
+
+  detail::qr_matrix_view<NumericT, F> M(const_cast<matrix<NumericT, F, AlignmentV> &>(A));
+  NumericT * b_data   = detail::extract_raw_pointer<NumericT>(b) + viennacl::traits::start(b);
+  vcl_size_t b_stride = viennacl::traits::stride(b);
+
+  long leaves = static_cast<long>(factors.block_betas.size());
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic) if (leaves > 1)
+#endif
+  for (long b = 0; b < leaves; ++b)
+  {
+    vcl_size_t row_begin = factors.block_start[static_cast<vcl_size_t>(b)];
+    vcl_size_t row_end   = factors.block_start[static_cast<vcl_size_t>(b) + 1];
+    detail::qr_apply_trans_Q(M.rows_from(row_begin), row_end - row_begin, n, &(factors.block_betas[static_cast<vcl_size_t>(b)][0]), block_size,
+                             b_data + row_begin * b_stride, b_stride);
+  }
+
+  std::vector<NumericT> v(2 * n);
+  for (vcl_size_t node = 0; node < factors.node_upper.size(); ++node)
+  {
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      v[i]     = b_data[(factors.node_upper[node] + i) * b_stride];
+      v[n + i] = b_data[(factors.node_lower[node] + i) * b_stride];
+    }
+    detail::qr_matrix_view<NumericT, viennacl::column_major> M_S(const_cast<NumericT *>(&(factors.node_reflectors[node][0])), 2 * n, n);
+    detail::qr_apply_trans_Q(M_S, 2 * n, n, &(factors.node_betas[node][0]), block_size, &(v[0]), vcl_size_t(1));
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      b_data[(factors.node_upper[node] + i) * b_stride] = v[i];
+      b_data[(factors.node_lower[node] + i) * b_stride] = v[n + i];
+    }
+  }
+}
+
+/** @brief Generates the A.size1() x A.size2() matrix Q with orthonormal columns and the triangular factor R from a TSQR factorization computed by tsqr().
+*
+* Q and R are resized if necessary.
+* The tree is traversed in reverse order starting from the first columns of the identity matrix, then the blocks apply their reflectors independently.
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void tsqr_recoverQ(matrix<NumericT, F, AlignmentV> const & A, viennacl::linalg::tsqr_factors<NumericT> const & factors,
+                   matrix<NumericT, F, AlignmentV> & Q, matrix<NumericT, F, AlignmentV> & R, vcl_size_t block_size)
+{
+  vcl_size_t m = factors.size1;
+  vcl_size_t n = factors.size2;
+  if (A.size1() != m || A.size2() != n)
+    throw std::runtime_error("ViennaCL: Size mismatch of matrix and TSQR factors in tsqr_recoverQ()!");
+  if (Q.size1() != m || Q.size2() != n)
+    Q.resize(m, n, false);
+  if (R.size1() != n || R.size2() != n)
+    R.resize(n, n, false);
+
+  detail::qr_matrix_view<NumericT, F> M(const_cast<matrix<NumericT, F, AlignmentV> &>(A));
+  detail::qr_matrix_view<NumericT, F> M_Q(Q);
+  detail::qr_matrix_view<NumericT, F> M_R(R);
+
+  detail::qr_copy_upper_triangle(M, 0, M_R, 0, n, true);
+
+  typename detail::qr_matrix_view<NumericT, F>::accessor_type Q_acc = M_Q.block(0, 0);
+  for (vcl_size_t i = 0; i < m; ++i)
+    for (vcl_size_t j = 0; j < n; ++j)
+      Q_acc(i, j) = (i == j) ? NumericT(1) : NumericT(0);
+
+  std::vector<NumericT> C(2 * n * n);
+  detail::qr_matrix_view<NumericT, viennacl::column_major> M_C(&(C[0]), 2 * n, n);
+  typename detail::qr_matrix_view<NumericT, viennacl::column_major>::accessor_type C_acc = M_C.block(0, 0);
+  for (vcl_size_t node = factors.node_upper.size(); node-- > 0; )
+  {
+    typename detail::qr_matrix_view<NumericT, F>::accessor_type Q_upper = M_Q.block(factors.node_upper[node], 0);
+    typename detail::qr_matrix_view<NumericT, F>::accessor_type Q_lower = M_Q.block(factors.node_lower[node], 0);
+    for (vcl_size_t i = 0; i < n; ++i)
+      for (vcl_size_t j = 0; j < n; ++j)
+      {
+        C_acc(i, j)     = Q_upper(i, j);
+        C_acc(n + i, j) = Q_lower(i, j);
+      }
+
+    detail::qr_matrix_view<NumericT, viennacl::column_major> M_S(const_cast<NumericT *>(&(factors.node_reflectors[node][0])), 2 * n, n);
+    detail::qr_apply_Q(M_S, 2 * n, n, &(factors.node_betas[node][0]), block_size, M_C, n, false);
+
+    for (vcl_size_t i = 0; i < n; ++i)
+      for (vcl_size_t j = 0; j < n; ++j)
+      {
+        Q_upper(i, j) = C_acc(i, j);
+        Q_lower(i, j) = C_acc(n + i, j);
+      }
+  }
+
+  long leaves = static_cast<long>(factors.block_betas.size());
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic) if (leaves > 1)
+#endif
+  for (long b = 0; b < leaves; ++b)
+  {
+    vcl_size_t row_begin = factors.block_start[static_cast<vcl_size_t>(b)];
+    vcl_size_t row_end   = factors.block_start[static_cast<vcl_size_t>(b) + 1];
+    detail::qr_apply_Q(M.rows_from(row_begin), row_end - row_begin, n, &(factors.block_betas[static_cast<vcl_size_t>(b)][0]), block_size,
+                       M_Q.rows_from(row_begin), n, false);
+  }
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
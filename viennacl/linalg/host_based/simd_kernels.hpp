@@ -0,0 +1,876 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_SIMD_KERNELS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_SIMD_KERNELS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/simd_kernels.hpp
+    @brief Hot loops of the host backend (BLAS level 1, CSR row products, SELL-C slices, GEMM micro-kernels) for several instruction sets, selected once at runtime.
+
+    All kernels operate on contiguous (unit-stride) data. The kernel table for a numeric type is set up on first use according to viennacl::tools::host_isa().
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/cpu_features.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum vector size for using OpenMP on vector operations:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+//
+// Generic kernels (plain C++, auto-vectorized by the compiler for the baseline instruction set)
+//
+
+template<typename NumericT>
+NumericT dot_generic(NumericT const * x, NumericT const * y, vcl_size_t n)
+{
+  NumericT t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+  vcl_size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    t0 += x[i]   * y[i];
+    t1 += x[i+1] * y[i+1];
+    t2 += x[i+2] * y[i+2];
+    t3 += x[i+3] * y[i+3];
+  }
+  for (; i < n; ++i)
+    t0 += x[i] * y[i];
+  return (t0 + t1) + (t2 + t3);
+}
+
+template<typename NumericT>
+void axpby_generic(NumericT * z, NumericT alpha, NumericT const * x, NumericT beta, NumericT const * y, vcl_size_t n, bool accumulate)
+{
+  if (accumulate)
+    for (vcl_size_t i = 0; i < n; ++i)
+      z[i] += alpha * x[i] + beta * y[i];
+  else
+    for (vcl_size_t i = 0; i < n; ++i)
+      z[i]  = alpha * x[i] + beta * y[i];
+}
+
+template<typename NumericT>
+NumericT csr_row_dot_generic(NumericT const * elements, unsigned int const * cols, NumericT const * x, vcl_size_t nnz)
+{
+  NumericT t0 = 0, t1 = 0;
+  vcl_size_t i = 0;
+  for (; i + 2 <= nnz; i += 2)
+  {
+    t0 += elements[i]   * x[cols[i]];
+    t1 += elements[i+1] * x[cols[i+1]];
+  }
+  if (i < nnz)
+    t0 += elements[i] * x[cols[i]];
+  return t0 + t1;
+}
+
+/** @brief Computes rows row_begin, ..., slice_height-1 of a SELL-C slice. Padding entries (zero values) are skipped. */
+template<typename NumericT>
+void sell_slice_rows_generic(NumericT const * elements, unsigned int const * cols, vcl_size_t num_columns, vcl_size_t slice_height,
+                             vcl_size_t row_begin, NumericT const * x, NumericT * result)
+{
+  for (vcl_size_t r = row_begin; r < slice_height; ++r)
+    result[r] = 0;
+
+  for (vcl_size_t j = 0; j < num_columns; ++j)
+  {
+    NumericT     const * elements_j = elements + j * slice_height;
+    unsigned int const * cols_j     = cols     + j * slice_height;
+    for (vcl_size_t r = row_begin; r < slice_height; ++r)
+    {
+      NumericT val = elements_j[r];
+      result[r] += (val > 0 || val < 0) ? val * x[cols_j[r]] : 0;
+    }
+  }
+}
+
+/** @brief SELL-C slice kernel: Computes result[r] = sum_j elements[j*C + r] * x[cols[j*C + r]] for the C = slice_height rows of a slice with num_columns column entries. */
+template<typename NumericT>
+void sell_slice_generic(NumericT const * elements, unsigned int const * cols, vcl_size_t num_columns, vcl_size_t slice_height, NumericT const * x, NumericT * result)
+{
+  sell_slice_rows_generic(elements, cols, num_columns, slice_height, 0, x, result);
+}
+
+/** @brief Register-blocked GEMM micro-kernel: Computes the MR x NR tile AB = A_panel * B_panel from packed micro-panels of depth kc. AB is stored row-major. */
+template<typename NumericT, vcl_size_t MR, vcl_size_t NR>
+void gemm_micro_kernel_generic(vcl_size_t kc, NumericT const * a, NumericT const * b, NumericT * ab)
+{
+  NumericT acc[MR * NR];
+  for (vcl_size_t i = 0; i < MR * NR; ++i)
+    acc[i] = NumericT(0);
+
+  for (vcl_size_t k = 0; k < kc; ++k)
+  {
+    for (vcl_size_t i = 0; i < MR; ++i)
+    {
+      NumericT a_ik = a[i];
+      for (vcl_size_t j = 0; j < NR; ++j)
+        acc[i * NR + j] += a_ik * b[j];
+    }
+    a += MR;
+    b += NR;
+  }
+
+  for (vcl_size_t i = 0; i < MR * NR; ++i)
+    ab[i] = acc[i];
+}
+
+
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+
+//
+// AVX2 + FMA kernels
+//
+
+/** \cond */
+VIENNACL_TARGET_AVX2 inline double hsum_AVX2(__m256d v)
+{
+  __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+VIENNACL_TARGET_AVX2 inline float hsum_AVX2(__m256 v)
+{
+  __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+  return _mm_cvtss_f32(_mm_add_ss(lo, _mm_movehdup_ps(lo)));
+}
+/** \endcond */
+
+VIENNACL_TARGET_AVX2 inline double dot_AVX2(double const * x, double const * y, vcl_size_t n)
+{
+  __m256d t0 = _mm256_setzero_pd(), t1 = _mm256_setzero_pd(), t2 = _mm256_setzero_pd(), t3 = _mm256_setzero_pd();
+  vcl_size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    t0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i),      _mm256_loadu_pd(y + i),      t0);
+    t1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4),  _mm256_loadu_pd(y + i + 4),  t1);
+    t2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8),  _mm256_loadu_pd(y + i + 8),  t2);
+    t3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), t3);
+  }
+  for (; i + 4 <= n; i += 4)
+    t0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), t0);
+
+  double result = hsum_AVX2(_mm256_add_pd(_mm256_add_pd(t0, t1), _mm256_add_pd(t2, t3)));
+  for (; i < n; ++i)
+    result += x[i] * y[i];
+  return result;
+}
+
+VIENNACL_TARGET_AVX2 inline float dot_AVX2(float const * x, float const * y, vcl_size_t n)
+{
+  __m256 t0 = _mm256_setzero_ps(), t1 = _mm256_setzero_ps(), t2 = _mm256_setzero_ps(), t3 = _mm256_setzero_ps();
+  vcl_size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    t0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i),      _mm256_loadu_ps(y + i),      t0);
+    t1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8),  _mm256_loadu_ps(y + i + 8),  t1);
+    t2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), t2);
+    t3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), t3);
+  }
+  for (; i + 8 <= n; i += 8)
+    t0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), t0);
+
+  float result = hsum_AVX2(_mm256_add_ps(_mm256_add_ps(t0, t1), _mm256_add_ps(t2, t3)));
+  for (; i < n; ++i)
+    result += x[i] * y[i];
+  return result;
+}
+
+VIENNACL_TARGET_AVX2 inline void axpby_AVX2(double * z, double alpha, double const * x, double beta, double const * y, vcl_size_t n, bool accumulate)
+{
+  __m256d a = _mm256_set1_pd(alpha);
+  __m256d b = _mm256_set1_pd(beta);
+  vcl_size_t i = 0;
+  if (accumulate)
+  {
+    for (; i + 4 <= n; i += 4)
+      _mm256_storeu_pd(z + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_fmadd_pd(b, _mm256_loadu_pd(y + i), _mm256_loadu_pd(z + i))));
+    for (; i < n; ++i)
+      z[i] += alpha * x[i] + beta * y[i];
+  }
+  else
+  {
+    for (; i + 4 <= n; i += 4)
+      _mm256_storeu_pd(z + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_mul_pd(b, _mm256_loadu_pd(y + i))));
+    for (; i < n; ++i)
+      z[i] = alpha * x[i] + beta * y[i];
+  }
+}
+
+VIENNACL_TARGET_AVX2 inline void axpby_AVX2(float * z, float alpha, float const * x, float beta, float const * y, vcl_size_t n, bool accumulate)
+{
+  __m256 a = _mm256_set1_ps(alpha);
+  __m256 b = _mm256_set1_ps(beta);
+  vcl_size_t i = 0;
+  if (accumulate)
+  {
+    for (; i + 8 <= n; i += 8)
+      _mm256_storeu_ps(z + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i), _mm256_fmadd_ps(b, _mm256_loadu_ps(y + i), _mm256_loadu_ps(z + i))));
+    for (; i < n; ++i)
+      z[i] += alpha * x[i] + beta * y[i];
+  }
+  else
+  {
+    for (; i + 8 <= n; i += 8)
+      _mm256_storeu_ps(z + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i), _mm256_mul_ps(b, _mm256_loadu_ps(y + i))));
+    for (; i < n; ++i)
+      z[i] = alpha * x[i] + beta * y[i];
+  }
+}
+
+VIENNACL_TARGET_AVX2 inline double csr_row_dot_AVX2(double const * elements, unsigned int const * cols, double const * x, vcl_size_t nnz)
+{
+  __m256d t0 = _mm256_setzero_pd(), t1 = _mm256_setzero_pd();
+  __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));  // masked gathers with a zero source avoid uninitialized-use warnings of the unmasked forms
+  vcl_size_t i = 0;
+  for (; i + 8 <= nnz; i += 8)
+  {
+    __m128i idx0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(cols + i));
+    __m128i idx1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(cols + i + 4));
+    t0 = _mm256_fmadd_pd(_mm256_loadu_pd(elements + i),     _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, idx0, all, 8), t0);
+    t1 = _mm256_fmadd_pd(_mm256_loadu_pd(elements + i + 4), _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, idx1, all, 8), t1);
+  }
+  double result = hsum_AVX2(_mm256_add_pd(t0, t1));
+  for (; i < nnz; ++i)
+    result += elements[i] * x[cols[i]];
+  return result;
+}
+
+VIENNACL_TARGET_AVX2 inline float csr_row_dot_AVX2(float const * elements, unsigned int const * cols, float const * x, vcl_size_t nnz)
+{
+  __m256 t0 = _mm256_setzero_ps();
+  __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  vcl_size_t i = 0;
+  for (; i + 8 <= nnz; i += 8)
+  {
+    __m256i idx = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(cols + i));
+    t0 = _mm256_fmadd_ps(_mm256_loadu_ps(elements + i), _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, idx, all, 4), t0);
+  }
+  float result = hsum_AVX2(t0);
+  for (; i < nnz; ++i)
+    result += elements[i] * x[cols[i]];
+  return result;
+}
+
+VIENNACL_TARGET_AVX2 inline void sell_slice_AVX2(double const * elements, unsigned int const * cols, vcl_size_t num_columns, vcl_size_t slice_height, double const * x, double * result)
+{
+  vcl_size_t r = 0;
+  for (; r + 4 <= slice_height; r += 4)
+  {
+    __m256d sum = _mm256_setzero_pd();
+    for (vcl_size_t j = 0; j < num_columns; ++j)
+    {
+      vcl_size_t offset = j * slice_height + r;
+      __m256d val  = _mm256_loadu_pd(elements + offset);
+      __m128i idx  = _mm_loadu_si128(reinterpret_cast<__m128i const *>(cols + offset));
+      __m256d mask = _mm256_cmp_pd(val, _mm256_setzero_pd(), _CMP_NEQ_OQ);  // do not touch x for padding entries
+      sum = _mm256_fmadd_pd(val, _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, idx, mask, 8), sum);
+    }
+    _mm256_storeu_pd(result + r, sum);
+  }
+  if (r < slice_height)
+    sell_slice_rows_generic(elements, cols, num_columns, slice_height, r, x, result);
+}
+
+VIENNACL_TARGET_AVX2 inline void sell_slice_AVX2(float const * elements, unsigned int const * cols, vcl_size_t num_columns, vcl_size_t slice_height, float const * x, float * result)
+{
+  vcl_size_t r = 0;
+  for (; r + 8 <= slice_height; r += 8)
+  {
+    __m256 sum = _mm256_setzero_ps();
+    for (vcl_size_t j = 0; j < num_columns; ++j)
+    {
+      vcl_size_t offset = j * slice_height + r;
+      __m256  val  = _mm256_loadu_ps(elements + offset);
+      __m256i idx  = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(cols + offset));
+      __m256  mask = _mm256_cmp_ps(val, _mm256_setzero_ps(), _CMP_NEQ_OQ);
+      sum = _mm256_fmadd_ps(val, _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, idx, mask, 4), sum);
+    }
+    _mm256_storeu_ps(result + r, sum);
+  }
+  if (r < slice_height)
+    sell_slice_rows_generic(elements, cols, num_columns, slice_height, r, x, result);
+}
+
+/** @brief 6x16 AVX2 GEMM micro-kernel for single precision: 12 accumulator registers, two for the B row, one for the broadcast of A. */
+VIENNACL_TARGET_AVX2 inline void gemm_micro_kernel_AVX2(vcl_size_t kc, float const * a, float const * b, float * ab)
+{
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+  for (vcl_size_t k = 0; k < kc; ++k)
+  {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+    __m256 a_i;
+
+    a_i = _mm256_broadcast_ss(a);     c00 = _mm256_fmadd_ps(a_i, b0, c00); c01 = _mm256_fmadd_ps(a_i, b1, c01);
+    a_i = _mm256_broadcast_ss(a + 1); c10 = _mm256_fmadd_ps(a_i, b0, c10); c11 = _mm256_fmadd_ps(a_i, b1, c11);
+    a_i = _mm256_broadcast_ss(a + 2); c20 = _mm256_fmadd_ps(a_i, b0, c20); c21 = _mm256_fmadd_ps(a_i, b1, c21);
+    a_i = _mm256_broadcast_ss(a + 3); c30 = _mm256_fmadd_ps(a_i, b0, c30); c31 = _mm256_fmadd_ps(a_i, b1, c31);
+    a_i = _mm256_broadcast_ss(a + 4); c40 = _mm256_fmadd_ps(a_i, b0, c40); c41 = _mm256_fmadd_ps(a_i, b1, c41);
+    a_i = _mm256_broadcast_ss(a + 5); c50 = _mm256_fmadd_ps(a_i, b0, c50); c51 = _mm256_fmadd_ps(a_i, b1, c51);
+
+    a += 6;
+    b += 16;
+  }
+
+  _mm256_storeu_ps(ab +  0, c00); _mm256_storeu_ps(ab +  8, c01);
+  _mm256_storeu_ps(ab + 16, c10); _mm256_storeu_ps(ab + 24, c11);
+  _mm256_storeu_ps(ab + 32, c20); _mm256_storeu_ps(ab + 40, c21);
+  _mm256_storeu_ps(ab + 48, c30); _mm256_storeu_ps(ab + 56, c31);
+  _mm256_storeu_ps(ab + 64, c40); _mm256_storeu_ps(ab + 72, c41);
+  _mm256_storeu_ps(ab + 80, c50); _mm256_storeu_ps(ab + 88, c51);
+}
+
+/** @brief 6x8 AVX2 GEMM micro-kernel for double precision: 12 accumulator registers, two for the B row, one for the broadcast of A. */
+VIENNACL_TARGET_AVX2 inline void gemm_micro_kernel_AVX2(vcl_size_t kc, double const * a, double const * b, double * ab)
+{
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+  __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+  for (vcl_size_t k = 0; k < kc; ++k)
+  {
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + 4);
+    __m256d a_i;
+
+    a_i = _mm256_broadcast_sd(a);     c00 = _mm256_fmadd_pd(a_i, b0, c00); c01 = _mm256_fmadd_pd(a_i, b1, c01);
+    a_i = _mm256_broadcast_sd(a + 1); c10 = _mm256_fmadd_pd(a_i, b0, c10); c11 = _mm256_fmadd_pd(a_i, b1, c11);
+    a_i = _mm256_broadcast_sd(a + 2); c20 = _mm256_fmadd_pd(a_i, b0, c20); c21 = _mm256_fmadd_pd(a_i, b1, c21);
+    a_i = _mm256_broadcast_sd(a + 3); c30 = _mm256_fmadd_pd(a_i, b0, c30); c31 = _mm256_fmadd_pd(a_i, b1, c31);
+    a_i = _mm256_broadcast_sd(a + 4); c40 = _mm256_fmadd_pd(a_i, b0, c40); c41 = _mm256_fmadd_pd(a_i, b1, c41);
+    a_i = _mm256_broadcast_sd(a + 5); c50 = _mm256_fmadd_pd(a_i, b0, c50); c51 = _mm256_fmadd_pd(a_i, b1, c51);
+
+    a += 6;
+    b += 8;
+  }
+
+  _mm256_storeu_pd(ab +  0, c00); _mm256_storeu_pd(ab +  4, c01);
+  _mm256_storeu_pd(ab +  8, c10); _mm256_storeu_pd(ab + 12, c11);
+  _mm256_storeu_pd(ab + 16, c20); _mm256_storeu_pd(ab + 20, c21);
+  _mm256_storeu_pd(ab + 24, c30); _mm256_storeu_pd(ab + 28, c31);
+  _mm256_storeu_pd(ab + 32, c40); _mm256_storeu_pd(ab + 36, c41);
+  _mm256_storeu_pd(ab + 40, c50); _mm256_storeu_pd(ab + 44, c51);
+}
+
+#endif // VIENNACL_HAVE_AVX2_KERNELS
+
+
+#ifdef VIENNACL_HAVE_AVX512_KERNELS
+
+//
+// AVX-512F kernels
+//
+
+/** \cond */
+// the _mm512_reduce_add_* and _mm512_cast*512_*256 intrinsics of GCC extract halves from an undefined source, which -Wuninitialized reports in every caller:
+VIENNACL_TARGET_AVX512 inline double hsum_AVX512(__m512d v)
+{
+  __m256d lo = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, v, 0);
+  __m256d hi = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, v, 1);
+  return hsum_AVX2(_mm256_add_pd(lo, hi));
+}
+
+VIENNACL_TARGET_AVX512 inline float hsum_AVX512(__m512 v)
+{
+  __m256 lo = _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, _mm512_castps_pd(v), 0));
+  __m256 hi = _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF, _mm512_castps_pd(v), 1));
+  return hsum_AVX2(_mm256_add_ps(lo, hi));
+}
+/** \endcond */
+
+VIENNACL_TARGET_AVX512 inline double dot_AVX512(double const * x, double const * y, vcl_size_t n)
+{
+  __m512d t0 = _mm512_setzero_pd(), t1 = _mm512_setzero_pd();
+  vcl_size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    t0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i),     _mm512_loadu_pd(y + i),     t0);
+    t1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), t1);
+  }
+  if (i < n) // masked remainder
+  {
+    __mmask8 m = static_cast<__mmask8>((n - i >= 8) ? 0xFF : ((1u << (n - i)) - 1));
+    t0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i), t0);
+    i += 8;
+    if (i < n)
+    {
+      m = static_cast<__mmask8>((1u << (n - i)) - 1);
+      t1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i), t1);
+    }
+  }
+  return hsum_AVX512(_mm512_add_pd(t0, t1));
+}
+
+VIENNACL_TARGET_AVX512 inline float dot_AVX512(float const * x, float const * y, vcl_size_t n)
+{
+  __m512 t0 = _mm512_setzero_ps(), t1 = _mm512_setzero_ps();
+  vcl_size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    t0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i),      _mm512_loadu_ps(y + i),      t0);
+    t1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), t1);
+  }
+  for (; i < n; i += 16) // masked remainder
+  {
+    __mmask16 m = static_cast<__mmask16>((n - i >= 16) ? 0xFFFF : ((1u << (n - i)) - 1));
+    t0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, x + i), _mm512_maskz_loadu_ps(m, y + i), t0);
+  }
+  return hsum_AVX512(_mm512_add_ps(t0, t1));
+}
+
+VIENNACL_TARGET_AVX512 inline void axpby_AVX512(double * z, double alpha, double const * x, double beta, double const * y, vcl_size_t n, bool accumulate)
+{
+  __m512d a = _mm512_set1_pd(alpha);
+  __m512d b = _mm512_set1_pd(beta);
+  for (vcl_size_t i = 0; i < n; i += 8)
+  {
+    __mmask8 m = static_cast<__mmask8>((n - i >= 8) ? 0xFF : ((1u << (n - i)) - 1));
+    __m512d zi = accumulate ? _mm512_maskz_loadu_pd(m, z + i) : _mm512_setzero_pd();
+    zi = _mm512_fmadd_pd(a, _mm512_maskz_loadu_pd(m, x + i), _mm512_fmadd_pd(b, _mm512_maskz_loadu_pd(m, y + i), zi));
+    _mm512_mask_storeu_pd(z + i, m, zi);
+  }
+}
+
+VIENNACL_TARGET_AVX512 inline void axpby_AVX512(float * z, float alpha, float const * x, float beta, float const * y, vcl_size_t n, bool accumulate)
+{
+  __m512 a = _mm512_set1_ps(alpha);
+  __m512 b = _mm512_set1_ps(beta);
+  for (vcl_size_t i = 0; i < n; i += 16)
+  {
+    __mmask16 m = static_cast<__mmask16>((n - i >= 16) ? 0xFFFF : ((1u << (n - i)) - 1));
+    __m512 zi = accumulate ? _mm512_maskz_loadu_ps(m, z + i) : _mm512_setzero_ps();
+    zi = _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(m, x + i), _mm512_fmadd_ps(b, _mm512_maskz_loadu_ps(m, y + i), zi));
+    _mm512_mask_storeu_ps(z + i, m, zi);
+  }
+}
+
+VIENNACL_TARGET_AVX512 inline double csr_row_dot_AVX512(double const * elements, unsigned int const * cols, double const * x, vcl_size_t nnz)
+{
+  __m512d t0 = _mm512_setzero_pd();
+  vcl_size_t i = 0;
+  for (; i + 8 <= nnz; i += 8)
+  {
+    __m256i idx = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(cols + i));
+    t0 = _mm512_fmadd_pd(_mm512_loadu_pd(elements + i), _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, x, 8), t0);
+  }
+  double result = hsum_AVX512(t0);
+  for (; i < nnz; ++i)
+    result += elements[i] * x[cols[i]];
+  return result;
+}
+
+VIENNACL_TARGET_AVX512 inline float csr_row_dot_AVX512(float const * elements, unsigned int const * cols, float const * x, vcl_size_t nnz)
+{
+  __m512 t0 = _mm512_setzero_ps();
+  vcl_size_t i = 0;
+  for (; i + 16 <= nnz; i += 16)
+  {
+    __m512i idx = _mm512_loadu_si512(cols + i);
+    t0 = _mm512_fmadd_ps(_mm512_loadu_ps(elements + i), _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, idx, x, 4), t0);
+  }
+  float result = hsum_AVX512(t0);
+  for (; i < nnz; ++i)
+    result += elements[i] * x[cols[i]];
+  return result;
+}
+
+VIENNACL_TARGET_AVX512 inline void sell_slice_AVX512(double const * elements, unsigned int const * cols, vcl_size_t num_columns, vcl_size_t slice_height, double const * x, double * result)
+{
+  vcl_size_t r = 0;
+  for (; r + 8 <= slice_height; r += 8)
+  {
+    __m512d sum = _mm512_setzero_pd();
+    for (vcl_size_t j = 0; j < num_columns; ++j)
+    {
+      vcl_size_t offset = j * slice_height + r;
+      __m512d   val  = _mm512_loadu_pd(elements + offset);
+      __m256i   idx  = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(cols + offset));
+      __mmask8  mask = _mm512_cmp_pd_mask(val, _mm512_setzero_pd(), _CMP_NEQ_OQ);
+      sum = _mm512_fmadd_pd(val, _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, idx, x, 8), sum);
+    }
+    _mm512_storeu_pd(result + r, sum);
+  }
+  if (r < slice_height)
+    sell_slice_rows_generic(elements, cols, num_columns, slice_height, r, x, result);
+}
+
+VIENNACL_TARGET_AVX512 inline void sell_slice_AVX512(float const * elements, unsigned int const * cols, vcl_size_t num_columns, vcl_size_t slice_height, float const * x, float * result)
+{
+  vcl_size_t r = 0;
+  for (; r + 16 <= slice_height; r += 16)
+  {
+    __m512 sum = _mm512_setzero_ps();
+    for (vcl_size_t j = 0; j < num_columns; ++j)
+    {
+      vcl_size_t offset = j * slice_height + r;
+      __m512    val  = _mm512_loadu_ps(elements + offset);
+      __m512i   idx  = _mm512_loadu_si512(cols + offset);
+      __mmask16 mask = _mm512_cmp_ps_mask(val, _mm512_setzero_ps(), _CMP_NEQ_OQ);
+      sum = _mm512_fmadd_ps(val, _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, idx, x, 4), sum);
+    }
+    _mm512_storeu_ps(result + r, sum);
+  }
+  if (r < slice_height)
+    sell_slice_rows_generic(elements, cols, num_columns, slice_height, r, x, result);
+}
+
+/** @brief 6x32 AVX-512 GEMM micro-kernel for single precision. */
+VIENNACL_TARGET_AVX512 inline void gemm_micro_kernel_AVX512(vcl_size_t kc, float const * a, float const * b, float * ab)
+{
+  __m512 c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm512_setzero_ps();
+
+  for (vcl_size_t k = 0; k < kc; ++k)
+  {
+    __m512 b0 = _mm512_loadu_ps(b);
+    __m512 b1 = _mm512_loadu_ps(b + 16);
+    for (int i = 0; i < 6; ++i)
+    {
+      __m512 a_i = _mm512_set1_ps(a[i]);
+      c[2*i]   = _mm512_fmadd_ps(a_i, b0, c[2*i]);
+      c[2*i+1] = _mm512_fmadd_ps(a_i, b1, c[2*i+1]);
+    }
+    a += 6;
+    b += 32;
+  }
+
+  for (int i = 0; i < 12; ++i)
+    _mm512_storeu_ps(ab + 16 * i, c[i]);
+}
+
+/** @brief 6x16 AVX-512 GEMM micro-kernel for double precision. */
+VIENNACL_TARGET_AVX512 inline void gemm_micro_kernel_AVX512(vcl_size_t kc, double const * a, double const * b, double * ab)
+{
+  __m512d c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm512_setzero_pd();
+
+  for (vcl_size_t k = 0; k < kc; ++k)
+  {
+    __m512d b0 = _mm512_loadu_pd(b);
+    __m512d b1 = _mm512_loadu_pd(b + 8);
+    for (int i = 0; i < 6; ++i)
+    {
+      __m512d a_i = _mm512_set1_pd(a[i]);
+      c[2*i]   = _mm512_fmadd_pd(a_i, b0, c[2*i]);
+      c[2*i+1] = _mm512_fmadd_pd(a_i, b1, c[2*i+1]);
+    }
+    a += 6;
+    b += 16;
+  }
+
+  for (int i = 0; i < 12; ++i)
+    _mm512_storeu_pd(ab + 8 * i, c[i]);
+}
+
+#endif // VIENNACL_HAVE_AVX512_KERNELS
+
+
+
+/** @brief Table of function pointers to the host kernels for a given numeric type, including the GEMM blocking parameters matching the micro-kernel. */
+template<typename NumericT>
+struct host_kernels
+{
+  typedef NumericT (*dot_kernel)(NumericT const *, NumericT const *, vcl_size_t);
+  typedef void     (*axpby_kernel)(NumericT *, NumericT, NumericT const *, NumericT, NumericT const *, vcl_size_t, bool);
+  typedef NumericT (*csr_row_dot_kernel)(NumericT const *, unsigned int const *, NumericT const *, vcl_size_t);
+  typedef void     (*gemm_kernel)(vcl_size_t, NumericT const *, NumericT const *, NumericT *);
+  typedef void     (*sell_slice_kernel)(NumericT const *, unsigned int const *, vcl_size_t, vcl_size_t, NumericT const *, NumericT *);
+
+  viennacl::tools::cpu_isa isa;
+
+  dot_kernel          dot;          // returns x^T y
+  axpby_kernel        axpby;        // z = alpha * x + beta * y,  or z += alpha * x + beta * y if the last argument is true
+  csr_row_dot_kernel  csr_row_dot;  // returns sum_i elements[i] * x[cols[i]]
+  sell_slice_kernel   sell_slice;   // result = A_slice * x for one slice of a sliced_ell_matrix
+  vcl_size_t          simd_width;   // number of NumericT entries per SIMD register
+
+  gemm_kernel         gemm_micro_kernel;
+  vcl_size_t          gemm_mr, gemm_nr;           // register block
+  vcl_size_t          gemm_mc, gemm_kc, gemm_nc;  // cache blocks. gemm_mc is a multiple of gemm_mr, gemm_nc a multiple of gemm_nr
+};
+
+/** @brief Sets up the kernel table for a numeric type. The generic version is used for all types other than float and double. */
+template<typename NumericT>
+struct host_kernel_table
+{
+  /** @brief Whether kernels are (potentially) SIMD-accelerated. If false, callers should keep their existing code path. */
+  static const bool is_simd = false;
+
+  static host_kernels<NumericT> create(viennacl::tools::cpu_isa)
+  {
+    host_kernels<NumericT> k;
+    k.isa               = viennacl::tools::ISA_GENERIC;
+    k.dot               = dot_generic<NumericT>;
+    k.axpby             = axpby_generic<NumericT>;
+    k.csr_row_dot       = csr_row_dot_generic<NumericT>;
+    k.sell_slice        = sell_slice_generic<NumericT>;
+    k.simd_width        = 1;
+    k.gemm_micro_kernel = gemm_micro_kernel_generic<NumericT, 4, 4>;
+    k.gemm_mr = 4;   k.gemm_nr = 4;
+    k.gemm_mc = 128; k.gemm_kc = 256; k.gemm_nc = 4096;
+    return k;
+  }
+};
+
+/** \cond */
+template<>
+struct host_kernel_table<float>
+{
+  static const bool is_simd = true;
+
+  static host_kernels<float> create(viennacl::tools::cpu_isa isa)
+  {
+    host_kernels<float> k;
+    k.isa               = viennacl::tools::ISA_GENERIC;
+    k.dot               = dot_generic<float>;
+    k.axpby             = axpby_generic<float>;
+    k.csr_row_dot       = csr_row_dot_generic<float>;
+    k.sell_slice        = sell_slice_generic<float>;
+    k.simd_width        = 4;
+    k.gemm_micro_kernel = gemm_micro_kernel_generic<float, 4, 8>;  // 6x16 spills with 16 SSE registers
+    k.gemm_mr = 4;   k.gemm_nr = 8;
+    k.gemm_mc = 128; k.gemm_kc = 256; k.gemm_nc = 4080;
+
+    if (isa >= viennacl::tools::ISA_SSE42)
+      k.isa = viennacl::tools::ISA_SSE42; // no dedicated kernels, the generic ones already use SSE
+
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+    if (isa >= viennacl::tools::ISA_AVX2)
+    {
+      k.isa               = viennacl::tools::ISA_AVX2;
+      k.dot               = dot_AVX2;
+      k.axpby             = axpby_AVX2;
+      k.csr_row_dot       = csr_row_dot_AVX2;
+      k.sell_slice        = sell_slice_AVX2;
+      k.simd_width        = 8;
+      k.gemm_micro_kernel = gemm_micro_kernel_AVX2;
+      k.gemm_mr = 6;   k.gemm_nr = 16;
+      k.gemm_mc = 144;
+    }
+#endif
+#ifdef VIENNACL_HAVE_AVX512_KERNELS
+    if (isa >= viennacl::tools::ISA_AVX512)
+    {
+      k.isa               = viennacl::tools::ISA_AVX512;
+      k.dot               = dot_AVX512;
+      k.axpby             = axpby_AVX512;
+      k.csr_row_dot       = csr_row_dot_AVX512;
+      k.sell_slice        = sell_slice_AVX512;
+      k.simd_width        = 16;
+      k.gemm_micro_kernel = gemm_micro_kernel_AVX512;
+      k.gemm_mr = 6;   k.gemm_nr = 32;
+      k.gemm_mc = 144; k.gemm_nc = 4064;
+    }
+#endif
+    return k;
+  }
+};
+
+template<>
+struct host_kernel_table<double>
+{
+  static const bool is_simd = true;
+
+  static host_kernels<double> create(viennacl::tools::cpu_isa isa)
+  {
+    host_kernels<double> k;
+    k.isa               = viennacl::tools::ISA_GENERIC;
+    k.dot               = dot_generic<double>;
+    k.axpby             = axpby_generic<double>;
+    k.csr_row_dot       = csr_row_dot_generic<double>;
+    k.sell_slice        = sell_slice_generic<double>;
+    k.simd_width        = 2;
+    k.gemm_micro_kernel = gemm_micro_kernel_generic<double, 6, 8>;
+    k.gemm_mr = 6;   k.gemm_nr = 8;
+    k.gemm_mc = 96;  k.gemm_kc = 256; k.gemm_nc = 4080;
+
+    if (isa >= viennacl::tools::ISA_SSE42)
+      k.isa = viennacl::tools::ISA_SSE42; // no dedicated kernels, the generic ones already use SSE
+
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+    if (isa >= viennacl::tools::ISA_AVX2)
+    {
+      k.isa               = viennacl::tools::ISA_AVX2;
+      k.dot               = dot_AVX2;
+      k.axpby             = axpby_AVX2;
+      k.csr_row_dot       = csr_row_dot_AVX2;
+      k.sell_slice        = sell_slice_AVX2;
+      k.simd_width        = 4;
+      k.gemm_micro_kernel = gemm_micro_kernel_AVX2;
+    }
+#endif
+#ifdef VIENNACL_HAVE_AVX512_KERNELS
+    if (isa >= viennacl::tools::ISA_AVX512)
+    {
+      k.isa               = viennacl::tools::ISA_AVX512;
+      k.dot               = dot_AVX512;
+      k.axpby             = axpby_AVX512;
+      k.csr_row_dot       = csr_row_dot_AVX512;
+      k.sell_slice        = sell_slice_AVX512;
+      k.simd_width        = 8;
+      k.gemm_micro_kernel = gemm_micro_kernel_AVX512;
+      k.gemm_mr = 6;   k.gemm_nr = 16;
+      k.gemm_nc = 4080;
+    }
+#endif
+    return k;
+  }
+};
+/** \endcond */
+
+/** @brief Returns the kernel table for the numeric type. The table is set up on first use according to the instruction sets supported by the host CPU. */
+template<typename NumericT>
+host_kernels<NumericT> const & get_host_kernels()
+{
+  static const host_kernels<NumericT> kernels = host_kernel_table<NumericT>::create(viennacl::tools::host_isa());
+  return kernels;
+}
+
+/** @brief Computes result = A_slice * x for one slice of a sliced_ell_matrix with arbitrary index type and strided x. Padding entries (zero values) are skipped. */
+template<typename NumericT, typename IndexT>
+void sell_slice_strided(NumericT const * elements, IndexT const * column_indices, vcl_size_t num_columns, vcl_size_t slice_height,
+                        NumericT const * x, vcl_size_t x_start, vcl_size_t x_stride, NumericT * result)
+{
+  for (vcl_size_t row_in_block = 0; row_in_block < slice_height; ++row_in_block)
+    result[row_in_block] = 0;
+
+  for (vcl_size_t column_entry_index = 0; column_entry_index < num_columns; ++column_entry_index)
+  {
+    vcl_size_t stride_start = column_entry_index * slice_height;
+    for (vcl_size_t row_in_block = 0; row_in_block < slice_height; ++row_in_block)
+    {
+      NumericT val = elements[stride_start + row_in_block];
+      result[row_in_block] += (val > 0 || val < 0) ? x[column_indices[stride_start + row_in_block] * x_stride + x_start] * val : 0;
+    }
+  }
+}
+
+template<typename NumericT, typename IndexT>
+void sell_slice(host_kernels<NumericT> const &,
+                NumericT const * elements, IndexT const * column_indices, vcl_size_t num_columns, vcl_size_t slice_height,
+                NumericT const * x, vcl_size_t x_start, vcl_size_t x_stride, NumericT * result)
+{
+  sell_slice_strided(elements, column_indices, num_columns, slice_height, x, x_start, x_stride, result);
+}
+
+/** @brief Computes result = A_slice * x for one slice of a sliced_ell_matrix. Uses the SIMD slice kernel for 'unsigned int' indices and unit-stride x. */
+template<typename NumericT>
+void sell_slice(host_kernels<NumericT> const & kernels,
+                NumericT const * elements, unsigned int const * column_indices, vcl_size_t num_columns, vcl_size_t slice_height,
+                NumericT const * x, vcl_size_t x_start, vcl_size_t x_stride, NumericT * result)
+{
+  if (x_stride == 1)
+    kernels.sell_slice(elements, column_indices, num_columns, slice_height, x + x_start, result);
+  else
+    sell_slice_strided(elements, column_indices, num_columns, slice_height, x, x_start, x_stride, result);
+}
+
+
+//
+// OpenMP-parallel drivers for the BLAS level 1 kernels. Each thread processes one contiguous chunk.
+//
+
+/** @brief Computes x^T y for contiguous x and y using the dispatched kernel */
+template<typename NumericT>
+NumericT host_dot(NumericT const * x, NumericT const * y, vcl_size_t n)
+{
+  typename host_kernels<NumericT>::dot_kernel dot = get_host_kernels<NumericT>().dot;
+
+#ifdef VIENNACL_WITH_OPENMP
+  if (n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+  {
+    std::vector<NumericT> partial(static_cast<vcl_size_t>(omp_get_max_threads()), NumericT(0));
+
+    #pragma omp parallel
+    {
+      vcl_size_t tid = static_cast<vcl_size_t>(omp_get_thread_num());
+      vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+      vcl_size_t begin = (n * tid) / num_threads;
+      vcl_size_t end   = (n * (tid + 1)) / num_threads;
+      partial[tid] = dot(x + begin, y + begin, end - begin);
+    }
+
+    NumericT result = 0;
+    for (vcl_size_t i = 0; i < partial.size(); ++i)
+      result += partial[i];
+    return result;
+  }
+#endif
+
+  return dot(x, y, n);
+}
+
+/** @brief Computes z = alpha * x + beta * y (or z += alpha * x + beta * y if 'accumulate' is true) for contiguous z, x, y using the dispatched kernel */
+template<typename NumericT>
+void host_axpby(NumericT * z, NumericT alpha, NumericT const * x, NumericT beta, NumericT const * y, vcl_size_t n, bool accumulate)
+{
+  typename host_kernels<NumericT>::axpby_kernel axpby = get_host_kernels<NumericT>().axpby;
+
+#ifdef VIENNACL_WITH_OPENMP
+  if (n > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+  {
+    #pragma omp parallel
+    {
+      vcl_size_t tid = static_cast<vcl_size_t>(omp_get_thread_num());
+      vcl_size_t num_threads = static_cast<vcl_size_t>(omp_get_num_threads());
+      vcl_size_t begin = (n * tid) / num_threads;
+      vcl_size_t end   = (n * (tid + 1)) / num_threads;
+      axpby(z + begin, alpha, x + begin, beta, y + begin, end - begin, accumulate);
+    }
+    return;
+  }
+#endif
+
+  axpby(z, alpha, x, beta, y, n, accumulate);
+}
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -23,20 +23,33 @@
 */
 
 #include "viennacl/forwards.h"
+#include "viennacl/detail/csr_partition.hpp"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
+#include "viennacl/linalg/host_based/simd_kernels.hpp"
 
 #include "viennacl/linalg/host_based/spgemm_vector.hpp"
 
 #include <vector>
+#include <algorithm>
 
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
 #endif
 
+// Minimum number of rows plus nonzeros for partitioning a sparse matrix-vector product with a compressed_matrix among threads:
+#ifndef VIENNACL_OPENMP_SPMV_MIN_SIZE
+  #define VIENNACL_OPENMP_SPMV_MIN_SIZE  5000
+#endif
+
+// Minimum average number of rows per level for running level-scheduled triangular solves in parallel:
+#ifndef VIENNACL_OPENMP_TRIANGULAR_MIN_ROWS_PER_LEVEL
+  #define VIENNACL_OPENMP_TRIANGULAR_MIN_ROWS_PER_LEVEL  128
+#endif
+
 namespace viennacl
 {
 namespace linalg
@@ -96,6 +109,174 @@ namespace detail
       result_buf[row] = value;
     }
   }
+
+  /** @brief Returns the partition of a CSR matrix for a sparse matrix-vector product with 'num_parts' threads. The partition is cached on the matrix.
+    *
+    * The work of a thread is measured along the merge path of the row offsets and the nonzeros, i.e. one unit per row plus one unit per nonzero.
+    * If the longest row holds less than half of the work of a thread, the partition is snapped to row boundaries (nnz-balanced row partition).
+    * Otherwise (e.g. power-law matrices with few dense rows) the merge-path partition is used as is, so that long rows are split among threads.
+    * Partitions are immutable once cached, so the reference stays valid while other threads use the same matrix. The matrix must have at least one row.
+    */
+  template<typename NumericT, unsigned int AlignmentV>
+  viennacl::detail::csr_host_partition const & csr_partition(compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t num_parts)
+  {
+    unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+
+    vcl_size_t rows = A.size1();
+    vcl_size_t nnz  = row_buffer[rows];
+
+    viennacl::detail::csr_host_partition_cache & cache = A.host_partitions();
+    viennacl::backend::cpu_ram::detail::pool_lock guard(cache.mutex());
+
+    viennacl::detail::csr_host_partition const * cached = cache.find(num_parts, rows, nnz, A.row_buffer_generation());
+    if (cached)
+      return *cached;
+
+    vcl_size_t max_row_length = 0;
+    for (vcl_size_t row = 0; row < rows; ++row)
+      max_row_length = std::max<vcl_size_t>(max_row_length, row_buffer[row+1] - row_buffer[row]);
+
+    vcl_size_t path_length    = rows + nnz;
+    vcl_size_t work_per_part  = (path_length + num_parts - 1) / num_parts;
+
+    viennacl::detail::csr_host_partition & partition = cache.insert();
+    partition.num_parts  = num_parts;
+    partition.rows       = rows;
+    partition.nonzeros   = nnz;
+    partition.generation = A.row_buffer_generation();
+    partition.merge_path = (2 * max_row_length > work_per_part);
+    partition.row_start.resize(num_parts + 1);
+    partition.nnz_start.resize(num_parts + 1);
+
+    for (vcl_size_t part = 0; part < num_parts; ++part)
+    {
+      vcl_size_t diagonal = std::min(part * work_per_part, path_length);
+
+      // binary search for the number of completed rows on this diagonal of the merge path:
+      vcl_size_t row_min = (diagonal > nnz) ? diagonal - nnz : 0;
+      vcl_size_t row_max = std::min(diagonal, rows);
+      while (row_min < row_max)
+      {
+        vcl_size_t pivot = (row_min + row_max) / 2;
+        if (row_buffer[pivot + 1] + pivot + 1 <= diagonal)
+          row_min = pivot + 1;
+        else
+          row_max = pivot;
+      }
+
+      partition.row_start[part] = row_min;
+      partition.nnz_start[part] = partition.merge_path ? diagonal - row_min : row_buffer[row_min];
+    }
+    partition.row_start[num_parts] = rows;
+    partition.nnz_start[num_parts] = nnz;
+
+    return partition;
+  }
+
+  /** @brief Writes y = A * x for a row-wise result, used by csr_prod_partitioned(). */
+  template<typename NumericT>
+  struct csr_result_assign
+  {
+    csr_result_assign(NumericT * result) : result_(result) {}
+
+    void assign(vcl_size_t row, NumericT value) const { result_[row]  = value; }
+    void add   (vcl_size_t row, NumericT value) const { result_[row] += value; }
+
+    NumericT * result_;
+  };
+
+  /** @brief Writes y = alpha * A * x + beta * y for a row-wise result with start and stride, used by csr_prod_partitioned(). */
+  template<typename NumericT>
+  struct csr_result_axpby
+  {
+    csr_result_axpby(NumericT * result, vcl_size_t start, vcl_size_t stride, NumericT alpha, NumericT beta)
+      : result_(result), start_(start), stride_(stride), alpha_(alpha), beta_(beta) {}
+
+    void assign(vcl_size_t row, NumericT value) const
+    {
+      vcl_size_t index = row * stride_ + start_;
+      if (beta_ < 0 || beta_ > 0)
+        result_[index] = alpha_ * value + beta_ * result_[index];
+      else
+        result_[index] = alpha_ * value;
+    }
+
+    void add(vcl_size_t row, NumericT value) const { result_[row * stride_ + start_] += alpha_ * value; }
+
+    NumericT * result_;
+    vcl_size_t start_;
+    vcl_size_t stride_;
+    NumericT alpha_;
+    NumericT beta_;
+  };
+
+  /** @brief Computes the rows of part 'part' of the given partition. The leading part of a row completed by one of the next parts is written to carry[part]. */
+  template<typename NumericT, typename ResultT>
+  void csr_prod_part(viennacl::detail::csr_host_partition const & partition, vcl_size_t part,
+                     NumericT const * elements, unsigned int const * row_buffer, unsigned int const * col_buffer,
+                     NumericT const * x, ResultT const & result, NumericT * carry)
+  {
+    typename host_kernels<NumericT>::csr_row_dot_kernel row_dot = get_host_kernels<NumericT>().csr_row_dot;
+
+    vcl_size_t row      = partition.row_start[part];
+    vcl_size_t row_stop = partition.row_start[part + 1];
+    vcl_size_t k        = partition.nnz_start[part];
+    vcl_size_t k_stop   = partition.nnz_start[part + 1];
+
+    for (; row < row_stop; ++row)
+    {
+      vcl_size_t row_end = row_buffer[row + 1];
+      result.assign(row, row_dot(elements + k, col_buffer + k, x, row_end - k));
+      k = row_end;
+    }
+
+    // leading part of a row completed by one of the next threads (merge path only):
+    carry[part] = (k < k_stop) ? row_dot(elements + k, col_buffer + k, x, k_stop - k) : NumericT(0);
+  }
+
+  /** @brief Adds the carry-out of all parts to the rows split among threads. To be called once all parts are computed. */
+  template<typename NumericT, typename ResultT>
+  void csr_prod_add_carries(viennacl::detail::csr_host_partition const & partition, NumericT const * carry, ResultT const & result)
+  {
+    for (vcl_size_t part = 0; part < partition.num_parts; ++part)
+      if (partition.nnz_start[part] < partition.nnz_start[part + 1] && partition.row_start[part + 1] < partition.rows)
+        result.add(partition.row_start[part + 1], carry[part]);
+  }
+
+  /** @brief Sparse matrix-vector product with a CSR matrix using the given partition. Rows split among threads are completed by adding the carry-out of the preceding threads. */
+  template<typename NumericT, typename ResultT>
+  void csr_prod_partitioned(viennacl::detail::csr_host_partition const & partition,
+                            NumericT const * elements, unsigned int const * row_buffer, unsigned int const * col_buffer,
+                            NumericT const * x, ResultT const & result)
+  {
+    long num_parts = static_cast<long>(partition.num_parts);
+    std::vector<NumericT> carry(partition.num_parts);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(static, 1)
+#endif
+    for (long part = 0; part < num_parts; ++part)
+      csr_prod_part(partition, vcl_size_t(part), elements, row_buffer, col_buffer, x, result, &(carry[0]));
+
+    csr_prod_add_carries(partition, &(carry[0]), result);
+  }
+
+  /** @brief Returns the number of threads for the host-based sparse matrix-vector products. */
+  inline vcl_size_t spmv_num_threads()
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    return static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+  }
+
+  /** @brief Returns true if a product with the CSR matrix is worth partitioning among several threads. Matrices without rows have no row array, hence are never partitioned. */
+  template<typename NumericT, unsigned int AlignmentV>
+  bool csr_use_partition(compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t num_threads)
+  {
+    return num_threads > 1 && A.size1() > 0 && A.size1() + A.nnz() >= VIENNACL_OPENMP_SPMV_MIN_SIZE;
+  }
 }
 
 
@@ -118,18 +299,20 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-  for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
+  vcl_size_t num_threads = detail::spmv_num_threads();
+  if (detail::csr_use_partition(mat, num_threads))
   {
-    NumericT dot_prod = 0;
+    detail::csr_prod_partitioned(detail::csr_partition(mat, num_threads), elements, row_buffer, col_buffer, vec_buf,
+                                 detail::csr_result_assign<NumericT>(result_buf));
+    return;
+  }
 
-    unsigned int row_end = row_buffer[row+1];
-    for (unsigned int i = row_buffer[row]; i < row_end; ++i)
-      dot_prod += elements[i] * vec_buf[col_buffer[i]];
+  typename detail::host_kernels<NumericT>::csr_row_dot_kernel row_dot = detail::get_host_kernels<NumericT>().csr_row_dot;
 
-    result_buf[row] = dot_prod;
+  for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
+  {
+    unsigned int row_start = row_buffer[row];
+    result_buf[row] = row_dot(elements + row_start, col_buffer + row_start, vec_buf, row_buffer[row+1] - row_start);
   }
 
 }
@@ -152,7 +335,7 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   if (   alpha <= NumericT(1) && alpha >= NumericT(1)
       &&  beta <= NumericT(0) &&  beta >= NumericT(0)
       && vec.start() == 0 && vec.stride() == 1
-      && result.start() == 0 && result.stride() == 0)
+      && result.start() == 0 && result.stride() == 1)
   {
     prod_impl(mat, vec, result);
     return;
@@ -164,6 +347,16 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
+  vcl_size_t num_threads = detail::spmv_num_threads();
+  if (detail::csr_use_partition(mat, num_threads) && vec.stride() == 1)
+  {
+    detail::csr_prod_partitioned(detail::csr_partition(mat, num_threads), elements, row_buffer, col_buffer, vec_buf + vec.start(),
+                                 detail::csr_result_axpby<NumericT>(result_buf, result.start(), result.stride(), alpha, beta));
+    return;
+  }
+
+  typename detail::host_kernels<NumericT>::csr_row_dot_kernel row_dot = detail::get_host_kernels<NumericT>().csr_row_dot;
+
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
@@ -171,8 +364,11 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   {
     NumericT dot_prod = 0;
     vcl_size_t row_end = row_buffer[row+1];
-    for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
-      dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
+    if (vec.stride() == 1)
+      dot_prod = row_dot(elements + row_buffer[row], col_buffer + row_buffer[row], vec_buf + vec.start(), row_end - row_buffer[row]);
+    else
+      for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
+        dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
 
     if (beta < 0 || beta > 0)
     {
@@ -229,7 +425,40 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
   detail::matrix_array_wrapper<NumericT, column_major, false>
       result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-  if ( d_mat.row_major() ) {
+  if ( d_mat.row_major() && result.row_major() && d_mat_inc2 == 1 && result_inc2 == 1 ) {
+    // rows of both dense matrices are contiguous: the nonzeros of a sparse row are applied to blocks of eight contiguous columns kept in registers
+    vcl_size_t num_cols = d_mat.size2();
+    vcl_size_t d_mat_row_stride = d_mat_inc1 * d_mat_internal_size2;
+    NumericT const * d_mat_begin = d_mat_data + d_mat_start1 * d_mat_internal_size2 + d_mat_start2;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row) {
+      NumericT * result_row = result_data + (result_start1 + static_cast<vcl_size_t>(row) * result_inc1) * result_internal_size2 + result_start2;
+      vcl_size_t row_start = sp_mat_row_buffer[row];
+      vcl_size_t row_end   = sp_mat_row_buffer[row+1];
+
+      vcl_size_t col = 0;
+      for (; col + 8 <= num_cols; col += 8) {
+        NumericT temp[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        for (vcl_size_t k = row_start; k < row_end; ++k) {
+          NumericT value = sp_mat_elements[k];
+          NumericT const * d_mat_row = d_mat_begin + static_cast<vcl_size_t>(sp_mat_col_buffer[k]) * d_mat_row_stride + col;
+          for (vcl_size_t i = 0; i < 8; ++i)
+            temp[i] += value * d_mat_row[i];
+        }
+        for (vcl_size_t i = 0; i < 8; ++i)
+          result_row[col + i] = temp[i];
+      }
+      for (; col < num_cols; ++col) {
+        NumericT temp = 0;
+        for (vcl_size_t k = row_start; k < row_end; ++k)
+          temp += sp_mat_elements[k] * d_mat_begin[static_cast<vcl_size_t>(sp_mat_col_buffer[k]) * d_mat_row_stride + col];
+        result_row[col] = temp;
+      }
+    }
+  }
+  else if ( d_mat.row_major() ) {
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
@@ -359,31 +588,25 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & sp_mat,
 }
 
 
-/** @brief Carries out sparse_matrix-sparse_matrix multiplication for CSR matrices
-*
-* Implementation of the convenience expression C = prod(A, B);
-* Based on computing C(i, :) = A(i, :) * B via merging the respective rows of B
+/** @brief Symbolic phase of the sparse matrix-matrix product C = A * B for CSR matrices: Determines the number of nonzeros in each row of C.
 *
-* @param A     Left factor
-* @param B     Right factor
-* @param C     Result matrix
+* @param A                 Left factor
+* @param B                 Right factor
+* @param C_row_buffer      Row start indices of C (size A.size1() + 1) on output
+* @return                  Upper bound for the length of the rows of C, used for sizing the work buffers of the numeric phase
 */
 template<typename NumericT, unsigned int AlignmentV>
-void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
-               viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
-               viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+unsigned int prod_symbolic_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+                                std::vector<unsigned int> & C_row_buffer)
 {
-
-  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A.handle());
   unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
   unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
 
-  NumericT     const * B_elements   = detail::extract_raw_pointer<NumericT>(B.handle());
   unsigned int const * B_row_buffer = detail::extract_raw_pointer<unsigned int>(B.handle1());
   unsigned int const * B_col_buffer = detail::extract_raw_pointer<unsigned int>(B.handle2());
 
-  C.resize(A.size1(), B.size2(), false);
-  unsigned int * C_row_buffer = detail::extract_raw_pointer<unsigned int>(C.handle1());
+  C_row_buffer.resize(A.size1() + 1);
 
 #if defined(VIENNACL_WITH_OPENMP)
   unsigned int block_factor = 10;
@@ -394,7 +617,6 @@ void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
 #endif
   std::vector<unsigned int> max_length_row_C(max_threads);
   std::vector<unsigned int *> row_C_temp_index_buffers(max_threads);
-  std::vector<NumericT *>     row_C_temp_value_buffers(max_threads);
 
 
   /*
@@ -458,28 +680,76 @@ void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
     unsigned int row_start_A = A_row_buffer[i];
     unsigned int row_end_A   = A_row_buffer[i+1];
 
-    C_row_buffer[i] = row_C_scan_symbolic_vector(row_start_A, row_end_A, A_col_buffer,
-                                                 B_row_buffer, B_col_buffer, static_cast<unsigned int>(B.size2()),
-                                                 row_C_vector_1, row_C_vector_2, row_C_vector_3);
+    C_row_buffer[std::size_t(i)] = row_C_scan_symbolic_vector(row_start_A, row_end_A, A_col_buffer,
+                                                              B_row_buffer, B_col_buffer, static_cast<unsigned int>(B.size2()),
+                                                              row_C_vector_1, row_C_vector_2, row_C_vector_3);
   }
 
   // exclusive scan to obtain row start indices:
   unsigned int current_offset = 0;
-  for (std::size_t i=0; i<C.size1(); ++i)
+  for (std::size_t i=0; i<A.size1(); ++i)
   {
     unsigned int tmp = C_row_buffer[i];
     C_row_buffer[i] = current_offset;
     current_offset += tmp;
   }
-  C_row_buffer[C.size1()] = current_offset;
-  C.reserve(current_offset, false);
+  C_row_buffer[A.size1()] = current_offset;
+
+  for (unsigned int i=0; i<max_threads; ++i)
+    free(row_C_temp_index_buffers[i]);
+
+  return max_length_row_C[0];
+}
+
+
+/** @brief Numeric phase of the sparse matrix-matrix product C = A * B for CSR matrices: Merges the rows of B into C.
+*
+* C must already provide the number of rows and columns as well as the storage for the number of nonzeros given by C_row_buffer.
+*
+* @param A                 Left factor
+* @param B                 Right factor
+* @param C                 Result matrix
+* @param C_row_buffer      Row start indices of C as obtained from prod_symbolic_impl()
+* @param max_length_row_C  Upper bound for the length of the rows of C as returned by prod_symbolic_impl()
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_numeric_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                       viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+                       viennacl::compressed_matrix<NumericT, AlignmentV> & C,
+                       unsigned int const * C_row_buffer,
+                       unsigned int max_length_row_C)
+{
+  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT     const * B_elements   = detail::extract_raw_pointer<NumericT>(B.handle());
+  unsigned int const * B_row_buffer = detail::extract_raw_pointer<unsigned int>(B.handle1());
+  unsigned int const * B_col_buffer = detail::extract_raw_pointer<unsigned int>(B.handle2());
+
+  unsigned int * C_row_buffer_out = detail::extract_raw_pointer<unsigned int>(C.handle1());
+  if (C_row_buffer_out != C_row_buffer)
+    std::copy(C_row_buffer, C_row_buffer + A.size1() + 1, C_row_buffer_out);
+
+#if defined(VIENNACL_WITH_OPENMP)
+  unsigned int block_factor = 10;
+  unsigned int max_threads = omp_get_max_threads();
+  long chunk_size = long(A.size1()) / long(block_factor * max_threads) + 1;
+#else
+  unsigned int max_threads = 1;
+#endif
+  std::vector<unsigned int *> row_C_temp_index_buffers(max_threads);
+  std::vector<NumericT *>     row_C_temp_value_buffers(max_threads);
 
   // allocate work vectors:
   for (unsigned int i=0; i<max_threads; ++i)
-    row_C_temp_value_buffers[i] = (NumericT *)malloc(sizeof(NumericT)*3*max_length_row_C[0]);
+  {
+    row_C_temp_index_buffers[i] = (unsigned int *)malloc(sizeof(unsigned int)*3*max_length_row_C);
+    row_C_temp_value_buffers[i] = (NumericT *)malloc(sizeof(NumericT)*3*max_length_row_C);
+  }
 
   /*
-   * Stage 3: Compute product (code similar, maybe pull out into a separate function to avoid code duplication?)
+   * Stage 3: Compute product
    */
   NumericT     * C_elements   = detail::extract_raw_pointer<NumericT>(C.handle());
   unsigned int * C_col_buffer = detail::extract_raw_pointer<unsigned int>(C.handle2());
@@ -502,12 +772,12 @@ void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
 #endif
 
     unsigned int *row_C_vector_1 = row_C_temp_index_buffers[thread_id];
-    unsigned int *row_C_vector_2 = row_C_vector_1 + max_length_row_C[0];
-    unsigned int *row_C_vector_3 = row_C_vector_2 + max_length_row_C[0];
+    unsigned int *row_C_vector_2 = row_C_vector_1 + max_length_row_C;
+    unsigned int *row_C_vector_3 = row_C_vector_2 + max_length_row_C;
 
     NumericT *row_C_vector_1_values = row_C_temp_value_buffers[thread_id];
-    NumericT *row_C_vector_2_values = row_C_vector_1_values + max_length_row_C[0];
-    NumericT *row_C_vector_3_values = row_C_vector_2_values + max_length_row_C[0];
+    NumericT *row_C_vector_2_values = row_C_vector_1_values + max_length_row_C;
+    NumericT *row_C_vector_3_values = row_C_vector_2_values + max_length_row_C;
 
     row_C_scan_numeric_vector(row_start_A, row_end_A, A_col_buffer, A_elements,
                               B_row_buffer, B_col_buffer, B_elements, static_cast<unsigned int>(B.size2()),
@@ -523,7 +793,113 @@ void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
     free(row_C_temp_index_buffers[i]);
     free(row_C_temp_value_buffers[i]);
   }
+}
+
+
+/** @brief Numeric phase of the sparse matrix-matrix product C = A * B for CSR matrices if the sparsity pattern of C is known.
+*
+* Instead of merging rows of B, the products are accumulated into the known positions of the entries of C. C must already provide
+* the number of rows and columns as well as the storage for the number of nonzeros given by C_row_buffer.
+*
+* @param A                 Left factor
+* @param B                 Right factor
+* @param C                 Result matrix
+* @param C_row_buffer      Row start indices of C as obtained from prod_symbolic_impl()
+* @param C_col_buffer      Sorted column indices of C as obtained from a previous numeric phase
+* @param C_positions       Workspace of B.size2() entries per thread. Only enlarged if too small, hence no memory is allocated if the same workspace is passed in repeated products.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_numeric_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                       viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+                       viennacl::compressed_matrix<NumericT, AlignmentV> & C,
+                       unsigned int const * C_row_buffer,
+                       unsigned int const * C_col_buffer,
+                       std::vector<unsigned int> & C_positions)
+{
+  NumericT     const * A_elements   = detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * A_row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT     const * B_elements   = detail::extract_raw_pointer<NumericT>(B.handle());
+  unsigned int const * B_row_buffer = detail::extract_raw_pointer<unsigned int>(B.handle1());
+  unsigned int const * B_col_buffer = detail::extract_raw_pointer<unsigned int>(B.handle2());
+
+  unsigned int * C_row_buffer_out = detail::extract_raw_pointer<unsigned int>(C.handle1());
+  unsigned int * C_col_buffer_out = detail::extract_raw_pointer<unsigned int>(C.handle2());
+  NumericT     * C_elements       = detail::extract_raw_pointer<NumericT>(C.handle());
+  if (C_row_buffer_out != C_row_buffer)
+    std::copy(C_row_buffer, C_row_buffer + A.size1() + 1, C_row_buffer_out);
+  if (B.size2() == 0)
+    return;
+
+#ifdef VIENNACL_WITH_OPENMP
+  int num_threads = omp_get_max_threads();
+#else
+  int num_threads = 1;
+#endif
+  if (C_positions.size() < vcl_size_t(num_threads) * B.size2())
+    C_positions.resize(vcl_size_t(num_threads) * B.size2());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel num_threads(num_threads)
+#endif
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    vcl_size_t thread_id = vcl_size_t(omp_get_thread_num());
+#else
+    vcl_size_t thread_id = 0;
+#endif
+    // position of each column of the current row in C:
+    unsigned int * C_position = &(C_positions[0]) + thread_id * B.size2();
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+#endif
+    for (long i = 0; i < long(A.size1()); ++i)
+    {
+      unsigned int row_C_start = C_row_buffer[i];
+      unsigned int row_C_end   = C_row_buffer[i+1];
+
+      for (unsigned int k = row_C_start; k < row_C_end; ++k)
+      {
+        C_col_buffer_out[k] = C_col_buffer[k];
+        C_elements[k]       = NumericT(0);
+        C_position[C_col_buffer[k]] = k;
+      }
+
+      for (unsigned int j = A_row_buffer[i]; j < A_row_buffer[i+1]; ++j)
+      {
+        NumericT A_value = A_elements[j];
+        unsigned int row_B = A_col_buffer[j];
+        for (unsigned int k = B_row_buffer[row_B]; k < B_row_buffer[row_B+1]; ++k)
+          C_elements[C_position[B_col_buffer[k]]] += A_value * B_elements[k];
+      }
+    }
+  }
+}
 
+
+/** @brief Carries out sparse_matrix-sparse_matrix multiplication for CSR matrices
+*
+* Implementation of the convenience expression C = prod(A, B);
+* Based on computing C(i, :) = A(i, :) * B via merging the respective rows of B
+*
+* @param A     Left factor
+* @param B     Right factor
+* @param C     Result matrix
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+               viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+               viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+{
+  std::vector<unsigned int> C_row_buffer;
+  unsigned int max_length_row_C = prod_symbolic_impl(A, B, C_row_buffer);
+
+  C.resize(A.size1(), B.size2(), false);
+  C.reserve(C_row_buffer.back(), false);
+
+  prod_numeric_impl(A, B, C, &(C_row_buffer[0]), max_length_row_C);
 }
 
 
@@ -643,6 +1019,237 @@ namespace detail
     }
   }
 
+
+  /** @brief Level sets of the dependency graph of a sparse triangular solve.
+  *
+  * Row i is in level k if the longest chain of rows it depends on has length k. All rows in a level are independent of each other,
+  * hence the triangular solve can be carried out with one parallel loop per level. Whether this pays off is decided from the depth of the dependency graph:
+  * If the levels are too narrow, the synchronization after each level outweighs the work and the sequential substitution is used instead.
+  */
+  class csr_level_schedule
+  {
+  public:
+    csr_level_schedule() : num_rows_(0) {}
+
+    /** @brief Computes the level sets for a triangular solve with the lower (lower == true) or upper (lower == false) triangular part of a CSR matrix. */
+    template<typename IndexArrayT>
+    void init(IndexArrayT const & row_buffer, IndexArrayT const & col_buffer, vcl_size_t num_rows, bool lower)
+    {
+      num_rows_ = num_rows;
+
+      // level of each row:
+      std::vector<unsigned int> row_level(num_rows);
+      unsigned int num_levels = 0;
+      for (vcl_size_t row2 = 0; row2 < num_rows; ++row2)
+      {
+        vcl_size_t row = lower ? row2 : (num_rows - row2) - 1;
+        unsigned int level = 0;
+        for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+        {
+          vcl_size_t col_index = col_buffer[i];
+          if (lower ? (col_index < row) : (col_index > row))
+            level = std::max<unsigned int>(level, row_level[col_index] + 1);
+        }
+        row_level[row] = level;
+        num_levels = std::max<unsigned int>(num_levels, level + 1);
+      }
+
+      sort_rows(row_level, num_levels);
+    }
+
+    /** @brief Computes the level sets for a triangular solve with the lower (lower == true) or upper (lower == false) triangular part of the transpose of a CSR matrix.
+    *
+    * The dependencies are pushed along the rows of the CSR matrix, so the transpose does not need to be set up explicitly.
+    */
+    template<typename IndexArrayT>
+    void init_transposed(IndexArrayT const & row_buffer, IndexArrayT const & col_buffer, vcl_size_t num_rows, bool lower)
+    {
+      num_rows_ = num_rows;
+
+      // level of each row of the transpose, final once all rows it depends on have been visited:
+      std::vector<unsigned int> row_level(num_rows, 0);
+      unsigned int num_levels = 0;
+      for (vcl_size_t row2 = 0; row2 < num_rows; ++row2)
+      {
+        vcl_size_t row = lower ? row2 : (num_rows - row2) - 1;
+        unsigned int level = row_level[row];
+        for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+        {
+          vcl_size_t col_index = col_buffer[i];
+          if (lower ? (col_index > row) : (col_index < row))
+            row_level[col_index] = std::max<unsigned int>(row_level[col_index], level + 1);
+        }
+        num_levels = std::max<unsigned int>(num_levels, level + 1);
+      }
+
+      sort_rows(row_level, num_levels);
+    }
+
+    /** @brief Returns the number of levels, i.e. the depth of the dependency graph */
+    vcl_size_t levels() const { return level_start_.size() > 0 ? level_start_.size() - 1 : 0; }
+
+    /** @brief Returns true if the levels are wide enough for a parallel solve to pay off */
+    bool worthwhile() const { return levels() > 0 && num_rows_ >= VIENNACL_OPENMP_TRIANGULAR_MIN_ROWS_PER_LEVEL * levels(); }
+
+    /** @brief Returns true if the triangular solve is run level by level in parallel */
+    bool parallel() const
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      return worthwhile() && omp_get_max_threads() > 1;
+#else
+      return false;
+#endif
+    }
+
+    unsigned int const * level_start() const { return &(level_start_[0]); }
+    unsigned int const * level_rows()  const { return &(level_rows_[0]); }
+
+  private:
+    /** @brief Sorts the rows by level (stable, so rows within a level are in ascending order) */
+    void sort_rows(std::vector<unsigned int> const & row_level, unsigned int num_levels)
+    {
+      vcl_size_t num_rows = row_level.size();
+      level_start_.assign(num_levels + 1, 0);
+      for (vcl_size_t row = 0; row < num_rows; ++row)
+        ++level_start_[row_level[row] + 1];
+      for (vcl_size_t level = 0; level < num_levels; ++level)
+        level_start_[level + 1] += level_start_[level];
+
+      std::vector<unsigned int> level_position(level_start_.begin(), level_start_.begin() + num_levels);
+      level_rows_.resize(num_rows);
+      for (vcl_size_t row = 0; row < num_rows; ++row)
+        level_rows_[level_position[row_level[row]]++] = static_cast<unsigned int>(row);
+    }
+
+    vcl_size_t num_rows_;
+    std::vector<unsigned int> level_start_;
+    std::vector<unsigned int> level_rows_;
+  };
+
+  /** @brief Level-scheduled triangular substitution. The rows of each level are processed in parallel, the implicit barrier at the end of each loop separates the levels. */
+  template<typename NumericT, typename ConstScalarArrayT, typename ScalarArrayT, typename IndexArrayT>
+  void csr_level_scheduled_inplace_solve(IndexArrayT const & row_buffer,
+                                         IndexArrayT const & col_buffer,
+                                         ConstScalarArrayT const & element_buffer,
+                                         ScalarArrayT & vec_buffer,
+                                         csr_level_schedule const & schedule,
+                                         bool lower,
+                                         bool unit_diagonal)
+  {
+    unsigned int const * level_start = schedule.level_start();
+    unsigned int const * level_rows  = schedule.level_rows();
+    long num_levels = static_cast<long>(schedule.levels());
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    for (long level = 0; level < num_levels; ++level)
+    {
+      long level_begin = static_cast<long>(level_start[level]);
+      long level_end   = static_cast<long>(level_start[level + 1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long k = level_begin; k < level_end; ++k)
+      {
+        vcl_size_t row = level_rows[k];
+        NumericT vec_entry = vec_buffer[row];
+        NumericT diagonal_entry = 1;
+        for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+        {
+          vcl_size_t col_index = col_buffer[i];
+          if (lower ? (col_index < row) : (col_index > row))
+            vec_entry -= vec_buffer[col_index] * element_buffer[i];
+          else if (col_index == row && !unit_diagonal)
+            diagonal_entry = element_buffer[i];
+        }
+        vec_buffer[row] = unit_diagonal ? vec_entry : vec_entry / diagonal_entry;
+      }
+    }
+  }
+
+  /** @brief Triangular solves using the level schedule if it runs in parallel, otherwise the sequential substitution above */
+  template<typename NumericT, typename ConstScalarArrayT, typename ScalarArrayT, typename IndexArrayT>
+  void csr_inplace_solve(IndexArrayT const & row_buffer,
+                         IndexArrayT const & col_buffer,
+                         ConstScalarArrayT const & element_buffer,
+                         ScalarArrayT & vec_buffer,
+                         vcl_size_t num_cols,
+                         csr_level_schedule const & schedule,
+                         viennacl::linalg::unit_lower_tag tag)
+  {
+    if (schedule.parallel())
+      csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, schedule, true, true);
+    else
+      csr_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, num_cols, tag);
+  }
+
+  template<typename NumericT, typename ConstScalarArrayT, typename ScalarArrayT, typename IndexArrayT>
+  void csr_inplace_solve(IndexArrayT const & row_buffer,
+                         IndexArrayT const & col_buffer,
+                         ConstScalarArrayT const & element_buffer,
+                         ScalarArrayT & vec_buffer,
+                         vcl_size_t num_cols,
+                         csr_level_schedule const & schedule,
+                         viennacl::linalg::lower_tag tag)
+  {
+    if (schedule.parallel())
+      csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, schedule, true, false);
+    else
+      csr_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, num_cols, tag);
+  }
+
+  template<typename NumericT, typename ConstScalarArrayT, typename ScalarArrayT, typename IndexArrayT>
+  void csr_inplace_solve(IndexArrayT const & row_buffer,
+                         IndexArrayT const & col_buffer,
+                         ConstScalarArrayT const & element_buffer,
+                         ScalarArrayT & vec_buffer,
+                         vcl_size_t num_cols,
+                         csr_level_schedule const & schedule,
+                         viennacl::linalg::unit_upper_tag tag)
+  {
+    if (schedule.parallel())
+      csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, schedule, false, true);
+    else
+      csr_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, num_cols, tag);
+  }
+
+  template<typename NumericT, typename ConstScalarArrayT, typename ScalarArrayT, typename IndexArrayT>
+  void csr_inplace_solve(IndexArrayT const & row_buffer,
+                         IndexArrayT const & col_buffer,
+                         ConstScalarArrayT const & element_buffer,
+                         ScalarArrayT & vec_buffer,
+                         vcl_size_t num_cols,
+                         csr_level_schedule const & schedule,
+                         viennacl::linalg::upper_tag tag)
+  {
+    if (schedule.parallel())
+      csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, schedule, false, false);
+    else
+      csr_inplace_solve<NumericT>(row_buffer, col_buffer, element_buffer, vec_buffer, num_cols, tag);
+  }
+
+  /** @brief Computes the level schedule for a triangular solve with the lower or upper triangular part of a compressed_matrix in host memory */
+  template<typename NumericT, unsigned int AlignmentV>
+  void csr_level_schedule_setup(compressed_matrix<NumericT, AlignmentV> const & A, csr_level_schedule & schedule, bool lower)
+  {
+    unsigned int const * row_buffer = extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = extract_raw_pointer<unsigned int>(A.handle2());
+
+    schedule.init(row_buffer, col_buffer, A.size1(), lower);
+  }
+
+  /** @brief Computes the level schedule for a triangular solve with the lower or upper triangular part of the transpose of a compressed_matrix in host memory */
+  template<typename NumericT, unsigned int AlignmentV>
+  void csr_trans_level_schedule_setup(compressed_matrix<NumericT, AlignmentV> const & A, csr_level_schedule & schedule, bool lower)
+  {
+    unsigned int const * row_buffer = extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = extract_raw_pointer<unsigned int>(A.handle2());
+
+    schedule.init_transposed(row_buffer, col_buffer, A.size2(), lower);
+  }
+
 } //namespace detail
 
 
@@ -1785,6 +2392,16 @@ void prod_impl(const viennacl::ell_matrix<NumericT, AlignmentV> & sp_mat,
 //
 // SELL-C-\sigma Matrix
 //
+namespace detail
+{
+  /** @brief Slice height C of a sliced_ell_matrix in main memory if not set by the user: the SIMD width of the host for NumericT, but at least 8 rows. */
+  template<typename NumericT>
+  vcl_size_t sell_host_rows_per_block()
+  {
+    return std::max<vcl_size_t>(8, get_host_kernels<NumericT>().simd_width);
+  }
+}
+
 /** @brief Carries out matrix-vector multiplication with a sliced_ell_matrix
 *
 * Implementation of the convenience expression result = prod(mat, vec);
@@ -1807,50 +2424,43 @@ void prod_impl(const viennacl::sliced_ell_matrix<NumericT, IndexT> & mat,
   IndexT   const * column_indices    = detail::extract_raw_pointer<IndexT>(mat.handle2());
   IndexT   const * block_start       = detail::extract_raw_pointer<IndexT>(mat.handle3());
 
-  vcl_size_t num_blocks = mat.size1() / mat.rows_per_block() + 1;
+  if (mat.size1() == 0)
+    return;
+
+  detail::host_kernels<NumericT> const & kernels = detail::get_host_kernels<NumericT>();
+
+  vcl_size_t rows_per_block = mat.rows_per_block();
+  vcl_size_t num_blocks = (mat.size1() - 1) / rows_per_block + 1;
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel
 #endif
-  for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
   {
-    vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
-    vcl_size_t current_columns_per_block = columns_per_block[block_idx];
+    std::vector<NumericT> result_values(rows_per_block);
 
-    std::vector<NumericT> result_values(mat.rows_per_block());
-
-    for (IndexT column_entry_index = 0;
-                column_entry_index < current_columns_per_block;
-              ++column_entry_index)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
     {
-      vcl_size_t stride_start = block_start[block_idx] + column_entry_index * mat.rows_per_block();
-      // Note: This for-loop may be unrolled by hand for exploiting vectorization
-      //       Careful benchmarking recommended first, memory channels may be saturated already!
-      for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
-      {
-        NumericT val = elements[stride_start + row_in_block];
+      vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
 
-        result_values[row_in_block] += (val > 0 || val < 0) ? vec_buf[column_indices[stride_start + row_in_block] * vec.stride() + vec.start()] * val : 0;
-      }
-    }
+      detail::sell_slice(kernels, elements + block_start[block_idx], column_indices + block_start[block_idx], columns_per_block[block_idx], rows_per_block,
+                         vec_buf, vec.start(), vec.stride(), &(result_values[0]));
 
-    vcl_size_t first_row_in_matrix = block_idx * mat.rows_per_block();
-    if (beta < 0 || beta > 0)
-    {
-      for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
+      vcl_size_t first_row_in_matrix = block_idx * rows_per_block;
+      vcl_size_t rows_in_block = std::min(rows_per_block, result.size() - first_row_in_matrix);
+      if (beta < 0 || beta > 0)
       {
-        if (first_row_in_matrix + row_in_block < result.size())
+        for (vcl_size_t row_in_block = 0; row_in_block < rows_in_block; ++row_in_block)
         {
           vcl_size_t index = (first_row_in_matrix + row_in_block) * result.stride() + result.start();
           result_buf[index] = alpha * result_values[row_in_block] + beta * result_buf[index];
         }
       }
-    }
-    else
-    {
-      for (IndexT row_in_block = 0; row_in_block < mat.rows_per_block(); ++row_in_block)
+      else
       {
-        if (first_row_in_matrix + row_in_block < result.size())
+        for (vcl_size_t row_in_block = 0; row_in_block < rows_in_block; ++row_in_block)
           result_buf[(first_row_in_matrix + row_in_block) * result.stride() + result.start()] = alpha * result_values[row_in_block];
       }
     }
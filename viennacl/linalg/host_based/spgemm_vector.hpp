@@ -18,17 +18,13 @@
    License:         MIT (X11), see file LICENSE in the base directory
 ============================================================================= */
 
-/** @file viennacl/linalg/host_based/sparse_matrix_operations.hpp
-    @brief Implementations of operations using sparse matrices on the CPU using a single thread or OpenMP.
+/** @file viennacl/linalg/host_based/spgemm_vector.hpp
+    @brief Row merge kernels for sparse matrix-matrix products on the CPU. The AVX2 kernels are selected at runtime if supported by the CPU.
 */
 
 #include "viennacl/forwards.h"
 #include "viennacl/linalg/host_based/common.hpp"
-
-
-#ifdef VIENNACL_WITH_AVX2
-#include "immintrin.h"
-#endif
+#include "viennacl/tools/cpu_features.hpp"
 
 
 namespace viennacl
@@ -40,8 +36,8 @@ namespace host_based
 
 
 
-#ifdef VIENNACL_WITH_AVX2
-inline
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+VIENNACL_TARGET_AVX2 inline
 unsigned int row_C_scan_symbolic_vector_AVX2(int const *row_indices_B_begin, int const *row_indices_B_end,
                                              int const *B_row_buffer, int const *B_col_buffer, int B_size2,
                                              int *row_C_vector_output)
@@ -50,7 +46,7 @@ unsigned int row_C_scan_symbolic_vector_AVX2(int const *row_indices_B_begin, int
   __m256i avx_all_bsize2  = _mm256_set_epi32(B_size2, B_size2, B_size2, B_size2, B_size2, B_size2, B_size2, B_size2);
 
   __m256i avx_row_indices_offsets = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
-  __m256i avx_load_mask = _mm256_sub_epi32(avx_row_indices_offsets, _mm256_set1_epi32(row_indices_B_end - row_indices_B_begin));
+  __m256i avx_load_mask = _mm256_sub_epi32(avx_row_indices_offsets, _mm256_set1_epi32(static_cast<int>(row_indices_B_end - row_indices_B_begin)));
   __m256i avx_load_mask2 = avx_load_mask;
 
   __m256i avx_row_indices = _mm256_set1_epi32(0);
@@ -79,7 +75,7 @@ unsigned int row_C_scan_symbolic_vector_AVX2(int const *row_indices_B_begin, int
     avx_temp       = _mm256_shuffle_epi32(avx_index_min1, int(177));    // 0b10110001 = 177, using shuffle instead of permutevar here because of lower latency
     avx_index_min1 = _mm256_min_epi32(avx_index_min1, avx_temp); // now all entries of avx_index_min1 hold the minimum
 
-    int min_index_in_front = ((int*)&avx_index_min1)[0];
+    int min_index_in_front = _mm_cvtsi128_si32(_mm256_castsi256_si128(avx_index_min1));
     // check for end of merge operation:
     if (min_index_in_front == B_size2)
       break;
@@ -218,6 +214,10 @@ unsigned int row_C_scan_symbolic_vector(unsigned int row_start_A, unsigned int r
     return B_row_buffer[A_col + 1] - B_row_buffer[A_col];
   }
 
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+  bool use_AVX2 = viennacl::tools::host_isa() >= viennacl::tools::ISA_AVX2;
+#endif
+
   // Optimizations for row length 2:
   unsigned int row_C_len = 0;
   if (row_end_A - row_start_A == 2)
@@ -231,27 +231,32 @@ unsigned int row_C_scan_symbolic_vector(unsigned int row_start_A, unsigned int r
   }
   else // for more than two rows we can safely merge the first two:
   {
-#ifdef VIENNACL_WITH_AVX2
-    row_C_len = row_C_scan_symbolic_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A),
-                                                (const int*)B_row_buffer, (const int*)B_col_buffer, int(B_size2),
-                                                (int*)row_C_vector_1);
-    row_start_A += 8;
-#else
-    unsigned int A_col_1 = A_col_buffer[row_start_A];
-    unsigned int A_col_2 = A_col_buffer[row_start_A + 1];
-    row_C_len =  row_C_scan_symbolic_vector_1<spgemm_output_write_enabled>(B_col_buffer + B_row_buffer[A_col_1], B_col_buffer + B_row_buffer[A_col_1 + 1],
-                                                                           B_col_buffer + B_row_buffer[A_col_2], B_col_buffer + B_row_buffer[A_col_2 + 1],
-                                                                           B_size2,
-                                                                           row_C_vector_1);
-    row_start_A += 2;
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+    if (use_AVX2)
+    {
+      row_C_len = row_C_scan_symbolic_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A),
+                                                  (const int*)B_row_buffer, (const int*)B_col_buffer, int(B_size2),
+                                                  (int*)row_C_vector_1);
+      row_start_A += 8;
+    }
+    else
 #endif
+    {
+      unsigned int A_col_1 = A_col_buffer[row_start_A];
+      unsigned int A_col_2 = A_col_buffer[row_start_A + 1];
+      row_C_len =  row_C_scan_symbolic_vector_1<spgemm_output_write_enabled>(B_col_buffer + B_row_buffer[A_col_1], B_col_buffer + B_row_buffer[A_col_1 + 1],
+                                                                             B_col_buffer + B_row_buffer[A_col_2], B_col_buffer + B_row_buffer[A_col_2 + 1],
+                                                                             B_size2,
+                                                                             row_C_vector_1);
+      row_start_A += 2;
+    }
   }
 
   // all other row lengths:
   while (row_end_A > row_start_A)
   {
-#ifdef VIENNACL_WITH_AVX2
-    if (row_end_A - row_start_A > 2) // we deal with one or two remaining rows more efficiently below:
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+    if (use_AVX2 && row_end_A - row_start_A > 2) // we deal with one or two remaining rows more efficiently below:
     {
       unsigned int merged_len = row_C_scan_symbolic_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A),
                                                                 (const int*)B_row_buffer, (const int*)B_col_buffer, int(B_size2),
@@ -392,8 +397,8 @@ unsigned int row_C_scan_numeric_vector_N(unsigned int const *row_indices_B, Nume
 
 
 
-#ifdef VIENNACL_WITH_AVX2
-inline
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+VIENNACL_TARGET_AVX2 inline
 unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int const *row_indices_B_end, double const *values_A,
                                              int const *B_row_buffer, int const *B_col_buffer, double const *B_elements,
                                              int B_size2,
@@ -403,7 +408,7 @@ unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int
   __m256i avx_all_bsize2  = _mm256_set_epi32(B_size2, B_size2, B_size2, B_size2, B_size2, B_size2, B_size2, B_size2);
 
   __m256i avx_row_indices_offsets = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
-  __m256i avx_load_mask = _mm256_sub_epi32(avx_row_indices_offsets, _mm256_set1_epi32(row_indices_B_end - row_indices_B_begin));
+  __m256i avx_load_mask = _mm256_sub_epi32(avx_row_indices_offsets, _mm256_set1_epi32(static_cast<int>(row_indices_B_end - row_indices_B_begin)));
   __m256i avx_load_mask2 = avx_load_mask;
 
   __m256i avx_row_indices = _mm256_set1_epi32(0);
@@ -414,12 +419,12 @@ unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int
   __m256d avx_value_A_low  = _mm256_mask_i32gather_pd(_mm256_set_pd(0, 0, 0, 0), //src
                                                       values_A,                  //base ptr
                                                       _mm256_extractf128_si256(avx_row_indices_offsets, 0),                           //indices
-                                                      _mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(3, 7, 2, 6, 1, 5, 0, 4)), 8); // mask
+                                                      _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(3, 7, 2, 6, 1, 5, 0, 4))), 8); // mask
   avx_load_mask = avx_load_mask2; // reload mask (destroyed by gather)
   __m256d avx_value_A_high  = _mm256_mask_i32gather_pd(_mm256_set_pd(0, 0, 0, 0), //src
                                                        values_A,                  //base ptr
                                                        _mm256_extractf128_si256(avx_row_indices_offsets, 1),                           //indices
-                                                       _mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0)), 8); // mask
+                                                       _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0))), 8); // mask
 
 
             avx_load_mask = avx_load_mask2; // reload mask (destroyed by gather)
@@ -437,12 +442,12 @@ unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int
   __m256d avx_value_front_low  = _mm256_mask_i32gather_pd(_mm256_set_pd(0, 0, 0, 0), //src
                                                           B_elements,                  //base ptr
                                                           _mm256_extractf128_si256(avx_row_start, 0),                           //indices
-                                                          _mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(3, 7, 2, 6, 1, 5, 0, 4)), 8); // mask
+                                                          _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(3, 7, 2, 6, 1, 5, 0, 4))), 8); // mask
   avx_load_mask = avx_load_mask2; // reload mask (destroyed by gather)
   __m256d avx_value_front_high  = _mm256_mask_i32gather_pd(_mm256_set_pd(0, 0, 0, 0), //src
                                                            B_elements,                  //base ptr
                                                            _mm256_extractf128_si256(avx_row_start, 1),                           //indices
-                                                           _mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0)), 8); // mask
+                                                           _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0))), 8); // mask
 
   int *output_ptr = row_C_vector_output;
 
@@ -459,30 +464,28 @@ unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int
     avx_temp       = _mm256_shuffle_epi32(avx_index_min1, int(177));    // 0b10110001 = 177, using shuffle instead of permutevar here because of lower latency
     avx_index_min1 = _mm256_min_epi32(avx_index_min1, avx_temp); // now all entries of avx_index_min1 hold the minimum
 
-    int min_index_in_front = ((int*)&avx_index_min1)[0];
+    int min_index_in_front = _mm_cvtsi128_si32(_mm256_castsi256_si128(avx_index_min1));
     // check for end of merge operation:
     if (min_index_in_front == B_size2)
       break;
 
-    // accumulate value (can certainly be done more elegantly...)
-    double value = 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[0]) ? ((double*)&avx_value_front_low)[0] * ((double*)&avx_value_A_low)[0] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[1]) ? ((double*)&avx_value_front_low)[1] * ((double*)&avx_value_A_low)[1] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[2]) ? ((double*)&avx_value_front_low)[2] * ((double*)&avx_value_A_low)[2] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[3]) ? ((double*)&avx_value_front_low)[3] * ((double*)&avx_value_A_low)[3] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[4]) ? ((double*)&avx_value_front_high)[0] * ((double*)&avx_value_A_high)[0] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[5]) ? ((double*)&avx_value_front_high)[1] * ((double*)&avx_value_A_high)[1] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[6]) ? ((double*)&avx_value_front_high)[2] * ((double*)&avx_value_A_high)[2] : 0;
-    value += (min_index_in_front == ((int*)&avx_index_front)[7]) ? ((double*)&avx_value_front_high)[3] * ((double*)&avx_value_A_high)[3] : 0;
-    *row_C_vector_output_values = value;
+    // accumulate value: sum of the products in the lanes holding the minimum index (64-bit masks obtained by sign extension of the 32-bit masks)
+    avx_load_mask = _mm256_cmpeq_epi32(avx_index_front, avx_index_min1);
+    __m256d avx_products_low  = _mm256_and_pd(_mm256_mul_pd(avx_value_front_low,  avx_value_A_low),
+                                              _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(avx_load_mask))));
+    __m256d avx_products_high = _mm256_and_pd(_mm256_mul_pd(avx_value_front_high, avx_value_A_high),
+                                              _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(avx_load_mask, 1))));
+    __m256d avx_products = _mm256_add_pd(avx_products_low, avx_products_high);
+    __m128d sse_sum      = _mm_add_pd(_mm256_castpd256_pd128(avx_products), _mm256_extractf128_pd(avx_products, 1));
+    sse_sum              = _mm_add_sd(sse_sum, _mm_unpackhi_pd(sse_sum, sse_sum));
+    *row_C_vector_output_values = _mm_cvtsd_f64(sse_sum);
     ++row_C_vector_output_values;
 
     // write current entry:
     *output_ptr = min_index_in_front;
     ++output_ptr;
 
-    // advance index front where equal to minimum index:
-    avx_load_mask   = _mm256_cmpeq_epi32(avx_index_front, avx_index_min1);
+    // advance index front where equal to minimum index (mask computed above):
     // first part: set index to B_size2 if equal to minimum index:
     avx_temp        = _mm256_and_si256(avx_all_bsize2, avx_load_mask);
     avx_index_front = _mm256_max_epi32(avx_index_front, avx_temp);
@@ -499,13 +502,13 @@ unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int
     avx_value_front_low = _mm256_mask_i32gather_pd(avx_value_front_low, //src
                                             B_elements,                  //base ptr
                                             _mm256_extractf128_si256(avx_row_start, 0),                           //indices
-                                            _mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(3, 7, 2, 6, 1, 5, 0, 4)), 8); // mask
+                                            _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(3, 7, 2, 6, 1, 5, 0, 4))), 8); // mask
 
     avx_load_mask = avx_load_mask2; // reload mask (destroyed by gather)
     avx_value_front_high = _mm256_mask_i32gather_pd(avx_value_front_high, //src
                                     B_elements,                  //base ptr
                                     _mm256_extractf128_si256(avx_row_start, 1),                           //indices
-                                    _mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0)), 8); // mask
+                                    _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(avx_load_mask, _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0))), 8); // mask
 
     //multiply new entries:
 
@@ -513,6 +516,19 @@ unsigned int row_C_scan_numeric_vector_AVX2(int const *row_indices_B_begin, int
 
   return static_cast<unsigned int>(output_ptr - row_C_vector_output);
 }
+
+/** @brief Compile-time flag for the availability of the AVX2 kernel for the numeric phase. Only available for double precision. */
+template<typename NumericT>
+struct row_C_scan_numeric_vector_AVX2_available
+{
+  static const bool value = false;
+};
+
+template<>
+struct row_C_scan_numeric_vector_AVX2_available<double>
+{
+  static const bool value = true;
+};
 #endif
 
 
@@ -563,8 +579,9 @@ unsigned int row_C_scan_numeric_vector_1(unsigned int const *input1_index_begin,
   return static_cast<unsigned int>(output_ptr - output_index_begin);
 }
 
+/** @brief Merges the rows of B selected by the row of A into C(row_start_C:row_end_C) and returns the number of entries written. */
 template<typename NumericT>
-void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A, unsigned int const *A_col_buffer, NumericT const *A_elements,
+unsigned int row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A, unsigned int const *A_col_buffer, NumericT const *A_elements,
                                unsigned int const *B_row_buffer, unsigned int const *B_col_buffer, NumericT const *B_elements, unsigned int B_size2,
                                unsigned int row_start_C, unsigned int row_end_C, unsigned int *C_col_buffer, NumericT *C_elements,
                                unsigned int *row_C_vector_1, NumericT *row_C_vector_1_values,
@@ -575,7 +592,7 @@ void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A,
 
   // Trivial case: row length 0:
   if (row_start_A == row_end_A)
-    return;
+    return 0;
 
   // Trivial case: row length 1:
   if (row_end_A - row_start_A == 1)
@@ -590,9 +607,14 @@ void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A,
       *C_col_buffer = B_col_buffer[j];
       *C_elements = A_value * B_elements[j];
     }
-    return;
+    return B_end - B_row_buffer[A_col];
   }
 
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+  // The branches below are only taken for double precision, hence the pointer casts for the AVX2 kernel are no-ops:
+  bool use_AVX2 = row_C_scan_numeric_vector_AVX2_available<NumericT>::value && viennacl::tools::host_isa() >= viennacl::tools::ISA_AVX2;
+#endif
+
   unsigned int row_C_len = 0;
   if (row_end_A - row_start_A == 2) // directly merge to C:
   {
@@ -602,18 +624,17 @@ void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A,
     unsigned int B_offset_1 = B_row_buffer[A_col_1];
     unsigned int B_offset_2 = B_row_buffer[A_col_2];
 
-    row_C_scan_numeric_vector_1(B_col_buffer + B_offset_1, B_col_buffer + B_row_buffer[A_col_1+1], B_elements + B_offset_1, A_elements[row_start_A],
-                                B_col_buffer + B_offset_2, B_col_buffer + B_row_buffer[A_col_2+1], B_elements + B_offset_2, A_elements[row_start_A + 1],
-                                B_size2,
-                                C_col_buffer + row_start_C, C_elements + row_start_C);
-    return;
+    return row_C_scan_numeric_vector_1(B_col_buffer + B_offset_1, B_col_buffer + B_row_buffer[A_col_1+1], B_elements + B_offset_1, A_elements[row_start_A],
+                                       B_col_buffer + B_offset_2, B_col_buffer + B_row_buffer[A_col_2+1], B_elements + B_offset_2, A_elements[row_start_A + 1],
+                                       B_size2,
+                                       C_col_buffer + row_start_C, C_elements + row_start_C);
   }
-#ifdef VIENNACL_WITH_AVX2
-  else if (row_end_A - row_start_A > 10) // safely merge eight rows into temporary buffer:
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+  else if (use_AVX2 && row_end_A - row_start_A > 10) // safely merge eight rows into temporary buffer:
   {
-    row_C_len = row_C_scan_numeric_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A), A_elements + row_start_A,
-                                               (const int*)B_row_buffer, (const int*)B_col_buffer, B_elements, int(B_size2),
-                                               (int*)row_C_vector_1, row_C_vector_1_values);
+    row_C_len = row_C_scan_numeric_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A), reinterpret_cast<double const *>(A_elements + row_start_A),
+                                               (const int*)B_row_buffer, (const int*)B_col_buffer, reinterpret_cast<double const *>(B_elements), int(B_size2),
+                                               (int*)row_C_vector_1, reinterpret_cast<double *>(row_C_vector_1_values));
     row_start_A += 8;
   }
 #endif
@@ -635,12 +656,12 @@ void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A,
   // process remaining rows:
   while (row_end_A > row_start_A)
   {
-#ifdef VIENNACL_WITH_AVX2
-    if (row_end_A - row_start_A > 9) // code in other if-conditionals ensures that values get written to C
+#ifdef VIENNACL_HAVE_AVX2_KERNELS
+    if (use_AVX2 && row_end_A - row_start_A > 9) // code in other if-conditionals ensures that values get written to C
     {
-      unsigned int merged_len = row_C_scan_numeric_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A), A_elements + row_start_A,
-                                                               (const int*)B_row_buffer, (const int*)B_col_buffer, B_elements, int(B_size2),
-                                                               (int*)row_C_vector_3, row_C_vector_3_values);
+      unsigned int merged_len = row_C_scan_numeric_vector_AVX2((const int*)(A_col_buffer + row_start_A), (const int*)(A_col_buffer + row_end_A), reinterpret_cast<double const *>(A_elements + row_start_A),
+                                                               (const int*)B_row_buffer, (const int*)B_col_buffer, reinterpret_cast<double const *>(B_elements), int(B_size2),
+                                                               (int*)row_C_vector_3, reinterpret_cast<double *>(row_C_vector_3_values));
       row_C_len = row_C_scan_numeric_vector_1(row_C_vector_3, row_C_vector_3 + merged_len, row_C_vector_3_values, NumericT(1.0),
                                               row_C_vector_1, row_C_vector_1 + row_C_len, row_C_vector_1_values, NumericT(1.0),
                                               B_size2,
@@ -654,11 +675,10 @@ void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A,
       unsigned int A_col    = A_col_buffer[row_start_A];
       unsigned int B_offset = B_row_buffer[A_col];
 
-      row_C_len = row_C_scan_numeric_vector_1(B_col_buffer + B_offset, B_col_buffer + B_row_buffer[A_col+1], B_elements + B_offset, A_elements[row_start_A],
-                                              row_C_vector_1, row_C_vector_1 + row_C_len, row_C_vector_1_values, NumericT(1.0),
-                                              B_size2,
-                                              C_col_buffer + row_start_C, C_elements + row_start_C);
-      return;
+      return row_C_scan_numeric_vector_1(B_col_buffer + B_offset, B_col_buffer + B_row_buffer[A_col+1], B_elements + B_offset, A_elements[row_start_A],
+                                         row_C_vector_1, row_C_vector_1 + row_C_len, row_C_vector_1_values, NumericT(1.0),
+                                         B_size2,
+                                         C_col_buffer + row_start_C, C_elements + row_start_C);
     }
     else if (row_start_A + 2 < row_end_A)// at least three more rows left, so merge two
     {
@@ -694,6 +714,8 @@ void row_C_scan_numeric_vector(unsigned int row_start_A, unsigned int row_end_A,
     std::swap(row_C_vector_1,        row_C_vector_2);
     std::swap(row_C_vector_1_values, row_C_vector_2_values);
   }
+
+  return row_C_len; // not reached, the last row is always merged into C above
 }
 
 
@@ -33,6 +33,7 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/simd_kernels.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
@@ -152,6 +153,12 @@ void avbv(vector_base<NumericT> & vec1,
   vcl_size_t start3 = viennacl::traits::start(vec3);
   vcl_size_t inc3   = viennacl::traits::stride(vec3);
 
+  if (detail::host_kernel_table<NumericT>::is_simd && !reciprocal_alpha && !reciprocal_beta && inc1 == 1 && inc2 == 1 && inc3 == 1)
+  {
+    detail::host_axpby(data_vec1 + start1, data_alpha, data_vec2 + start2, data_beta, data_vec3 + start3, size1, false);
+    return;
+  }
+
   if (reciprocal_alpha)
   {
     if (reciprocal_beta)
@@ -222,6 +229,12 @@ void avbv_v(vector_base<NumericT> & vec1,
   vcl_size_t start3 = viennacl::traits::start(vec3);
   vcl_size_t inc3   = viennacl::traits::stride(vec3);
 
+  if (detail::host_kernel_table<NumericT>::is_simd && !reciprocal_alpha && !reciprocal_beta && inc1 == 1 && inc2 == 1 && inc3 == 1)
+  {
+    detail::host_axpby(data_vec1 + start1, data_alpha, data_vec2 + start2, data_beta, data_vec3 + start3, size1, true);
+    return;
+  }
+
   if (reciprocal_alpha)
   {
     if (reciprocal_beta)
@@ -570,8 +583,11 @@ void inner_prod_impl(vector_base<NumericT> const & vec1,
   vcl_size_t start2 = viennacl::traits::start(vec2);
   vcl_size_t inc2   = viennacl::traits::stride(vec2);
 
-  result = detail::inner_prod_impl(data_vec1, start1, inc1, size1,
-                                   data_vec2, start2, inc2);  //Note: Assignment to result might be expensive, thus a temporary is introduced here
+  if (detail::host_kernel_table<NumericT>::is_simd && inc1 == 1 && inc2 == 1)
+    result = detail::host_dot(data_vec1 + start1, data_vec2 + start2, size1);
+  else
+    result = detail::inner_prod_impl(data_vec1, start1, inc1, size1,
+                                     data_vec2, start2, inc2);  //Note: Assignment to result might be expensive, thus a temporary is introduced here
 }
 
 template<typename NumericT>
@@ -829,7 +845,10 @@ void norm_2_impl(vector_base<NumericT> const & vec1,
   vcl_size_t inc1   = viennacl::traits::stride(vec1);
   vcl_size_t size1  = viennacl::traits::size(vec1);
 
-  result = std::sqrt(detail::norm_2_impl(data_vec1, start1, inc1, size1));  //Note: Assignment to result might be expensive, thus 'temp' is used for accumulation
+  if (detail::host_kernel_table<NumericT>::is_simd && inc1 == 1)
+    result = std::sqrt(detail::host_dot(data_vec1 + start1, data_vec1 + start1, size1));
+  else
+    result = std::sqrt(detail::norm_2_impl(data_vec1, start1, inc1, size1));  //Note: Assignment to result might be expensive, thus 'temp' is used for accumulation
 }
 
 /** @brief Computes the supremum-norm of a vector
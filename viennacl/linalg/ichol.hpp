@@ -30,6 +30,7 @@
 #include "viennacl/compressed_matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 
 #include <map>
 
@@ -121,6 +122,69 @@ void precondition(viennacl::compressed_matrix<NumericT> & A, ichol0_tag const &
 }
 
 
+namespace detail
+{
+  /** @brief Extracts the factor L in CSR format from the upper triangular part of a matrix factored by precondition(A, ichol0_tag()).
+  *
+  * The factor is stored transposed in the upper triangular part, hence the forward substitution with L runs column by column, which cannot be parallelized.
+  * The explicit copy of L allows for a row-oriented, level-scheduled forward substitution.
+  * It is only set up by ichol0_setup_lower() if the level schedule of L is wide enough to be used.
+  */
+  template<typename NumericT>
+  void ichol0_extract_lower(viennacl::compressed_matrix<NumericT> const & LLT, viennacl::compressed_matrix<NumericT> & L)
+  {
+    unsigned int const * LLT_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle1());
+    unsigned int const * LLT_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle2());
+    NumericT     const * LLT_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LLT.handle());
+
+    vcl_size_t n = LLT.size1();
+
+    // count entries per column of the upper triangular part:
+    std::vector<unsigned int> L_rows(n + 1, 0);
+    for (vcl_size_t row = 0; row < n; ++row)
+      for (unsigned int i = LLT_row_buffer[row]; i < LLT_row_buffer[row+1]; ++i)
+        if (LLT_col_buffer[i] >= row)
+          ++L_rows[LLT_col_buffer[i] + 1];
+    for (vcl_size_t row = 0; row < n; ++row)
+      L_rows[row + 1] += L_rows[row];
+
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::switch_memory_context(L, host_context);
+    L = viennacl::compressed_matrix<NumericT>(n, n, L_rows[n], host_context);
+
+    unsigned int * L_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle1());
+    unsigned int * L_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle2());
+    NumericT     * L_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L.handle());
+
+    std::copy(L_rows.begin(), L_rows.end(), L_row_buffer);
+
+    // scatter (rows of LLT are traversed in ascending order, so columns of L end up sorted):
+    for (vcl_size_t row = 0; row < n; ++row)
+      for (unsigned int i = LLT_row_buffer[row]; i < LLT_row_buffer[row+1]; ++i)
+        if (LLT_col_buffer[i] >= row)
+        {
+          unsigned int index = L_rows[LLT_col_buffer[i]]++;
+          L_col_buffer[index] = static_cast<unsigned int>(row);
+          L_elements[index]   = LLT_elements[i];
+        }
+  }
+
+  /** @brief Computes the level schedule of L from the upper triangular part of LLT and extracts L only if the schedule may be used for a parallel forward substitution. */
+  template<typename NumericT>
+  void ichol0_setup_lower(viennacl::compressed_matrix<NumericT> const & LLT, viennacl::compressed_matrix<NumericT> & L,
+                          viennacl::linalg::host_based::detail::csr_level_schedule & L_schedule)
+  {
+    viennacl::linalg::host_based::detail::csr_trans_level_schedule_setup(LLT, L_schedule, true);
+#ifdef VIENNACL_WITH_OPENMP
+    if (L_schedule.worthwhile())
+      ichol0_extract_lower(LLT, L);
+#else
+    (void)L;
+#endif
+  }
+}
+
+
 /** @brief Incomplete Cholesky preconditioner class with static pattern (ICHOL0), can be supplied to solve()-routines
 */
 template<typename MatrixT>
@@ -145,8 +209,17 @@ public:
     NumericType  const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(LLT.handle());
 
     // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
-    viennacl::linalg::host_based::detail::csr_trans_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), lower_tag());
-    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), upper_tag());
+    if (L_schedule_.parallel())
+    {
+      unsigned int const * L_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle1());
+      unsigned int const * L_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle2());
+      NumericType  const * L_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericType>(L_.handle());
+
+      viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve<NumericType>(L_row_buffer, L_col_buffer, L_elements, vec, L_schedule_, true, false);
+    }
+    else
+      viennacl::linalg::host_based::detail::csr_trans_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), lower_tag());
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericType>(row_buffer, col_buffer, elements, vec, LLT.size2(), U_schedule_, upper_tag());
   }
 
 private:
@@ -157,10 +230,16 @@ private:
 
     viennacl::copy(mat, LLT);
     viennacl::linalg::precondition(LLT, tag_);
+
+    detail::ichol0_setup_lower(LLT, L_, L_schedule_);
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(LLT, U_schedule_, false);
   }
 
   ichol0_tag const & tag_;
   viennacl::compressed_matrix<NumericType> LLT;
+  viennacl::compressed_matrix<NumericType> L_;
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule U_schedule_;
 };
 
 
@@ -190,19 +269,42 @@ public:
       viennacl::context old_ctx = viennacl::traits::context(vec);
 
       viennacl::switch_memory_context(vec, host_ctx);
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+      apply_host(vec);
       viennacl::switch_memory_context(vec, old_ctx);
     }
     else //apply ILU0 directly:
+      apply_host(vec);
+  }
+
+private:
+  /** @brief Forward and backward substitution in host memory, level-scheduled in parallel if the dependency graphs are shallow enough */
+  void apply_host(vector<NumericT> & vec) const
+  {
+    if (L_schedule_.parallel())
     {
-      // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
+      NumericT           * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L_.handle2());
+      NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L_.handle());
+
+      viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, L_schedule_, true, false);
+    }
+    else // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
       viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+
+    if (U_schedule_.parallel())
+    {
+      NumericT           * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle());
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle2());
+      NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LLT.handle());
+
+      viennacl::linalg::host_based::detail::csr_level_scheduled_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, U_schedule_, false, false);
     }
+    else
+      viennacl::linalg::inplace_solve(LLT, vec, upper_tag());
   }
 
-private:
   void init(MatrixType const & mat)
   {
     viennacl::context host_ctx(viennacl::MAIN_MEMORY);
@@ -210,10 +312,16 @@ private:
     LLT = mat;
 
     viennacl::linalg::precondition(LLT, tag_);
+
+    detail::ichol0_setup_lower(LLT, L_, L_schedule_);
+    viennacl::linalg::host_based::detail::csr_level_schedule_setup(LLT, U_schedule_, false);
   }
 
   ichol0_tag const & tag_;
   viennacl::compressed_matrix<NumericT> LLT;
+  viennacl::compressed_matrix<NumericT> L_;
+  viennacl::linalg::host_based::detail::csr_level_schedule L_schedule_;
+  viennacl::linalg::host_based::detail::csr_level_schedule U_schedule_;
 };
 
 }
@@ -32,6 +32,10 @@
 #include "viennacl/traits/start.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/vector_operations.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/host_based/iterative_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -418,6 +422,172 @@ void pipelined_gmres_prod(MatrixType const & A,
 }
 
 
+/** @brief Matrix powers kernel for the s-step Krylov solvers: Computes v_{first+j+1} = scaling * A v_{first+j} for j=0..count-1.
+  *
+  *  All vectors v_i are stored column-major in the array 'krylov_basis', where each vector has an actual length 'v_size', but might be padded to have 'v_internal_size'.
+  *  Generic implementation based on the sparse matrix-vector product, see below for the fused kernel for compressed_matrix.
+  */
+template <typename MatrixT, typename T>
+void s_step_matrix_powers(MatrixT const & A,
+                          vector<T> & krylov_basis,
+                          vcl_size_t v_size,
+                          vcl_size_t v_internal_size,
+                          vcl_size_t first,
+                          vcl_size_t count,
+                          T scaling)
+{
+  for (vcl_size_t j = 0; j < count; ++j)
+  {
+    viennacl::vector_range<viennacl::vector<T> > v_in (krylov_basis, viennacl::range((first + j    ) * v_internal_size, (first + j    ) * v_internal_size + v_size));
+    viennacl::vector_range<viennacl::vector<T> > v_out(krylov_basis, viennacl::range((first + j + 1) * v_internal_size, (first + j + 1) * v_internal_size + v_size));
+    viennacl::linalg::prod_impl(A, v_in, scaling, v_out, T(0));
+  }
+}
+
+/** @brief Matrix powers kernel for the s-step Krylov solvers with a compressed_matrix. All products are computed within a single parallel region for matrices in main memory. */
+template <typename T, unsigned int AlignmentV>
+void s_step_matrix_powers(compressed_matrix<T, AlignmentV> const & A,
+                          vector<T> & krylov_basis,
+                          vcl_size_t v_size,
+                          vcl_size_t v_internal_size,
+                          vcl_size_t first,
+                          vcl_size_t count,
+                          T scaling)
+{
+  switch (viennacl::traits::handle(krylov_basis).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::s_step_matrix_powers(A, krylov_basis, v_internal_size, first, count, scaling);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    for (vcl_size_t j = 0; j < count; ++j)
+    {
+      viennacl::vector_range<viennacl::vector<T> > v_in (krylov_basis, viennacl::range((first + j    ) * v_internal_size, (first + j    ) * v_internal_size + v_size));
+      viennacl::vector_range<viennacl::vector<T> > v_out(krylov_basis, viennacl::range((first + j + 1) * v_internal_size, (first + j + 1) * v_internal_size + v_size));
+      viennacl::linalg::prod_impl(A, v_in, scaling, v_out, T(0));
+    }
+  }
+}
+
+/** @brief Computes the inner products <v_i, v_j> for i=0..num_vectors-1 and j=block_start..block_start+block_size-1 in a single pass for the s-step Krylov solvers.
+  *
+  *  All vectors v_i are stored column-major in the array 'krylov_basis', where each vector has an actual length 'v_size', but might be padded to have 'v_internal_size'.
+  *  The result <v_i, v_{block_start+j}> is written to inner_prod_result[i + j * num_vectors]. Only available for vectors in main memory.
+  */
+template <typename T>
+void s_step_inner_products(vector_base<T> const & krylov_basis,
+                           vcl_size_t v_size,
+                           vcl_size_t v_internal_size,
+                           vcl_size_t num_vectors,
+                           vcl_size_t block_start,
+                           vcl_size_t block_size,
+                           vector_base<T> & inner_prod_result)
+{
+  switch (viennacl::traits::handle(krylov_basis).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::s_step_inner_products(krylov_basis, v_size, v_internal_size, num_vectors, block_start, block_size, inner_prod_result);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Recovers result, residual, and search direction of s-step CG from their coefficients in the s-step basis [p, A p, ..., A^s p, r, A r, ..., A^{s-1} r]. Only available for vectors in main memory. */
+template <typename T>
+void s_step_cg_vector_update(vector_base<T> & result,
+                             vector_base<T> & krylov_basis,
+                             vcl_size_t v_size,
+                             vcl_size_t v_internal_size,
+                             vcl_size_t s,
+                             vector_base<T> const & coefficients)
+{
+  switch (viennacl::traits::handle(result).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::s_step_cg_vector_update(result, krylov_basis, v_size, v_internal_size, s, coefficients);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Block orthogonalization step of s-step GMRES: Computes W = (W - Q * C) * R^{-1} for the block W following the first 'num_previous' vectors Q of the Krylov basis. Only available for vectors in main memory. */
+template <typename T>
+void s_step_gmres_orthogonalize(vector_base<T> & krylov_basis,
+                                vcl_size_t v_size,
+                                vcl_size_t v_internal_size,
+                                vcl_size_t num_previous,
+                                vcl_size_t block_size,
+                                vector_base<T> const & coefficients)
+{
+  switch (viennacl::traits::handle(krylov_basis).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::s_step_gmres_orthogonalize(krylov_basis, v_size, v_internal_size, num_previous, block_size, coefficients);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes x += sum_{i=0}^{k-1} coefficients_i v_i for the vectors v_i in the Krylov basis of s-step GMRES. Only available for vectors in main memory. */
+template <typename T>
+void s_step_gmres_update_result(vector_base<T> & result,
+                                vector_base<T> const & krylov_basis,
+                                vcl_size_t v_size,
+                                vcl_size_t v_internal_size,
+                                vector_base<T> const & coefficients,
+                                vcl_size_t k)
+{
+  switch (viennacl::traits::handle(result).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::s_step_gmres_update_result(result, krylov_basis, v_size, v_internal_size, coefficients, k);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+namespace detail
+{
+
+  /** @brief Assigns the new residual in the solvers and computes its l^2-norm. Other vector types than viennacl::vector use two separate passes. */
+  template<typename VectorT>
+  struct residual_norm_2_assigner
+  {
+    template<typename ExpressionT, typename NumericT>
+    static void apply(VectorT & residual, ExpressionT const & proxy, NumericT & result)
+    {
+      residual = proxy;
+      result = viennacl::linalg::norm_2(residual);
+    }
+  };
+
+  /** @brief For ViennaCL vectors in host memory, the residual and its norm are computed in a single pass */
+  template<typename NumericT, unsigned int AlignmentV>
+  struct residual_norm_2_assigner<viennacl::vector<NumericT, AlignmentV> >
+  {
+    template<typename ExpressionT>
+    static void apply(viennacl::vector<NumericT, AlignmentV> & residual, ExpressionT const & proxy, NumericT & result)
+    {
+      viennacl::linalg::assign_norm_2_cpu(residual, proxy, result);
+    }
+  };
+
+} //namespace detail
+
 } //namespace linalg
 } //namespace viennacl
 
@@ -23,12 +23,14 @@
 */
 
 #include <algorithm>    //for std::min
+#include <vector>
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/lu.hpp"
 
 namespace viennacl
 {
@@ -188,6 +190,46 @@ void lu_factorize(matrix<NumericT, viennacl::column_major> & A)
 }
 
 
+/** @brief LU factorization with partial pivoting PA = LU of a dense matrix.
+*
+* Blocked factorization with recursive panels and lookahead on the host. Other backends factor a host copy of the matrix.
+*
+* @param A      The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+* @param perm   The row permutation P: Row i of PA is row perm[i] of A.
+*/
+template<typename NumericT, typename F>
+void lu_factorize(matrix<NumericT, F> & A, std::vector<vcl_size_t> & perm)
+{
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::lu_factorize(A, perm);
+    break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+  case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+  case viennacl::CUDA_MEMORY:
+#endif
+  {
+    matrix<NumericT, F> A_host(A);
+    A_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::linalg::host_based::lu_factorize(A_host, perm);
+    A_host.switch_memory_context(viennacl::traits::context(A));
+    A = A_host;
+    break;
+  }
+#endif
+
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+
 //
 // Convenience layer:
 //
@@ -221,6 +263,57 @@ void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
   inplace_solve(A, vec, upper_tag());
 }
 
+/** @brief LU substitution for the system PA x = P rhs, where A and perm are obtained from lu_factorize() with partial pivoting.
+*
+* @param A      The LU factors of the system matrix
+* @param perm   The row permutation returned by lu_factorize()
+* @param B      The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void lu_substitute(matrix<NumericT, F1, AlignmentV1> const & A,
+                   std::vector<vcl_size_t> const & perm,
+                   matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(A.size1() == B.size1() && bool("Matrix must be square"));
+  assert(perm.size() == B.size1() && bool("Permutation size does not match"));
+
+  std::vector<std::vector<NumericT> > B_host(B.size1(), std::vector<NumericT>(B.size2()));
+  std::vector<std::vector<NumericT> > B_perm(B.size1());
+  viennacl::copy(B, B_host);
+  for (vcl_size_t i = 0; i < perm.size(); ++i)
+    B_perm[i].swap(B_host[perm[i]]);
+  viennacl::copy(B_perm, B);
+
+  inplace_solve(A, B, unit_lower_tag());
+  inplace_solve(A, B, upper_tag());
+}
+
+/** @brief LU substitution for the system PA x = P rhs, where A and perm are obtained from lu_factorize() with partial pivoting.
+*
+* @param A      The LU factors of the system matrix
+* @param perm   The row permutation returned by lu_factorize()
+* @param vec    The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
+                   std::vector<vcl_size_t> const & perm,
+                   vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(perm.size() == vec.size() && bool("Permutation size does not match"));
+
+  std::vector<NumericT> vec_host(vec.size());
+  std::vector<NumericT> vec_perm(vec.size());
+  viennacl::copy(vec, vec_host);
+  for (vcl_size_t i = 0; i < perm.size(); ++i)
+    vec_perm[i] = vec_host[perm[i]];
+  viennacl::copy(vec_perm, vec);
+
+  inplace_solve(A, vec, unit_lower_tag());
+  inplace_solve(A, vec, upper_tag());
+}
+
 }
 }
 
@@ -0,0 +1,258 @@
+#ifndef VIENNACL_LINALG_MIXED_PRECISION_HPP_
+#define VIENNACL_LINALG_MIXED_PRECISION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/mixed_precision.hpp
+    @brief Mixed-precision iterative refinement with an arbitrary inner iterative solver running in low precision.
+*/
+
+#include <cmath>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A compressed_matrix together with a copy of its values in lower precision.
+*
+* The low-precision copy shares the sparsity pattern of the original matrix and is used for the inner iterations of mixed-precision solvers.
+* It is created once and only needs to be refreshed via update_values() if the values of the matrix change.
+* The original matrix is referenced, not copied, so it must outlive this object.
+*/
+template<typename HighNumericT, typename LowNumericT = float, unsigned int AlignmentV = 1>
+class mixed_precision_matrix
+{
+public:
+  typedef viennacl::compressed_matrix<HighNumericT, AlignmentV>   high_matrix_type;
+  typedef viennacl::compressed_matrix<LowNumericT, AlignmentV>    low_matrix_type;
+
+  mixed_precision_matrix() : high_(NULL) {}
+
+  /** @brief Creates the low-precision copy of the matrix A */
+  explicit mixed_precision_matrix(high_matrix_type const & A) : high_(NULL) { init(A); }
+
+  /** @brief Creates the low-precision copy of A including its sparsity pattern. */
+  void init(high_matrix_type const & A)
+  {
+    viennacl::context ctx = viennacl::traits::context(A);
+    low_matrix_type low(A.size1(), A.size2(), A.nnz(), ctx);
+    if (A.nnz() > 0)
+    {
+      viennacl::backend::memory_copy(A.handle1(), low.handle1(), 0, 0, low.handle1().raw_size());
+      viennacl::backend::memory_copy(A.handle2(), low.handle2(), 0, 0, low.handle2().raw_size());
+      convert_values(A, low);
+      low.generate_row_block_information();
+    }
+
+    if (low_.size1() > 0 && (low_.size1() != A.size1() || low_.size2() != A.size2()))
+      low_.resize(A.size1(), A.size2(), false);
+    low_.switch_memory_context(ctx);
+    low_ = low;
+    high_ = &A;
+  }
+
+  /** @brief Refreshes the low-precision values after the values (but not the sparsity pattern) of the matrix changed.
+  *
+  * @param A  The matrix with the same sparsity pattern as the one passed to init(). Subsequent solver runs refer to A.
+  */
+  void update_values(high_matrix_type const & A)
+  {
+    assert(A.size1() == low_.size1() && A.size2() == low_.size2() && A.nnz() == low_.nnz() && bool("Matrix does not match the one passed to init()!"));
+    high_ = &A;
+    if (A.nnz() > 0)
+      convert_values(A, low_);
+  }
+
+  /** @brief Returns the matrix in full precision */
+  high_matrix_type const & high() const { return *high_; }
+  /** @brief Returns the copy of the matrix in low precision */
+  low_matrix_type const & low() const { return low_; }
+
+private:
+  static void convert_values(high_matrix_type const & A, low_matrix_type & A_low)
+  {
+    viennacl::vector_base<HighNumericT> values_high(const_cast<viennacl::backend::mem_handle &>(A.handle()), A.nnz(), 0, 1);
+    viennacl::vector_base<LowNumericT>  values_low(A_low.handle(), A.nnz(), 0, 1);
+    values_low = values_high;
+  }
+
+  high_matrix_type const * high_;
+  low_matrix_type low_;
+};
+
+
+/** @brief A tag for mixed-precision iterative refinement. Used for supplying solver parameters and for dispatching the solve() function.
+*
+* Each refinement step computes the residual in full precision and solves for a correction in low precision with the inner solver.
+* The inner solver is selected and configured by its tag, e.g. cg_tag, bicgstab_tag or gmres_tag. Its tolerance is relative to the current residual.
+*/
+template<typename InnerTagT>
+class mixed_precision_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param inner_tag        Tag of the inner solver running in low precision, with a relative tolerance attainable in low precision (e.g. 1e-4 for float)
+  * @param tol              Relative tolerance for the residual in full precision (solver quits if ||r|| < tol * ||b||)
+  * @param max_iterations   The maximum number of refinement steps
+  */
+  mixed_precision_tag(InnerTagT const & inner_tag, double tol = 1e-8, unsigned int max_iterations = 30)
+    : inner_tag_(inner_tag), tol_(tol), iterations_(max_iterations), iters_taken_(0), inner_iters_taken_(0), last_error_(0) {}
+
+  /** @brief Returns the tag of the inner solver */
+  InnerTagT const & inner_tag() const { return inner_tag_; }
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of refinement steps */
+  unsigned int max_iterations() const { return iterations_; }
+
+  /** @brief Return the number of refinement steps */
+  unsigned int iters() const { return iters_taken_; }
+  void iters(unsigned int i) const { iters_taken_ = i; }
+
+  /** @brief Return the total number of iterations of the inner solver */
+  unsigned int inner_iters() const { return inner_iters_taken_; }
+  void inner_iters(unsigned int i) const { inner_iters_taken_ = i; }
+
+  /** @brief Returns the relative residual at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the relative residual at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  InnerTagT inner_tag_;
+  double tol_;
+  unsigned int iterations_;
+
+  //return values from solver
+  mutable unsigned int iters_taken_;
+  mutable unsigned int inner_iters_taken_;
+  mutable double last_error_;
+};
+
+
+/** @brief Solves A x = b by mixed-precision iterative refinement.
+*
+* The residual b - A x is computed in the precision of A, the corrections are computed in low precision with the inner solver given by the tag.
+* Since the inner solver only reads the low-precision values of the matrix, the bandwidth-limited sparse matrix-vector products inside the inner iterations move less data.
+* The residual is scaled to unit norm before it is passed to the inner solver, so that the low-precision range is not exceeded.
+* A correction is only accepted if it reduces the residual. Otherwise the refinement stops and the previous iterate is returned.
+*
+* Example (with the preconditioner set up for the low-precision matrix):
+*   mixed_precision_matrix<double> A_mixed(A);
+*   ilu0_precond<compressed_matrix<float> > ilu(A_mixed.low(), ilu0_tag());
+*   x = solve(A_mixed, b, mixed_precision_tag<bicgstab_tag>(bicgstab_tag(1e-4, 200)), ilu);
+*
+* The header of the inner solver (e.g. viennacl/linalg/bicgstab.hpp) needs to be included as well.
+*
+* @param A         The system matrix together with its low-precision copy
+* @param rhs       The right hand side vector
+* @param tag       Solver configuration tag
+* @param precond   A preconditioner for the low-precision matrix, operating on low-precision vectors
+* @return The result vector
+*/
+template<typename HighNumericT, typename LowNumericT, unsigned int AlignmentV, typename InnerTagT, typename PreconditionerT>
+viennacl::vector<HighNumericT> solve(mixed_precision_matrix<HighNumericT, LowNumericT, AlignmentV> const & A,
+                                     viennacl::vector<HighNumericT> const & rhs,
+                                     mixed_precision_tag<InnerTagT> const & tag,
+                                     PreconditionerT const & precond)
+{
+  viennacl::context ctx = viennacl::traits::context(rhs);
+  viennacl::vector<HighNumericT> result(rhs.size(), ctx);
+  viennacl::vector<HighNumericT> candidate(rhs.size(), ctx);
+  viennacl::vector<HighNumericT> residual = rhs;
+  viennacl::vector<LowNumericT> residual_low_precision(rhs.size(), ctx);
+  viennacl::vector<LowNumericT> correction_low_precision(rhs.size(), ctx);
+  result.clear();
+
+  tag.iters(0);
+  tag.inner_iters(0);
+  tag.error(0);
+
+  HighNumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+  if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+    return result;
+
+  HighNumericT norm_residual = norm_rhs;
+  for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+  {
+    if (norm_residual <= HighNumericT(tag.tolerance()) * norm_rhs)
+      break;
+
+    // correction in low precision:
+    residual_low_precision = residual;
+    residual_low_precision *= LowNumericT(HighNumericT(1) / norm_residual);
+    correction_low_precision = viennacl::linalg::solve(A.low(), residual_low_precision, tag.inner_tag(), precond);
+
+    tag.iters(i+1);
+    tag.inner_iters(tag.inner_iters() + tag.inner_tag().iters());
+
+    residual = correction_low_precision; // reusing residual vector as temporary buffer for conversion. Overwritten below anyway
+    candidate = result + norm_residual * residual;
+
+    // residual = b - Ax  (without introducing a temporary)
+    residual = viennacl::linalg::prod(A.high(), candidate);
+    residual = rhs - residual;
+
+    HighNumericT new_norm_residual = viennacl::linalg::norm_2(residual);
+    if (!(new_norm_residual < norm_residual)) // the inner solver does not improve the solution any further, keep the previous iterate
+      break;
+
+    result.fast_swap(candidate);
+    norm_residual = new_norm_residual;
+  }
+
+  tag.error(norm_residual / norm_rhs);
+
+  return result;
+}
+
+/** @brief Solves A x = b by mixed-precision iterative refinement without preconditioner. */
+template<typename HighNumericT, typename LowNumericT, unsigned int AlignmentV, typename InnerTagT>
+viennacl::vector<HighNumericT> solve(mixed_precision_matrix<HighNumericT, LowNumericT, AlignmentV> const & A,
+                                     viennacl::vector<HighNumericT> const & rhs,
+                                     mixed_precision_tag<InnerTagT> const & tag)
+{
+  return solve(A, rhs, tag, viennacl::linalg::no_precond());
+}
+
+/** @brief Solves A x = b by mixed-precision iterative refinement. The low-precision copy of A is created for this call only.
+*
+* Use a mixed_precision_matrix instead if several systems with the same matrix are solved.
+*/
+template<typename HighNumericT, unsigned int AlignmentV, typename InnerTagT>
+viennacl::vector<HighNumericT> solve(viennacl::compressed_matrix<HighNumericT, AlignmentV> const & A,
+                                     viennacl::vector<HighNumericT> const & rhs,
+                                     mixed_precision_tag<InnerTagT> const & tag)
+{
+  mixed_precision_matrix<HighNumericT, float, AlignmentV> A_mixed(A);
+  return solve(A_mixed, rhs, tag, viennacl::linalg::no_precond());
+}
+
+}
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/mixed_precision.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/traits/clear.hpp"
@@ -127,14 +128,8 @@ namespace viennacl
       residual_low_precision = p_low_precision;
 
       // transfer matrix to single precision:
-      viennacl::compressed_matrix<float> matrix_low_precision(matrix.size1(), matrix.size2(), matrix.nnz(), viennacl::traits::context(rhs));
-      viennacl::backend::memory_copy(matrix.handle1(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle1()), 0, 0, matrix_low_precision.handle1().raw_size() );
-      viennacl::backend::memory_copy(matrix.handle2(), const_cast<viennacl::backend::mem_handle &>(matrix_low_precision.handle2()), 0, 0, matrix_low_precision.handle2().raw_size() );
-
-      viennacl::vector_base<CPU_ScalarType> matrix_elements_high_precision(const_cast<viennacl::backend::mem_handle &>(matrix.handle()), matrix.nnz(), 0, 1);
-      viennacl::vector_base<float>          matrix_elements_low_precision(matrix_low_precision.handle(), matrix.nnz(), 0, 1);
-      matrix_elements_low_precision = matrix_elements_high_precision;
-      matrix_low_precision.generate_row_block_information();
+      viennacl::linalg::mixed_precision_matrix<CPU_ScalarType, float> matrix_mixed_precision(matrix);
+      viennacl::compressed_matrix<float> const & matrix_low_precision = matrix_mixed_precision.low();
 
       for (unsigned int i = 0; i < tag.max_iterations(); ++i)
       {
@@ -0,0 +1,466 @@
+#ifndef VIENNACL_LINALG_MRRR_HPP_
+#define VIENNACL_LINALG_MRRR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/mrrr.hpp
+    @brief Eigenvalues and eigenvectors of symmetric tridiagonal matrices based on bisection and twisted factorizations (in the spirit of the MRRR algorithm by Dhillon and Parlett).
+           Clusters of close eigenvalues are handled by inverse iteration and orthogonalization rather than by representation trees.
+*/
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/detail/bisect/bisect_host.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Work arrays of a single thread for the computation of eigenvectors */
+template<typename NumericT>
+struct mrrr_workspace
+{
+  explicit mrrr_workspace(vcl_size_t n) : dplus(n), dminus(n), u0(n), u1(n), u2(n), multiplier(n), pivot(n) {}
+
+  std::vector<NumericT> dplus;
+  std::vector<NumericT> dminus;
+
+  // LU factorization with partial pivoting of T - lambda I for inverse iteration:
+  std::vector<NumericT> u0;
+  std::vector<NumericT> u1;
+  std::vector<NumericT> u2;
+  std::vector<NumericT> multiplier;
+  std::vector<bool>     pivot;
+};
+
+template<typename NumericT>
+NumericT mrrr_safe_pivot(NumericT value, NumericT pivmin)
+{
+  if (value < pivmin && value > -pivmin)
+    return (value < 0) ? -pivmin : pivmin;
+  return value;
+}
+
+/** @brief Computes the eigenvector for an isolated eigenvalue from the twisted factorization T - lambda I = N_r D_r N_r^T and refines the eigenvalue by Rayleigh quotient corrections.
+*
+* The twist index r is chosen such that |gamma_r| is minimal, for which the solution of N_r D_r N_r^T z = gamma_r e_r with z_r = 1 is an accurate eigenvector.
+* The residual of z is |gamma_r| / ||z||, the Rayleigh quotient is lambda + gamma_r / ||z||^2. The corrections converge rapidly if the eigenvalue is well separated,
+* hence an approximation of the eigenvalue to a fraction of the gap to its neighbors is sufficient.
+* The off-diagonal convention is the one of bisect(): s[i] couples rows i-1 and i.
+*
+* @param lambda      On input an approximation to the eigenvalue with an error below 'bracket', on output the refined eigenvalue
+* @param bracket     Maximum distance of the refined eigenvalue to the initial approximation
+* @param tol         Tolerance for the residual
+* @return False if the iteration did not converge within the bracket, in which case inverse iteration should be used instead.
+*/
+template<typename NumericT>
+bool mrrr_twisted_eigenvector(std::vector<NumericT> const & d, std::vector<NumericT> const & s, NumericT & lambda, NumericT bracket, NumericT tol, NumericT pivmin,
+                              mrrr_workspace<NumericT> & work, NumericT * z)
+{
+  vcl_size_t n = d.size();
+  std::vector<NumericT> & dplus  = work.dplus;
+  std::vector<NumericT> & dminus = work.dminus;
+  NumericT lambda_initial = lambda;
+
+  for (vcl_size_t iter = 0; iter < 6; ++iter)
+  {
+    // stationary (top to bottom) and progressive (bottom to top) factorizations:
+    dplus[0] = mrrr_safe_pivot(d[0] - lambda, pivmin);
+    for (vcl_size_t i = 1; i < n; ++i)
+      dplus[i] = mrrr_safe_pivot(d[i] - lambda - s[i] * s[i] / dplus[i-1], pivmin);
+
+    dminus[n-1] = mrrr_safe_pivot(d[n-1] - lambda, pivmin);
+    for (vcl_size_t i = n-1; i > 0; --i)
+      dminus[i-1] = mrrr_safe_pivot(d[i-1] - lambda - s[i] * s[i] / dminus[i], pivmin);
+
+    // twist index:
+    vcl_size_t r = 0;
+    NumericT gamma_r = dplus[0] + dminus[0] - (d[0] - lambda);
+    for (vcl_size_t i = 1; i < n; ++i)
+    {
+      NumericT gamma = dplus[i] + dminus[i] - (d[i] - lambda);
+      if (std::fabs(gamma) < std::fabs(gamma_r))
+      {
+        gamma_r = gamma;
+        r = i;
+      }
+    }
+
+    // solve for z with z_r = 1:
+    z[r] = 1;
+    NumericT norm = 1;
+    for (vcl_size_t i = r; i > 0; --i)
+    {
+      z[i-1] = -s[i] * z[i] / dplus[i-1];
+      norm += z[i-1] * z[i-1];
+    }
+    for (vcl_size_t i = r+1; i < n; ++i)
+    {
+      z[i] = -s[i] * z[i-1] / dminus[i];
+      norm += z[i] * z[i];
+    }
+
+    if (!(norm <= std::numeric_limits<NumericT>::max())) // also catches NaN
+      return false;
+
+    NumericT correction = gamma_r / norm;
+    norm = std::sqrt(norm);
+    if (std::fabs(gamma_r) / norm <= tol)
+    {
+      for (vcl_size_t i = 0; i < n; ++i)
+        z[i] /= norm;
+      return true;
+    }
+
+    lambda += correction;
+    if (!(std::fabs(lambda - lambda_initial) <= bracket))
+      break;
+  }
+
+  lambda = lambda_initial;
+  return false;
+}
+
+/** @brief Computes the LU factorization with partial pivoting of T - lambda I. Small pivots are replaced by +-pivmin. */
+template<typename NumericT>
+void mrrr_tridiagonal_lu(std::vector<NumericT> const & d, std::vector<NumericT> const & s, NumericT lambda, NumericT pivmin,
+                         mrrr_workspace<NumericT> & work)
+{
+  vcl_size_t n = d.size();
+
+  // remaining row after each elimination step has entries in the columns i and i+1 only:
+  NumericT row_diag  = d[0] - lambda;
+  NumericT row_upper = (n > 1) ? s[1] : 0;
+  for (vcl_size_t i = 0; i+1 < n; ++i)
+  {
+    NumericT lower      = s[i+1];
+    NumericT next_diag  = d[i+1] - lambda;
+    NumericT next_upper = (i+2 < n) ? s[i+2] : 0;
+
+    if (std::fabs(row_diag) >= std::fabs(lower))
+    {
+      work.pivot[i]      = false;
+      work.u0[i]         = mrrr_safe_pivot(row_diag, pivmin);
+      work.u1[i]         = row_upper;
+      work.u2[i]         = 0;
+      work.multiplier[i] = lower / work.u0[i];
+      row_diag  = next_diag - work.multiplier[i] * row_upper;
+      row_upper = next_upper;
+    }
+    else
+    {
+      work.pivot[i]      = true;
+      work.u0[i]         = lower;
+      work.u1[i]         = next_diag;
+      work.u2[i]         = next_upper;
+      work.multiplier[i] = row_diag / lower;
+      row_diag  = row_upper - work.multiplier[i] * next_diag;
+      row_upper =           - work.multiplier[i] * next_upper;
+    }
+  }
+  work.u0[n-1] = mrrr_safe_pivot(row_diag, pivmin);
+}
+
+/** @brief Solves (T - lambda I) x = z in-place using the factorization computed by mrrr_tridiagonal_lu() */
+template<typename NumericT>
+void mrrr_tridiagonal_solve(mrrr_workspace<NumericT> const & work, NumericT * z, vcl_size_t n)
+{
+  for (vcl_size_t i = 0; i+1 < n; ++i)
+  {
+    if (work.pivot[i])
+      std::swap(z[i], z[i+1]);
+    z[i+1] -= work.multiplier[i] * z[i];
+  }
+
+  z[n-1] /= work.u0[n-1];
+  if (n > 1)
+  {
+    z[n-2] = (z[n-2] - work.u1[n-2] * z[n-1]) / work.u0[n-2];
+    for (vcl_size_t i = n-2; i > 0; --i)
+      z[i-1] = (z[i-1] - work.u1[i-1] * z[i] - work.u2[i-1] * z[i+1]) / work.u0[i-1];
+  }
+}
+
+/** @brief Orthogonalizes the k-th vector against the previous vectors with eigenvalues closer than 'window' by modified Gram-Schmidt and normalizes it.
+*
+* Eigenvectors for eigenvalues further apart are sufficiently orthogonal already, so only few vectors are involved even for long chains of close eigenvalues.
+*
+* @param lambdas   The eigenvalues in ascending order
+* @param vectors   Eigenvectors of length n, the k-th eigenvector starts at vectors + k * ld
+*/
+template<typename NumericT>
+void mrrr_orthogonalize(NumericT const * lambdas, vcl_size_t k, NumericT window, NumericT * vectors, vcl_size_t n, vcl_size_t ld)
+{
+  NumericT * z = vectors + k * ld;
+
+  vcl_size_t window_begin = k;
+  while (window_begin > 0 && lambdas[k] - lambdas[window_begin - 1] <= window)
+    --window_begin;
+  for (vcl_size_t j = window_begin; j < k; ++j)
+  {
+    NumericT const * q = vectors + j * ld;
+    NumericT dot = 0;
+    for (vcl_size_t i = 0; i < n; ++i)
+      dot += q[i] * z[i];
+    for (vcl_size_t i = 0; i < n; ++i)
+      z[i] -= dot * q[i];
+  }
+
+  NumericT norm = 0;
+  for (vcl_size_t i = 0; i < n; ++i)
+    norm += z[i] * z[i];
+  norm = std::sqrt(norm);
+  for (vcl_size_t i = 0; i < n; ++i)
+    z[i] /= norm;
+}
+
+/** @brief Computes the eigenvectors for a cluster of close eigenvalues by inverse iteration with orthogonalization against the previous vectors of the cluster.
+*
+* Equal eigenvalues are perturbed slightly so that different vectors are obtained (cf. LAPACK's xSTEIN).
+* The cluster is a chain of eigenvalues with consecutive gaps below cluster_gap, but each vector is only orthogonalized against the ones within cluster_gap, so long chains cost O(n k) rather than O(n k^2).
+*
+* @param vectors   Eigenvectors of length d.size(), the k-th eigenvector starts at vectors + k * ld
+*/
+template<typename NumericT>
+void mrrr_cluster_eigenvectors(std::vector<NumericT> const & d, std::vector<NumericT> const & s, NumericT const * lambdas, vcl_size_t cluster_size,
+                               NumericT tnorm, NumericT cluster_gap, mrrr_workspace<NumericT> & work, NumericT * vectors, vcl_size_t ld)
+{
+  vcl_size_t n = d.size();
+  NumericT eps    = std::numeric_limits<NumericT>::epsilon();
+  NumericT pivmin = std::max(eps * tnorm, std::numeric_limits<NumericT>::min());
+  NumericT perturbation = NumericT(10) * eps * tnorm;
+
+  NumericT lambda_previous = 0;
+  for (vcl_size_t k = 0; k < cluster_size; ++k)
+  {
+    NumericT lambda = lambdas[k];
+    if (k > 0 && lambda - lambda_previous < perturbation)
+      lambda = lambda_previous + perturbation;
+    lambda_previous = lambda;
+
+    mrrr_tridiagonal_lu(d, s, lambda, pivmin, work);
+
+    // deterministic start vector with components in (0.5, 1.5):
+    NumericT * z = vectors + k * ld;
+    vcl_size_t seed = 12345 + 97 * k;
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      seed = (seed * 1103515245 + 12345) % 2147483648UL;
+      z[i] = NumericT(0.5) + NumericT(seed) / NumericT(2147483648UL);
+    }
+
+    for (vcl_size_t iter = 0; iter < 3; ++iter)
+    {
+      mrrr_tridiagonal_solve(work, z, n);
+
+      mrrr_orthogonalize(lambdas, k, cluster_gap, vectors, n, ld);
+    }
+  }
+}
+
+} // namespace detail
+
+
+/** @brief Computes selected eigenvalues and the corresponding eigenvectors of a symmetric tridiagonal matrix by bisection, twisted factorizations for isolated eigenvalues and inverse iteration for clusters.
+*
+* The eigenvalues are approximated by multithreaded bisection. For each isolated eigenvalue the eigenvector is obtained in O(n) operations from a twisted factorization,
+* which also refines the eigenvalue by Rayleigh quotient corrections. Thus, the total cost is O(n k) for k well-separated eigenpairs rather than O(n^2 k) as for QL iterations.
+* Unlike the full MRRR algorithm, no representation trees are built for clusters: Groups of close eigenvalues (gap below 1e-3 times the norm of the matrix) are refined by bisection
+* and their eigenvectors are computed by inverse iteration with Gram-Schmidt orthogonalization within the group (as in LAPACK's xSTEIN).
+* Hence, the O(n k) bound does not hold for large clusters, where the orthogonalization costs up to O(n c^2) for a cluster of c eigenvalues.
+* The eigenvectors of different groups are computed in parallel if OpenMP is enabled.
+*
+* If eigenvectors is a column-major matrix in main memory, the eigenvectors are computed in place. Otherwise, one temporary array of n times (last - first) entries is used.
+*
+* The convention for the off-diagonal follows bisect(): superdiagonal[i] couples rows i-1 and i, superdiagonal[0] is ignored.
+*
+* @param diagonal        Diagonal entries of the matrix
+* @param superdiagonal   Off-diagonal entries of the matrix, shifted by one
+* @param eigenvalues     Output: The eigenvalues with indices first, ..., last-1 in ascending order
+* @param eigenvectors    Output: The corresponding eigenvectors as columns. Resized to diagonal.size() times (last - first) if necessary, left unchanged if first == last.
+* @param first           Index of the smallest eigenvalue to be computed
+* @param last            One past the index of the largest eigenvalue to be computed
+*/
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void mrrr(std::vector<NumericT> const & diagonal,
+          std::vector<NumericT> const & superdiagonal,
+          std::vector<NumericT> & eigenvalues,
+          viennacl::matrix<NumericT, F, AlignmentV> & eigenvectors,
+          vcl_size_t first, vcl_size_t last)
+{
+  vcl_size_t n = diagonal.size();
+  assert(superdiagonal.size() >= n && first <= last && last <= n && bool("Size mismatch"));
+
+  vcl_size_t num_eigenvalues = last - first;
+  if (num_eigenvalues == 0)  // matrices cannot be resized to zero columns
+  {
+    eigenvalues.clear();
+    return;
+  }
+  if (eigenvectors.size1() != n || eigenvectors.size2() != num_eigenvalues)
+    eigenvectors.resize(n, num_eigenvalues, false);
+
+  // the superdiagonal is not required to have its first entry set to zero:
+  std::vector<NumericT> s(superdiagonal.begin(), superdiagonal.begin() + vcl_ptrdiff_t(n));
+  s[0] = 0;
+
+  NumericT tnorm = 0;
+  for (vcl_size_t i = 0; i < n; ++i)
+    tnorm = std::max(tnorm, std::fabs(diagonal[i]) + std::fabs(s[i]) + ((i+1 < n) ? std::fabs(s[i+1]) : NumericT(0)));
+  if (tnorm <= 0)
+    tnorm = 1;
+
+  // Eigenvalues with a gap above tight_gap to their neighbors are approximated to a fraction of the gap, which suffices as initial guess for the Rayleigh quotient corrections.
+  // Eigenvectors for eigenvalues closer than cluster_gap are orthogonalized explicitly.
+  NumericT eps = std::numeric_limits<NumericT>::epsilon();
+  NumericT cluster_gap = NumericT(1e-3) * tnorm;
+  NumericT tight_gap   = NumericT(1e-5) * tnorm;
+  NumericT coarse_tol  = NumericT(1e-3) * tight_gap;
+  detail::bisect_host(diagonal, s, eigenvalues, first, last, coarse_tol);
+
+  // neighbors outside of the requested range:
+  std::vector<NumericT> neighbor;
+  NumericT lower_gap = 2 * tight_gap;
+  NumericT upper_gap = 2 * tight_gap;
+  if (first > 0)
+  {
+    detail::bisect_host(diagonal, s, neighbor, first - 1, first, coarse_tol);
+    lower_gap = eigenvalues[0] - neighbor[0];
+  }
+  if (last < n)
+  {
+    detail::bisect_host(diagonal, s, neighbor, last, last + 1, coarse_tol);
+    upper_gap = neighbor[0] - eigenvalues[num_eigenvalues - 1];
+  }
+
+  // units of eigenvalues computed together: isolated eigenvalues and groups of eigenvalues with gaps below tight_gap.
+  std::vector<vcl_size_t> unit_start(1, 0);
+  for (vcl_size_t k = 1; k < num_eigenvalues; ++k)
+    if (eigenvalues[k] - eigenvalues[k-1] > tight_gap)
+      unit_start.push_back(k);
+  unit_start.push_back(num_eigenvalues);
+
+  // chains of eigenvalues with gaps below cluster_gap, within which the eigenvectors are orthogonalized:
+  std::vector<vcl_size_t> chain_start(1, 0);
+  for (vcl_size_t k = 1; k < num_eigenvalues; ++k)
+    if (eigenvalues[k] - eigenvalues[k-1] > cluster_gap)
+      chain_start.push_back(k);
+  chain_start.push_back(num_eigenvalues);
+
+  // eigenvalues in groups and eigenvalues without convergence of the Rayleigh quotient corrections are refined by bisection to full accuracy:
+  detail::bisect_setup<NumericT> fine_setup;
+  detail::bisect_init(fine_setup, diagonal, s, first, last, eps * tnorm);
+
+  // column-major matrices in main memory are written in place, otherwise the eigenvectors are computed in consecutive memory and transferred to the matrix at the end:
+  bool in_place = !eigenvectors.row_major() && viennacl::traits::active_handle_id(eigenvectors) == viennacl::MAIN_MEMORY;
+  std::vector<NumericT> temp_vectors(in_place ? 0 : n * num_eigenvalues);
+  NumericT * vectors = in_place ? viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(eigenvectors) : &temp_vectors[0];
+  vcl_size_t ld = in_place ? eigenvectors.internal_size1() : n;
+  NumericT residual_tol = NumericT(4) * eps * tnorm;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (num_eigenvalues > 1 && n * num_eigenvalues > 1000)
+#endif
+  {
+    detail::mrrr_workspace<NumericT> work(n);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic)
+#endif
+    for (long u = 0; u < static_cast<long>(unit_start.size()) - 1; ++u)
+    {
+      vcl_size_t begin = unit_start[static_cast<vcl_size_t>(u)];
+      vcl_size_t end   = unit_start[static_cast<vcl_size_t>(u) + 1];
+      bool isolated = (end - begin == 1) && (begin > 0 || lower_gap > tight_gap) && (end < num_eigenvalues || upper_gap > tight_gap);
+      if (isolated && detail::mrrr_twisted_eigenvector(diagonal, s, eigenvalues[begin], coarse_tol, residual_tol, fine_setup.pivmin, work, vectors + begin * ld))
+        continue;
+
+      // the gaps to other eigenvalues in the requested range exceed the bisection tolerance by far, hence the interval only contains the eigenvalues of the unit
+      // and possibly eigenvalues outside of the requested range, which are ignored by the bisection:
+      NumericT lower = eigenvalues[begin] - coarse_tol;
+      NumericT upper = eigenvalues[end - 1] + coarse_tol;
+      detail::bisect_interval<NumericT> interval(lower, upper, detail::sturm_count(fine_setup.d, fine_setup.e2, lower, fine_setup.pivmin),
+                                                               detail::sturm_count(fine_setup.d, fine_setup.e2, upper, fine_setup.pivmin));
+      detail::bisect_refine(fine_setup, interval, eigenvalues);
+      detail::mrrr_cluster_eigenvectors(diagonal, s, &eigenvalues[begin], end - begin, tnorm, cluster_gap, work, vectors + begin * ld, ld);
+    }
+
+    // orthogonalization within chains:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(dynamic)
+#endif
+    for (long c = 0; c < static_cast<long>(chain_start.size()) - 1; ++c)
+    {
+      vcl_size_t begin = chain_start[static_cast<vcl_size_t>(c)];
+      vcl_size_t end   = chain_start[static_cast<vcl_size_t>(c) + 1];
+      for (vcl_size_t k = begin + 1; k < end; ++k)
+        detail::mrrr_orthogonalize(&eigenvalues[begin], k - begin, cluster_gap, vectors + begin * ld, n, ld);
+    }
+  }
+
+  if (in_place)
+    return;
+
+  if (!eigenvectors.row_major())
+  {
+    for (vcl_size_t k = 0; k < num_eigenvalues; ++k)
+      viennacl::backend::memory_write(eigenvectors.handle(), sizeof(NumericT) * k * eigenvectors.internal_size1(), sizeof(NumericT) * n, vectors + k * n);
+    return;
+  }
+
+  // transpose blocks of rows, so that only a small buffer is required in addition:
+  vcl_size_t row_block_size = std::max<vcl_size_t>(1, (vcl_size_t(1) << 20) / eigenvectors.internal_size2());
+  std::vector<NumericT> buffer(std::min(row_block_size, n) * eigenvectors.internal_size2());
+  for (vcl_size_t row_begin = 0; row_begin < n; row_begin += row_block_size)
+  {
+    vcl_size_t row_end = std::min(row_begin + row_block_size, n);
+    for (vcl_size_t i = row_begin; i < row_end; ++i)
+      for (vcl_size_t k = 0; k < num_eigenvalues; ++k)
+        buffer[(i - row_begin) * eigenvectors.internal_size2() + k] = vectors[k * n + i];
+    viennacl::backend::memory_write(eigenvectors.handle(), sizeof(NumericT) * row_begin * eigenvectors.internal_size2(),
+                                    sizeof(NumericT) * (row_end - row_begin) * eigenvectors.internal_size2(), &buffer[0]);
+  }
+}
+
+/** @brief Computes all eigenvalues and eigenvectors of a symmetric tridiagonal matrix. See the overload with index range for details. */
+template<typename NumericT, typename F, unsigned int AlignmentV>
+void mrrr(std::vector<NumericT> const & diagonal,
+          std::vector<NumericT> const & superdiagonal,
+          std::vector<NumericT> & eigenvalues,
+          viennacl::matrix<NumericT, F, AlignmentV> & eigenvectors)
+{
+  mrrr(diagonal, superdiagonal, eigenvalues, eigenvectors, 0, diagonal.size());
+}
+
+} // namespace linalg
+} // namespace viennacl
+
+#endif
@@ -25,6 +25,7 @@
 #include <utility>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -41,6 +42,7 @@
 #include "viennacl/matrix_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/range.hpp"
+#include "viennacl/linalg/host_based/qr.hpp"
 
 namespace viennacl
 {
@@ -438,7 +440,7 @@ namespace viennacl
         UblasMatrixType ublasW(A.size1(), block_size); ublasW.clear(); ublasW.resize(A.size1(), block_size);
         UblasMatrixType ublasY(A.size1(), block_size); ublasY.clear(); ublasY.resize(A.size1(), block_size);
 
-        UblasMatrixType ublasA(A.size1(), A.size1());
+        UblasMatrixType ublasA(A.size1(), A.size2());
 
         MatrixType vclW(ublasW.size1(), ublasW.size2());
         MatrixType vclY(ublasY.size1(), ublasY.size2());
@@ -597,6 +599,59 @@ namespace viennacl
       }
     }
 
+    /** @brief Overload of recoverQ() for dense ViennaCL matrices. The reflectors are applied block-wise with matrix-matrix products on the host. Other backends use a host copy.
+     *
+     * Q is resized to A.size1() x A.size1() and R to A.size1() x A.size2() if necessary. Throws if there are fewer betas than reflectors.
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT>
+    void recoverQ(viennacl::matrix<T, F, ALIGNMENT> const & A, std::vector<T> const & betas, viennacl::matrix<T, F, ALIGNMENT> & Q, viennacl::matrix<T, F, ALIGNMENT> & R)
+    {
+      if (betas.size() < std::min(A.size1(), A.size2()))
+        throw std::runtime_error("ViennaCL: Size mismatch of matrix and betas in recoverQ()!");
+      if (A.size1() == 0)
+        return;
+      if (Q.size1() != A.size1() || Q.size2() != A.size1())
+        Q.resize(A.size1(), A.size1(), false);
+      if (A.size2() > 0 && (R.size1() != A.size1() || R.size2() != A.size2()))
+        R.resize(A.size1(), A.size2(), false);
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+      case viennacl::MAIN_MEMORY:
+        if (viennacl::traits::handle(Q).get_active_handle_id() == viennacl::MAIN_MEMORY && viennacl::traits::handle(R).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        {
+          viennacl::linalg::host_based::recoverQ(A, betas, Q, R, VIENNACL_QR_BLOCK_SIZE);
+          break;
+        }
+        // fall through: Q or R reside on a different backend
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+      case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+      case viennacl::CUDA_MEMORY:
+#endif
+#endif
+      {
+        viennacl::matrix<T, F, ALIGNMENT> A_host(A);
+        viennacl::matrix<T, F, ALIGNMENT> Q_host(Q.size1(), Q.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+        viennacl::matrix<T, F, ALIGNMENT> R_host(R.size1(), R.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+        A_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+        viennacl::linalg::host_based::recoverQ(A_host, betas, Q_host, R_host, VIENNACL_QR_BLOCK_SIZE);
+        Q_host.switch_memory_context(viennacl::traits::context(Q));
+        R_host.switch_memory_context(viennacl::traits::context(R));
+        Q = Q_host;
+        R = R_host;
+        break;
+      }
+
+      case viennacl::MEMORY_NOT_INITIALIZED:
+        throw memory_exception("not initialised!");
+      default:
+        throw memory_exception("not implemented");
+      }
+    }
+
 
     /** @brief Computes Q^T b, where Q is an implicit orthogonal matrix defined via its Householder reflectors stored in A.
      *
@@ -627,6 +682,15 @@ namespace viennacl
     template<typename T, typename F, unsigned int ALIGNMENT, typename VectorType1, unsigned int A2>
     void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b)
     {
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY && viennacl::traits::handle(b).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        std::vector<T> host_betas(betas.size());
+        for (vcl_size_t i=0; i<betas.size(); ++i)
+          host_betas[i] = betas[i];
+        viennacl::linalg::host_based::inplace_qr_apply_trans_Q(A, host_betas, b, VIENNACL_QR_BLOCK_SIZE);
+        return;
+      }
+
       boost::numeric::ublas::matrix<T> ublas_A(A.size1(), A.size2());
       viennacl::copy(A, ublas_A);
 
@@ -639,6 +703,9 @@ namespace viennacl
     }
 
     /** @brief Overload of inplace-QR factorization of a ViennaCL matrix A
+     *
+     * On the host, each panel of block_size columns is factored recursively and the trailing matrix is updated with matrix-matrix products using the compact WY representation of the panel.
+     * Other backends use a hybrid factorization, where panels are factored on the CPU.
      *
      * @param A            A dense ViennaCL matrix to be factored
      * @param block_size   The block size to be used.
@@ -646,9 +713,138 @@ namespace viennacl
     template<typename T, typename F, unsigned int ALIGNMENT>
     std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, vcl_size_t block_size = 16)
     {
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        std::vector<T> betas;
+        viennacl::linalg::host_based::inplace_qr(A, betas, block_size);
+        return betas;
+      }
       return detail::inplace_qr_hybrid(A, block_size);
     }
 
+    /** @brief Implicit orthogonal factor of a tall-skinny QR factorization computed by tsqr().
+     *
+     * The reflectors of the row blocks are stored in the factored matrix. This class holds the row blocks and the reflectors of the nodes of the reduction tree in main memory.
+     */
+    template<typename NumericT>
+    class tsqr_factors
+    {
+    public:
+      tsqr_factors() : size1(0), size2(0) {}
+
+      /** @brief Number of rows of the factored matrix */
+      vcl_size_t size1;
+      /** @brief Number of columns of the factored matrix */
+      vcl_size_t size2;
+      /** @brief First row of each block, followed by the number of rows */
+      std::vector<vcl_size_t> block_start;
+      /** @brief The scalars beta of the reflectors of each block */
+      std::vector<std::vector<NumericT> > block_betas;
+      /** @brief For each tree node (in the order of application), the first rows of the two blocks whose triangular factors are combined */
+      std::vector<vcl_size_t> node_upper;
+      std::vector<vcl_size_t> node_lower;
+      /** @brief For each tree node, the reflectors of the QR factorization of the stacked triangular factors, stored column-major (2 size2 x size2) */
+      std::vector<std::vector<NumericT> > node_reflectors;
+      std::vector<std::vector<NumericT> > node_betas;
+    };
+
+    /** @brief Tall-skinny QR factorization (TSQR) of a ViennaCL matrix A with at least as many rows as columns.
+     *
+     * The rows are split into blocks, which are factored independently by the threads. The triangular factors of the blocks are combined in a binary reduction tree.
+     * R is returned in the upper triangular part of the first A.size2() rows of A, Q is kept implicitly in A and 'factors'. Other backends factor a host copy of A.
+     *
+     * @param A            The matrix to be factored
+     * @param factors      Output: The implicit orthogonal factor
+     * @param num_blocks   Number of row blocks. If zero, one block per thread is used.
+     * @param block_size   The block size to be used for the factorization of the blocks.
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT>
+    void tsqr(viennacl::matrix<T, F, ALIGNMENT> & A, tsqr_factors<T> & factors, vcl_size_t num_blocks = 0, vcl_size_t block_size = 16)
+    {
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+      case viennacl::MAIN_MEMORY:
+        viennacl::linalg::host_based::tsqr(A, factors, num_blocks, block_size);
+        break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+#ifdef VIENNACL_WITH_OPENCL
+      case viennacl::OPENCL_MEMORY:
+#endif
+#ifdef VIENNACL_WITH_CUDA
+      case viennacl::CUDA_MEMORY:
+#endif
+      {
+        viennacl::matrix<T, F, ALIGNMENT> A_host(A);
+        A_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+        viennacl::linalg::host_based::tsqr(A_host, factors, num_blocks, block_size);
+        A_host.switch_memory_context(viennacl::traits::context(A));
+        A = A_host;
+        break;
+      }
+#endif
+
+      case viennacl::MEMORY_NOT_INITIALIZED:
+        throw memory_exception("not initialised!");
+      default:
+        throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Computes Q^T b for the implicit Q of a TSQR factorization. The least squares solution is obtained from the first A.size2() entries of b and R.
+     *
+     * @param A         The matrix factored by tsqr()
+     * @param factors   The implicit orthogonal factor computed by tsqr()
+     * @param b         The vector b to which the result Q^T b is directly written to
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT, unsigned int A2>
+    void tsqr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, tsqr_factors<T> const & factors, viennacl::vector<T, A2> & b)
+    {
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY && viennacl::traits::handle(b).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        viennacl::linalg::host_based::tsqr_apply_trans_Q(A, factors, b, VIENNACL_QR_BLOCK_SIZE);
+        return;
+      }
+
+      viennacl::matrix<T, F, ALIGNMENT> A_host(A);
+      viennacl::vector<T, A2> b_host(b);
+      A_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+      b_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::host_based::tsqr_apply_trans_Q(A_host, factors, b_host, VIENNACL_QR_BLOCK_SIZE);
+      b_host.switch_memory_context(viennacl::traits::context(b));
+      b = b_host;
+    }
+
+    /** @brief Generates the matrix Q with orthonormal columns (A.size1() x A.size2()) and the triangular factor R (A.size2() x A.size2()) from a TSQR factorization.
+     *
+     * @param A         The matrix factored by tsqr()
+     * @param factors   The implicit orthogonal factor computed by tsqr()
+     * @param Q         Output: Q with A.size2() orthonormal columns such that Q R equals the original matrix. Resized to A.size1() x A.size2() if necessary.
+     * @param R         Output: The upper triangular factor. Resized to A.size2() x A.size2() if necessary.
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT>
+    void tsqr_recoverQ(viennacl::matrix<T, F, ALIGNMENT> const & A, tsqr_factors<T> const & factors, viennacl::matrix<T, F, ALIGNMENT> & Q, viennacl::matrix<T, F, ALIGNMENT> & R)
+    {
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY
+          && viennacl::traits::handle(Q).get_active_handle_id() == viennacl::MAIN_MEMORY
+          && viennacl::traits::handle(R).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        viennacl::linalg::host_based::tsqr_recoverQ(A, factors, Q, R, VIENNACL_QR_BLOCK_SIZE);
+        return;
+      }
+
+      viennacl::matrix<T, F, ALIGNMENT> A_host(A);
+      viennacl::matrix<T, F, ALIGNMENT> Q_host(A.size1(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::matrix<T, F, ALIGNMENT> R_host(A.size2(), A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      A_host.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::host_based::tsqr_recoverQ(A_host, factors, Q_host, R_host, VIENNACL_QR_BLOCK_SIZE);
+      Q_host.switch_memory_context(viennacl::traits::context(Q));
+      R_host.switch_memory_context(viennacl::traits::context(R));
+      Q.resize(A.size1(), A.size2(), false);
+      R.resize(A.size2(), A.size2(), false);
+      Q = Q_host;
+      R = R_host;
+    }
+
     /** @brief Overload of inplace-QR factorization for a general Boost.uBLAS compatible matrix A
      *
      * @param A            A dense compatible to Boost.uBLAS
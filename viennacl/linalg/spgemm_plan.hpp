@@ -0,0 +1,228 @@
+#ifndef VIENNACL_LINALG_SPGEMM_PLAN_HPP_
+#define VIENNACL_LINALG_SPGEMM_PLAN_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/spgemm_plan.hpp
+    @brief Plans for repeated sparse matrix-matrix products with unchanged sparsity patterns.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief Plan for the sparse matrix-matrix product C = A * B, which is carried out repeatedly for factors with unchanged sparsity patterns.
+*
+* The symbolic phase (the number of nonzeros in each row of C) is computed once when the plan is created, execute() then only runs the numeric phase.
+* If the column indices of C are stored in the plan as well, the numeric phase accumulates the products directly into the known positions of C
+* instead of merging rows of B, which is faster at the expense of storing the sparsity pattern of C.
+*
+* Plans are computed for factors in host memory. For factors in OpenCL or CUDA memory, execute() falls back to computing C = prod(A, B).
+* execute() only compares the sizes, the numbers of nonzeros, and the generation counters of the row arrays of the factors (cf. compressed_matrix::row_buffer_generation())
+* with the ones the plan was created for, and computes C = prod(A, B) without the plan if they differ.
+* The generation counter changes whenever the row array of a matrix may have been modified (e.g. by copy(), set(), resize(), or the non-const handle1()),
+* hence new values for the same sparsity pattern are to be written through handle().
+* If the plan is created with check_patterns = true, it keeps a copy of the sparsity patterns of the factors and compares them in execute() if the generation counters differ.
+* This costs one pass over the patterns per product, but also reuses the plan if new values are written with copy().
+*/
+template<typename NumericT>
+class spgemm_plan
+{
+public:
+  spgemm_plan() : size1_(0), size2_(0), nnz_A_(0), nnz_B_(0), generation_A_(0), generation_B_(0), max_length_row_C_(0), store_columns_(false), check_patterns_(false) {}
+
+  /** @brief Creates the plan for the product of A and B.
+  *
+  * @param A               Left factor
+  * @param B               Right factor
+  * @param store_columns   If true, the column indices of C are stored in the plan as well
+  * @param check_patterns  If true, the sparsity patterns of A and B are stored and compared in execute() if the row arrays of the factors may have been modified
+  */
+  template<unsigned int AlignmentV>
+  spgemm_plan(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+              viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+              bool store_columns = true,
+              bool check_patterns = false)
+  {
+    init(A, B, store_columns, check_patterns);
+  }
+
+  /** @brief Recomputes the plan for the product of A and B. See the constructor for details. */
+  template<unsigned int AlignmentV>
+  void init(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+            viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+            bool store_columns = true,
+            bool check_patterns = false)
+  {
+    assert(A.size2() == B.size1() && bool("Size check failed for sparse matrix-matrix product: size2(A) != size1(B)"));
+
+    size1_ = A.size1();
+    size2_ = B.size2();
+    nnz_A_ = A.nnz();
+    nnz_B_ = B.nnz();
+    generation_A_ = A.row_buffer_generation();
+    generation_B_ = B.row_buffer_generation();
+    max_length_row_C_ = 0;
+    store_columns_ = false;
+    check_patterns_ = false;
+    C_row_buffer_.clear();
+    C_col_buffer_.clear();
+    A_pattern_.clear();
+    B_pattern_.clear();
+
+    if (viennacl::traits::handle(A).get_active_handle_id() != viennacl::MAIN_MEMORY)
+      return;
+
+    max_length_row_C_ = viennacl::linalg::host_based::prod_symbolic_impl(A, B, C_row_buffer_);
+    if (check_patterns)
+    {
+      copy_pattern(A, A_pattern_);
+      copy_pattern(B, B_pattern_);
+      check_patterns_ = true;
+    }
+
+    if (store_columns && nnz() > 0)
+    {
+      viennacl::compressed_matrix<NumericT, AlignmentV> C(size1_, size2_, nnz(), viennacl::traits::context(A));
+      viennacl::linalg::host_based::prod_numeric_impl(A, B, C, &(C_row_buffer_[0]), max_length_row_C_);
+
+      unsigned int const * C_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(C.handle2());
+      C_col_buffer_.assign(C_col_buffer, C_col_buffer + nnz());
+      store_columns_ = true;
+    }
+  }
+
+  /** @brief Computes C = A * B, where A and B have the same sparsity patterns as the factors the plan was created for.
+  *
+  * If C already has the size and number of nonzeros of the product, its memory is reused.
+  * If A or B fail the validation described for the class, C = prod(A, B) is computed without using the plan.
+  * The work arrays of the numeric phase are kept in the plan, hence a plan must not be executed by several threads at the same time.
+  */
+  template<unsigned int AlignmentV>
+  void execute(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+               viennacl::compressed_matrix<NumericT, AlignmentV> const & B,
+               viennacl::compressed_matrix<NumericT, AlignmentV> & C)
+  {
+    assert(A.size2() == B.size1() && bool("Size check failed for sparse matrix-matrix product: size2(A) != size1(B)"));
+
+    if (!matches(A, B))
+    {
+      C = viennacl::linalg::prod(A, B);
+      return;
+    }
+
+    if (C.size1() != size1_ || C.size2() != size2_ || C.nnz() != nnz()
+        || viennacl::traits::handle(C).get_active_handle_id() != viennacl::MAIN_MEMORY)
+      C = viennacl::compressed_matrix<NumericT, AlignmentV>(size1_, size2_, nnz(), viennacl::traits::context(A));
+
+    if (nnz() == 0)
+      return;
+
+    if (store_columns_)
+      viennacl::linalg::host_based::prod_numeric_impl(A, B, C, &(C_row_buffer_[0]), &(C_col_buffer_[0]), C_positions_);
+    else
+      viennacl::linalg::host_based::prod_numeric_impl(A, B, C, &(C_row_buffer_[0]), max_length_row_C_);
+
+    // the sparsity pattern of C has been overwritten, hence the row blocks and the cached work partition of C are outdated:
+    C.generate_row_block_information();
+  }
+
+  /** @brief Returns the number of nonzeros of the product, or zero if the plan was not computed in host memory */
+  vcl_size_t nnz() const { return C_row_buffer_.size() > 0 ? C_row_buffer_.back() : 0; }
+
+  /** @brief Returns true if the column indices of the product are stored in the plan */
+  bool stores_columns() const { return store_columns_; }
+
+private:
+  /** @brief Returns true if the plan can be used for the product of A and B */
+  template<unsigned int AlignmentV>
+  bool matches(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+               viennacl::compressed_matrix<NumericT, AlignmentV> const & B) const
+  {
+    if (viennacl::traits::handle(A).get_active_handle_id() != viennacl::MAIN_MEMORY
+        || viennacl::traits::handle(B).get_active_handle_id() != viennacl::MAIN_MEMORY
+        || C_row_buffer_.size() == 0
+        || A.size1() != size1_ || B.size2() != size2_ || A.nnz() != nnz_A_ || B.nnz() != nnz_B_)
+      return false;
+
+    if (A.row_buffer_generation() == generation_A_ && B.row_buffer_generation() == generation_B_)
+      return true;
+
+    return check_patterns_ && same_pattern(A, A_pattern_) && same_pattern(B, B_pattern_);
+  }
+
+  /** @brief Stores the row start indices followed by the column indices of M. Empty for a matrix without rows, which has no row array. */
+  template<unsigned int AlignmentV>
+  static void copy_pattern(viennacl::compressed_matrix<NumericT, AlignmentV> const & M, std::vector<unsigned int> & pattern)
+  {
+    pattern.clear();
+    if (M.size1() == 0)
+      return;
+
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle2());
+
+    pattern.assign(row_buffer, row_buffer + M.size1() + 1);
+    pattern.insert(pattern.end(), col_buffer, col_buffer + M.nnz());
+  }
+
+  /** @brief Returns true if the sparsity pattern of M is the one stored by copy_pattern() */
+  template<unsigned int AlignmentV>
+  static bool same_pattern(viennacl::compressed_matrix<NumericT, AlignmentV> const & M, std::vector<unsigned int> const & pattern)
+  {
+    if (M.size1() == 0)
+      return pattern.empty();
+    if (pattern.size() != M.size1() + 1 + M.nnz())
+      return false;
+
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle2());
+
+    return std::equal(row_buffer, row_buffer + M.size1() + 1, pattern.begin())
+        && std::equal(col_buffer, col_buffer + M.nnz(), pattern.begin() + long(M.size1() + 1));
+  }
+
+  vcl_size_t size1_;
+  vcl_size_t size2_;
+  vcl_size_t nnz_A_;
+  vcl_size_t nnz_B_;
+  vcl_size_t generation_A_;
+  vcl_size_t generation_B_;
+  unsigned int max_length_row_C_;
+  bool store_columns_;
+  bool check_patterns_;
+  std::vector<unsigned int> C_row_buffer_;
+  std::vector<unsigned int> C_col_buffer_;
+  std::vector<unsigned int> C_positions_;   // work array of the numeric phase with known column indices
+  std::vector<unsigned int> A_pattern_;
+  std::vector<unsigned int> B_pattern_;
+};
+
+}
+}
+
+#endif
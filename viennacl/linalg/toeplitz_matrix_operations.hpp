@@ -23,7 +23,9 @@
 */
 
 #include "viennacl/forwards.h"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -40,6 +42,7 @@ namespace viennacl
     /** @brief Carries out matrix-vector multiplication with a toeplitz_matrix
     *
     * Implementation of the convenience expression result = prod(mat, vec);
+    * The Fourier transform of the matrix entries is computed in the first product and only recomputed after non-const access to the entries, cf. toeplitz_matrix::convolution_cache().
     *
     * @param mat    The matrix
     * @param vec    The vector
@@ -53,19 +56,8 @@ namespace viennacl
       assert(mat.size1() == result.size());
       assert(mat.size2() == vec.size());
 
-      viennacl::vector<SCALARTYPE> tmp(vec.size() * 4); tmp.clear();
-      viennacl::vector<SCALARTYPE> tmp2(vec.size() * 4);
-
-      viennacl::vector<SCALARTYPE> tep(mat.elements().size() * 2);
-      viennacl::linalg::real_to_complex(mat.elements(), tep, mat.elements().size());
-
-
-
-      viennacl::copy(vec.begin(), vec.end(), tmp.begin());
-      viennacl::linalg::real_to_complex(tmp, tmp2, vec.size() * 2);
-      viennacl::linalg::convolve(tep, tmp2, tmp);
-      viennacl::linalg::complex_to_real(tmp, tmp2, vec.size() * 2);
-      viennacl::copy(tmp2.begin(), tmp2.begin() + static_cast<vcl_ptrdiff_t>(vec.size()), result.begin());
+      // cyclic convolution of length 2n with the cached transform of the matrix entries:
+      mat.convolution_cache().apply(mat.elements(), vec, result, vec.size() * 2);
     }
 
   } //namespace linalg
@@ -34,6 +34,7 @@
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/detail/op_executor.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
+#include "viennacl/linalg/host_based/fused_vector_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
   #include "viennacl/linalg/opencl/vector_operations.hpp"
@@ -847,6 +848,52 @@ namespace viennacl
       norm_2_cpu(temp, result);
     }
 
+    /** @brief Computes vec = proxy together with the l^2-norm of the new vec. For vectors in host memory, both are computed in a single pass over the data.
+    *
+    * @param vec    The result vector
+    * @param proxy  The vector expression assigned to vec
+    * @param result The l^2-norm of vec after the assignment
+    */
+    template<typename T, typename LHS, typename RHS, typename OP>
+    void assign_norm_2_cpu(vector_base<T> & vec,
+                           viennacl::vector_expression<const LHS, const RHS, OP> const & proxy,
+                           T & result)
+    {
+      assert( (viennacl::traits::size(proxy) == vec.size()) && bool("Incompatible vector sizes!"));
+
+      T squared_norm = 0;
+      if (viennacl::linalg::host_based::fused_assign_norm_2(vec, proxy, squared_norm))
+      {
+        result = std::sqrt(squared_norm);
+        return;
+      }
+
+      vec = proxy;
+      norm_2_cpu(vec, result);
+    }
+
+    /** @brief Computes vec1 = proxy together with the inner product of the new vec1 with vec2. For vectors in host memory, both are computed in a single pass over the data.
+    *
+    * @param vec1   The result vector
+    * @param proxy  The vector expression assigned to vec1
+    * @param vec2   The second vector of the inner product
+    * @param result The inner product <vec1, vec2> after the assignment
+    */
+    template<typename T, typename LHS, typename RHS, typename OP>
+    void assign_inner_prod_cpu(vector_base<T> & vec1,
+                               viennacl::vector_expression<const LHS, const RHS, OP> const & proxy,
+                               vector_base<T> const & vec2,
+                               T & result)
+    {
+      assert( (viennacl::traits::size(proxy) == vec1.size()) && (vec1.size() == vec2.size()) && bool("Incompatible vector sizes!"));
+
+      if (viennacl::linalg::host_based::fused_assign_inner_prod(vec1, proxy, vec2, result))
+        return;
+
+      vec1 = proxy;
+      inner_prod_cpu(vec1, vec2, result);
+    }
+
 
 
 
@@ -1389,7 +1436,8 @@ namespace viennacl
     assert( (viennacl::traits::size(proxy) == v1.size()) && bool("Incompatible vector sizes!"));
     assert( (v1.size() > 0) && bool("Vector not yet initialized!") );
 
-    linalg::detail::op_executor<vector_base<T>, op_inplace_add, vector_expression<const LHS, const RHS, OP> >::apply(v1, proxy);
+    if (!viennacl::linalg::host_based::fused_vector_assign<op_inplace_add>(v1, proxy))
+      linalg::detail::op_executor<vector_base<T>, op_inplace_add, vector_expression<const LHS, const RHS, OP> >::apply(v1, proxy);
 
     return v1;
   }
@@ -1400,7 +1448,8 @@ namespace viennacl
     assert( (viennacl::traits::size(proxy) == v1.size()) && bool("Incompatible vector sizes!"));
     assert( (v1.size() > 0) && bool("Vector not yet initialized!") );
 
-    linalg::detail::op_executor<vector_base<T>, op_inplace_sub, vector_expression<const LHS, const RHS, OP> >::apply(v1, proxy);
+    if (!viennacl::linalg::host_based::fused_vector_assign<op_inplace_sub>(v1, proxy))
+      linalg::detail::op_executor<vector_base<T>, op_inplace_sub, vector_expression<const LHS, const RHS, OP> >::apply(v1, proxy);
 
     return v1;
   }
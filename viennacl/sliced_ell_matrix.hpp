@@ -55,6 +55,7 @@ public:
   /** @brief Standard constructor for setting the row and column sizes as well as the block size.
     *
     * Supported values for num_rows_per_block_ are 32, 64, 128, 256. Other values may work, but are unlikely to yield good performance.
+    * If zero, the block size is chosen when data is copied to the matrix: 32 for GPUs, and the SIMD width of the CPU (at least 8) in main memory.
     **/
   sliced_ell_matrix(size_type num_rows,
                     size_type num_cols,
@@ -144,7 +145,12 @@ void copy(CPUMatrixT const & cpu_matrix, sliced_ell_matrix<ScalarT, IndexT> & gp
   assert( (gpu_matrix.size2() == 0 || viennacl::traits::size2(cpu_matrix) == gpu_matrix.size2()) && bool("Size mismatch") );
 
   if (gpu_matrix.rows_per_block() == 0) // not yet initialized by user. Set default: 32 is perfect for NVIDIA GPUs and older AMD GPUs. Still okay for newer AMD GPUs.
-    gpu_matrix.rows_per_block_ = 32;
+  {
+    if (traits::context(gpu_matrix.handle1()).memory_type() == MAIN_MEMORY) // CPU: slices as high as (a small multiple of) the SIMD width
+      gpu_matrix.rows_per_block_ = viennacl::linalg::host_based::detail::sell_host_rows_per_block<ScalarT>();
+    else
+      gpu_matrix.rows_per_block_ = 32;
+  }
 
   if (viennacl::traits::size1(cpu_matrix) > 0 && viennacl::traits::size2(cpu_matrix) > 0)
   {
@@ -24,7 +24,10 @@
 
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
+#include "viennacl/linalg/detail/fft_convolution_cache.hpp"
 
 #include "viennacl/fft.hpp"
 
@@ -73,6 +76,7 @@ public:
   void resize(vcl_size_t sz, bool preserve = true)
   {
     elements_.resize(sz * 2, preserve);
+    convolution_cache_.invalidate();
   }
 
   /** @brief Returns the OpenCL handle
@@ -84,10 +88,15 @@ public:
   /**
        * @brief Returns an internal viennacl::vector, which represents a Toeplitz matrix elements
        *
+       * Non-const access discards the cached transform of the entries used for matrix-vector products,
+       * hence call elements() again after changing entries instead of keeping the reference across products.
        */
-  viennacl::vector<NumericT, AlignmentV> & elements() { return elements_; }
+  viennacl::vector<NumericT, AlignmentV> & elements() { convolution_cache_.invalidate(); return elements_; }
   viennacl::vector<NumericT, AlignmentV> const & elements() const { return elements_; }
 
+  /** @brief Returns the cached transform of the entries and the work vectors used for matrix-vector products. Call invalidate() on it after changing entries through a reference or an entry proxy kept across products. */
+  viennacl::linalg::detail::fft_convolution_cache<NumericT> & convolution_cache() const { return convolution_cache_; }
+
 
   /**
        * @brief Returns the number of rows of the matrix
@@ -124,6 +133,7 @@ public:
       index = -index;
     else if
         (index > 0) index = 2 * static_cast<long>(size1()) - index;
+    convolution_cache_.invalidate();
     return elements_[vcl_size_t(index)];
   }
 
@@ -137,6 +147,7 @@ public:
   toeplitz_matrix<NumericT, AlignmentV>& operator +=(toeplitz_matrix<NumericT, AlignmentV>& that)
   {
     elements_ += that.elements();
+    convolution_cache_.invalidate();
     return *this;
   }
 
@@ -146,6 +157,7 @@ private:
 
 
   viennacl::vector<NumericT, AlignmentV> elements_;
+  mutable viennacl::linalg::detail::fft_convolution_cache<NumericT> convolution_cache_;
 };
 
 /** @brief Copies a Toeplitz matrix from the std::vector to the OpenCL device (either GPU or multi-core CPU)
@@ -0,0 +1,169 @@
+#ifndef VIENNACL_TOOLS_CPU_FEATURES_HPP_
+#define VIENNACL_TOOLS_CPU_FEATURES_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/cpu_features.hpp
+    @brief Runtime detection of SIMD instruction set extensions of the host CPU.
+
+    With GCC and Clang on x86, SIMD kernels of the host backend are compiled with function-level target attributes (VIENNACL_TARGET_AVX2, VIENNACL_TARGET_AVX512)
+    and selected at runtime via host_isa(). Hence, a single binary runs on all x86 CPUs without compiling with -mavx2 or similar.
+    Define VIENNACL_NO_CPU_DISPATCH to disable runtime dispatch, in which case only the instruction set enabled at compile time (e.g. via VIENNACL_WITH_AVX2 and -mavx2) is used.
+
+    The selected instruction set can be capped by setting the environment variable VIENNACL_HOST_ISA to one of 'generic', 'sse42', 'avx2', 'avx512'.
+*/
+
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(VIENNACL_NO_CPU_DISPATCH) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define VIENNACL_WITH_CPU_DISPATCH
+#endif
+
+#ifdef VIENNACL_WITH_CPU_DISPATCH
+  #define VIENNACL_TARGET_AVX2    __attribute__((target("avx2,fma")))
+  #define VIENNACL_TARGET_AVX512  __attribute__((target("avx512f,avx2,fma")))
+  #define VIENNACL_HAVE_AVX2_KERNELS
+  #define VIENNACL_HAVE_AVX512_KERNELS
+#else
+  #define VIENNACL_TARGET_AVX2
+  #define VIENNACL_TARGET_AVX512
+  #if defined(VIENNACL_WITH_AVX2) || (defined(__AVX2__) && defined(__FMA__))
+    #define VIENNACL_HAVE_AVX2_KERNELS
+  #endif
+  #if defined(__AVX512F__) && defined(__FMA__)
+    #define VIENNACL_HAVE_AVX512_KERNELS
+  #endif
+#endif
+
+#if defined(VIENNACL_HAVE_AVX2_KERNELS) || defined(VIENNACL_HAVE_AVX512_KERNELS)
+  #include <immintrin.h>
+#endif
+
+namespace viennacl
+{
+namespace tools
+{
+
+/** @brief Instruction set levels for the SIMD kernels of the host backend. Each level implies the previous ones. */
+enum cpu_isa
+{
+  ISA_GENERIC = 0,
+  ISA_SSE42,
+  ISA_AVX2,     // AVX2 and FMA
+  ISA_AVX512    // AVX-512F, AVX2 and FMA
+};
+
+/** @brief Instruction set extensions supported by the host CPU (and enabled by the operating system). */
+struct cpu_features
+{
+  cpu_features() : sse42(false), avx(false), avx2(false), fma(false), avx512f(false) {}
+
+  bool sse42;
+  bool avx;
+  bool avx2;
+  bool fma;
+  bool avx512f;
+};
+
+namespace detail
+{
+  inline cpu_features detect_cpu_features()
+  {
+    cpu_features features;
+#ifdef VIENNACL_WITH_CPU_DISPATCH
+    __builtin_cpu_init();
+    features.sse42   = __builtin_cpu_supports("sse4.2") != 0;
+    features.avx     = __builtin_cpu_supports("avx") != 0;
+    features.avx2    = __builtin_cpu_supports("avx2") != 0;
+    features.fma     = __builtin_cpu_supports("fma") != 0;
+    features.avx512f = __builtin_cpu_supports("avx512f") != 0;
+#else
+  #if defined(__SSE4_2__)
+    features.sse42 = true;
+  #endif
+  #if defined(__AVX__)
+    features.avx = true;
+  #endif
+  #if defined(VIENNACL_HAVE_AVX2_KERNELS)
+    features.avx2 = features.fma = true;
+  #endif
+  #if defined(VIENNACL_HAVE_AVX512_KERNELS)
+    features.avx512f = true;
+  #endif
+#endif
+    return features;
+  }
+
+  inline cpu_isa select_isa(cpu_features const & features)
+  {
+    cpu_isa isa = ISA_GENERIC;
+    if (features.sse42)
+      isa = ISA_SSE42;
+    if (isa == ISA_SSE42 && features.avx2 && features.fma)
+      isa = ISA_AVX2;
+    if (isa == ISA_AVX2 && features.avx512f)
+      isa = ISA_AVX512;
+
+    // user-provided cap:
+    if (char const * env = std::getenv("VIENNACL_HOST_ISA"))
+    {
+      cpu_isa cap = isa;
+      if      (std::strcmp(env, "generic") == 0) cap = ISA_GENERIC;
+      else if (std::strcmp(env, "sse42")   == 0) cap = ISA_SSE42;
+      else if (std::strcmp(env, "avx2")    == 0) cap = ISA_AVX2;
+      else if (std::strcmp(env, "avx512")  == 0) cap = ISA_AVX512;
+      if (cap < isa)
+        isa = cap;
+    }
+
+    return isa;
+  }
+}
+
+/** @brief Returns the instruction set extensions of the host CPU. Detection is carried out only once. */
+inline cpu_features const & host_cpu_features()
+{
+  static const cpu_features features = detail::detect_cpu_features();
+  return features;
+}
+
+/** @brief Returns the best instruction set level for which host kernels are available. Determined only once. */
+inline cpu_isa host_isa()
+{
+  static const cpu_isa isa = detail::select_isa(host_cpu_features());
+  return isa;
+}
+
+/** @brief Returns a human-readable name of the instruction set level, e.g. for logging. */
+inline char const * isa_name(cpu_isa isa)
+{
+  switch (isa)
+  {
+  case ISA_SSE42:  return "sse42";
+  case ISA_AVX2:   return "avx2";
+  case ISA_AVX512: return "avx512";
+  default:         return "generic";
+  }
+}
+
+} //namespace tools
+} //namespace viennacl
+
+
+#endif
@@ -400,7 +400,8 @@ vector_base<NumericT, SizeT, DistanceT> & vector_base<NumericT, SizeT, DistanceT
     pad();
   }
 
-  linalg::detail::op_executor<self_type, op_assign, vector_expression<const LHS, const RHS, OP> >::apply(*this, proxy);
+  if (!viennacl::linalg::host_based::fused_vector_assign<op_assign>(*this, proxy))
+    linalg::detail::op_executor<self_type, op_assign, vector_expression<const LHS, const RHS, OP> >::apply(*this, proxy);
 
   return *this;
 }